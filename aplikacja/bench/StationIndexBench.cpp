@@ -0,0 +1,182 @@
+/**
+ * @file StationIndexBench.cpp
+ * @brief Pomiar wydajności i poprawności indeksu przestrzennego stacji (StationIndex).
+ *
+ * Program tworzy losowe stacje na obszarze Polski z losowymi zestawami wskaźników, sprawdza wyniki
+ * zapytań nearest i withinRadius (bez filtra i z filtrem PM2.5) z przeglądem zupełnym, a następnie
+ * mierzy liczbę zapytań na sekundę. Uruchomienie:
+ *
+ *     StationIndexBench [liczba_stacji] [liczba_zapytań]
+ *
+ * Kod wyjścia 1 oznacza niezgodność z przeglądem zupełnym.
+ */
+
+#include "StationIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Punkt zapytania.
+ */
+struct Query {
+    double latitude;  ///< Szerokość geograficzna.
+    double longitude; ///< Długość geograficzna.
+};
+
+/**
+ * @brief Wyszukuje k najbliższych stacji przeglądem zupełnym.
+ *
+ * @return Indeksy stacji rosnąco według odległości.
+ */
+std::vector<size_t> bruteNearest(const std::vector<Station>& stations, const std::vector<uint32_t>& masks,
+    const Query& query, size_t k, uint32_t requiredMask) {
+    std::vector<std::pair<double, size_t>> all;
+    for (size_t i = 0; i < stations.size(); i++) {
+        if ((masks[i] & requiredMask) != requiredMask) continue;
+        all.push_back({ StationIndex::distanceKm(query.latitude, query.longitude,
+            stations[i].getLatitude(), stations[i].getLongitude()), i });
+    }
+    std::sort(all.begin(), all.end());
+    std::vector<size_t> result;
+    for (size_t i = 0; i < std::min(k, all.size()); i++) {
+        result.push_back(all[i].second);
+    }
+    return result;
+}
+
+/**
+ * @brief Wyszukuje stacje w promieniu przeglądem zupełnym.
+ *
+ * @return Indeksy stacji rosnąco.
+ */
+std::vector<size_t> bruteRadius(const std::vector<Station>& stations, const std::vector<uint32_t>& masks,
+    const Query& query, double radiusKm, uint32_t requiredMask) {
+    std::vector<size_t> result;
+    for (size_t i = 0; i < stations.size(); i++) {
+        if ((masks[i] & requiredMask) != requiredMask) continue;
+        if (StationIndex::distanceKm(query.latitude, query.longitude, stations[i].getLatitude(),
+            stations[i].getLongitude()) <= radiusKm) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Porównuje odległości wyników z przeglądem zupełnym (kolejność równo odległych stacji może się różnić).
+ *
+ * @return Liczba niezgodnych zapytań.
+ */
+size_t verify(const StationIndex& index, const std::vector<Station>& stations, const std::vector<uint32_t>& masks,
+    const std::vector<Query>& queries, size_t k, double radiusKm, uint32_t requiredMask) {
+    const double TOLERANCE_KM = 1e-6;
+    size_t mismatches = 0;
+    for (const auto& query : queries) {
+        const std::vector<StationIndex::Hit> hits = index.nearest(query.latitude, query.longitude, k, requiredMask);
+        const std::vector<size_t> expected = bruteNearest(stations, masks, query, k, requiredMask);
+        bool ok = hits.size() == expected.size();
+        for (size_t i = 0; ok && i < hits.size(); i++) {
+            const Station& station = stations[expected[i]];
+            const double distance = StationIndex::distanceKm(query.latitude, query.longitude,
+                station.getLatitude(), station.getLongitude());
+            ok = std::abs(hits[i].distanceKm - distance) <= TOLERANCE_KM &&
+                (masks[hits[i].index] & requiredMask) == requiredMask;
+        }
+
+        std::vector<size_t> inRadius;
+        for (const auto& hit : index.withinRadius(query.latitude, query.longitude, radiusKm, requiredMask)) {
+            inRadius.push_back(hit.index);
+        }
+        std::sort(inRadius.begin(), inRadius.end());
+        ok = ok && inRadius == bruteRadius(stations, masks, query, radiusKm, requiredMask);
+
+        if (!ok) mismatches++;
+    }
+    return mismatches;
+}
+
+/**
+ * @brief Mierzy czas wykonania zapytań i wypisuje liczbę zapytań na sekundę.
+ *
+ * @param label Opis zapytania.
+ * @param queries Punkty zapytań.
+ * @param run Zapytanie dla jednego punktu; zwraca liczbę wyników (sumowaną, żeby kompilator jej nie pominął).
+ */
+template <typename Run>
+void measure(const char* label, const std::vector<Query>& queries, Run run) {
+    size_t results = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& query : queries) {
+        results += run(query);
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-40s %12.0f zapytań/s  (%.1f wyników na zapytanie)\n", label,
+        queries.size() / seconds, static_cast<double>(results) / queries.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t stationCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000;
+    const size_t queryCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000000;
+    const size_t VERIFIED_QUERIES = 2000;
+    const size_t K = 5;
+    const double RADIUS_KM = 25.0;
+
+    // Stacje w prostokącie obejmującym Polskę, każda mierzy losowy podzbiór wskaźników
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<double> latitude(49.0, 54.9);
+    std::uniform_real_distribution<double> longitude(14.1, 24.2);
+    const char* const formulas[] = { "PM10", "PM2.5", "O3", "NO2", "SO2", "CO", "C6H6" };
+    std::vector<Station> stations;
+    std::vector<uint32_t> masks;
+    for (size_t i = 0; i < stationCount; i++) {
+        stations.emplace_back(static_cast<int>(i), "Stacja " + std::to_string(i), latitude(random), longitude(random),
+            "", "", "", "", "");
+        std::vector<Sensor> sensors;
+        for (const char* formula : formulas) {
+            if (random() % 3 == 0) sensors.emplace_back(static_cast<int>(sensors.size()), formula, formula);
+        }
+        masks.push_back(StationIndex::parameterMask(sensors));
+    }
+
+    std::vector<Query> queries(queryCount);
+    for (auto& query : queries) {
+        query = { latitude(random), longitude(random) };
+    }
+
+    const auto buildStart = std::chrono::steady_clock::now();
+    const StationIndex index(stations, masks);
+    const double buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - buildStart).count();
+    std::printf("Stacje: %zu, zapytania: %zu, budowa indeksu: %.2f ms\n", stationCount, queryCount, buildSeconds * 1000.0);
+
+    const uint32_t pm25 = StationIndex::parameterBit("PM2.5");
+    const std::vector<Query> verified(queries.begin(), queries.begin() + std::min(VERIFIED_QUERIES, queries.size()));
+    const size_t mismatches = verify(index, stations, masks, verified, K, RADIUS_KM, StationIndex::ALL_PARAMETERS) +
+        verify(index, stations, masks, verified, K, RADIUS_KM, pm25);
+    std::printf("Zgodność z przeglądem zupełnym: %zu zapytań, niezgodnych: %zu\n", 2 * verified.size(), mismatches);
+
+    StationIndex::Hit hits[K];
+    measure("nearest k=5", queries, [&](const Query& q) {
+        return index.nearest(q.latitude, q.longitude, K, StationIndex::ALL_PARAMETERS, hits);
+    });
+    measure("nearest k=5, PM2.5", queries, [&](const Query& q) {
+        return index.nearest(q.latitude, q.longitude, K, pm25, hits);
+    });
+    measure("withinRadius 25 km", queries, [&](const Query& q) {
+        return index.withinRadius(q.latitude, q.longitude, RADIUS_KM).size();
+    });
+    measure("withinRadius 25 km, PM2.5", queries, [&](const Query& q) {
+        return index.withinRadius(q.latitude, q.longitude, RADIUS_KM, pm25).size();
+    });
+
+    return mismatches == 0 ? 0 : 1;
+}
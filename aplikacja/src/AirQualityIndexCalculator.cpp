@@ -0,0 +1,146 @@
+/**
+ * @file AirQualityIndexCalculator.cpp
+ * @brief Implementacja lokalnego wyznaczania indeksu jakości powietrza.
+ */
+
+#include "AirQualityIndexCalculator.h"
+#include "MeasurementSeries.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Górne granice pięciu pierwszych poziomów indeksu dla wskaźnika (ug/m3, wartości 1-godzinne).
+ */
+struct Breakpoints {
+    const char* formula;  ///< Wzór wskaźnika (klucz wyniku).
+    double upper[5];      ///< Górne granice poziomów 0-4; powyżej ostatniej - poziom 5.
+};
+
+const Breakpoints BREAKPOINTS[] = {
+    { "PM10",  { 20.0, 50.0, 80.0, 110.0, 150.0 } },
+    { "PM2.5", { 13.0, 35.0, 55.0, 75.0, 110.0 } },
+    { "O3",    { 70.0, 120.0, 150.0, 180.0, 240.0 } },
+    { "NO2",   { 40.0, 100.0, 150.0, 230.0, 400.0 } },
+    { "SO2",   { 50.0, 100.0, 200.0, 350.0, 500.0 } },
+    { "CO",    { 3000.0, 7000.0, 11000.0, 15000.0, 21000.0 } },
+};
+
+const char* const LEVEL_NAMES[] = { "Bardzo dobry", "Dobry", "Umiarkowany", "Dostateczny", "Zły", "Bardzo zły" };
+
+} // namespace
+
+/**
+ * @brief Konstruktor klasy AirQualityIndexCalculator.
+ *
+ * @param maxAgeSeconds Maksymalny wiek pomiaru (0 - bez ograniczenia).
+ */
+AirQualityIndexCalculator::AirQualityIndexCalculator(int64_t maxAgeSeconds)
+    : maxAgeSeconds_(maxAgeSeconds) {
+}
+
+/**
+ * @brief Wyznacza poziom indeksu dla wartości wskaźnika.
+ *
+ * @param formula Wzór wskaźnika.
+ * @param value Stężenie w ug/m3.
+ * @return Poziom 0-5 lub LEVEL_NONE.
+ */
+int AirQualityIndexCalculator::levelFor(const std::string& formula, double value) {
+    if (!(value >= 0)) return LEVEL_NONE;
+
+    for (const auto& breakpoints : BREAKPOINTS) {
+        if (formula != breakpoints.formula) continue;
+
+        int level = 0;
+        while (level < 5 && value > breakpoints.upper[level]) level++;
+        return level;
+    }
+    return LEVEL_NONE;
+}
+
+/**
+ * @brief Zwraca nazwę poziomu indeksu.
+ *
+ * @param level Poziom 0-5.
+ * @return Nazwa poziomu lub pusty tekst.
+ */
+std::string AirQualityIndexCalculator::levelName(int level) {
+    if (level < 0 || level > 5) return "";
+    return LEVEL_NAMES[level];
+}
+
+/**
+ * @brief Wyznacza indeks stacji z ostatnich prawidłowych pomiarów każdego wskaźnika.
+ *
+ * Pomiary oznaczone jako podejrzane (skok, zablokowany czujnik) są pomijane, podobnie jak
+ * pomiary z przyszłości i starsze niż maxAgeSeconds względem chwili obliczeń. Indeks ogólny
+ * jest pomijany, jeśli któryś indeksowany wskaźnik stacji nie ma aktualnego pomiaru.
+ *
+ * @param measurements Pomiary według wzoru wskaźnika.
+ * @param now Chwila obliczeń.
+ * @param measuredFormulas Wskaźniki mierzone na stacji.
+ * @return Nazwy poziomów według klucza.
+ */
+std::map<std::string, std::string> AirQualityIndexCalculator::compute(
+    const std::map<std::string, std::vector<Measurement>>& measurements, int64_t now,
+    const std::vector<std::string>& measuredFormulas) const {
+    std::map<std::string, std::string> result;
+    int overall = LEVEL_NONE;
+    bool complete = true;
+
+    for (const auto& entry : measurements) {
+        int64_t latestTimestamp = INT64_MIN;
+        double latestValue = -1.0;
+        for (const auto& m : entry.second) {
+            if (!m.isValid() || m.isSuspect()) continue;
+
+            int64_t timestamp;
+            if (!MeasurementSeries::parseTimestamp(m.getDate(), timestamp)) continue;
+            if (timestamp > now || (maxAgeSeconds_ > 0 && timestamp < now - maxAgeSeconds_)) continue;
+            if (timestamp > latestTimestamp) {
+                latestTimestamp = timestamp;
+                latestValue = m.getValue();
+            }
+        }
+
+        const int level = levelFor(entry.first, latestValue);
+        if (level == LEVEL_NONE) {
+            // Wskaźnik indeksowany bez aktualnego pomiaru - indeks ogólny byłby niepełny
+            if (levelFor(entry.first, 0.0) != LEVEL_NONE) complete = false;
+            continue;
+        }
+
+        result[entry.first] = levelName(level);
+        overall = std::max(overall, level);
+    }
+
+    for (const auto& formula : measuredFormulas) {
+        if (levelFor(formula, 0.0) != LEVEL_NONE && !result.count(formula)) complete = false;
+    }
+
+    if (overall != LEVEL_NONE && complete) {
+        result["Ogólny"] = levelName(overall);
+    }
+    return result;
+}
+
+/**
+ * @brief Wyznacza indeksy wielu stacji w jednym przebiegu.
+ *
+ * @param stations Pomiary stacji.
+ * @param now Chwila obliczeń.
+ * @return Indeks każdej stacji według jej ID (stacje bez aktualnych pomiarów są pomijane).
+ */
+std::map<int, std::map<std::string, std::string>> AirQualityIndexCalculator::computeAll(
+    const std::vector<StationReadings>& stations, int64_t now) const {
+    std::map<int, std::map<std::string, std::string>> result;
+    for (const auto& station : stations) {
+        std::map<std::string, std::string> index = compute(station.measurements, now, station.measuredFormulas);
+        if (!index.empty()) {
+            result[station.stationId] = std::move(index);
+        }
+    }
+    return result;
+}
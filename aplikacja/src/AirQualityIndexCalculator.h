@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "Measurement.h"
+
+/**
+ * @file AirQualityIndexCalculator.h
+ * @brief Lokalne wyznaczanie polskiego indeksu jakości powietrza z posiadanych pomiarów.
+ *
+ * Zastępuje zapytanie aqindex/getIndex wysyłane osobno dla każdej stacji. Stosuje progi
+ * indeksu GIOŚ dla wartości 1-godzinnych (sześć poziomów od "Bardzo dobry" do "Bardzo zły");
+ * indeks ogólny to najgorszy z indeksów poszczególnych wskaźników i jest wyznaczany tylko wtedy,
+ * gdy każdy indeksowany wskaźnik mierzony na stacji ma aktualny pomiar. Wynik ma te same klucze
+ * co ApiClient::getAirQualityIndex ("Ogólny", "PM10", "PM2.5", "O3", "NO2", "SO2", "CO").
+ */
+class AirQualityIndexCalculator {
+public:
+    static const int LEVEL_NONE = -1; ///< Brak poziomu (nieznany wskaźnik lub brak pomiaru).
+
+    /**
+     * @brief Pomiary jednej stacji do obliczeń zbiorczych.
+     */
+    struct StationReadings {
+        int stationId;                                              ///< ID stacji.
+        std::map<std::string, std::vector<Measurement>> measurements; ///< Pomiary według wzoru wskaźnika.
+        std::vector<std::string> measuredFormulas;                  ///< Wszystkie wskaźniki mierzone na stacji.
+    };
+
+    /**
+     * @brief Konstruktor klasy AirQualityIndexCalculator.
+     *
+     * @param maxAgeSeconds Maksymalny wiek pomiaru względem chwili obliczeń (0 - bez ograniczenia).
+     */
+    explicit AirQualityIndexCalculator(int64_t maxAgeSeconds = 3 * 3600);
+
+    /**
+     * @brief Wyznacza poziom indeksu dla wartości wskaźnika.
+     *
+     * @param formula Wzór wskaźnika (np. "PM10").
+     * @param value Stężenie w ug/m3.
+     * @return Poziom 0 (bardzo dobry) - 5 (bardzo zły) lub LEVEL_NONE.
+     */
+    static int levelFor(const std::string& formula, double value);
+
+    /**
+     * @brief Zwraca nazwę poziomu indeksu (taką jak w API GIOŚ).
+     *
+     * @param level Poziom 0-5.
+     * @return Nazwa poziomu (UTF-8) lub pusty tekst dla LEVEL_NONE.
+     */
+    static std::string levelName(int level);
+
+    /**
+     * @brief Wyznacza indeks stacji z ostatnich prawidłowych pomiarów każdego wskaźnika.
+     *
+     * @param measurements Pomiary według wzoru wskaźnika (w dowolnej kolejności).
+     * @param now Chwila obliczeń (znacznik czasu jak w MeasurementSeries).
+     * @param measuredFormulas Wskaźniki mierzone na stacji, także te bez przekazanych pomiarów.
+     * @return Nazwy poziomów według klucza (tylko wskaźniki z aktualnym pomiarem). Klucz "Ogólny"
+     *         występuje tylko wtedy, gdy aktualny pomiar ma każdy indeksowany wskaźnik z measurements
+     *         i measuredFormulas - indeks częściowy mógłby zaniżać ocenę stacji.
+     */
+    std::map<std::string, std::string> compute(const std::map<std::string, std::vector<Measurement>>& measurements,
+        int64_t now, const std::vector<std::string>& measuredFormulas = {}) const;
+
+    /**
+     * @brief Wyznacza indeksy wielu stacji w jednym przebiegu.
+     *
+     * @param stations Pomiary stacji.
+     * @param now Chwila obliczeń.
+     * @return Indeks każdej stacji według jej ID.
+     */
+    std::map<int, std::map<std::string, std::string>> computeAll(const std::vector<StationReadings>& stations,
+        int64_t now) const;
+
+private:
+    int64_t maxAgeSeconds_; ///< Maksymalny wiek pomiaru.
+};
@@ -0,0 +1,252 @@
+/**
+ * @file AnomalyDetector.cpp
+ * @brief Implementacja strumieniowego wykrywania skoków, zablokowanych czujników i zmian poziomu.
+ */
+
+#include "AnomalyDetector.h"
+#include "MeasurementSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+/**
+ * @brief Konstruktor z parametrami domyślnymi.
+ */
+AnomalyDetector::AnomalyDetector()
+    : settings_() {
+}
+
+/**
+ * @brief Konstruktor klasy AnomalyDetector.
+ *
+ * @param settings Parametry detekcji.
+ */
+AnomalyDetector::AnomalyDetector(const Settings& settings)
+    : settings_(settings) {
+}
+
+/**
+ * @brief Przetwarza kolejny pomiar sensora i aktualizuje jego stan.
+ *
+ * Kolejność kontroli:
+ * - seria identycznych odczytów o długości co najmniej flatlineLength - zablokowany czujnik,
+ * - |z| względem średniej i odchylenia EWMA powyżej progu - skok (nie zmienia poziomu bazowego);
+ *   kilka skoków z rzędu w tym samym kierunku oznacza zmianę poziomu,
+ * - dwustronny CUSUM na wartościach z - stopniowa, trwała zmiana poziomu.
+ * Po wykryciu zmiany poziomu średnia jest ustawiana od nowa.
+ *
+ * @param state Stan sensora.
+ * @param value Wartość pomiaru (ujemna = brak pomiaru).
+ * @return Flagi jakości pomiaru.
+ */
+uint8_t AnomalyDetector::update(State& state, double value) const {
+    // Brak pomiaru przerywa serię identycznych odczytów, ale nie zmienia poziomu bazowego
+    if (!(value >= 0)) {
+        state.runLength = 0;
+        return Measurement::FLAG_NONE;
+    }
+
+    uint8_t flags = Measurement::FLAG_NONE;
+
+    if (state.runLength > 0 && value == state.lastValue) state.runLength++;
+    else state.runLength = 1;
+    state.lastValue = value;
+    if (state.runLength >= settings_.flatlineLength) {
+        flags |= Measurement::FLAG_FLATLINE;
+    }
+
+    if (state.count >= settings_.warmup) {
+        const double sd = std::max(std::sqrt(state.variance), settings_.minStdDev);
+        const double z = (value - state.mean) / sd;
+
+        if (std::fabs(z) > settings_.zThreshold) {
+            const int direction = z > 0 ? 1 : -1;
+            state.spikeRun = state.spikeRun * direction > 0 ? state.spikeRun + direction : direction;
+            if (static_cast<size_t>(std::abs(state.spikeRun)) >= settings_.spikeRunLimit) {
+                rebaseline(state, value);
+                return flags | Measurement::FLAG_LEVEL_SHIFT;
+            }
+            return flags | Measurement::FLAG_SPIKE;
+        }
+        state.spikeRun = 0;
+
+        state.cusumHigh = std::max(0.0, state.cusumHigh + z - settings_.cusumDrift);
+        state.cusumLow = std::max(0.0, state.cusumLow - z - settings_.cusumDrift);
+        if (state.cusumHigh > settings_.cusumThreshold || state.cusumLow > settings_.cusumThreshold) {
+            rebaseline(state, value);
+            return flags | Measurement::FLAG_LEVEL_SHIFT;
+        }
+    }
+
+    // Aktualizacja EWMA; na początku waga 1/(n+1), czyli zwykła średnia z dotychczasowych pomiarów
+    if (state.count == 0) {
+        state.mean = value;
+        state.variance = 0.0;
+    }
+    else {
+        const double a = std::max(settings_.alpha, 1.0 / static_cast<double>(state.count + 1));
+        const double diff = value - state.mean;
+        const double increment = a * diff;
+        state.mean += increment;
+        state.variance = (1.0 - a) * (state.variance + diff * increment);
+    }
+    state.count++;
+
+    return flags;
+}
+
+/**
+ * @brief Ustala nowy poziom bazowy po wykryciu zmiany poziomu.
+ *
+ * Wariancja jest zachowywana (skala zmienności zwykle się nie zmienia), a ocena wznawia się
+ * po ponownym okresie rozgrzewki.
+ *
+ * @param state Stan sensora.
+ * @param value Wartość wyznaczająca nowy poziom.
+ */
+void AnomalyDetector::rebaseline(State& state, double value) const {
+    state.mean = value;
+    state.count = 1;
+    state.cusumHigh = 0.0;
+    state.cusumLow = 0.0;
+    state.spikeRun = 0;
+}
+
+/**
+ * @brief Zwraca opis flag jakości.
+ *
+ * @param flags Suma bitowa wartości Measurement::Flag.
+ * @return Opis tekstowy (UTF-8).
+ */
+std::string AnomalyDetector::describeFlags(uint8_t flags) {
+    std::string description;
+    auto add = [&](const char* text) {
+        if (!description.empty()) description += ", ";
+        description += text;
+    };
+    if (flags & Measurement::FLAG_SPIKE) add("skok");
+    if (flags & Measurement::FLAG_FLATLINE) add("stała wartość");
+    if (flags & Measurement::FLAG_LEVEL_SHIFT) add("zmiana poziomu");
+    return description;
+}
+
+/**
+ * @brief Konstruktor klasy AnomalyMonitor.
+ *
+ * @param detector Detektor używany dla wszystkich sensorów.
+ */
+AnomalyMonitor::AnomalyMonitor(const AnomalyDetector& detector)
+    : detector_(detector) {
+}
+
+/**
+ * @brief Przetwarza pomiar sensora.
+ *
+ * Tylko pomiary nowsze od ostatnio przetworzonego aktualizują stan EWMA/CUSUM. Flagi niezerowe
+ * z ostatnich FLAG_RETENTION_SECONDS są zapamiętywane, więc ponownie pobrany pomiar dostaje
+ * te same flagi; starsze flagi są usuwane przy każdym nowym pomiarze (są już w bazie).
+ *
+ * @param sensorId ID sensora.
+ * @param timestamp Znacznik czasu pomiaru.
+ * @param value Wartość pomiaru.
+ * @return Flagi jakości.
+ */
+uint8_t AnomalyMonitor::push(int sensorId, int64_t timestamp, double value) {
+    AnomalyDetector::State& state = states_[sensorId];
+    if (timestamp <= state.lastTimestamp) {
+        auto sensorFlags = flags_.find(sensorId);
+        if (sensorFlags == flags_.end()) return Measurement::FLAG_NONE;
+        const auto& remembered = sensorFlags->second;
+        auto it = std::lower_bound(remembered.begin(), remembered.end(), timestamp,
+            [](const std::pair<int64_t, uint8_t>& entry, int64_t value) { return entry.first < value; });
+        return it != remembered.end() && it->first == timestamp ? it->second : static_cast<uint8_t>(Measurement::FLAG_NONE);
+    }
+    state.lastTimestamp = timestamp;
+    const uint8_t flags = detector_.update(state, value);
+
+    auto sensorFlags = flags_.find(sensorId);
+    if (sensorFlags != flags_.end()) {
+        auto& remembered = sensorFlags->second;
+        while (!remembered.empty() && remembered.front().first < timestamp - FLAG_RETENTION_SECONDS) {
+            remembered.pop_front();
+        }
+        if (remembered.empty() && flags == Measurement::FLAG_NONE) {
+            flags_.erase(sensorFlags);
+        }
+    }
+    if (flags != Measurement::FLAG_NONE) {
+        flags_[sensorId].emplace_back(timestamp, flags);
+    }
+    return flags;
+}
+
+/**
+ * @brief Przetwarza pomiary sensora.
+ *
+ * Pomiary już przetworzone otrzymują zapamiętane flagi (nie są oceniane ponownie).
+ *
+ * @param sensorId ID sensora.
+ * @param measurements Pomiary (flagi są ustawiane w miejscu).
+ * @return Liczba nowych pomiarów oznaczonych flagą.
+ */
+size_t AnomalyMonitor::process(int sensorId, std::vector<Measurement>& measurements) {
+    std::vector<std::pair<int64_t, size_t>> order;
+    order.reserve(measurements.size());
+    for (size_t i = 0; i < measurements.size(); i++) {
+        int64_t timestamp;
+        if (MeasurementSeries::parseTimestamp(measurements[i].getDate(), timestamp)) {
+            order.emplace_back(timestamp, i);
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    const int64_t lastSeen = states_[sensorId].lastTimestamp;
+    size_t flagged = 0;
+    for (const auto& entry : order) {
+        Measurement& m = measurements[entry.second];
+        uint8_t flags = push(sensorId, entry.first, m.getValue());
+        m.setFlags(flags);
+        if (flags != Measurement::FLAG_NONE && entry.first > lastSeen) flagged++;
+    }
+    return flagged;
+}
+
+/**
+ * @brief Zwraca kopię monitora ograniczoną do jednego sensora.
+ *
+ * @param sensorId ID sensora.
+ * @return Monitor ze stanem i flagami sensora.
+ */
+AnomalyMonitor AnomalyMonitor::extract(int sensorId) const {
+    AnomalyMonitor copy(detector_);
+    auto state = states_.find(sensorId);
+    if (state != states_.end()) copy.states_.insert(*state);
+    auto flags = flags_.find(sensorId);
+    if (flags != flags_.end()) copy.flags_.insert(*flags);
+    return copy;
+}
+
+/**
+ * @brief Zastępuje stan i flagi sensorów stanem z innego monitora.
+ *
+ * @param other Monitor z nowym stanem sensorów.
+ */
+void AnomalyMonitor::commit(const AnomalyMonitor& other) {
+    for (const auto& state : other.states_) {
+        states_[state.first] = state.second;
+        auto flags = other.flags_.find(state.first);
+        if (flags != other.flags_.end()) flags_[state.first] = flags->second;
+        else flags_.erase(state.first);
+    }
+}
+
+/**
+ * @brief Usuwa stan i zapamiętane flagi sensora.
+ *
+ * @param sensorId ID sensora.
+ */
+void AnomalyMonitor::reset(int sensorId) {
+    states_.erase(sensorId);
+    flags_.erase(sensorId);
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Measurement.h"
+
+/**
+ * @file AnomalyDetector.h
+ * @brief Strumieniowe wykrywanie błędnych danych: skoków, zablokowanych czujników i zmian poziomu.
+ *
+ * Detektor nie przechowuje historii pomiarów - stan każdego sensora to kilka liczb (O(1) pamięci
+ * i czasu na pomiar), dzięki czemu przy każdym odpytaniu API można sprawdzić tysiące sensorów.
+ * Wyniki są zapisywane jako flagi jakości w obiektach Measurement.
+ */
+class AnomalyDetector {
+public:
+    /**
+     * @brief Parametry detekcji.
+     */
+    struct Settings {
+        double alpha;           ///< Waga nowego pomiaru w średniej i wariancji EWMA.
+        double zThreshold;      ///< Próg |z|, powyżej którego pomiar jest skokiem.
+        double minStdDev;       ///< Dolne ograniczenie odchylenia (chroni przed dzieleniem przez ~0).
+        size_t warmup;          ///< Liczba pomiarów przed rozpoczęciem oceny.
+        size_t flatlineLength;  ///< Liczba identycznych odczytów z rzędu uznawana za zablokowany czujnik.
+        double cusumDrift;      ///< Dopuszczalny dryf CUSUM (w odchyleniach standardowych).
+        double cusumThreshold;  ///< Próg CUSUM zgłoszenia zmiany poziomu.
+        size_t spikeRunLimit;   ///< Liczba skoków w tym samym kierunku z rzędu uznawana za zmianę poziomu.
+
+        /**
+         * @brief Tworzy parametry domyślne dobrane do danych godzinowych.
+         */
+        Settings()
+            : alpha(0.1), zThreshold(4.0), minStdDev(1.0), warmup(12), flatlineLength(6),
+            cusumDrift(0.5), cusumThreshold(8.0), spikeRunLimit(3) {
+        }
+    };
+
+    /**
+     * @brief Stan detektora dla jednego sensora.
+     */
+    struct State {
+        int64_t lastTimestamp; ///< Znacznik czasu ostatniego przetworzonego pomiaru.
+        size_t count;          ///< Liczba pomiarów od ostatniego ustalenia poziomu bazowego.
+        double mean;           ///< Średnia EWMA.
+        double variance;       ///< Wariancja EWMA.
+        double lastValue;      ///< Ostatnia prawidłowa wartość.
+        size_t runLength;      ///< Długość serii identycznych odczytów.
+        double cusumHigh;      ///< Skumulowane odchylenie w górę.
+        double cusumLow;       ///< Skumulowane odchylenie w dół.
+        int spikeRun;          ///< Liczba skoków z rzędu (znak oznacza kierunek).
+
+        /**
+         * @brief Tworzy stan początkowy (brak historii).
+         */
+        State()
+            : lastTimestamp(INT64_MIN), count(0), mean(0.0), variance(0.0), lastValue(-1.0),
+            runLength(0), cusumHigh(0.0), cusumLow(0.0), spikeRun(0) {
+        }
+    };
+
+    /**
+     * @brief Konstruktor z parametrami domyślnymi.
+     */
+    AnomalyDetector();
+
+    /**
+     * @brief Konstruktor klasy AnomalyDetector.
+     *
+     * @param settings Parametry detekcji.
+     */
+    explicit AnomalyDetector(const Settings& settings);
+
+    /**
+     * @brief Przetwarza kolejny pomiar sensora i aktualizuje jego stan.
+     *
+     * @param state Stan sensora.
+     * @param value Wartość pomiaru (ujemna = brak pomiaru).
+     * @return Flagi jakości pomiaru (Measurement::Flag).
+     */
+    uint8_t update(State& state, double value) const;
+
+    /**
+     * @brief Zwraca opis flag jakości.
+     *
+     * @param flags Suma bitowa wartości Measurement::Flag.
+     * @return Opis tekstowy (UTF-8) lub pusty tekst dla braku flag.
+     */
+    static std::string describeFlags(uint8_t flags);
+
+private:
+    /**
+     * @brief Ustala nowy poziom bazowy po wykryciu zmiany poziomu.
+     */
+    void rebaseline(State& state, double value) const;
+
+    Settings settings_; ///< Parametry detekcji.
+};
+
+/**
+ * @brief Monitor wielu sensorów - przechowuje stan detektora dla każdego sensora.
+ *
+ * Przy każdym odpytaniu przetwarzane są tylko pomiary nowsze niż ostatnio widziane,
+ * więc koszt zależy od liczby nowych pomiarów, a nie od długości historii. Flagi są pamiętane
+ * tylko z okresu, który API zwraca ponownie (FLAG_RETENTION_SECONDS) - starsze flagi są zapisane
+ * w bazie razem z wartościami, więc pamięć na sensor jest ograniczona także przy długiej sesji.
+ */
+class AnomalyMonitor {
+public:
+    static const int64_t FLAG_RETENTION_SECONDS = 3 * 24 * 3600; ///< Okres zapamiętanych flag (zakres danych zwracanych przez API).
+
+    /**
+     * @brief Konstruktor klasy AnomalyMonitor.
+     *
+     * @param detector Detektor używany dla wszystkich sensorów.
+     */
+    explicit AnomalyMonitor(const AnomalyDetector& detector = AnomalyDetector());
+
+    /**
+     * @brief Przetwarza pomiar sensora.
+     *
+     * @param sensorId ID sensora.
+     * @param timestamp Znacznik czasu pomiaru.
+     * @param value Wartość pomiaru.
+     * @return Flagi jakości (dla pomiaru już przetworzonego - flagi nadane wcześniej).
+     */
+    uint8_t push(int sensorId, int64_t timestamp, double value);
+
+    /**
+     * @brief Przetwarza pomiary sensora (w dowolnej kolejności, np. od najnowszych jak w API).
+     *
+     * Nowe pomiary są oceniane chronologicznie i otrzymują flagi; pomiary już przetworzone
+     * (API zwraca nakładające się okna) otrzymują flagi nadane przy pierwszej ocenie i nie
+     * zmieniają stanu detektora.
+     *
+     * @param sensorId ID sensora.
+     * @param measurements Pomiary (flagi są ustawiane w miejscu).
+     * @return Liczba nowych pomiarów oznaczonych flagą.
+     */
+    size_t process(int sensorId, std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Zwraca kopię monitora ograniczoną do jednego sensora.
+     *
+     * Pozwala ocenić pomiary w wątku roboczym bez zmiany wspólnego stanu; wynik jest
+     * zatwierdzany przez commit dopiero wtedy, gdy zostanie użyty.
+     *
+     * @param sensorId ID sensora.
+     * @return Monitor ze stanem i flagami tylko tego sensora.
+     */
+    AnomalyMonitor extract(int sensorId) const;
+
+    /**
+     * @brief Zastępuje stan i flagi sensorów stanem z innego monitora (np. z extract).
+     *
+     * @param other Monitor z nowym stanem sensorów.
+     */
+    void commit(const AnomalyMonitor& other);
+
+    /**
+     * @brief Usuwa stan i zapamiętane flagi sensora (np. po naprawie czujnika).
+     *
+     * @param sensorId ID sensora.
+     */
+    void reset(int sensorId);
+
+    /**
+     * @brief Zwraca liczbę monitorowanych sensorów.
+     *
+     * @return Liczba sensorów.
+     */
+    size_t getSensorCount() const { return states_.size(); }
+
+private:
+    AnomalyDetector detector_;                           ///< Detektor.
+    std::unordered_map<int, AnomalyDetector::State> states_; ///< Stan każdego sensora.
+    std::unordered_map<int, std::deque<std::pair<int64_t, uint8_t>>> flags_; ///< Niezerowe flagi pomiarów każdego sensora, rosnąco według czasu.
+};
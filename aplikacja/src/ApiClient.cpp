@@ -1,190 +1,239 @@
-#include "ApiClient.h"
-#include <curl/curl.h>
-#include <iostream>
-#include <locale.h>
-
-/**
- * @brief Konstruktor klasy ApiClient
- *
- * Inicjalizuje bibliotekę cURL i ustawia lokalizację na język polski.
- */
-ApiClient::ApiClient() {
-    setlocale(LC_ALL, "Polish");
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-}
-
-/**
- * @brief Destruktor klasy ApiClient
- *
- * Czyści globalny stan cURL.
- */
-ApiClient::~ApiClient() {
-    curl_global_cleanup();
-}
-
-/**
- * @brief Pobiera listę wszystkich stacji pomiarowych.
- *
- * @return Wektor obiektów Station reprezentujących stacje.
- */
-std::vector<Station> ApiClient::getStations() {
-    std::vector<Station> result;
-    std::string url = "https://api.gios.gov.pl/pjp-api/rest/station/findAll";
-    std::string response;
-
-    performCurlRequest(url, response);
-
-    Json::Value root;
-    parseJsonResponse(response, root);
-
-    for (const auto& station : root) {
-        int id = station["id"].asInt();
-        std::string name = station["stationName"].asString();
-        result.emplace_back(id, name);
-    }
-    return result;
-}
-
-/**
- * @brief Pobiera listę czujników dla wybranej stacji.
- *
- * @param stationId Identyfikator stacji.
- * @return Wektor obiektów Sensor przypisanych do stacji.
- */
-std::vector<Sensor> ApiClient::getSensors(int stationId) {
-    std::vector<Sensor> result;
-    std::string url = "https://api.gios.gov.pl/pjp-api/rest/station/sensors/" + std::to_string(stationId);
-    std::string response;
-
-    performCurlRequest(url, response);
-
-    Json::Value root;
-    if (!parseJsonResponse(response, root))
-        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla czujników.");
-
-    for (const auto& sensor : root) {
-        int id = sensor["id"].asInt();
-        std::string param = sensor["param"]["paramName"].asString();
-        std::string formula = sensor["param"]["paramFormula"].asString();
-        result.emplace_back(id, param, formula);
-    }
-    return result;
-}
-
-/**
- * @brief Pobiera dane pomiarowe z wybranego czujnika.
- *
- * @param sensorId Identyfikator czujnika.
- * @return Wektor obiektów Measurement zawierających dane pomiarowe.
- */
-std::vector<Measurement> ApiClient::getSensorData(int sensorId) {
-    std::vector<Measurement> result;
-    std::string url = "https://api.gios.gov.pl/pjp-api/rest/data/getData/" + std::to_string(sensorId);
-    std::string response;
-
-    performCurlRequest(url, response);
-
-    Json::Value root;
-    if (!parseJsonResponse(response, root))
-        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla danych pomiarowych.");
-
-    for (const auto& val : root["values"]) {
-        std::string date = val["date"].asString();
-        double value = val["value"].isNull() ? -1.0 : val["value"].asDouble();
-        result.emplace_back(date, value);
-    }
-    return result;
-}
-
-/**
- * @brief Pobiera indeks jakości powietrza dla wybranej stacji.
- *
- * @param stationId Identyfikator stacji.
- * @return Mapa z nazwą parametru jako kluczem i poziomem jakości jako wartością.
- */
-std::map<std::string, std::string> ApiClient::getAirQualityIndex(int stationId) {
-    std::map<std::string, std::string> result;
-    std::string url = "https://api.gios.gov.pl/pjp-api/rest/aqindex/getIndex/" + std::to_string(stationId);
-    std::string response;
-
-    performCurlRequest(url, response);
-
-    Json::Value root;
-    if (!parseJsonResponse(response, root))
-        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla indeksu jakości powietrza.");
-
-    if (!root["stIndexLevel"].isNull())
-        result["Ogólny"] = root["stIndexLevel"]["indexLevelName"].asString();
-    if (!root["pm10IndexLevel"].isNull())
-        result["PM10"] = root["pm10IndexLevel"]["indexLevelName"].asString();
-    if (!root["pm25IndexLevel"].isNull())
-        result["PM2.5"] = root["pm25IndexLevel"]["indexLevelName"].asString();
-    if (!root["o3IndexLevel"].isNull())
-        result["O3"] = root["o3IndexLevel"]["indexLevelName"].asString();
-    if (!root["no2IndexLevel"].isNull())
-        result["NO2"] = root["no2IndexLevel"]["indexLevelName"].asString();
-    if (!root["so2IndexLevel"].isNull())
-        result["SO2"] = root["so2IndexLevel"]["indexLevelName"].asString();
-    if (!root["coIndexLevel"].isNull())
-        result["CO"] = root["coIndexLevel"]["indexLevelName"].asString();
-
-    return result;
-}
-
-/**
- * @brief Funkcja callback dla cURL - zapisuje dane do stringa.
- *
- * @param contents Bufor z danymi
- * @param size Rozmiar bloku
- * @param nmemb Ilość bloków
- * @param userp Wskaźnik do stringa, do którego zapisujemy dane
- * @return Liczba przetworzonych bajtów
- */
-size_t ApiClient::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-    ((std::string*)userp)->append((char*)contents, size * nmemb);
-    return size * nmemb;
-}
-
-/**
- * @brief Wykonuje zapytanie HTTP GET przy pomocy cURL.
- *
- * @param url Adres URL do zapytania
- * @param response Zmienna do której zostanie zapisany wynik zapytania
- * @return true jeśli zapytanie zakończyło się sukcesem, w przeciwnym wypadku rzuca wyjątek
- */
-bool ApiClient::performCurlRequest(const std::string& url, std::string& response) {
-    CURL* curl = curl_easy_init();
-    if (!curl) throw std::runtime_error("Nie udało się zainicjować CURL-a.");
-
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-
-    CURLcode res = curl_easy_perform(curl);
-
-    if (res != CURLE_OK) {
-        std::string err = curl_easy_strerror(res);
-        curl_easy_cleanup(curl);
-
-        if (res == CURLE_COULDNT_RESOLVE_HOST || res == CURLE_COULDNT_CONNECT || res == CURLE_OPERATION_TIMEDOUT) {
-            throw std::runtime_error("Brak połączenia z internetem: " + err);
-        }
-
-        throw std::runtime_error("Błąd podczas pobierania danych: " + err);
-    }
-
-    curl_easy_cleanup(curl);
-    return true;
-}
-
-/**
- * @brief Parsuje odpowiedź JSON do obiektu Json::Value.
- *
- * @param jsonResponse Surowa odpowiedź w formacie JSON
- * @param parsedRoot Obiekt, do którego zostanie zapisany sparsowany JSON
- * @return true jeśli parsowanie zakończyło się sukcesem, false w przeciwnym wypadku
- */
-bool ApiClient::parseJsonResponse(const std::string& jsonResponse, Json::Value& parsedRoot) {
-    Json::Reader reader;
-    return reader.parse(jsonResponse, parsedRoot);
+#include "ApiClient.h"
+#include <curl/curl.h>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <locale.h>
+#include <sstream>
+#include <utility>
+
+/**
+ * @brief Konstruktor klasy ApiClient
+ *
+ * Inicjalizuje bibliotekę cURL i ustawia lokalizację na język polski.
+ */
+ApiClient::ApiClient() : cancelGeneration_(0) {
+    setlocale(LC_ALL, "Polish");
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+/**
+ * @brief Destruktor klasy ApiClient
+ *
+ * Czyści globalny stan cURL.
+ */
+ApiClient::~ApiClient() {
+    curl_global_cleanup();
+}
+
+/**
+ * @brief Pobiera listę wszystkich stacji pomiarowych.
+ *
+ * @return Wektor obiektów Station reprezentujących stacje.
+ */
+std::vector<Station> ApiClient::getStations() {
+    std::vector<Station> result;
+    std::string url = "https://api.gios.gov.pl/pjp-api/rest/station/findAll";
+    std::string response;
+
+    performCurlRequest(url, response);
+
+    Json::Value root;
+    parseJsonResponse(response, root);
+
+    // Współrzędne przychodzą jako tekst (np. "50.972167"). Parsujemy w locale "C", bo konstruktor
+    // ustawia polskie locale z przecinkiem dziesiętnym, przy którym std::stod obcięłoby część ułamkową
+    auto coordinate = [](const Json::Value& value) {
+        if (value.isNumeric()) return value.asDouble();
+        double parsed;
+        std::istringstream stream(value.isString() ? value.asString() : "");
+        stream.imbue(std::locale::classic());
+        if (stream >> parsed) return parsed;
+        return std::numeric_limits<double>::quiet_NaN();
+    };
+
+    for (const auto& station : root) {
+        int id = station["id"].asInt();
+        std::string name = station["stationName"].asString();
+        const Json::Value& city = station["city"];
+        const Json::Value& commune = city["commune"];
+        result.emplace_back(id, name, coordinate(station["gegrLat"]), coordinate(station["gegrLon"]),
+            city["name"].asString(), commune["communeName"].asString(), commune["districtName"].asString(),
+            commune["provinceName"].asString(), station["addressStreet"].asString());
+    }
+    return result;
+}
+
+/**
+ * @brief Pobiera listę czujników dla wybranej stacji.
+ *
+ * @param stationId Identyfikator stacji.
+ * @return Wektor obiektów Sensor przypisanych do stacji.
+ */
+std::vector<Sensor> ApiClient::getSensors(int stationId) {
+    std::vector<Sensor> result;
+    std::string url = "https://api.gios.gov.pl/pjp-api/rest/station/sensors/" + std::to_string(stationId);
+    std::string response;
+
+    performCurlRequest(url, response);
+
+    Json::Value root;
+    if (!parseJsonResponse(response, root))
+        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla czujników.");
+
+    for (const auto& sensor : root) {
+        int id = sensor["id"].asInt();
+        std::string param = sensor["param"]["paramName"].asString();
+        std::string formula = sensor["param"]["paramFormula"].asString();
+        result.emplace_back(id, param, formula);
+    }
+    return result;
+}
+
+/**
+ * @brief Pobiera dane pomiarowe z wybranego czujnika.
+ *
+ * @param sensorId Identyfikator czujnika.
+ * @return Wektor obiektów Measurement zawierających dane pomiarowe.
+ */
+std::vector<Measurement> ApiClient::getSensorData(int sensorId) {
+    std::vector<Measurement> result;
+    std::string url = "https://api.gios.gov.pl/pjp-api/rest/data/getData/" + std::to_string(sensorId);
+    std::string response;
+
+    performCurlRequest(url, response);
+
+    Json::Value root;
+    if (!parseJsonResponse(response, root))
+        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla danych pomiarowych.");
+
+    for (const auto& val : root["values"]) {
+        std::string date = val["date"].asString();
+        double value = val["value"].isNull() ? -1.0 : val["value"].asDouble();
+        result.emplace_back(date, value);
+    }
+    return result;
+}
+
+/**
+ * @brief Pobiera indeks jakości powietrza dla wybranej stacji.
+ *
+ * @param stationId Identyfikator stacji.
+ * @return Mapa z nazwą parametru jako kluczem i poziomem jakości jako wartością.
+ */
+std::map<std::string, std::string> ApiClient::getAirQualityIndex(int stationId) {
+    std::map<std::string, std::string> result;
+    std::string url = "https://api.gios.gov.pl/pjp-api/rest/aqindex/getIndex/" + std::to_string(stationId);
+    std::string response;
+
+    performCurlRequest(url, response);
+
+    Json::Value root;
+    if (!parseJsonResponse(response, root))
+        throw std::runtime_error("Nie udało się sparsować odpowiedzi JSON dla indeksu jakości powietrza.");
+
+    if (!root["stIndexLevel"].isNull())
+        result["Ogólny"] = root["stIndexLevel"]["indexLevelName"].asString();
+    if (!root["pm10IndexLevel"].isNull())
+        result["PM10"] = root["pm10IndexLevel"]["indexLevelName"].asString();
+    if (!root["pm25IndexLevel"].isNull())
+        result["PM2.5"] = root["pm25IndexLevel"]["indexLevelName"].asString();
+    if (!root["o3IndexLevel"].isNull())
+        result["O3"] = root["o3IndexLevel"]["indexLevelName"].asString();
+    if (!root["no2IndexLevel"].isNull())
+        result["NO2"] = root["no2IndexLevel"]["indexLevelName"].asString();
+    if (!root["so2IndexLevel"].isNull())
+        result["SO2"] = root["so2IndexLevel"]["indexLevelName"].asString();
+    if (!root["coIndexLevel"].isNull())
+        result["CO"] = root["coIndexLevel"]["indexLevelName"].asString();
+
+    return result;
+}
+
+/**
+ * @brief Callback postępu cURL - przerywa transfer, jeśli od jego rozpoczęcia przerwano zapytania.
+ *
+ * @param clientp Para (licznik przerwań klienta, wartość licznika na początku zapytania).
+ * @return Wartość różna od zera przerywa transfer.
+ */
+static int AbortCallback(void* clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    auto* request = static_cast<std::pair<const std::atomic<unsigned>*, unsigned>*>(clientp);
+    return request->first->load() != request->second ? 1 : 0;
+}
+
+/**
+ * @brief Funkcja callback dla cURL - zapisuje dane do stringa.
+ *
+ * @param contents Bufor z danymi
+ * @param size Rozmiar bloku
+ * @param nmemb Ilość bloków
+ * @param userp Wskaźnik do stringa, do którego zapisujemy dane
+ * @return Liczba przetworzonych bajtów
+ */
+size_t ApiClient::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
+    ((std::string*)userp)->append((char*)contents, size * nmemb);
+    return size * nmemb;
+}
+
+/**
+ * @brief Wykonuje zapytanie HTTP GET przy pomocy cURL.
+ *
+ * @param url Adres URL do zapytania
+ * @param response Zmienna do której zostanie zapisany wynik zapytania
+ * @return true jeśli zapytanie zakończyło się sukcesem, w przeciwnym wypadku rzuca wyjątek
+ */
+bool ApiClient::performCurlRequest(const std::string& url, std::string& response) {
+    CURL* curl = curl_easy_init();
+    if (!curl) throw std::runtime_error("Nie udało się zainicjować CURL-a.");
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+
+    // Przerwanie przez cancelPendingRequests() - sprawdzane przez cURL kilka razy na sekundę
+    std::pair<const std::atomic<unsigned>*, unsigned> request(&cancelGeneration_, cancelGeneration_.load());
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, AbortCallback);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &request);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+
+    CURLcode res = curl_easy_perform(curl);
+
+    if (res != CURLE_OK) {
+        std::string err = curl_easy_strerror(res);
+        curl_easy_cleanup(curl);
+
+        if (res == CURLE_ABORTED_BY_CALLBACK) {
+            throw std::runtime_error("Zapytanie zostało anulowane.");
+        }
+        if (res == CURLE_COULDNT_RESOLVE_HOST || res == CURLE_COULDNT_CONNECT || res == CURLE_OPERATION_TIMEDOUT) {
+            throw std::runtime_error("Brak połączenia z internetem: " + err);
+        }
+
+        throw std::runtime_error("Błąd podczas pobierania danych: " + err);
+    }
+
+    curl_easy_cleanup(curl);
+    return true;
+}
+
+/**
+ * @brief Przerywa wszystkie trwające zapytania.
+ *
+ * Zapytania porównują licznik przerwań z wartością z chwili rozpoczęcia, więc zapytania
+ * rozpoczęte po wywołaniu nie są przerywane.
+ */
+void ApiClient::cancelPendingRequests() {
+    cancelGeneration_++;
+}
+
+/**
+ * @brief Parsuje odpowiedź JSON do obiektu Json::Value.
+ *
+ * @param jsonResponse Surowa odpowiedź w formacie JSON
+ * @param parsedRoot Obiekt, do którego zostanie zapisany sparsowany JSON
+ * @return true jeśli parsowanie zakończyło się sukcesem, false w przeciwnym wypadku
+ */
+bool ApiClient::parseJsonResponse(const std::string& jsonResponse, Json::Value& parsedRoot) {
+    Json::Reader reader;
+    return reader.parse(jsonResponse, parsedRoot);
 }
\ No newline at end of file
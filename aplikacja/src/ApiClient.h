@@ -1,92 +1,103 @@
-#ifndef APICLIENT_H
-#define APICLIENT_H
-
-#include <string>
-#include <vector>
-#include <map>
-#include <json/json.h>
-#include "Station.h"
-#include "Sensor.h"
-#include "Measurement.h"
-
-/**
- * @file ApiClient.h
- * @brief Klasa do komunikacji z API zewntrznego systemu monitoringu powietrza.
- *
- * Umoliwia pobieranie danych o stacjach, sensorach, pomiarach i indeksie jakoci powietrza.
- */
-class ApiClient {
-public:
-    /**
-     * @brief Konstruktor klasy ApiClient.
-     */
-    ApiClient();
-
-    /**
-     * @brief Destruktor klasy ApiClient.
-     */
-    ~ApiClient();
-
-    /**
-     * @brief Pobiera list stacji pomiarowych.
-     *
-     * @return Wektor obiektw typu Station.
-     */
-    std::vector<Station> getStations();
-
-    /**
-     * @brief Pobiera list sensorw dla danej stacji.
-     *
-     * @param stationId ID stacji, dla ktrej maj by pobrane sensory.
-     * @return Wektor obiektw typu Sensor.
-     */
-    std::vector<Sensor> getSensors(int stationId);
-
-    /**
-     * @brief Pobiera dane pomiarowe dla danego sensora.
-     *
-     * @param sensorId ID sensora, dla ktrego maj by pobrane dane.
-     * @return Wektor obiektw typu Measurement.
-     */
-    std::vector<Measurement> getSensorData(int sensorId);
-
-    /**
-     * @brief Pobiera indeks jakoci powietrza dla danej stacji.
-     *
-     * @param stationId ID stacji, dla ktrej ma by pobrany indeks.
-     * @return Mapa par klucz-warto reprezentujcych indeks jakoci powietrza.
-     */
-    std::map<std::string, std::string> getAirQualityIndex(int stationId);
-
-private:
-    /**
-     * @brief Callback funkcji CURL do zapisywania odpowiedzi.
-     *
-     * @param contents Dane odpowiedzi.
-     * @param size Rozmiar pojedynczego elementu.
-     * @param nmemb Liczba elementw.
-     * @param userp Wskanik do danych uytkownika (bufor odpowiedzi).
-     * @return Liczba zapisanych bajtw.
-     */
-    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
-
-    /**
-     * @brief Wykonuje danie HTTP za pomoc CURL.
-     *
-     * @param url Adres URL do ktrego ma zosta wysane danie.
-     * @param response Zmienna do ktrej zostanie zapisana odpowied.
-     * @return true jeli danie si powiodo, false w przeciwnym razie.
-     */
-    bool performCurlRequest(const std::string& url, std::string& response);
-
-    /**
-     * @brief Parsuje odpowied JSON.
-     *
-     * @param jsonResponse Surowa odpowied w formacie JSON.
-     * @param parsedRoot Referencja do obiektu JSON, do ktrego zostanie zapisany wynik.
-     * @return true jeli parsowanie si powiodo, false w przeciwnym razie.
-     */
-    bool parseJsonResponse(const std::string& jsonResponse, Json::Value& parsedRoot);
-};
-
+#ifndef APICLIENT_H
+#define APICLIENT_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <map>
+#include <json/json.h>
+#include "Station.h"
+#include "Sensor.h"
+#include "Measurement.h"
+
+/**
+ * @file ApiClient.h
+ * @brief Klasa do komunikacji z API zewnętrznego systemu monitoringu powietrza.
+ *
+ * Umożliwia pobieranie danych o stacjach, sensorach, pomiarach i indeksie jakości powietrza.
+ * Każde zapytanie używa własnego uchwytu cURL, więc metody mogą być wywoływane z wątków roboczych.
+ */
+class ApiClient {
+public:
+    /**
+     * @brief Konstruktor klasy ApiClient.
+     */
+    ApiClient();
+
+    /**
+     * @brief Destruktor klasy ApiClient.
+     */
+    ~ApiClient();
+
+    /**
+     * @brief Pobiera listę stacji pomiarowych.
+     *
+     * @return Wektor obiektów typu Station.
+     */
+    std::vector<Station> getStations();
+
+    /**
+     * @brief Pobiera listę sensorów dla danej stacji.
+     *
+     * @param stationId ID stacji, dla której mają być pobrane sensory.
+     * @return Wektor obiektów typu Sensor.
+     */
+    std::vector<Sensor> getSensors(int stationId);
+
+    /**
+     * @brief Pobiera dane pomiarowe dla danego sensora.
+     *
+     * @param sensorId ID sensora, dla którego mają być pobrane dane.
+     * @return Wektor obiektów typu Measurement.
+     */
+    std::vector<Measurement> getSensorData(int sensorId);
+
+    /**
+     * @brief Pobiera indeks jakości powietrza dla danej stacji.
+     *
+     * @param stationId ID stacji, dla której ma być pobrany indeks.
+     * @return Mapa par klucz-wartość reprezentujących indeks jakości powietrza.
+     */
+    std::map<std::string, std::string> getAirQualityIndex(int stationId);
+
+    /**
+     * @brief Przerywa wszystkie trwające zapytania (zapytania rozpoczęte później działają normalnie).
+     *
+     * Może być wywołana z dowolnego wątku; przerwane zapytanie zgłasza wyjątek std::runtime_error.
+     */
+    void cancelPendingRequests();
+
+private:
+    /**
+     * @brief Callback funkcji CURL do zapisywania odpowiedzi.
+     *
+     * @param contents Dane odpowiedzi.
+     * @param size Rozmiar pojedynczego elementu.
+     * @param nmemb Liczba elementów.
+     * @param userp Wskaźnik do danych użytkownika (bufor odpowiedzi).
+     * @return Liczba zapisanych bajtów.
+     */
+    static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+
+    /**
+     * @brief Wykonuje żądanie HTTP za pomocą CURL.
+     *
+     * @param url Adres URL do którego ma zostać wysłane żądanie.
+     * @param response Zmienna do której zostanie zapisana odpowiedź.
+     * @return true jeśli żądanie się powiodło, false w przeciwnym razie.
+     */
+    bool performCurlRequest(const std::string& url, std::string& response);
+
+    /**
+     * @brief Parsuje odpowiedź JSON.
+     *
+     * @param jsonResponse Surowa odpowiedź w formacie JSON.
+     * @param parsedRoot Referencja do obiektu JSON, do którego zostanie zapisany wynik.
+     * @return true jeśli parsowanie się powiodło, false w przeciwnym razie.
+     */
+    bool parseJsonResponse(const std::string& jsonResponse, Json::Value& parsedRoot);
+
+    std::atomic<unsigned> cancelGeneration_;  ///< Numer zwiększany przy każdym przerwaniu zapytań.
+};
+
 #endif // APICLIENT_H
\ No newline at end of file
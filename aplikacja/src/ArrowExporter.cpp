@@ -0,0 +1,398 @@
+/**
+ * @file ArrowExporter.cpp
+ * @brief Implementacja eksportu serii pomiarowych do formatu Apache Arrow IPC (Feather v2).
+ */
+
+#include "ArrowExporter.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+/**
+ * @brief Minimalny budowniczy buforów FlatBuffers (tylko to, czego potrzebują metadane Arrow).
+ *
+ * Bufor jest budowany od końca, tak jak w oficjalnej bibliotece: każdy obiekt jest identyfikowany
+ * przez odległość od końca bufora w chwili jego utworzenia.
+ */
+class FlatBuilder {
+public:
+    uint32_t size() const { return static_cast<uint32_t>(buf_.size()); }
+
+    /// Wyrównuje bufor tak, aby po dopisaniu `extra` bajtów rozmiar był wielokrotnością `alignment`.
+    void align(size_t alignment, size_t extra = 0) {
+        minAlign_ = std::max(minAlign_, alignment);
+        size_t rem = (buf_.size() + extra) % alignment;
+        if (rem != 0) {
+            buf_.insert(buf_.begin(), alignment - rem, 0);
+        }
+    }
+
+    template <typename T>
+    void prepend(T value) {
+        align(sizeof(T));
+        prependRaw(value);
+    }
+
+    uint32_t createString(const std::string& s) {
+        align(4, s.size() + 1);
+        buf_.insert(buf_.begin(), 1, 0);
+        buf_.insert(buf_.begin(), s.begin(), s.end());
+        prependRaw(static_cast<uint32_t>(s.size()));
+        return size();
+    }
+
+    uint32_t createOffsetVector(const std::vector<uint32_t>& offsets) {
+        align(4, offsets.size() * 4);
+        for (auto it = offsets.rbegin(); it != offsets.rend(); ++it) {
+            prependRaw(static_cast<uint32_t>(size() + 4 - *it));
+        }
+        prependRaw(static_cast<uint32_t>(offsets.size()));
+        return size();
+    }
+
+    /// Wektor struktur o wyrównaniu 8 bajtów (FieldNode, Buffer, Block).
+    uint32_t createStructVector(const std::vector<uint8_t>& bytes, size_t count) {
+        align(8, bytes.size());
+        buf_.insert(buf_.begin(), bytes.begin(), bytes.end());
+        prependRaw(static_cast<uint32_t>(count));
+        return size();
+    }
+
+    void startTable() {
+        fields_.clear();
+        tableStart_ = size();
+    }
+
+    template <typename T>
+    void addScalar(uint16_t field, T value) {
+        prepend(value);
+        fields_.emplace_back(field, size());
+    }
+
+    void addOffset(uint16_t field, uint32_t target) {
+        align(4);
+        prependRaw(static_cast<uint32_t>(size() + 4 - target));
+        fields_.emplace_back(field, size());
+    }
+
+    uint32_t endTable() {
+        prepend<int32_t>(0);
+        uint32_t table = size();
+
+        uint16_t count = 0;
+        for (const auto& f : fields_) count = std::max<uint16_t>(count, f.first + 1);
+
+        std::vector<uint16_t> vtable(count, 0);
+        for (const auto& f : fields_) vtable[f.first] = static_cast<uint16_t>(table - f.second);
+
+        for (int i = count - 1; i >= 0; i--) prependRaw(vtable[i]);
+        prependRaw(static_cast<uint16_t>(table - tableStart_));
+        prependRaw(static_cast<uint16_t>(4 + 2 * count));
+
+        int32_t vtableOffset = static_cast<int32_t>(size() - table);
+        std::memcpy(&buf_[buf_.size() - table], &vtableOffset, sizeof(vtableOffset));
+        return table;
+    }
+
+    std::vector<uint8_t> finish(uint32_t root) {
+        align(std::max<size_t>(minAlign_, 8), 4);
+        prependRaw(static_cast<uint32_t>(size() + 4 - root));
+        return buf_;
+    }
+
+private:
+    template <typename T>
+    void prependRaw(T value) {
+        uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        buf_.insert(buf_.begin(), bytes, bytes + sizeof(T));
+    }
+
+    std::vector<uint8_t> buf_;
+    std::vector<std::pair<uint16_t, uint32_t>> fields_;
+    uint32_t tableStart_ = 0;
+    size_t minAlign_ = 1;
+};
+
+// Stałe z Schema.fbs / Message.fbs formatu Arrow
+const int16_t METADATA_V5 = 4;
+const uint8_t HEADER_SCHEMA = 1;
+const uint8_t HEADER_RECORD_BATCH = 3;
+const uint8_t TYPE_INT = 2;
+const uint8_t TYPE_FLOATING_POINT = 3;
+const uint8_t TYPE_TIMESTAMP = 10;
+const int16_t PRECISION_DOUBLE = 2;
+const int16_t TIME_UNIT_SECOND = 0;
+
+void appendInt64(std::vector<uint8_t>& out, int64_t value) {
+    uint8_t bytes[8];
+    std::memcpy(bytes, &value, 8);
+    out.insert(out.end(), bytes, bytes + 8);
+}
+
+uint32_t buildField(FlatBuilder& fb, const std::string& name, uint8_t typeType, uint32_t type, bool nullable) {
+    uint32_t nameOffset = fb.createString(name);
+    uint32_t children = fb.createOffsetVector({});
+
+    fb.startTable();
+    fb.addOffset(0, nameOffset);
+    fb.addScalar<uint8_t>(1, nullable ? 1 : 0);
+    fb.addScalar<uint8_t>(2, typeType);
+    fb.addOffset(3, type);
+    fb.addOffset(5, children);
+    return fb.endTable();
+}
+
+uint32_t buildSchema(FlatBuilder& fb) {
+    fb.startTable();
+    fb.addScalar<int32_t>(0, 32);
+    fb.addScalar<uint8_t>(1, 1);
+    uint32_t int32Type = fb.endTable();
+
+    fb.startTable();
+    fb.addScalar<int16_t>(0, TIME_UNIT_SECOND);
+    uint32_t timestampType = fb.endTable();
+
+    fb.startTable();
+    fb.addScalar<int16_t>(0, PRECISION_DOUBLE);
+    uint32_t doubleType = fb.endTable();
+
+    std::vector<uint32_t> fields = {
+        buildField(fb, "station_id", TYPE_INT, int32Type, false),
+        buildField(fb, "sensor_id", TYPE_INT, int32Type, false),
+        buildField(fb, "timestamp", TYPE_TIMESTAMP, timestampType, false),
+        buildField(fb, "value", TYPE_FLOATING_POINT, doubleType, true),
+    };
+    uint32_t fieldsVector = fb.createOffsetVector(fields);
+
+    fb.startTable();
+    fb.addScalar<int16_t>(0, 0); // Little endian
+    fb.addOffset(1, fieldsVector);
+    return fb.endTable();
+}
+
+std::vector<uint8_t> buildMessage(uint8_t headerType, uint32_t header, FlatBuilder& fb, int64_t bodyLength) {
+    fb.startTable();
+    fb.addScalar<int16_t>(0, METADATA_V5);
+    fb.addScalar<uint8_t>(1, headerType);
+    fb.addOffset(2, header);
+    fb.addScalar<int64_t>(3, bodyLength);
+    return fb.finish(fb.endTable());
+}
+
+size_t padded(size_t length) {
+    return (length + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * @brief Zapisuje zakapsułkowaną wiadomość IPC (znacznik kontynuacji, długość, metadane, dopełnienie).
+ *
+ * @return Łączna długość części metadanych w bajtach.
+ */
+int32_t writeMessageMetadata(std::ofstream& file, const std::vector<uint8_t>& metadata) {
+    int32_t length = static_cast<int32_t>(padded(metadata.size() + 8) - 8);
+    uint32_t continuation = 0xFFFFFFFF;
+    file.write(reinterpret_cast<const char*>(&continuation), 4);
+    file.write(reinterpret_cast<const char*>(&length), 4);
+    file.write(reinterpret_cast<const char*>(metadata.data()), metadata.size());
+
+    static const char zeros[8] = {};
+    file.write(zeros, length - metadata.size());
+    return length + 8;
+}
+
+void writePadded(std::ofstream& file, const void* data, size_t length) {
+    static const char zeros[8] = {};
+    if (length > 0) {
+        file.write(static_cast<const char*>(data), length);
+    }
+    file.write(zeros, padded(length) - length);
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor klasy ArrowExporter.
+ *
+ * @param dbManager Baza danych, z której czytane są serie.
+ */
+ArrowExporter::ArrowExporter(DatabaseManager& dbManager)
+    : dbManager_(dbManager) {
+}
+
+/**
+ * @brief Eksportuje wybrane stacje, sensory i przedziały czasu do pliku.
+ *
+ * @param selections Lista wyborów.
+ * @param filePath Ścieżka do pliku wynikowego.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool ArrowExporter::exportSelections(const std::vector<Selection>& selections, const std::string& filePath) {
+    return writeFile(collectBatches(selections), filePath);
+}
+
+/**
+ * @brief Wczytuje z bazy partie rekordów dla wybranych stacji, sensorów i przedziałów czasu.
+ *
+ * Każda para stacja/sensor trafia do osobnej partii rekordów.
+ *
+ * @param selections Lista wyborów.
+ * @return Partie rekordów.
+ */
+std::vector<ArrowExporter::Batch> ArrowExporter::collectBatches(const std::vector<Selection>& selections) {
+    std::vector<Batch> batches;
+
+    for (const auto& selection : selections) {
+        std::vector<int> stationIds;
+        if (selection.stationId < 0) {
+            for (const auto& station : dbManager_.getSavedStations()) {
+                stationIds.push_back(station.getId());
+            }
+        }
+        else {
+            stationIds.push_back(selection.stationId);
+        }
+
+        for (int stationId : stationIds) {
+            std::vector<int> sensorIds;
+            if (selection.sensorId < 0) {
+                for (const auto& sensor : dbManager_.getSavedSensors(stationId)) {
+                    sensorIds.push_back(sensor.getId());
+                }
+            }
+            else {
+                sensorIds.push_back(selection.sensorId);
+            }
+
+            for (int sensorId : sensorIds) {
+                MeasurementSeries series;
+                if (!dbManager_.loadSeries(stationId, sensorId, series)) continue;
+
+                Batch batch{ stationId, sensorId, series.slice(selection.from, selection.to) };
+                if (!batch.series.empty()) {
+                    batches.push_back(std::move(batch));
+                }
+            }
+        }
+    }
+
+    return batches;
+}
+
+/**
+ * @brief Zapisuje podane partie do pliku Arrow IPC.
+ *
+ * Układ pliku: "ARROW1", wiadomość ze schematem, wiadomości z partiami rekordów,
+ * znacznik końca strumienia, stopka (FlatBuffers) z położeniem partii, "ARROW1".
+ *
+ * @param batches Partie rekordów.
+ * @param filePath Ścieżka do pliku wynikowego.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool ArrowExporter::writeFile(const std::vector<Batch>& batches, const std::string& filePath) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write("ARROW1\0\0", 8);
+    int64_t position = 8;
+
+    {
+        FlatBuilder fb;
+        uint32_t schema = buildSchema(fb);
+        position += writeMessageMetadata(file, buildMessage(HEADER_SCHEMA, schema, fb, 0));
+    }
+
+    std::vector<uint8_t> blocks;
+    for (const auto& batch : batches) {
+        const auto& timestamps = batch.series.getTimestamps();
+        const auto& values = batch.series.getValues();
+        size_t rows = batch.series.size();
+
+        // Kolumny stałe dla partii oraz maska ważności wartości
+        std::vector<int32_t> stationColumn(rows, batch.stationId);
+        std::vector<int32_t> sensorColumn(rows, batch.sensorId);
+        std::vector<uint8_t> validity((rows + 7) / 8, 0);
+        int64_t nullCount = 0;
+        for (size_t i = 0; i < rows; i++) {
+            if (values[i] >= 0) {
+                validity[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+            }
+            else {
+                nullCount++;
+            }
+        }
+
+        // Bufory: (maska, dane) dla każdej z czterech kolumn
+        const size_t lengths[8] = {
+            0, rows * sizeof(int32_t),
+            0, rows * sizeof(int32_t),
+            0, rows * sizeof(int64_t),
+            nullCount > 0 ? validity.size() : 0, rows * sizeof(double),
+        };
+        std::vector<uint8_t> buffers;
+        int64_t bodyLength = 0;
+        for (size_t length : lengths) {
+            appendInt64(buffers, bodyLength);
+            appendInt64(buffers, static_cast<int64_t>(length));
+            bodyLength += padded(length);
+        }
+
+        std::vector<uint8_t> nodes;
+        for (int column = 0; column < 4; column++) {
+            appendInt64(nodes, static_cast<int64_t>(rows));
+            appendInt64(nodes, column == 3 ? nullCount : 0);
+        }
+
+        FlatBuilder fb;
+        uint32_t nodesVector = fb.createStructVector(nodes, 4);
+        uint32_t buffersVector = fb.createStructVector(buffers, 8);
+        fb.startTable();
+        fb.addScalar<int64_t>(0, static_cast<int64_t>(rows));
+        fb.addOffset(1, nodesVector);
+        fb.addOffset(2, buffersVector);
+        uint32_t recordBatch = fb.endTable();
+
+        int32_t metadataLength = writeMessageMetadata(file,
+            buildMessage(HEADER_RECORD_BATCH, recordBatch, fb, bodyLength));
+
+        writePadded(file, stationColumn.data(), lengths[1]);
+        writePadded(file, sensorColumn.data(), lengths[3]);
+        writePadded(file, timestamps.data(), lengths[5]);
+        writePadded(file, validity.data(), lengths[6]);
+        writePadded(file, values.data(), lengths[7]);
+
+        // Block { offset, metaDataLength, (wyrównanie), bodyLength }
+        appendInt64(blocks, position);
+        int64_t metadataField = static_cast<uint32_t>(metadataLength);
+        appendInt64(blocks, metadataField);
+        appendInt64(blocks, bodyLength);
+
+        position += metadataLength + bodyLength;
+    }
+
+    // Znacznik końca strumienia
+    const uint32_t endOfStream[2] = { 0xFFFFFFFF, 0 };
+    file.write(reinterpret_cast<const char*>(endOfStream), sizeof(endOfStream));
+
+    FlatBuilder fb;
+    uint32_t schema = buildSchema(fb);
+    uint32_t dictionaries = fb.createStructVector({}, 0);
+    uint32_t recordBatches = fb.createStructVector(blocks, batches.size());
+    fb.startTable();
+    fb.addScalar<int16_t>(0, METADATA_V5);
+    fb.addOffset(1, schema);
+    fb.addOffset(2, dictionaries);
+    fb.addOffset(3, recordBatches);
+    std::vector<uint8_t> footer = fb.finish(fb.endTable());
+
+    int32_t footerLength = static_cast<int32_t>(footer.size());
+    file.write(reinterpret_cast<const char*>(footer.data()), footer.size());
+    file.write(reinterpret_cast<const char*>(&footerLength), 4);
+    file.write("ARROW1", 6);
+
+    return file.good();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "DatabaseManager.h"
+#include "MeasurementSeries.h"
+
+/**
+ * @file ArrowExporter.h
+ * @brief Eksport zapisanych serii pomiarowych do formatu Apache Arrow IPC (Feather v2).
+ *
+ * Plik jest zapisywany bez użycia biblioteki Arrow - metadane (FlatBuffers) są budowane ręcznie,
+ * a kolumny znaczników czasu i wartości są kopiowane do pliku w całości, bez konwersji wiersz po wierszu.
+ * Wynik można bezpośrednio otworzyć w pandas (read_feather), pyarrow lub DuckDB.
+ *
+ * Schemat: station_id (int32), sensor_id (int32), timestamp (timestamp[s]), value (float64, null = brak pomiaru).
+ */
+class ArrowExporter {
+public:
+    /**
+     * @brief Pojedynczy wybór danych do eksportu.
+     *
+     * Ujemne ID stacji oznacza wszystkie zapisane stacje, ujemne ID sensora - wszystkie sensory stacji.
+     */
+    struct Selection {
+        int stationId;                                       ///< ID stacji (lub -1).
+        int sensorId;                                        ///< ID sensora (lub -1).
+        int64_t from = std::numeric_limits<int64_t>::min();  ///< Początek przedziału czasu (włącznie).
+        int64_t to = std::numeric_limits<int64_t>::max();    ///< Koniec przedziału czasu (wyłącznie).
+    };
+
+    /**
+     * @brief Jedna partia rekordów (record batch) zapisywana do pliku.
+     */
+    struct Batch {
+        int stationId;              ///< ID stacji.
+        int sensorId;               ///< ID sensora.
+        MeasurementSeries series;   ///< Dane pomiarowe partii.
+    };
+
+    /**
+     * @brief Konstruktor klasy ArrowExporter.
+     *
+     * @param dbManager Baza danych, z której czytane są serie.
+     */
+    explicit ArrowExporter(DatabaseManager& dbManager);
+
+    /**
+     * @brief Eksportuje wybrane stacje, sensory i przedziały czasu do pliku.
+     *
+     * Każda para stacja/sensor trafia do osobnej partii rekordów.
+     *
+     * @param selections Lista wyborów.
+     * @param filePath Ścieżka do pliku wynikowego.
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    bool exportSelections(const std::vector<Selection>& selections, const std::string& filePath);
+
+    /**
+     * @brief Wczytuje z bazy partie rekordów dla wybranych stacji, sensorów i przedziałów czasu.
+     *
+     * Pozwala przygotować dane w wątku roboczym, a zapisać plik (writeFile) w innym miejscu.
+     *
+     * @param selections Lista wyborów.
+     * @return Partie rekordów (pary bez pomiarów w przedziale są pomijane).
+     */
+    std::vector<Batch> collectBatches(const std::vector<Selection>& selections);
+
+    /**
+     * @brief Zapisuje podane partie do pliku Arrow IPC.
+     *
+     * @param batches Partie rekordów.
+     * @param filePath Ścieżka do pliku wynikowego.
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    static bool writeFile(const std::vector<Batch>& batches, const std::string& filePath);
+
+private:
+    DatabaseManager& dbManager_; ///< Źródło danych.
+};
@@ -0,0 +1,141 @@
+/**
+ * @file ChartBatch.cpp
+ * @brief Implementacja wsadowego tworzenia wykresów PNG i SVG.
+ */
+
+#include "ChartBatch.h"
+#include "ChartRenderer.h"
+#include "SvgCanvas.h"
+#include "TaskScheduler.h"
+#include "WxChartCanvas.h"
+#include <wx/image.h>
+#include <chrono>
+#include <cstring>
+
+/**
+ * @brief Konstruktor klasy ChartBatch.
+ *
+ * @param dbManager Baza danych.
+ */
+ChartBatch::ChartBatch(DatabaseManager& dbManager) : dbManager_(dbManager) {
+}
+
+/**
+ * @brief Tworzy zadania dla wszystkich zapisanych par stacja/sensor.
+ *
+ * @param days Liczba dni przed ostatnim pomiarem serii (0 - cała seria).
+ * @return Zadania.
+ */
+std::vector<ChartBatch::Job> ChartBatch::collectJobs(int days) {
+    std::vector<Job> jobs;
+    for (const auto& station : dbManager_.getSavedStations()) {
+        for (const auto& sensor : dbManager_.getSavedSensors(station.getId())) {
+            auto series = std::make_shared<MeasurementSeries>();
+            if (!dbManager_.loadSeries(station.getId(), sensor.getId(), *series) || series->empty()) {
+                continue;
+            }
+            if (days > 0) {
+                const int64_t last = series->getTimestamps().back();
+                *series = series->slice(last - static_cast<int64_t>(days) * 86400, last + 1);
+            }
+
+            const std::string parameter = sensor.getParamFormula().empty() ? sensor.getParamName() : sensor.getParamFormula();
+            Job job;
+            job.series = series;
+            job.title = station.getName() + " - " + sensor.getParamName();
+            job.label = parameter;
+            job.fileName = safeFileName(std::to_string(station.getId()) + "_" + std::to_string(sensor.getId()) + "_" + parameter);
+            jobs.push_back(std::move(job));
+        }
+    }
+    return jobs;
+}
+
+/**
+ * @brief Rysuje wykresy i zapisuje je do katalogu.
+ *
+ * Modele wykresów i pliki SVG powstają równolegle, po jednym zadaniu puli na wykres; błędy są
+ * zapisywane w tablicy indeksowanej numerem wykresu, więc wątki niczego nie współdzielą.
+ * Obrazy PNG są następnie rasteryzowane kolejno w wątku wywołującym, bo obiekty graficzne
+ * wxWidgets nie mogą być używane w wątkach roboczych.
+ *
+ * @param jobs Wykresy do utworzenia.
+ * @param directory Katalog wynikowy.
+ * @param formats Formaty (suma flag Format).
+ * @param width Szerokość wykresu.
+ * @param height Wysokość wykresu.
+ * @return Podsumowanie przebiegu.
+ */
+ChartBatch::Result ChartBatch::render(const std::vector<Job>& jobs, const std::string& directory, int formats,
+    int width, int height) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> errors(jobs.size());
+    std::vector<size_t> written(jobs.size(), 0);
+
+    std::string prefix = directory;
+    if (!prefix.empty() && prefix.back() != '/' && prefix.back() != '\\') {
+        prefix += '/';
+    }
+
+    // Modele wykresów (piramidy serii) i SVG - równolegle, bez wxWidgets
+    std::vector<std::unique_ptr<ChartRenderer>> renderers(jobs.size());
+    TaskScheduler::shared().parallelFor(jobs.size(), [&](size_t i) {
+        const Job& job = jobs[i];
+        renderers[i].reset(new ChartRenderer());
+        renderers[i]->addSeries(job.series, job.label);
+        renderers[i]->setTitle(job.title);
+
+        if (formats & SVG) {
+            SvgCanvas svg(width, height);
+            renderers[i]->render(svg, width, height);
+            if (svg.saveFile(prefix + job.fileName + ".svg")) written[i]++;
+            else errors[i] += "Nie udało się zapisać " + job.fileName + ".svg. ";
+        }
+    }, TaskScheduler::Priority::BACKGROUND);
+
+    // PNG - w wątku wywołującym (obiekty graficzne wxWidgets nie są bezpieczne wątkowo)
+    if (formats & PNG) {
+        for (size_t i = 0; i < jobs.size(); i++) {
+            const Job& job = jobs[i];
+            const ChartRenderer& renderer = *renderers[i];
+            wxImage image(width, height, false);
+            std::memset(image.GetData(), 255, static_cast<size_t>(width) * height * 3);  // białe tło
+            {
+                std::unique_ptr<wxGraphicsContext> context(wxGraphicsContext::Create(image));
+                if (context) {
+                    WxChartCanvas canvas(*context);
+                    renderer.render(canvas, width, height);
+                }
+            }  // zniszczenie kontekstu przenosi rysunek do obrazu
+            if (image.SaveFile(wxString::FromUTF8(prefix + job.fileName + ".png"), wxBITMAP_TYPE_PNG)) written[i]++;
+            else errors[i] += "Nie udało się zapisać " + job.fileName + ".png. ";
+        }
+    }
+
+    Result result{ jobs.size(), 0, 0, 0.0, {} };
+    for (size_t i = 0; i < jobs.size(); i++) {
+        result.files += written[i];
+        if (!errors[i].empty()) {
+            result.failed += ((formats & SVG) ? 1 : 0) + ((formats & PNG) ? 1 : 0) - written[i];
+            result.errors.push_back(errors[i]);
+        }
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief Zamienia znaki niedozwolone w nazwach plików na '_'.
+ *
+ * @param name Nazwa.
+ * @return Bezpieczna nazwa pliku.
+ */
+std::string ChartBatch::safeFileName(const std::string& name) {
+    std::string result = name;
+    for (char& c : result) {
+        const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+            c == '.' || c == '-' || c == '_';
+        if (!allowed) c = '_';
+    }
+    return result;
+}
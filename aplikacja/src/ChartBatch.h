@@ -0,0 +1,91 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "DatabaseManager.h"
+#include "MeasurementSeries.h"
+
+/**
+ * @file ChartBatch.h
+ * @brief Wsadowe tworzenie wykresów (PNG i SVG) dla raportów - bez okna, częściowo równolegle.
+ *
+ * W wątkach roboczych wspólnej puli (TaskScheduler) powstają modele wykresów (ChartRenderer
+ * z piramidami serii) i pliki SVG rysowane przez SvgCanvas, który nie korzysta z wxWidgets.
+ * Obrazy PNG są rasteryzowane kolejno w wątku wywołującym przez wxGraphicsContext utworzony
+ * dla wxImage - konteksty graficzne, czcionki, pióra i obiekty standardowe wxWidgets nie są
+ * bezpieczne wątkowo. Serie są wczytywane z bazy w wątku wywołującym, przed rozpoczęciem
+ * rysowania, więc wątki robocze nie korzystają z DatabaseManager.
+ */
+class ChartBatch {
+public:
+    /**
+     * @brief Formaty plików wynikowych (flagi bitowe).
+     */
+    enum Format {
+        PNG = 1, ///< Obraz PNG.
+        SVG = 2  ///< Grafika wektorowa SVG.
+    };
+
+    /**
+     * @brief Pojedynczy wykres do utworzenia.
+     */
+    struct Job {
+        std::shared_ptr<const MeasurementSeries> series; ///< Dane (współdzielone).
+        std::string title;                               ///< Tytuł wykresu (UTF-8).
+        std::string label;                               ///< Etykieta serii.
+        std::string fileName;                            ///< Nazwa pliku bez rozszerzenia.
+    };
+
+    /**
+     * @brief Podsumowanie przebiegu.
+     */
+    struct Result {
+        size_t charts;                   ///< Liczba wykresów.
+        size_t files;                    ///< Liczba zapisanych plików.
+        size_t failed;                   ///< Liczba plików, których nie udało się zapisać.
+        double seconds;                  ///< Czas rysowania i zapisu.
+        std::vector<std::string> errors; ///< Opisy błędów.
+    };
+
+    /**
+     * @brief Konstruktor klasy ChartBatch.
+     *
+     * @param dbManager Baza danych, z której czytane są serie.
+     */
+    explicit ChartBatch(DatabaseManager& dbManager);
+
+    /**
+     * @brief Tworzy zadania dla wszystkich zapisanych par stacja/sensor.
+     *
+     * @param days Liczba dni przed ostatnim pomiarem serii, które obejmuje wykres (0 - cała seria).
+     * @return Zadania (pary bez pomiarów są pomijane).
+     */
+    std::vector<Job> collectJobs(int days);
+
+    /**
+     * @brief Rysuje wykresy i zapisuje je do katalogu.
+     *
+     * Musi być wywoływana w głównym wątku aplikacji (wątku GUI), w którym rysowane są obrazy PNG.
+     *
+     * @param jobs Wykresy do utworzenia.
+     * @param directory Katalog wynikowy (musi istnieć).
+     * @param formats Formaty (suma flag Format).
+     * @param width Szerokość wykresu w pikselach.
+     * @param height Wysokość wykresu w pikselach.
+     * @return Podsumowanie przebiegu.
+     */
+    static Result render(const std::vector<Job>& jobs, const std::string& directory, int formats,
+        int width = 1200, int height = 600);
+
+    /**
+     * @brief Zamienia znaki niedozwolone w nazwach plików na '_'.
+     *
+     * @param name Nazwa.
+     * @return Nazwa złożona z liter ASCII, cyfr, '.', '-' i '_'.
+     */
+    static std::string safeFileName(const std::string& name);
+
+private:
+    DatabaseManager& dbManager_; ///< Źródło danych.
+};
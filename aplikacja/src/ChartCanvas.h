@@ -0,0 +1,124 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @file ChartCanvas.h
+ * @brief Interfejs powierzchni rysowania wykresu (ekran, obraz w pamięci, SVG).
+ *
+ * ChartRenderer rysuje wyłącznie przez ten interfejs, dzięki czemu ten sam kod obsługuje panel
+ * na ekranie, obrazy PNG tworzone bez okna i pliki SVG. Współrzędne są w pikselach, z początkiem
+ * w lewym górnym rogu; teksty są w UTF-8.
+ */
+
+/**
+ * @brief Kolor RGB.
+ */
+struct ChartColour {
+    unsigned char red;   ///< Składowa czerwona.
+    unsigned char green; ///< Składowa zielona.
+    unsigned char blue;  ///< Składowa niebieska.
+};
+
+/**
+ * @brief Powierzchnia rysowania wykresu.
+ */
+class ChartCanvas {
+public:
+    /**
+     * @brief Punkt na powierzchni rysowania.
+     */
+    struct Point {
+        double x; ///< Współrzędna X.
+        double y; ///< Współrzędna Y.
+    };
+
+    virtual ~ChartCanvas() = default;
+
+    /**
+     * @brief Ustawia pióro dla linii i obrysów.
+     *
+     * @param colour Kolor.
+     * @param width Grubość w pikselach.
+     * @param dotted Linia kropkowana (np. siatka).
+     */
+    virtual void setPen(const ChartColour& colour, double width, bool dotted = false) = 0;
+
+    /**
+     * @brief Wyłącza obrys (wypełnienia bez krawędzi).
+     */
+    virtual void setNoPen() = 0;
+
+    /**
+     * @brief Ustawia kolor wypełnienia wielokątów, prostokątów i kół.
+     *
+     * @param colour Kolor.
+     */
+    virtual void setBrush(const ChartColour& colour) = 0;
+
+    /**
+     * @brief Ustawia czcionkę tekstu.
+     *
+     * @param pointSize Rozmiar w punktach.
+     * @param bold Czcionka pogrubiona.
+     */
+    virtual void setFont(double pointSize, bool bold) = 0;
+
+    /**
+     * @brief Rysuje odcinek.
+     */
+    virtual void drawLine(double x1, double y1, double x2, double y2) = 0;
+
+    /**
+     * @brief Rysuje łamaną.
+     *
+     * @param points Wierzchołki łamanej.
+     */
+    virtual void drawLines(const std::vector<Point>& points) = 0;
+
+    /**
+     * @brief Rysuje wypełniony wielokąt.
+     *
+     * @param points Wierzchołki wielokąta.
+     */
+    virtual void drawPolygon(const std::vector<Point>& points) = 0;
+
+    /**
+     * @brief Rysuje wypełnione koło.
+     */
+    virtual void drawCircle(double x, double y, double radius) = 0;
+
+    /**
+     * @brief Rysuje wypełniony prostokąt.
+     */
+    virtual void drawRectangle(double x, double y, double width, double height) = 0;
+
+    /**
+     * @brief Rysuje tekst.
+     *
+     * @param text Tekst (UTF-8).
+     * @param x Lewa krawędź tekstu.
+     * @param y Górna krawędź tekstu.
+     */
+    virtual void drawText(const std::string& text, double x, double y) = 0;
+
+    /**
+     * @brief Mierzy tekst bieżącą czcionką.
+     *
+     * @param text Tekst (UTF-8).
+     * @param width Zmienna na szerokość.
+     * @param height Zmienna na wysokość.
+     */
+    virtual void getTextExtent(const std::string& text, double& width, double& height) = 0;
+
+    /**
+     * @brief Ogranicza rysowanie do prostokąta.
+     */
+    virtual void setClip(double x, double y, double width, double height) = 0;
+
+    /**
+     * @brief Usuwa ograniczenie rysowania.
+     */
+    virtual void resetClip() = 0;
+};
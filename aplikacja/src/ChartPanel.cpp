@@ -1,191 +1,266 @@
-/**
- * @file ChartPanel.cpp
- * @brief Implementacja klasy ChartPanel do wywietlania danych pomiarowych w formie wykresu.
- */
-
-#include "ChartPanel.h"
-#include <algorithm>
-
- /// Tablica zdarze wxWidgets
-wxBEGIN_EVENT_TABLE(ChartPanel, wxPanel)
-EVT_PAINT(ChartPanel::OnPaint) ///< Obsuga zdarzenia rysowania panelu
-EVT_SIZE(ChartPanel::OnSize)   ///< Obsuga zdarzenia zmiany rozmiaru
-wxEND_EVENT_TABLE()
-
-/**
- * @brief Konstruktor klasy ChartPanel.
- * @param parent Wskanik na okno nadrzdne.
- */
-    ChartPanel::ChartPanel(wxWindow* parent)
-    : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE),
-    minValue(0.0), maxValue(0.0)
-{
-    SetBackgroundColour(*wxWHITE);
-}
-
-/**
- * @brief Ustawia dane do wywietlenia na wykresie.
- *
- * Filtruje dane, ustawiajc tylko te poprawne, i aktualizuje zakres osi Y.
- *
- * @param measurements Wektor obiektw Measurement.
- * @param title Tytu wykresu.
- */
-void ChartPanel::SetData(const std::vector<Measurement>& measurements, const wxString& title)
-{
-    data.clear();
-
-    // Kopiujemy tylko prawidowe pomiary
-    for (const auto& m : measurements) {
-        if (m.isValid()) {
-            data.push_back(m);
-        }
-    }
-
-    chartTitle = title;
-
-    // Znajd min i max wartoci
-    if (!data.empty()) {
-        auto minmax = std::minmax_element(data.begin(), data.end(),
-            [](const Measurement& a, const Measurement& b) { return a.getValue() < b.getValue(); });
-
-        minValue = minmax.first->getValue();
-        maxValue = minmax.second->getValue();
-
-        // Dodaj margines
-        double range = maxValue - minValue;
-        if (range < 0.1) range = 1.0;
-
-        minValue -= range * 0.1;
-        maxValue += range * 0.1;
-
-        if (minValue < 0) minValue = 0;
-    }
-
-    Refresh();  ///< Odwiea panel, wywoujc rysowanie
-}
-
-/**
- * @brief Czyci dane wykresu i usuwa tytu.
- */
-void ChartPanel::ClearData()
-{
-    data.clear();
-    chartTitle = "";
-    Refresh();
-}
-
-/**
- * @brief Obsuguje zmian rozmiaru panelu.
- * @param event Zdarzenie rozmiaru.
- */
-void ChartPanel::OnSize(wxSizeEvent& event)
-{
-    Refresh();
-    event.Skip(); // Przekazuje zdarzenie dalej
-}
-
-/**
- * @brief Obsuguje rysowanie wykresu i elementw interfejsu.
- * @param event Zdarzenie rysowania.
- */
-void ChartPanel::OnPaint(wxPaintEvent& event)
-{
-    wxPaintDC dc(this);
-    wxSize size = GetClientSize();
-
-    // Komunikat, gdy brak danych
-    if (data.empty()) {
-        wxString message = "Brak danych do wywietlenia";
-        wxSize textSize = dc.GetTextExtent(message);
-        dc.DrawText(message, (size.x - textSize.x) / 2, (size.y - textSize.y) / 2);
-        return;
-    }
-
-    // Marginesy
-    const int leftMargin = 50;
-    const int rightMargin = 20;
-    const int topMargin = 40;
-    const int bottomMargin = 50;
-
-    // Obszar wykresu
-    wxRect chartArea(leftMargin, topMargin,
-        size.x - leftMargin - rightMargin,
-        size.y - topMargin - bottomMargin);
-
-    // Rysowanie tytuu
-    dc.SetFont(wxFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
-    wxSize titleSize = dc.GetTextExtent(chartTitle);
-    dc.DrawText(chartTitle, (size.x - titleSize.x) / 2, 10);
-
-    // Osie
-    dc.SetPen(wxPen(*wxBLACK, 1));
-    dc.DrawLine(chartArea.GetLeft(), chartArea.GetBottom(), chartArea.GetRight(), chartArea.GetBottom());  ///< O X
-    dc.DrawLine(chartArea.GetLeft(), chartArea.GetTop(), chartArea.GetLeft(), chartArea.GetBottom());      ///< O Y
-
-    // Czcionka do etykiet
-    dc.SetFont(wxFont(9, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
-
-    // Etykiety osi Y
-    const int yLabelCount = 5;
-    for (int i = 0; i <= yLabelCount; i++) {
-        double value = minValue + (maxValue - minValue) * i / yLabelCount;
-        int y = chartArea.GetBottom() - chartArea.GetHeight() * i / yLabelCount;
-
-        wxString label = wxString::Format("%.1f", value);
-        wxSize labelSize = dc.GetTextExtent(label);
-
-        dc.DrawText(label, chartArea.GetLeft() - labelSize.x - 5, y - labelSize.y / 2);
-
-        // Linie siatki
-        dc.SetPen(wxPen(wxColour(200, 200, 200), 1, wxPENSTYLE_DOT));
-        dc.DrawLine(chartArea.GetLeft(), y, chartArea.GetRight(), y);
-    }
-
-    // Etykiety osi X
-    const int xLabelCount = std::min(10, static_cast<int>(data.size()));
-    int dataStep = std::max(1, static_cast<int>(data.size()) / xLabelCount);
-
-    for (size_t i = 0; i < data.size(); i += dataStep) {
-        int x = chartArea.GetLeft() + chartArea.GetWidth() * i / (data.size() - 1);
-
-        wxString date = wxString::FromUTF8(data[i].getDate().substr(0, 10));
-        wxString time = wxString::FromUTF8(data[i].getDate().substr(11, 5));
-
-        wxSize dateSize = dc.GetTextExtent(date);
-        wxSize timeSize = dc.GetTextExtent(time);
-
-        dc.DrawText(date, x - dateSize.x / 2, chartArea.GetBottom() + 5);
-        dc.DrawText(time, x - timeSize.x / 2, chartArea.GetBottom() + 5 + dateSize.y);
-
-        // Linie siatki pionowej
-        dc.SetPen(wxPen(wxColour(200, 200, 200), 1, wxPENSTYLE_DOT));
-        dc.DrawLine(x, chartArea.GetTop(), x, chartArea.GetBottom());
-    }
-
-    // Rysowanie wykresu
-    if (data.size() > 1) {
-        dc.SetPen(wxPen(*wxBLUE, 2));
-
-        wxPoint prevPoint;
-        bool firstPoint = true;
-
-        for (size_t i = 0; i < data.size(); i++) {
-            int x = chartArea.GetLeft() + chartArea.GetWidth() * i / (data.size() - 1);
-            int y = chartArea.GetBottom() - chartArea.GetHeight() *
-                (data[i].getValue() - minValue) / (maxValue - minValue);
-
-            // Punkt danych
-            dc.SetBrush(*wxBLUE_BRUSH);
-            dc.DrawCircle(x, y, 3);
-
-            // czenie punktw
-            if (!firstPoint) {
-                dc.DrawLine(prevPoint, wxPoint(x, y));
-            }
-
-            prevPoint = wxPoint(x, y);
-            firstPoint = false;
-        }
-    }
+/**
+ * @file ChartPanel.cpp
+ * @brief Implementacja klasy ChartPanel do wyświetlania danych pomiarowych w formie wykresu.
+ */
+
+#include "ChartPanel.h"
+#include "WxChartCanvas.h"
+#include <wx/dcbuffer.h>
+#include <wx/graphics.h>
+#include <algorithm>
+#include <cmath>
+
+ /// Tablica zdarzeń wxWidgets
+wxBEGIN_EVENT_TABLE(ChartPanel, wxPanel)
+EVT_PAINT(ChartPanel::OnPaint) ///< Obsługa zdarzenia rysowania panelu
+EVT_SIZE(ChartPanel::OnSize)   ///< Obsługa zdarzenia zmiany rozmiaru
+EVT_MOUSEWHEEL(ChartPanel::OnMouseWheel)  ///< Przybliżanie kółkiem myszy
+EVT_LEFT_DOWN(ChartPanel::OnLeftDown)     ///< Początek przesuwania
+EVT_MOTION(ChartPanel::OnMotion)          ///< Przesuwanie
+EVT_LEFT_UP(ChartPanel::OnLeftUp)         ///< Koniec przesuwania
+EVT_LEFT_DCLICK(ChartPanel::OnLeftDClick) ///< Widok całej serii
+EVT_MOUSE_CAPTURE_LOST(ChartPanel::OnCaptureLost) ///< Przerwane przesuwanie
+wxEND_EVENT_TABLE()
+
+/**
+ * @brief Konstruktor klasy ChartPanel.
+ * @param parent Wskaźnik na okno nadrzędne.
+ */
+    ChartPanel::ChartPanel(wxWindow* parent)
+    : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE),
+    cacheValid(false), dragging(false), dragStartX(0), dragStartBegin(0.0)
+{
+    SetBackgroundColour(*wxWHITE);
+    SetBackgroundStyle(wxBG_STYLE_PAINT);  // całe tło rysuje OnPaint (wymagane przez wxAutoBufferedPaintDC)
+}
+
+/**
+ * @brief Ustawia dane do wyświetlenia na wykresie.
+ *
+ * Zastępuje wszystkie serie jedną serią utworzoną z poprawnych pomiarów (uporządkowaną według
+ * czasu). Jeśli nowe dane są przedłużeniem wyświetlanej serii, dopisywane są tylko nowe punkty,
+ * a widok pozostaje na miejscu (ChartRenderer::setData).
+ *
+ * @param measurements Wektor obiektów Measurement.
+ * @param title Tytuł wykresu.
+ */
+void ChartPanel::SetData(const std::vector<Measurement>& measurements, const wxString& title)
+{
+    renderer.setData(measurements, std::string(title.utf8_str()));
+    InvalidateCache();
+}
+
+/**
+ * @brief Nakłada kolejną serię na wykres.
+ *
+ * @param data Seria (współdzielona).
+ * @param label Etykieta w legendzie.
+ * @param axis Oś Y serii.
+ * @return Numer serii.
+ */
+size_t ChartPanel::AddSeries(std::shared_ptr<const MeasurementSeries> data, const wxString& label, Axis axis)
+{
+    size_t index = renderer.addSeries(std::move(data), std::string(label.utf8_str()), axis);
+    InvalidateCache();
+    return index;
+}
+
+/**
+ * @brief Ustawia tytuł wykresu.
+ *
+ * @param title Tytuł wykresu.
+ */
+void ChartPanel::SetTitle(const wxString& title)
+{
+    renderer.setTitle(std::string(title.utf8_str()));
+    InvalidateCache();
+}
+
+/**
+ * @brief Dopisuje pomiary na końcu serii ustawionej przez SetData bez przebudowy piramidy.
+ *
+ * @param measurements Nowe pomiary.
+ */
+void ChartPanel::AppendData(const std::vector<Measurement>& measurements)
+{
+    renderer.appendData(measurements);
+    InvalidateCache();
+}
+
+/**
+ * @brief Czyści dane wykresu i usuwa tytuł.
+ */
+void ChartPanel::ClearData()
+{
+    renderer.clear();
+    InvalidateCache();
+}
+
+/**
+ * @brief Przywraca widok wszystkich serii.
+ */
+void ChartPanel::ResetView()
+{
+    if (renderer.resetView()) {
+        InvalidateCache();
+    }
+}
+
+/**
+ * @brief Ustawia widoczny zakres czasu i odświeża wykres, jeśli się zmienił.
+ *
+ * @param begin Początek widoku.
+ * @param end Koniec widoku.
+ */
+void ChartPanel::SetView(double begin, double end)
+{
+    if (renderer.setView(begin, end)) {
+        InvalidateCache();
+    }
+}
+
+/**
+ * @brief Przybliża lub oddala wykres wokół punktu pod kursorem.
+ *
+ * Jeden skok kółka zmienia szerokość widoku o 20%; punkt pod kursorem pozostaje na miejscu.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void ChartPanel::OnMouseWheel(wxMouseEvent& event)
+{
+    wxSize size = GetClientSize();
+    ChartRenderer::Area chartArea = renderer.getChartArea(size.x, size.y);
+    const double viewBegin = renderer.getViewBegin(), viewEnd = renderer.getViewEnd();
+    if (!(viewEnd > viewBegin) || chartArea.width <= 0 || event.GetWheelDelta() == 0) return;
+
+    const double steps = static_cast<double>(event.GetWheelRotation()) / event.GetWheelDelta();
+    const double span = viewEnd - viewBegin;
+    const double newSpan = span * std::pow(0.8, steps);
+
+    const double fraction = std::min(std::max((event.GetX() - chartArea.x) / chartArea.width, 0.0), 1.0);
+    const double anchor = viewBegin + span * fraction;
+    SetView(anchor - newSpan * fraction, anchor + newSpan * (1.0 - fraction));
+}
+
+/**
+ * @brief Rozpoczyna przesuwanie wykresu myszą.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void ChartPanel::OnLeftDown(wxMouseEvent& event)
+{
+    event.Skip();
+    if (!(renderer.getViewEnd() > renderer.getViewBegin())) return;
+
+    dragging = true;
+    dragStartX = event.GetX();
+    dragStartBegin = renderer.getViewBegin();
+    if (!HasCapture()) CaptureMouse();
+}
+
+/**
+ * @brief Przesuwa wykres podczas przeciągania.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void ChartPanel::OnMotion(wxMouseEvent& event)
+{
+    wxSize size = GetClientSize();
+    ChartRenderer::Area chartArea = renderer.getChartArea(size.x, size.y);
+    if (!dragging || !event.Dragging() || chartArea.width <= 0) return;
+
+    const double span = renderer.getViewEnd() - renderer.getViewBegin();
+    const double shift = (dragStartX - event.GetX()) * span / chartArea.width;
+    SetView(dragStartBegin + shift, dragStartBegin + shift + span);
+}
+
+/**
+ * @brief Kończy przesuwanie wykresu.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void ChartPanel::OnLeftUp(wxMouseEvent& event)
+{
+    dragging = false;
+    if (HasCapture()) ReleaseMouse();
+    event.Skip();
+}
+
+/**
+ * @brief Przywraca widok wszystkich serii po dwukrotnym kliknięciu.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void ChartPanel::OnLeftDClick(wxMouseEvent& event)
+{
+    ResetView();
+    event.Skip();
+}
+
+/**
+ * @brief Kończy przesuwanie po utracie przechwycenia myszy.
+ *
+ * @param event Zdarzenie.
+ */
+void ChartPanel::OnCaptureLost(wxMouseCaptureLostEvent& event)
+{
+    dragging = false;
+}
+
+/**
+ * @brief Obsługuje zmianę rozmiaru panelu.
+ * @param event Zdarzenie rozmiaru.
+ */
+void ChartPanel::OnSize(wxSizeEvent& event)
+{
+    InvalidateCache();
+    event.Skip(); // Przekazuje zdarzenie dalej
+}
+
+/**
+ * @brief Unieważnia zapamiętany obraz wykresu i zleca odświeżenie panelu.
+ *
+ * Obraz jest tworzony ponownie dopiero przy najbliższym rysowaniu, więc kilka zmian
+ * (np. kolejne zdarzenia zmiany rozmiaru) między odświeżeniami kosztuje jedno rysowanie.
+ */
+void ChartPanel::InvalidateCache()
+{
+    cacheValid = false;
+    Refresh(false);
+}
+
+/**
+ * @brief Obsługuje rysowanie panelu.
+ *
+ * Wykres jest rysowany do bitmapy tylko po zmianie danych, rozmiaru lub widoku - przez
+ * ChartRenderer na kontekście graficznym bitmapy (ten sam kod tworzy wsadowo pliki PNG i SVG).
+ * Samo rysowanie panelu kopiuje bitmapę przez bufor (wxAutoBufferedPaintDC), co eliminuje migotanie.
+ *
+ * @param event Zdarzenie rysowania.
+ */
+void ChartPanel::OnPaint(wxPaintEvent& event)
+{
+    wxAutoBufferedPaintDC dc(this);
+    wxSize size = GetClientSize();
+    if (size.x <= 0 || size.y <= 0) {
+        return;
+    }
+
+    if (!cacheValid || !cache.IsOk() || cache.GetWidth() != size.x || cache.GetHeight() != size.y) {
+        cache.Create(size.x, size.y);
+        wxMemoryDC memoryDC(cache);
+        memoryDC.SetBackground(wxBrush(GetBackgroundColour()));
+        memoryDC.Clear();
+        {
+            std::unique_ptr<wxGraphicsContext> context(wxGraphicsContext::Create(memoryDC));
+            if (context) {
+                WxChartCanvas canvas(*context);
+                renderer.render(canvas, size.x, size.y);
+            }
+        }
+        memoryDC.SelectObject(wxNullBitmap);
+        cacheValid = true;
+    }
+
+    dc.DrawBitmap(cache, 0, 0);
 }
\ No newline at end of file
@@ -1,56 +1,163 @@
-// Plik: ChartPanel.h
-#pragma once
-
-#include <wx/wx.h>
-#include <vector>
-#include <string>
-#include "Measurement.h"
-
-/**
- * @file ChartPanel.h
- * @brief Klasa ChartPanel odpowiadajca za wywietlanie wykresu pomiarw w aplikacji wxWidgets.
- */
-class ChartPanel : public wxPanel {
-public:
-    /**
-     * @brief Konstruktor klasy ChartPanel.
-     *
-     * @param parent Wskanik na okno nadrzdne.
-     */
-    ChartPanel(wxWindow* parent);
-
-    /**
-     * @brief Ustawia dane do wywietlenia na wykresie.
-     *
-     * @param measurements Wektor pomiarw do narysowania.
-     * @param title Tytu wykresu.
-     */
-    void SetData(const std::vector<Measurement>& measurements, const wxString& title);
-
-    /**
-     * @brief Czyci dane wykresu.
-     */
-    void ClearData();
-
-private:
-    /**
-     * @brief Obsuga zdarzenia rysowania panelu.
-     *
-     * @param event Obiekt zdarzenia rysowania.
-     */
-    void OnPaint(wxPaintEvent& event);
-
-    /**
-     * @brief Obsuga zmiany rozmiaru panelu.
-     *
-     * @param event Obiekt zdarzenia zmiany rozmiaru.
-     */
-    void OnSize(wxSizeEvent& event);
-
-    std::vector<Measurement> data;     ///< Dane pomiarowe do wywietlenia.
-    wxString chartTitle;               ///< Tytu wykresu.
-    double minValue;                   ///< Minimalna warto na osi Y.
-    double maxValue;                   ///< Maksymalna warto na osi Y.
-
-    wxDECLARE_EVENT_TABLE();          ///< Makro do deklaracji tablicy zdarze wxWidgets.
+// Plik: ChartPanel.h
+#pragma once
+
+#include <wx/wx.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include "Measurement.h"
+#include "MeasurementSeries.h"
+#include "ChartRenderer.h"
+
+/**
+ * @file ChartPanel.h
+ * @brief Klasa ChartPanel odpowiadająca za wyświetlanie wykresu pomiarów w aplikacji wxWidgets.
+ *
+ * Wykres może zawierać wiele nałożonych serii na wspólnej osi czasu (znaczniki czasu, a nie
+ * indeksy pomiarów), z legendą i opcjonalną drugą osią Y po prawej stronie. Serie są
+ * przekazywane jako std::shared_ptr<const MeasurementSeries>, więc panel ich nie kopiuje.
+ * Model i rysowanie wykresu należą do ChartRenderer (wspólnego z wsadowym zapisem PNG/SVG);
+ * panel odpowiada za bitmapę, przybliżanie i przesuwanie myszą.
+ */
+class ChartPanel : public wxPanel {
+public:
+    /**
+     * @brief Oś Y, do której przypisana jest seria.
+     */
+    using Axis = ChartRenderer::Axis;
+
+    /**
+     * @brief Konstruktor klasy ChartPanel.
+     *
+     * @param parent Wskaźnik na okno nadrzędne.
+     */
+    ChartPanel(wxWindow* parent);
+
+    /**
+     * @brief Ustawia dane do wyświetlenia na wykresie.
+     *
+     * @param measurements Wektor pomiarów do narysowania.
+     * @param title Tytuł wykresu.
+     */
+    void SetData(const std::vector<Measurement>& measurements, const wxString& title);
+
+    /**
+     * @brief Nakłada kolejną serię na wykres.
+     *
+     * @param data Seria (współdzielona, nie jest kopiowana).
+     * @param label Etykieta w legendzie.
+     * @param axis Oś Y serii.
+     * @return Numer serii.
+     */
+    size_t AddSeries(std::shared_ptr<const MeasurementSeries> data, const wxString& label, Axis axis = Axis::LEFT);
+
+    /**
+     * @brief Zwraca liczbę serii na wykresie.
+     */
+    size_t GetSeriesCount() const { return renderer.getSeriesCount(); }
+
+    /**
+     * @brief Ustawia tytuł wykresu.
+     *
+     * @param title Tytuł wykresu.
+     */
+    void SetTitle(const wxString& title);
+
+    /**
+     * @brief Czyści dane wykresu.
+     */
+    void ClearData();
+
+    /**
+     * @brief Dopisuje pomiary na końcu serii ustawionej przez SetData bez przebudowy piramidy.
+     *
+     * @param measurements Nowe pomiary (późniejsze niż już wyświetlone).
+     */
+    void AppendData(const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Przywraca widok wszystkich serii.
+     */
+    void ResetView();
+
+private:
+    /**
+     * @brief Obsługa zdarzenia rysowania panelu.
+     *
+     * @param event Obiekt zdarzenia rysowania.
+     */
+    void OnPaint(wxPaintEvent& event);
+
+    /**
+     * @brief Obsługa zmiany rozmiaru panelu.
+     *
+     * @param event Obiekt zdarzenia zmiany rozmiaru.
+     */
+    void OnSize(wxSizeEvent& event);
+
+    /**
+     * @brief Przybliża lub oddala wykres kółkiem myszy wokół punktu pod kursorem.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnMouseWheel(wxMouseEvent& event);
+
+    /**
+     * @brief Rozpoczyna przesuwanie wykresu myszą.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnLeftDown(wxMouseEvent& event);
+
+    /**
+     * @brief Przesuwa wykres podczas przeciągania.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnMotion(wxMouseEvent& event);
+
+    /**
+     * @brief Kończy przesuwanie wykresu.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnLeftUp(wxMouseEvent& event);
+
+    /**
+     * @brief Przywraca widok wszystkich serii po dwukrotnym kliknięciu.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnLeftDClick(wxMouseEvent& event);
+
+    /**
+     * @brief Kończy przesuwanie po utracie przechwycenia myszy.
+     *
+     * @param event Obiekt zdarzenia.
+     */
+    void OnCaptureLost(wxMouseCaptureLostEvent& event);
+
+    /**
+     * @brief Ustawia widoczny zakres czasu (przycięty do danych) i odświeża wykres, jeśli się zmienił.
+     *
+     * @param begin Początek widoku (znacznik czasu w sekundach).
+     * @param end Koniec widoku.
+     */
+    void SetView(double begin, double end);
+
+    /**
+     * @brief Unieważnia zapamiętany obraz wykresu i zleca odświeżenie panelu.
+     */
+    void InvalidateCache();
+
+    ChartRenderer renderer;            ///< Model i rysowanie wykresu (serie, widok, osie, legenda).
+
+    wxBitmap cache;                    ///< Zapamiętany obraz wykresu (odświeżany po zmianie danych, rozmiaru lub widoku).
+    bool cacheValid;                   ///< Czy obraz w cache odpowiada bieżącym danym, rozmiarowi i widokowi.
+
+    bool dragging;                     ///< Czy trwa przesuwanie myszą.
+    int dragStartX;                    ///< Położenie kursora na początku przesuwania.
+    double dragStartBegin;             ///< Początek widoku na początku przesuwania.
+
+    wxDECLARE_EVENT_TABLE();          ///< Makro do deklaracji tablicy zdarzeń wxWidgets.
 };
\ No newline at end of file
@@ -0,0 +1,463 @@
+/**
+ * @file ChartRenderer.cpp
+ * @brief Implementacja modelu i rysowania wykresu niezależnego od okna.
+ */
+
+#include "ChartRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    /// Kolory kolejnych serii (pierwsza - niebieska, jak dotychczasowy wykres pojedynczej serii)
+    const ChartColour SERIES_COLOURS[] = {
+        { 0, 0, 255 }, { 255, 127, 14 }, { 44, 160, 44 }, { 214, 39, 40 }, { 148, 103, 189 },
+        { 140, 86, 75 }, { 227, 119, 194 }, { 127, 127, 127 }, { 188, 189, 34 }, { 23, 190, 207 }
+    };
+
+    const ChartColour AXIS_COLOUR = { 0, 0, 0 };         ///< Kolor osi i tekstu.
+    const ChartColour GRID_COLOUR = { 200, 200, 200 };   ///< Kolor linii siatki.
+    const ChartColour LEGEND_COLOUR = { 160, 160, 160 }; ///< Kolor ramki legendy.
+    const ChartColour WHITE = { 255, 255, 255 };         ///< Tło legendy.
+
+    const double TITLE_FONT_SIZE = 12.0; ///< Rozmiar czcionki tytułu (pt).
+    const double LABEL_FONT_SIZE = 9.0;  ///< Rozmiar czcionki etykiet (pt).
+
+    /// Najmniejsza szerokość widoku przy przybliżaniu (4 godziny)
+    const double MIN_VIEW_SECONDS = 4 * 3600.0;
+
+    /**
+     * @brief Formatuje wartość osi Y z jednym miejscem po przecinku (zgodnie z bieżącą lokalizacją).
+     */
+    std::string formatValue(double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+        return buffer;
+    }
+}
+
+/**
+ * @brief Tworzy pusty wykres.
+ */
+ChartRenderer::ChartRenderer() : viewBegin_(0.0), viewEnd_(0.0) {
+}
+
+/**
+ * @brief Zastępuje serie jedną serią utworzoną z poprawnych pomiarów.
+ *
+ * @param measurements Pomiary.
+ * @param title Tytuł wykresu.
+ */
+void ChartRenderer::setData(const std::vector<Measurement>& measurements, const std::string& title) {
+    std::vector<Measurement> valid;
+    valid.reserve(measurements.size());
+
+    // Kopiujemy tylko prawidłowe pomiary
+    for (const auto& m : measurements) {
+        if (m.isValid()) {
+            valid.push_back(m);
+        }
+    }
+    auto created = std::make_shared<MeasurementSeries>(valid);
+
+    const bool extends = ownedSeries_ && series_.size() == 1 && series_[0].data == ownedSeries_ &&
+        title == title_ && !ownedSeries_->empty() && created->size() > ownedSeries_->size() &&
+        created->getTimestamps().front() == ownedSeries_->getTimestamps().front() &&
+        created->getTimestamps()[ownedSeries_->size() - 1] == ownedSeries_->getTimestamps().back();
+    if (extends) {
+        appendPoints(*created, ownedSeries_->size());
+        return;
+    }
+
+    series_.clear();
+    ownedSeries_ = created;
+    title_ = title;
+    addSeries(ownedSeries_, title);
+}
+
+/**
+ * @brief Nakłada kolejną serię na wykres.
+ *
+ * Piramida serii jest budowana raz, tutaj. Widok jest rozszerzany do zakresu czasu wszystkich serii.
+ *
+ * @param data Seria (współdzielona).
+ * @param label Etykieta w legendzie.
+ * @param axis Oś Y serii.
+ * @return Numer serii.
+ */
+size_t ChartRenderer::addSeries(std::shared_ptr<const MeasurementSeries> data, const std::string& label, Axis axis) {
+    const ChartColour& colour = SERIES_COLOURS[series_.size() % (sizeof(SERIES_COLOURS) / sizeof(SERIES_COLOURS[0]))];
+
+    Series added;
+    added.pyramid = data ? SeriesPyramid(data->getValues()) : SeriesPyramid();
+    added.data = data ? std::move(data) : std::make_shared<MeasurementSeries>();
+    added.label = label;
+    added.axis = axis;
+    added.colour = colour;
+    // Pasmo min-max w jaśniejszym odcieniu koloru serii
+    added.bandColour = { static_cast<unsigned char>(255 - (255 - colour.red) / 4),
+        static_cast<unsigned char>(255 - (255 - colour.green) / 4),
+        static_cast<unsigned char>(255 - (255 - colour.blue) / 4) };
+    series_.push_back(std::move(added));
+
+    getDataRange(viewBegin_, viewEnd_);
+    return series_.size() - 1;
+}
+
+/**
+ * @brief Dopisuje pomiary na końcu serii ustawionej przez setData bez przebudowy piramidy.
+ *
+ * @param measurements Nowe pomiary (w dowolnej kolejności; niepoprawne są pomijane).
+ */
+void ChartRenderer::appendData(const std::vector<Measurement>& measurements) {
+    std::vector<Measurement> valid;
+    valid.reserve(measurements.size());
+    for (const auto& m : measurements) {
+        if (m.isValid()) {
+            valid.push_back(m);
+        }
+    }
+    appendPoints(MeasurementSeries(valid), 0);
+}
+
+/**
+ * @brief Dopisuje punkty (od podanego indeksu) na końcu serii ustawionej przez setData.
+ *
+ * Każdy punkt aktualizuje tylko ostatni kubełek na każdym poziomie piramidy; punkty nie
+ * późniejsze niż koniec serii są pomijane. Jeśli widok obejmował koniec serii, przesuwa się
+ * razem z nim (z zachowaniem szerokości).
+ *
+ * @param points Punkty uporządkowane według czasu.
+ * @param from Indeks pierwszego dopisywanego punktu.
+ */
+void ChartRenderer::appendPoints(const MeasurementSeries& points, size_t from) {
+    if (!ownedSeries_ || series_.size() != 1 || series_[0].data != ownedSeries_) return;
+
+    double rangeBegin = 0.0, rangeEnd = 0.0;
+    const bool followEnd = !getDataRange(rangeBegin, rangeEnd) || viewEnd_ >= rangeEnd;
+    const double span = viewEnd_ - viewBegin_;
+
+    for (size_t i = from; i < points.size(); i++) {
+        const int64_t timestamp = points.getTimestamps()[i];
+        if (ownedSeries_->empty() || timestamp > ownedSeries_->getTimestamps().back()) {
+            ownedSeries_->append(timestamp, points.getValues()[i]);
+            series_[0].pyramid.append(points.getValues()[i]);
+        }
+    }
+
+    if (followEnd && getDataRange(rangeBegin, rangeEnd)) {
+        viewBegin_ = std::max(rangeBegin, rangeEnd - span);
+        viewEnd_ = rangeEnd;
+    }
+}
+
+/**
+ * @brief Usuwa wszystkie serie i tytuł.
+ */
+void ChartRenderer::clear() {
+    series_.clear();
+    ownedSeries_.reset();
+    viewBegin_ = viewEnd_ = 0.0;
+    title_.clear();
+}
+
+/**
+ * @brief Sprawdza, czy któraś seria używa prawej osi Y.
+ */
+bool ChartRenderer::hasRightAxis() const {
+    return std::any_of(series_.begin(), series_.end(), [](const Series& s) { return s.axis == Axis::RIGHT; });
+}
+
+/**
+ * @brief Wyznacza zakres czasu obejmujący wszystkie serie.
+ *
+ * @param begin Zmienna na najwcześniejszy znacznik czasu.
+ * @param end Zmienna na najpóźniejszy znacznik czasu.
+ * @return false jeśli wykres nie zawiera punktów.
+ */
+bool ChartRenderer::getDataRange(double& begin, double& end) const {
+    bool found = false;
+    for (const auto& s : series_) {
+        if (s.data->empty()) continue;
+        const double first = static_cast<double>(s.data->getTimestamps().front());
+        const double last = static_cast<double>(s.data->getTimestamps().back());
+        begin = found ? std::min(begin, first) : first;
+        end = found ? std::max(end, last) : last;
+        found = true;
+    }
+    if (!found) {
+        begin = end = 0.0;
+    }
+    return found;
+}
+
+/**
+ * @brief Ustawia widoczny zakres czasu.
+ *
+ * Zakres jest przycinany do danych z zachowaniem szerokości, a jego szerokość wynosi
+ * co najmniej MIN_VIEW_SECONDS (lub cały zakres danych, jeśli jest krótszy).
+ *
+ * @param begin Początek widoku.
+ * @param end Koniec widoku.
+ * @return true jeśli widok się zmienił.
+ */
+bool ChartRenderer::setView(double begin, double end) {
+    double first, last;
+    if (!getDataRange(first, last) || !(last > first)) return false;
+
+    const double full = last - first;
+    const double span = std::min(std::max(end - begin, std::min(MIN_VIEW_SECONDS, full)), full);
+    begin = std::min(std::max(begin, first), last - span);
+    end = begin + span;
+
+    if (begin == viewBegin_ && end == viewEnd_) return false;
+    viewBegin_ = begin;
+    viewEnd_ = end;
+    return true;
+}
+
+/**
+ * @brief Przywraca widok wszystkich serii.
+ *
+ * @return true jeśli widok się zmienił.
+ */
+bool ChartRenderer::resetView() {
+    double begin, end;
+    return getDataRange(begin, end) && setView(begin, end);
+}
+
+/**
+ * @brief Zwraca obszar wykresu (bez marginesów na tytuł i etykiety).
+ *
+ * @param width Szerokość powierzchni rysowania.
+ * @param height Wysokość powierzchni rysowania.
+ * @return Obszar wykresu.
+ */
+ChartRenderer::Area ChartRenderer::getChartArea(double width, double height) const {
+    // Marginesy
+    const double leftMargin = 50;
+    const double rightMargin = hasRightAxis() ? 50 : 20;
+    const double topMargin = 40;
+    const double bottomMargin = 50;
+
+    return { leftMargin, topMargin, width - leftMargin - rightMargin, height - topMargin - bottomMargin };
+}
+
+/**
+ * @brief Rysuje wykres i elementy opisu.
+ *
+ * Oś X jest osią czasu wspólną dla wszystkich serii. Punkty każdej serii w widocznym zakresie
+ * są czytane z poziomu piramidy, na którym mieszczą się w około 2 kubełkach na kolumnę pikseli,
+ * więc koszt rysowania zależy od szerokości wykresu i liczby serii, a nie od liczby pomiarów
+ * w zakresie. Gdy kubełek obejmuje wiele pomiarów, rysowane jest pasmo min-max i łamana średnich;
+ * w przeciwnym razie łamana pomiarów, a znaczniki punktów tylko przy jednej serii i rzadkich
+ * punktach. Osie Y są dopasowywane do widocznego zakresu przypisanych do nich serii.
+ *
+ * @param canvas Powierzchnia rysowania.
+ * @param width Szerokość powierzchni.
+ * @param height Wysokość powierzchni.
+ */
+void ChartRenderer::render(ChartCanvas& canvas, double width, double height) const {
+    double textWidth, textHeight;
+
+    // Komunikat, gdy brak danych
+    double rangeBegin, rangeEnd;
+    if (!getDataRange(rangeBegin, rangeEnd)) {
+        const std::string message = "Brak danych do wyświetlenia";
+        canvas.setFont(LABEL_FONT_SIZE, false);
+        canvas.getTextExtent(message, textWidth, textHeight);
+        canvas.drawText(message, (width - textWidth) / 2, (height - textHeight) / 2);
+        return;
+    }
+
+    // Obszar wykresu
+    const Area area = getChartArea(width, height);
+    if (area.width <= 0 || area.height <= 0) {
+        return;
+    }
+    const double left = area.x, top = area.y, right = area.x + area.width, bottom = area.y + area.height;
+    const bool rightAxis = hasRightAxis();
+
+    // Kubełki widocznego zakresu każdej serii (z sąsiadem po każdej stronie, by łamana dochodziła do krawędzi)
+    std::vector<std::vector<SeriesPyramid::Bucket>> buckets(series_.size());
+    for (size_t s = 0; s < series_.size(); s++) {
+        const std::vector<int64_t>& timestamps = series_[s].data->getTimestamps();
+        if (timestamps.empty()) continue;
+
+        size_t first = std::lower_bound(timestamps.begin(), timestamps.end(), viewBegin_,
+            [](int64_t t, double v) { return static_cast<double>(t) < v; }) - timestamps.begin();
+        size_t last = std::upper_bound(timestamps.begin(), timestamps.end(), viewEnd_,
+            [](double v, int64_t t) { return v < static_cast<double>(t); }) - timestamps.begin();
+        first = first > 0 ? first - 1 : 0;
+        last = std::min(last + 1, timestamps.size());
+        buckets[s] = series_[s].pyramid.query(first, last, 2 * static_cast<size_t>(area.width));
+    }
+
+    // Zakres osi Y (lewej i prawej) dla widocznych kubełków
+    double minValue[2], maxValue[2];
+    for (int axis = 0; axis < 2; axis++) {
+        bool firstBucket = true;
+        for (size_t s = 0; s < series_.size(); s++) {
+            if (static_cast<int>(series_[s].axis) != axis) continue;
+            for (const auto& bucket : buckets[s]) {
+                if (bucket.valid == 0) continue;
+                minValue[axis] = firstBucket ? bucket.min : std::min(minValue[axis], bucket.min);
+                maxValue[axis] = firstBucket ? bucket.max : std::max(maxValue[axis], bucket.max);
+                firstBucket = false;
+            }
+        }
+        if (firstBucket) {
+            minValue[axis] = maxValue[axis] = 0.0;
+        }
+
+        // Dodaj margines
+        double range = maxValue[axis] - minValue[axis];
+        if (range < 0.1) range = 1.0;
+
+        minValue[axis] -= range * 0.1;
+        maxValue[axis] += range * 0.1;
+
+        if (minValue[axis] < 0) minValue[axis] = 0;
+    }
+
+    // Położenie punktu na osi X (pojedyncza chwila - na środku)
+    auto xPosition = [&](double timestamp) {
+        if (!(viewEnd_ > viewBegin_)) return left + area.width / 2;
+        return left + std::round(area.width * (timestamp - viewBegin_) / (viewEnd_ - viewBegin_));
+    };
+    auto yPosition = [&](double value, int axis) {
+        return bottom - std::round(area.height * (value - minValue[axis]) / (maxValue[axis] - minValue[axis]));
+    };
+
+    // Rysowanie tytułu
+    canvas.setFont(TITLE_FONT_SIZE, true);
+    canvas.getTextExtent(title_, textWidth, textHeight);
+    canvas.drawText(title_, (width - textWidth) / 2, 10);
+
+    // Osie
+    canvas.setPen(AXIS_COLOUR, 1);
+    canvas.drawLine(left, bottom, right, bottom);  // Oś X
+    canvas.drawLine(left, top, left, bottom);      // Oś Y
+    if (rightAxis) {
+        canvas.drawLine(right, top, right, bottom); // Prawa oś Y
+    }
+
+    // Czcionka do etykiet i pióro linii siatki
+    canvas.setFont(LABEL_FONT_SIZE, false);
+    canvas.setPen(GRID_COLOUR, 1, true);
+
+    // Etykiety osi Y
+    const int yLabelCount = 5;
+    for (int i = 0; i <= yLabelCount; i++) {
+        const double y = std::round(bottom - area.height * i / yLabelCount);
+
+        const std::string label = formatValue(minValue[0] + (maxValue[0] - minValue[0]) * i / yLabelCount);
+        canvas.getTextExtent(label, textWidth, textHeight);
+        canvas.drawText(label, left - textWidth - 5, y - textHeight / 2);
+
+        if (rightAxis) {
+            const std::string rightLabel = formatValue(minValue[1] + (maxValue[1] - minValue[1]) * i / yLabelCount);
+            canvas.getTextExtent(rightLabel, textWidth, textHeight);
+            canvas.drawText(rightLabel, right + 5, y - textHeight / 2);
+        }
+
+        // Linie siatki
+        canvas.drawLine(left, y, right, y);
+    }
+
+    // Etykiety osi X (równomiernie w czasie; co najmniej 80 px na etykietę)
+    const int xLabelCount = (viewEnd_ > viewBegin_) ? std::max(1, std::min(10, static_cast<int>(area.width / 80))) : 1;
+    for (int k = 0; k < xLabelCount; k++) {
+        const double timestamp = (viewEnd_ > viewBegin_) ? viewBegin_ + (viewEnd_ - viewBegin_) * k / xLabelCount : viewBegin_;
+        const double x = xPosition(timestamp);
+
+        const std::string formatted = MeasurementSeries::formatTimestamp(static_cast<int64_t>(std::llround(timestamp)));
+        const std::string date = formatted.substr(0, 10);
+        const std::string time = formatted.substr(11, 5);
+
+        double dateWidth, dateHeight, timeWidth, timeHeight;
+        canvas.getTextExtent(date, dateWidth, dateHeight);
+        canvas.getTextExtent(time, timeWidth, timeHeight);
+
+        canvas.drawText(date, x - dateWidth / 2, bottom + 5);
+        canvas.drawText(time, x - timeWidth / 2, bottom + 5 + dateHeight);
+
+        // Linie siatki pionowej
+        canvas.drawLine(x, top, x, bottom);
+    }
+
+    // Rysowanie serii: najpierw pasma min-max wszystkich serii, potem łamane (pasma nie zasłaniają linii)
+    std::vector<std::vector<ChartCanvas::Point>> points(series_.size());
+    canvas.setClip(area.x, area.y, area.width, area.height);
+
+    for (size_t s = 0; s < series_.size(); s++) {
+        const std::vector<int64_t>& timestamps = series_[s].data->getTimestamps();
+        const int axis = static_cast<int>(series_[s].axis);
+        points[s].reserve(buckets[s].size());
+        for (const auto& bucket : buckets[s]) {
+            if (bucket.valid == 0) continue;
+            const double middle = 0.5 * (static_cast<double>(timestamps[bucket.first]) +
+                static_cast<double>(timestamps[bucket.first + bucket.count - 1]));
+            points[s].push_back({ xPosition(middle), yPosition(bucket.mean(), axis) });
+        }
+
+        // Pasmo min-max: górna krawędź w przód, dolna wstecz
+        if (!buckets[s].empty() && buckets[s].front().count > 1) {
+            std::vector<ChartCanvas::Point> band;
+            band.reserve(2 * points[s].size());
+            size_t k = 0;
+            for (const auto& bucket : buckets[s]) {
+                if (bucket.valid > 0) band.push_back({ points[s][k++].x, yPosition(bucket.max, axis) });
+            }
+            for (auto it = buckets[s].rbegin(); it != buckets[s].rend(); ++it) {
+                if (it->valid > 0) band.push_back({ points[s][--k].x, yPosition(it->min, axis) });
+            }
+            canvas.setNoPen();
+            canvas.setBrush(series_[s].bandColour);
+            canvas.drawPolygon(band);
+        }
+    }
+
+    for (size_t s = 0; s < series_.size(); s++) {
+        canvas.setPen(series_[s].colour, 2);
+        if (points[s].size() > 1) {
+            canvas.drawLines(points[s]);
+        }
+
+        // Znaczniki punktów tylko przy jednej serii i rzadkich danych (co najmniej 8 px między punktami)
+        const bool aggregated = !buckets[s].empty() && buckets[s].front().count > 1;
+        if (series_.size() == 1 && !aggregated && area.width >= points[s].size() * 8.0) {
+            canvas.setBrush(series_[s].colour);
+            for (const auto& point : points[s]) {
+                canvas.drawCircle(point.x, point.y, 3);
+            }
+        }
+    }
+
+    canvas.resetClip();
+
+    // Legenda (przy więcej niż jednej serii) w lewym górnym rogu obszaru wykresu
+    if (series_.size() > 1) {
+        std::vector<std::string> labels(series_.size());
+        double labelWidth = 0, labelHeight = 0;
+        for (size_t s = 0; s < series_.size(); s++) {
+            labels[s] = series_[s].axis == Axis::RIGHT ? series_[s].label + " (prawa oś)" : series_[s].label;
+            canvas.getTextExtent(labels[s], textWidth, textHeight);
+            labelWidth = std::max(labelWidth, textWidth);
+            labelHeight = std::max(labelHeight, textHeight);
+        }
+
+        const double rowHeight = labelHeight + 4;
+        const double legendX = left + 10, legendY = top + 10;
+        canvas.setPen(LEGEND_COLOUR, 1);
+        canvas.setBrush(WHITE);
+        canvas.drawRectangle(legendX, legendY, labelWidth + 40, rowHeight * series_.size() + 6);
+
+        for (size_t s = 0; s < series_.size(); s++) {
+            const double y = legendY + 3 + rowHeight * s;
+            canvas.setPen(series_[s].colour, 2);
+            canvas.drawLine(legendX + 6, y + rowHeight / 2, legendX + 26, y + rowHeight / 2);
+            canvas.drawText(labels[s], legendX + 32, y + 2);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ChartCanvas.h"
+#include "Measurement.h"
+#include "MeasurementSeries.h"
+#include "SeriesPyramid.h"
+
+/**
+ * @file ChartRenderer.h
+ * @brief Model i rysowanie wykresu pomiarów niezależne od okna (ekran, PNG, SVG).
+ *
+ * Wykres zawiera nałożone serie na wspólnej osi czasu, z legendą i opcjonalną prawą osią Y.
+ * Serie są współdzielone (std::shared_ptr<const MeasurementSeries>), a każda ma piramidę
+ * min/max/średnich, z której rysowanie czyta tylko poziom odpowiadający szerokości wykresu.
+ * Klasa nie korzysta z wxWidgets, a render() nie zmienia stanu, więc różne obiekty (lub ten sam
+ * obiekt) mogą być rysowane równolegle w wątkach roboczych.
+ */
+class ChartRenderer {
+public:
+    /**
+     * @brief Oś Y, do której przypisana jest seria.
+     */
+    enum class Axis {
+        LEFT = 0, ///< Oś lewa (domyślna).
+        RIGHT = 1 ///< Oś prawa (np. wskaźnik o innej skali).
+    };
+
+    /**
+     * @brief Prostokąt (obszar wykresu).
+     */
+    struct Area {
+        double x;      ///< Lewa krawędź.
+        double y;      ///< Górna krawędź.
+        double width;  ///< Szerokość.
+        double height; ///< Wysokość.
+    };
+
+    /**
+     * @brief Tworzy pusty wykres.
+     */
+    ChartRenderer();
+
+    /**
+     * @brief Zastępuje serie jedną serią utworzoną z poprawnych pomiarów.
+     *
+     * Jeśli nowe dane są przedłużeniem serii ustawionej poprzednio tą metodą (ten sam tytuł
+     * i te same znaczniki czasu na początku i końcu), dopisywane są tylko nowe punkty.
+     *
+     * @param measurements Pomiary (w dowolnej kolejności).
+     * @param title Tytuł wykresu (UTF-8).
+     */
+    void setData(const std::vector<Measurement>& measurements, const std::string& title);
+
+    /**
+     * @brief Nakłada kolejną serię na wykres i rozszerza widok do zakresu wszystkich serii.
+     *
+     * @param data Seria (współdzielona, nie jest kopiowana).
+     * @param label Etykieta w legendzie (UTF-8).
+     * @param axis Oś Y serii.
+     * @return Numer serii.
+     */
+    size_t addSeries(std::shared_ptr<const MeasurementSeries> data, const std::string& label, Axis axis = Axis::LEFT);
+
+    /**
+     * @brief Dopisuje pomiary na końcu serii ustawionej przez setData bez przebudowy piramidy.
+     *
+     * @param measurements Nowe pomiary (późniejsze niż już wyświetlone).
+     */
+    void appendData(const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Usuwa wszystkie serie i tytuł.
+     */
+    void clear();
+
+    /**
+     * @brief Ustawia tytuł wykresu.
+     *
+     * @param title Tytuł (UTF-8).
+     */
+    void setTitle(const std::string& title) { title_ = title; }
+
+    /**
+     * @brief Zwraca liczbę serii.
+     */
+    size_t getSeriesCount() const { return series_.size(); }
+
+    /**
+     * @brief Sprawdza, czy któraś seria używa prawej osi Y.
+     */
+    bool hasRightAxis() const;
+
+    /**
+     * @brief Wyznacza zakres czasu obejmujący wszystkie serie.
+     *
+     * @param begin Zmienna na najwcześniejszy znacznik czasu.
+     * @param end Zmienna na najpóźniejszy znacznik czasu.
+     * @return false jeśli wykres nie zawiera punktów.
+     */
+    bool getDataRange(double& begin, double& end) const;
+
+    /**
+     * @brief Zwraca początek widoku (znacznik czasu w sekundach).
+     */
+    double getViewBegin() const { return viewBegin_; }
+
+    /**
+     * @brief Zwraca koniec widoku (znacznik czasu w sekundach).
+     */
+    double getViewEnd() const { return viewEnd_; }
+
+    /**
+     * @brief Ustawia widoczny zakres czasu (przycięty do danych, co najmniej 4 godziny).
+     *
+     * @param begin Początek widoku.
+     * @param end Koniec widoku.
+     * @return true jeśli widok się zmienił.
+     */
+    bool setView(double begin, double end);
+
+    /**
+     * @brief Przywraca widok wszystkich serii.
+     *
+     * @return true jeśli widok się zmienił.
+     */
+    bool resetView();
+
+    /**
+     * @brief Zwraca obszar wykresu (bez marginesów na tytuł i etykiety).
+     *
+     * @param width Szerokość powierzchni rysowania.
+     * @param height Wysokość powierzchni rysowania.
+     * @return Obszar wykresu.
+     */
+    Area getChartArea(double width, double height) const;
+
+    /**
+     * @brief Rysuje wykres (tytuł, osie, siatkę, etykiety, serie i legendę).
+     *
+     * @param canvas Powierzchnia rysowania (tło powinno być już wypełnione).
+     * @param width Szerokość powierzchni.
+     * @param height Wysokość powierzchni.
+     */
+    void render(ChartCanvas& canvas, double width, double height) const;
+
+private:
+    /**
+     * @brief Seria wykresu z piramidą i kolorem.
+     */
+    struct Series {
+        std::shared_ptr<const MeasurementSeries> data; ///< Dane (współdzielone).
+        SeriesPyramid pyramid;                         ///< Piramida min/max/średnich.
+        std::string label;                             ///< Etykieta w legendzie.
+        Axis axis;                                     ///< Oś Y.
+        ChartColour colour;                            ///< Kolor linii.
+        ChartColour bandColour;                        ///< Kolor pasma min-max.
+    };
+
+    /**
+     * @brief Dopisuje punkty (od podanego indeksu) na końcu serii ustawionej przez setData.
+     *
+     * @param points Punkty uporządkowane według czasu.
+     * @param from Indeks pierwszego dopisywanego punktu.
+     */
+    void appendPoints(const MeasurementSeries& points, size_t from);
+
+    std::vector<Series> series_;                      ///< Serie wykresu.
+    std::shared_ptr<MeasurementSeries> ownedSeries_;  ///< Seria utworzona przez setData (może być przedłużana).
+    std::string title_;                               ///< Tytuł wykresu.
+    double viewBegin_;                                ///< Początek widoku (sekundy).
+    double viewEnd_;                                  ///< Koniec widoku (sekundy).
+};
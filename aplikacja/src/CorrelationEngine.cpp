@@ -0,0 +1,363 @@
+/**
+ * @file CorrelationEngine.cpp
+ * @brief Implementacja blokowego, równoległego wyznaczania macierzy korelacji.
+ */
+
+#include "CorrelationEngine.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+const size_t SERIES_BLOCK = 16;  ///< Liczba serii w bloku.
+const size_t TIME_BLOCK = 1024;  ///< Długość fragmentu serii przetwarzanego naraz (mieści się w pamięci podręcznej).
+
+/**
+ * @brief Sumy częściowe pary serii (tylko chwile, w których obie mają wartość).
+ */
+struct PairSums {
+    double count = 0.0; ///< Liczba wspólnych pomiarów.
+    double sx = 0.0;    ///< Suma x.
+    double sy = 0.0;    ///< Suma y.
+    double sxx = 0.0;   ///< Suma x^2.
+    double syy = 0.0;   ///< Suma y^2.
+    double sxy = 0.0;   ///< Suma x*y.
+};
+
+/**
+ * @brief Nadaje rangi wartościom serii tylko w chwilach, w których druga seria też ma wartość
+ * (średnia ranga dla wartości równych).
+ *
+ * Kolejność prawidłowych wartości jest wyznaczona raz dla serii, więc rangi pary powstają
+ * w jednym przejściu, bez sortowania.
+ *
+ * @param values Wartości serii (ujemne = brak).
+ * @param order Indeksy prawidłowych wartości serii, rosnąco według wartości.
+ * @param other Wartości drugiej serii (ujemne = brak).
+ * @param ranks Tablica rang (zapisywane są tylko chwile wspólne).
+ * @return Liczba wspólnych chwil.
+ */
+size_t rankOverlap(const double* values, const std::vector<uint32_t>& order, const double* other, double* ranks) {
+    size_t ranked = 0;
+    for (size_t k = 0; k < order.size();) {
+        const double value = values[order[k]];
+        size_t end = k;
+        size_t common = 0;
+        while (end < order.size() && values[order[end]] == value) {
+            if (other[order[end]] >= 0) common++;
+            end++;
+        }
+        const double rank = static_cast<double>(ranked) + (static_cast<double>(common) + 1.0) / 2.0;
+        for (size_t t = k; t < end; t++) {
+            if (other[order[t]] >= 0) ranks[order[t]] = rank;
+        }
+        ranked += common;
+        k = end;
+    }
+    return ranked;
+}
+
+/**
+ * @brief Zapisuje pole CSV, ujmując je w cudzysłów, jeśli zawiera separator lub cudzysłów.
+ */
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(";\"\n") == std::string::npos) return text;
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"') quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor klasy CorrelationEngine.
+ *
+ * @param method Rodzaj współczynnika.
+ * @param minOverlap Minimalna liczba wspólnych pomiarów.
+ */
+CorrelationEngine::CorrelationEngine(Method method, size_t minOverlap)
+    : method_(method), minOverlap_(std::max<size_t>(minOverlap, 2)) {
+}
+
+/**
+ * @brief Wyznacza macierz korelacji wyrównanych serii.
+ *
+ * Każda seria jest zamieniana na trzy ciągłe tablice: wartość wyśrodkowana (0 przy braku),
+ * maska obecności (1/0) i kwadrat wartości. Sumy dla pary liczone są bez rozgałęzień jako
+ * iloczyny z maską drugiej serii, blokami SERIES_BLOCK x SERIES_BLOCK serii i TIME_BLOCK chwil.
+ * Rangi Spearmana zależą od tego, które chwile są wspólne dla pary, więc ta metoda jest liczona
+ * osobno dla każdej pary (computeSpearman).
+ *
+ * @param series Serie o wspólnej siatce czasu.
+ * @return Macierz korelacji.
+ */
+CorrelationEngine::Matrix CorrelationEngine::compute(const std::vector<MeasurementSeries>& series) const {
+    const size_t n = series.size();
+    Matrix matrix;
+    matrix.size = n;
+    matrix.values.assign(n * n, std::numeric_limits<double>::quiet_NaN());
+    matrix.overlaps.assign(n * n, 0);
+    if (n == 0) return matrix;
+
+    size_t length = std::numeric_limits<size_t>::max();
+    for (const auto& s : series) length = std::min(length, s.size());
+    if (length == 0) return matrix;
+
+    if (method_ == Method::SPEARMAN) {
+        computeSpearman(series, length, matrix);
+        return matrix;
+    }
+
+    // Przygotowanie ciągłych tablic (wiersz = seria)
+    std::vector<double> centered(n * length), mask(n * length), squares(n * length);
+    for (size_t i = 0; i < n; i++) {
+        const std::vector<double>& values = series[i].getValues();
+
+        double sum = 0.0;
+        size_t count = 0;
+        for (size_t t = 0; t < length; t++) {
+            if (values[t] >= 0) {
+                sum += values[t];
+                count++;
+            }
+        }
+        // Wyśrodkowanie zmniejsza utratę precyzji przy odejmowaniu w wariancji i kowariancji
+        const double mean = count > 0 ? sum / count : 0.0;
+
+        for (size_t t = 0; t < length; t++) {
+            const bool valid = values[t] >= 0;
+            const double x = valid ? values[t] - mean : 0.0;
+            centered[i * length + t] = x;
+            mask[i * length + t] = valid ? 1.0 : 0.0;
+            squares[i * length + t] = x * x;
+        }
+    }
+
+    // Lista par bloków (górny trójkąt) rozdzielana między wątki
+    const size_t blocks = (n + SERIES_BLOCK - 1) / SERIES_BLOCK;
+    std::vector<std::pair<size_t, size_t>> blockPairs;
+    for (size_t bi = 0; bi < blocks; bi++) {
+        for (size_t bj = bi; bj < blocks; bj++) {
+            blockPairs.emplace_back(bi, bj);
+        }
+    }
+
+    TaskScheduler::shared().parallelFor(blockPairs.size(), [&](size_t p) {
+        std::vector<PairSums> sums(SERIES_BLOCK * SERIES_BLOCK);
+        const size_t iBegin = blockPairs[p].first * SERIES_BLOCK;
+        const size_t iEnd = std::min(iBegin + SERIES_BLOCK, n);
+        const size_t jBegin = blockPairs[p].second * SERIES_BLOCK;
+        const size_t jEnd = std::min(jBegin + SERIES_BLOCK, n);
+
+        for (size_t tBegin = 0; tBegin < length; tBegin += TIME_BLOCK) {
+            const size_t tEnd = std::min(tBegin + TIME_BLOCK, length);
+            for (size_t i = iBegin; i < iEnd; i++) {
+                const double* xi = &centered[i * length];
+                const double* mi = &mask[i * length];
+                const double* qi = &squares[i * length];
+                for (size_t j = std::max(i, jBegin); j < jEnd; j++) {
+                    const double* xj = &centered[j * length];
+                    const double* mj = &mask[j * length];
+                    const double* qj = &squares[j * length];
+                    double count = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, syy = 0.0, sxy = 0.0;
+                    for (size_t t = tBegin; t < tEnd; t++) {
+                        count += mi[t] * mj[t];
+                        sx += xi[t] * mj[t];
+                        sy += xj[t] * mi[t];
+                        sxx += qi[t] * mj[t];
+                        syy += qj[t] * mi[t];
+                        sxy += xi[t] * xj[t];
+                    }
+                    PairSums& s = sums[(i - iBegin) * SERIES_BLOCK + (j - jBegin)];
+                    s.count += count;
+                    s.sx += sx;
+                    s.sy += sy;
+                    s.sxx += sxx;
+                    s.syy += syy;
+                    s.sxy += sxy;
+                }
+            }
+        }
+
+        // Każda para należy do dokładnie jednego bloku, więc zapis nie wymaga synchronizacji
+        for (size_t i = iBegin; i < iEnd; i++) {
+            for (size_t j = std::max(i, jBegin); j < jEnd; j++) {
+                const PairSums& s = sums[(i - iBegin) * SERIES_BLOCK + (j - jBegin)];
+                const uint32_t overlap = static_cast<uint32_t>(s.count);
+                matrix.overlaps[i * n + j] = matrix.overlaps[j * n + i] = overlap;
+                if (overlap < minOverlap_) continue;
+
+                const double meanX = s.sx / s.count;
+                const double meanY = s.sy / s.count;
+                const double varX = s.sxx / s.count - meanX * meanX;
+                const double varY = s.syy / s.count - meanY * meanY;
+                const double cov = s.sxy / s.count - meanX * meanY;
+                if (!(varX > 0.0) || !(varY > 0.0)) continue;
+
+                const double r = std::max(-1.0, std::min(1.0, cov / std::sqrt(varX * varY)));
+                matrix.values[i * n + j] = matrix.values[j * n + i] = r;
+            }
+        }
+    });
+
+    return matrix;
+}
+
+/**
+ * @brief Wyznacza współczynniki Spearmana wszystkich par serii.
+ *
+ * Dla każdej pary rangi są nadawane tylko wartościom z chwil, w których obie serie mają pomiar,
+ * a współczynnik to korelacja Pearsona tych rang. Uporządkowanie prawidłowych wartości każdej
+ * serii jest wyznaczane raz, więc para kosztuje O(length) zamiast sortowania. Wiersze macierzy
+ * są rozdzielane między wątki puli.
+ *
+ * @param series Serie o wspólnej siatce czasu.
+ * @param length Liczba porównywanych chwil.
+ * @param matrix Macierz do uzupełnienia.
+ */
+void CorrelationEngine::computeSpearman(const std::vector<MeasurementSeries>& series, size_t length, Matrix& matrix) const {
+    const size_t n = series.size();
+    std::vector<std::vector<uint32_t>> orders(n);
+    for (size_t i = 0; i < n; i++) {
+        const double* values = series[i].getValues().data();
+        for (size_t t = 0; t < length; t++) {
+            if (values[t] >= 0) orders[i].push_back(static_cast<uint32_t>(t));
+        }
+        std::stable_sort(orders[i].begin(), orders[i].end(),
+            [values](uint32_t a, uint32_t b) { return values[a] < values[b]; });
+    }
+
+    TaskScheduler::shared().parallelFor(n, [&](size_t i) {
+        std::vector<double> ranksX(length), ranksY(length);
+        const double* x = series[i].getValues().data();
+        for (size_t j = i + 1; j < n; j++) {
+            const double* y = series[j].getValues().data();
+            const size_t overlap = rankOverlap(x, orders[i], y, ranksX.data());
+            rankOverlap(y, orders[j], x, ranksY.data());
+            matrix.overlaps[i * n + j] = matrix.overlaps[j * n + i] = static_cast<uint32_t>(overlap);
+            if (overlap < minOverlap_) continue;
+
+            // Średnia rang 1..overlap jest znana; przy remisach wariancja może spaść do zera
+            const double mean = (static_cast<double>(overlap) + 1.0) / 2.0;
+            double sxx = 0.0, syy = 0.0, sxy = 0.0;
+            for (size_t t = 0; t < length; t++) {
+                if (!(x[t] >= 0) || !(y[t] >= 0)) continue;
+                const double dx = ranksX[t] - mean;
+                const double dy = ranksY[t] - mean;
+                sxx += dx * dx;
+                syy += dy * dy;
+                sxy += dx * dy;
+            }
+            if (!(sxx > 0.0) || !(syy > 0.0)) continue;
+
+            const double r = std::max(-1.0, std::min(1.0, sxy / std::sqrt(sxx * syy)));
+            matrix.values[i * n + j] = matrix.values[j * n + i] = r;
+        }
+    });
+
+    // Przekątna jak w metodzie Pearsona: seria z co najmniej dwiema różnymi wartościami ma korelację 1
+    for (size_t i = 0; i < n; i++) {
+        matrix.overlaps[i * n + i] = static_cast<uint32_t>(orders[i].size());
+        const double* values = series[i].getValues().data();
+        if (!orders[i].empty() && orders[i].size() >= minOverlap_ && values[orders[i].front()] < values[orders[i].back()]) {
+            matrix.values[i * n + i] = 1.0;
+        }
+    }
+}
+
+/**
+ * @brief Wybiera k najbardziej skorelowanych sąsiadów każdej serii.
+ *
+ * @param matrix Macierz korelacji.
+ * @param k Liczba sąsiadów.
+ * @return Dla każdej serii lista sąsiadów malejąco według korelacji.
+ */
+std::vector<std::vector<CorrelationEngine::Neighbor>> CorrelationEngine::topNeighbors(const Matrix& matrix, size_t k) {
+    std::vector<std::vector<Neighbor>> result(matrix.size);
+    for (size_t i = 0; i < matrix.size; i++) {
+        std::vector<Neighbor> candidates;
+        for (size_t j = 0; j < matrix.size; j++) {
+            if (j == i || std::isnan(matrix.at(i, j))) continue;
+            candidates.push_back({ j, matrix.at(i, j), matrix.overlap(i, j) });
+        }
+
+        const size_t count = std::min(k, candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+            [](const Neighbor& a, const Neighbor& b) { return a.correlation > b.correlation; });
+        candidates.resize(count);
+        result[i] = std::move(candidates);
+    }
+    return result;
+}
+
+/**
+ * @brief Zapisuje macierz korelacji do pliku CSV.
+ *
+ * @param matrix Macierz korelacji.
+ * @param labels Etykiety serii.
+ * @param filePath Ścieżka do pliku.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool CorrelationEngine::exportMatrixCsv(const Matrix& matrix, const std::vector<std::string>& labels, const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto label = [&](size_t i) { return i < labels.size() ? csvField(labels[i]) : std::to_string(i); };
+
+    for (size_t j = 0; j < matrix.size; j++) {
+        file << ";" << label(j);
+    }
+    file << "\n";
+
+    for (size_t i = 0; i < matrix.size; i++) {
+        file << label(i);
+        for (size_t j = 0; j < matrix.size; j++) {
+            file << ";";
+            if (!std::isnan(matrix.at(i, j))) file << matrix.at(i, j);
+        }
+        file << "\n";
+    }
+
+    return file.good();
+}
+
+/**
+ * @brief Zapisuje k najbardziej skorelowanych sąsiadów każdej serii do pliku CSV.
+ *
+ * @param matrix Macierz korelacji.
+ * @param labels Etykiety serii.
+ * @param k Liczba sąsiadów.
+ * @param filePath Ścieżka do pliku.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool CorrelationEngine::exportNeighborsCsv(const Matrix& matrix, const std::vector<std::string>& labels, size_t k,
+    const std::string& filePath) {
+    std::ofstream file(filePath);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto label = [&](size_t i) { return i < labels.size() ? csvField(labels[i]) : std::to_string(i); };
+
+    file << "seria;pozycja;sasiad;korelacja;wspolne_pomiary\n";
+    const auto neighbors = topNeighbors(matrix, k);
+    for (size_t i = 0; i < neighbors.size(); i++) {
+        for (size_t r = 0; r < neighbors[i].size(); r++) {
+            const Neighbor& neighbor = neighbors[i][r];
+            file << label(i) << ";" << (r + 1) << ";" << label(neighbor.index) << ";"
+                << neighbor.correlation << ";" << neighbor.overlap << "\n";
+        }
+    }
+
+    return file.good();
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MeasurementSeries.h"
+
+/**
+ * @file CorrelationEngine.h
+ * @brief Macierz korelacji (Pearsona lub Spearmana) między wieloma seriami, np. PM10 ze wszystkich stacji.
+ *
+ * Serie muszą być wyrównane do wspólnej siatki czasu (np. Resampler::resampleMany), tak aby
+ * i-ty element każdej serii dotyczył tego samego przedziału. Braki są obsługiwane parami:
+ * korelacja pary jest liczona tylko z chwil, w których obie serie mają wartość. Obliczenia
+ * są wykonywane blokami (fragment serii mieści się w pamięci podręcznej) równolegle na wielu rdzeniach.
+ */
+class CorrelationEngine {
+public:
+    /**
+     * @brief Rodzaj współczynnika korelacji.
+     */
+    enum class Method {
+        PEARSON, ///< Korelacja liniowa Pearsona.
+        SPEARMAN ///< Korelacja rang Spearmana (rangi liczone dla każdej pary, tylko z chwil wspólnych).
+    };
+
+    /**
+     * @brief Symetryczna macierz korelacji.
+     */
+    struct Matrix {
+        size_t size;                   ///< Liczba serii.
+        std::vector<double> values;    ///< Współczynniki wierszami (NaN, gdy wspólnych pomiarów jest za mało).
+        std::vector<uint32_t> overlaps;///< Liczba wspólnych pomiarów każdej pary.
+
+        /**
+         * @brief Zwraca współczynnik korelacji pary serii.
+         *
+         * @param i Indeks pierwszej serii.
+         * @param j Indeks drugiej serii.
+         * @return Współczynnik korelacji lub NaN.
+         */
+        double at(size_t i, size_t j) const { return values[i * size + j]; }
+
+        /**
+         * @brief Zwraca liczbę wspólnych pomiarów pary serii.
+         *
+         * @param i Indeks pierwszej serii.
+         * @param j Indeks drugiej serii.
+         * @return Liczba wspólnych pomiarów.
+         */
+        uint32_t overlap(size_t i, size_t j) const { return overlaps[i * size + j]; }
+    };
+
+    /**
+     * @brief Najbardziej skorelowany sąsiad serii.
+     */
+    struct Neighbor {
+        size_t index;       ///< Indeks serii sąsiada.
+        double correlation; ///< Współczynnik korelacji.
+        uint32_t overlap;   ///< Liczba wspólnych pomiarów.
+    };
+
+    /**
+     * @brief Konstruktor klasy CorrelationEngine.
+     *
+     * @param method Rodzaj współczynnika.
+     * @param minOverlap Minimalna liczba wspólnych pomiarów, przy której korelacja jest liczona.
+     */
+    explicit CorrelationEngine(Method method = Method::PEARSON, size_t minOverlap = 24);
+
+    /**
+     * @brief Wyznacza macierz korelacji wyrównanych serii.
+     *
+     * @param series Serie o wspólnej siatce czasu (porównywane są wartości o tym samym indeksie).
+     * @return Macierz korelacji.
+     */
+    Matrix compute(const std::vector<MeasurementSeries>& series) const;
+
+    /**
+     * @brief Wybiera k najbardziej skorelowanych sąsiadów każdej serii.
+     *
+     * @param matrix Macierz korelacji.
+     * @param k Liczba sąsiadów.
+     * @return Dla każdej serii lista sąsiadów malejąco według korelacji.
+     */
+    static std::vector<std::vector<Neighbor>> topNeighbors(const Matrix& matrix, size_t k);
+
+    /**
+     * @brief Zapisuje macierz korelacji do pliku CSV (separator ';').
+     *
+     * @param matrix Macierz korelacji.
+     * @param labels Etykiety serii (np. nazwy stacji).
+     * @param filePath Ścieżka do pliku.
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    static bool exportMatrixCsv(const Matrix& matrix, const std::vector<std::string>& labels, const std::string& filePath);
+
+    /**
+     * @brief Zapisuje k najbardziej skorelowanych sąsiadów każdej serii do pliku CSV (separator ';').
+     *
+     * @param matrix Macierz korelacji.
+     * @param labels Etykiety serii.
+     * @param k Liczba sąsiadów.
+     * @param filePath Ścieżka do pliku.
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    static bool exportNeighborsCsv(const Matrix& matrix, const std::vector<std::string>& labels, size_t k,
+        const std::string& filePath);
+
+private:
+    /**
+     * @brief Wyznacza współczynniki Spearmana wszystkich par serii.
+     *
+     * @param series Serie o wspólnej siatce czasu.
+     * @param length Liczba porównywanych chwil (długość najkrótszej serii).
+     * @param matrix Macierz do uzupełnienia (wartości NaN i zerowe liczby wspólnych pomiarów).
+     */
+    void computeSpearman(const std::vector<MeasurementSeries>& series, size_t length, Matrix& matrix) const;
+
+    Method method_;     ///< Rodzaj współczynnika.
+    size_t minOverlap_; ///< Minimalna liczba wspólnych pomiarów.
+};
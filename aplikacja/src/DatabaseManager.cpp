@@ -1,239 +1,518 @@
-/**
- * @file DatabaseManager.cpp
- * @brief Implementacja klasy DatabaseManager zarzdzajcej zapisem i odczytem danych pomiarowych z pliku JSON.
- */
-
-#include "DatabaseManager.h"
-#include <iostream>
-
- /**
-  * @brief Konstruktor DatabaseManager.
-  *
-  * Inicjalizuje ciek do pliku bazy danych i aduje dane.
-  *
-  * @param dbFilePath cieka do pliku JSON z danymi.
-  */
-DatabaseManager::DatabaseManager(const std::string& dbFilePath)
-    : dbFilePath_(dbFilePath) {
-    loadDatabase();
-}
-
-/**
- * @brief aduje dane z pliku JSON do pamici.
- *
- * Tworzy domyln struktur, jeli plik nie istnieje.
- *
- * @return true jeli udao si wczyta dane lub utworzy now struktur, false w przypadku bdu parsowania.
- */
-bool DatabaseManager::loadDatabase() {
-    std::ifstream file(dbFilePath_);
-    if (!file.is_open()) {
-        dbRoot_["stations"] = Json::Value(Json::objectValue);
-        dbRoot_["data"] = Json::Value(Json::objectValue);
-        dbRoot_["indexes"] = Json::Value(Json::objectValue);
-        return true;
-    }
-
-    Json::Reader reader;
-    bool success = reader.parse(file, dbRoot_);
-    file.close();
-
-    if (!dbRoot_.isMember("stations")) {
-        dbRoot_["stations"] = Json::Value(Json::objectValue);
-    }
-    if (!dbRoot_.isMember("data")) {
-        dbRoot_["data"] = Json::Value(Json::objectValue);
-    }
-    if (!dbRoot_.isMember("indexes")) {  // Dodana walidacja
-        dbRoot_["indexes"] = Json::Value(Json::objectValue);
-    }
-
-
-    return success;
-}
-
-/**
- * @brief Zapisuje aktualny stan bazy danych do pliku.
- *
- * @return true jeli zapis zakoczy si sukcesem, false w przypadku bdu.
- */
-bool DatabaseManager::saveDatabase() {
-    std::ofstream file(dbFilePath_);
-    if (!file.is_open()) {
-        return false;
-    }
-
-    Json::StyledWriter writer;
-    file << writer.write(dbRoot_);
-    file.close();
-
-    return true;
-}
-
-/**
- * @brief Generuje klucz tekstowy na podstawie ID stacji i ID sensora.
- *
- * @param stationId ID stacji.
- * @param sensorId ID sensora.
- * @return Poczony klucz w postaci "stationId_sensorId".
- */
-std::string DatabaseManager::generateKey(int stationId, int sensorId) {
-    return std::to_string(stationId) + "_" + std::to_string(sensorId);
-}
-
-/**
- * @brief Zapisuje dane pomiarowe do pliku.
- *
- * Aktualizuje informacje o stacjach i sensorach oraz nadpisuje dane pomiarowe.
- *
- * @param stationId ID stacji.
- * @param stationName Nazwa stacji.
- * @param sensorId ID sensora.
- * @param sensorName Nazwa sensora.
- * @param measurements Wektor pomiarw do zapisania.
- * @return true jeli zapis si powid, false w przeciwnym razie.
- */
-bool DatabaseManager::saveData(int stationId, const std::string& stationName,
-    int sensorId, const std::string& sensorName,
-    const std::vector<Measurement>& measurements,
-    const std::map<std::string, std::string>& indexValues) {
-
-    // Zapisz dane stacji
-    if (!dbRoot_["stations"].isMember(std::to_string(stationId))) {
-        dbRoot_["stations"][std::to_string(stationId)] = Json::Value(Json::objectValue);
-        dbRoot_["stations"][std::to_string(stationId)]["name"] = stationName;
-        dbRoot_["stations"][std::to_string(stationId)]["sensors"] = Json::Value(Json::objectValue);
-    }
-
-    // Zapisz dane sensora
-    dbRoot_["stations"][std::to_string(stationId)]["sensors"][std::to_string(sensorId)] = sensorName;
-
-    // Zapisz dane pomiarowe
-    std::string key = generateKey(stationId, sensorId);
-    if (!dbRoot_["data"].isMember(key)) {
-        dbRoot_["data"][key] = Json::Value(Json::arrayValue);
-    }
-    else {
-        dbRoot_["data"][key].clear();
-    }
-
-    for (const auto& m : measurements) {
-        if (m.isValid()) {
-            Json::Value measurement;
-            measurement["date"] = m.getDate();
-            measurement["value"] = m.getValue();
-            dbRoot_["data"][key].append(measurement);
-        }
-    }
-
-    // Zapisz indeksy jakoci powietrza (jeli zostay podane)
-    if (!indexValues.empty()) {
-        std::string indexKey = "index_" + std::to_string(stationId);
-
-        if (!dbRoot_["indexes"].isObject()) {
-            dbRoot_["indexes"] = Json::Value(Json::objectValue);
-        }
-
-        dbRoot_["indexes"][indexKey] = Json::Value(Json::objectValue);
-        for (const auto& pair : indexValues) {
-            dbRoot_["indexes"][indexKey][pair.first] = pair.second;
-        }
-    }
-
-    return saveDatabase();
-}
-
-/**
- * @brief Wczytuje dane pomiarowe z pliku.
- *
- * @param stationId ID stacji.
- * @param sensorId ID sensora.
- * @param measurements Referencja do wektora, do ktrego zostan zaadowane dane.
- * @return true jeli dane zostay odnalezione i wczytane, false w przeciwnym razie.
- */
-bool DatabaseManager::loadData(int stationId, int sensorId, std::vector<Measurement>& measurements) {
-    std::string key = generateKey(stationId, sensorId);
-    if (!dbRoot_["data"].isMember(key)) {
-        return false;
-    }
-
-    measurements.clear();
-    const Json::Value& data = dbRoot_["data"][key];
-    for (const auto& m : data) {
-        std::string date = m["date"].asString();
-        double value = m["value"].asDouble();
-        measurements.emplace_back(date, value);
-    }
-
-    return true;
-}
-
-/**
- * @brief Pobiera zapisane stacje z bazy danych.
- *
- * @return Wektor par: ID stacji i nazwa stacji.
- */
-std::vector<Station> DatabaseManager::getSavedStations() {
-    std::vector<Station> stations;
-    const Json::Value& stationsJson = dbRoot_["stations"];
-
-    for (auto it = stationsJson.begin(); it != stationsJson.end(); ++it) {
-        int id = std::stoi(it.name());
-        std::string name = (*it)["name"].asString();
-
-        // Tworzymy obiekt Station bezporednio
-        stations.emplace_back(id, name);
-    }
-
-    return stations;
-}
-
-/**
- * @brief Pobiera zapisane sensory przypisane do danej stacji.
- *
- * @param stationId ID stacji.
- * @return Wektor par: ID sensora i nazwa sensora.
- */
-std::vector<Sensor> DatabaseManager::getSavedSensors(int stationId) {
-    std::vector<Sensor> sensors;
-    std::string stationIdStr = std::to_string(stationId);
-
-    if (dbRoot_["stations"].isMember(stationIdStr)) {
-        const Json::Value& sensorsJson = dbRoot_["stations"][stationIdStr]["sensors"];
-
-        for (auto it = sensorsJson.begin(); it != sensorsJson.end(); ++it) {
-            int id = std::stoi(it.name());
-            std::string name = (*it).asString();
-            // Trzeci parametr (wzr chemiczny) nie jest przechowywany w bazie,
-            // wic przekazujemy pusty string
-            sensors.emplace_back(id, name, "");
-        }
-    }
-
-    return sensors;
-}
-
-
-
-
-/**
- * @brief Wczytuje indeks jakoci powietrza dla stacji.
- *
- * @param stationId ID stacji.
- * @param indexValues Referencja do mapy, do ktrej zostan zaadowane indeksy.
- * @return true jeli dane zostay odnalezione i wczytane, false w przeciwnym razie.
- */
-bool DatabaseManager::loadAirQualityIndex(int stationId, std::map<std::string, std::string>& indexValues) {
-    std::string key = "index_" + std::to_string(stationId);
-
-    if (!dbRoot_["indexes"].isObject() || !dbRoot_["indexes"].isMember(key)) {
-        return false;
-    }
-
-    const Json::Value& indexJson = dbRoot_["indexes"][key];
-    for (auto it = indexJson.begin(); it != indexJson.end(); ++it) {
-        indexValues[it.name()] = (*it).asString();
-    }
-
-    return !indexValues.empty();
+/**
+ * @file DatabaseManager.cpp
+ * @brief Implementacja klasy DatabaseManager zarządzającej zapisem i odczytem danych pomiarowych z pliku JSON.
+ */
+
+#include "DatabaseManager.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+
+ /**
+  * @brief Konstruktor DatabaseManager.
+  *
+  * Inicjalizuje ścieżkę do pliku bazy danych. Plik jest wczytywany dopiero przy pierwszym
+  * użyciu bazy, więc utworzenie obiektu (np. razem z oknem) nie czeka na dysk.
+  *
+  * @param dbFilePath Ścieżka do pliku JSON z danymi.
+  */
+DatabaseManager::DatabaseManager(const std::string& dbFilePath)
+    : dbFilePath_(dbFilePath), loaded_(false) {
+}
+
+/**
+ * @brief Wczytuje bazę przy pierwszym użyciu (wywoływane pod blokadą mutex_).
+ */
+void DatabaseManager::ensureLoaded() {
+    if (!loaded_) {
+        loadDatabase();
+        loaded_ = true;
+    }
+}
+
+/**
+ * @brief Ładuje dane z pliku JSON do pamięci.
+ *
+ * Tworzy domyślną strukturę, jeśli plik nie istnieje.
+ *
+ * @return true jeśli udało się wczytać dane lub utworzyć nową strukturę, false w przypadku błędu parsowania.
+ */
+bool DatabaseManager::loadDatabase() {
+    std::ifstream file(dbFilePath_);
+    if (!file.is_open()) {
+        dbRoot_["stations"] = Json::Value(Json::objectValue);
+        dbRoot_["data"] = Json::Value(Json::objectValue);
+        dbRoot_["indexes"] = Json::Value(Json::objectValue);
+        dbRoot_["sketches"] = Json::Value(Json::objectValue);
+        dbRoot_["catalog"] = Json::Value(Json::objectValue);
+        return true;
+    }
+
+    Json::Reader reader;
+    bool success = reader.parse(file, dbRoot_);
+    file.close();
+
+    if (!dbRoot_.isMember("stations")) {
+        dbRoot_["stations"] = Json::Value(Json::objectValue);
+    }
+    if (!dbRoot_.isMember("data")) {
+        dbRoot_["data"] = Json::Value(Json::objectValue);
+    }
+    if (!dbRoot_.isMember("indexes")) {  // Dodana walidacja
+        dbRoot_["indexes"] = Json::Value(Json::objectValue);
+    }
+    if (!dbRoot_.isMember("sketches")) {
+        dbRoot_["sketches"] = Json::Value(Json::objectValue);
+    }
+    if (!dbRoot_.isMember("catalog")) {
+        dbRoot_["catalog"] = Json::Value(Json::objectValue);
+    }
+
+
+    return success;
+}
+
+/**
+ * @brief Zapisuje aktualny stan bazy danych do pliku.
+ *
+ * @return true jeśli zapis zakończył się sukcesem, false w przypadku błędu.
+ */
+bool DatabaseManager::saveDatabase() {
+    std::ofstream file(dbFilePath_);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    Json::StyledWriter writer;
+    file << writer.write(dbRoot_);
+    file.close();
+
+    return true;
+}
+
+/**
+ * @brief Generuje klucz tekstowy na podstawie ID stacji i ID sensora.
+ *
+ * @param stationId ID stacji.
+ * @param sensorId ID sensora.
+ * @return Połączony klucz w postaci "stationId_sensorId".
+ */
+std::string DatabaseManager::generateKey(int stationId, int sensorId) {
+    return std::to_string(stationId) + "_" + std::to_string(sensorId);
+}
+
+/**
+ * @brief Zapisuje dane pomiarowe do pliku.
+ *
+ * Aktualizuje informacje o stacjach i sensorach oraz nadpisuje dane pomiarowe.
+ *
+ * @param stationId ID stacji.
+ * @param stationName Nazwa stacji.
+ * @param sensorId ID sensora.
+ * @param sensorName Nazwa sensora.
+ * @param measurements Wektor pomiarów do zapisania.
+ * @param indexValues Mapa indeksów jakości powietrza.
+ * @param sensorFormula Wzór wskaźnika (pusty, jeśli nieznany).
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool DatabaseManager::saveData(int stationId, const std::string& stationName,
+    int sensorId, const std::string& sensorName,
+    const std::vector<Measurement>& measurements,
+    const std::map<std::string, std::string>& indexValues,
+    const std::string& sensorFormula) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+
+    // Zapisz dane stacji
+    if (!dbRoot_["stations"].isMember(std::to_string(stationId))) {
+        dbRoot_["stations"][std::to_string(stationId)] = Json::Value(Json::objectValue);
+        dbRoot_["stations"][std::to_string(stationId)]["name"] = stationName;
+        dbRoot_["stations"][std::to_string(stationId)]["sensors"] = Json::Value(Json::objectValue);
+    }
+
+    // Zapisz dane sensora
+    dbRoot_["stations"][std::to_string(stationId)]["sensors"][std::to_string(sensorId)] = sensorName;
+    if (!sensorFormula.empty()) {
+        // Wzory w osobnym obiekcie - starsze bazy (nazwa jako wartość sensora) pozostają czytelne
+        dbRoot_["stations"][std::to_string(stationId)]["formulas"][std::to_string(sensorId)] = sensorFormula;
+    }
+
+    // Zapisz dane pomiarowe
+    std::string key = generateKey(stationId, sensorId);
+    std::map<std::string, int> storedFlags;
+    std::vector<Measurement> previous;
+    if (!dbRoot_["data"].isMember(key)) {
+        dbRoot_["data"][key] = Json::Value(Json::arrayValue);
+    }
+    else {
+        // Flagi nadane przy wcześniejszych pobraniach nie mogą zniknąć przy ponownym zapisie
+        for (const auto& m : dbRoot_["data"][key]) {
+            if (m.isMember("flags")) storedFlags[m["date"].asString()] = m["flags"].asInt();
+            previous.emplace_back(m["date"].asString(), m["value"].asDouble(),
+                static_cast<uint8_t>(m.get("flags", 0).asInt()));
+        }
+        dbRoot_["data"][key].clear();
+    }
+
+    for (const auto& m : measurements) {
+        if (m.isValid()) {
+            Json::Value measurement;
+            measurement["date"] = m.getDate();
+            measurement["value"] = m.getValue();
+            int flags = m.getFlags();
+            auto stored = storedFlags.find(m.getDate());
+            if (stored != storedFlags.end()) flags |= stored->second;
+            if (flags != Measurement::FLAG_NONE) {
+                measurement["flags"] = flags;
+            }
+            dbRoot_["data"][key].append(measurement);
+        }
+    }
+
+    // Zapisz dzienne szkice kwantyli (do percentyli z dłuższych okresów)
+    saveDailySketches(key, measurements, previous);
+
+    // Zapisz indeksy jakości powietrza (jeśli zostały podane)
+    if (!indexValues.empty()) {
+        std::string indexKey = "index_" + std::to_string(stationId);
+
+        if (!dbRoot_["indexes"].isObject()) {
+            dbRoot_["indexes"] = Json::Value(Json::objectValue);
+        }
+
+        dbRoot_["indexes"][indexKey] = Json::Value(Json::objectValue);
+        for (const auto& pair : indexValues) {
+            dbRoot_["indexes"][indexKey][pair.first] = pair.second;
+        }
+    }
+
+    return saveDatabase();
+}
+
+/**
+ * @brief Wczytuje dane pomiarowe z pliku.
+ *
+ * @param stationId ID stacji.
+ * @param sensorId ID sensora.
+ * @param measurements Referencja do wektora, do którego zostaną załadowane dane.
+ * @return true jeśli dane zostały odnalezione i wczytane, false w przeciwnym razie.
+ */
+bool DatabaseManager::loadData(int stationId, int sensorId, std::vector<Measurement>& measurements) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::string key = generateKey(stationId, sensorId);
+    if (!dbRoot_["data"].isMember(key)) {
+        return false;
+    }
+
+    measurements.clear();
+    const Json::Value& data = dbRoot_["data"][key];
+    for (const auto& m : data) {
+        std::string date = m["date"].asString();
+        double value = m["value"].asDouble();
+        uint8_t flags = static_cast<uint8_t>(m.get("flags", 0).asInt());
+        measurements.emplace_back(date, value, flags);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Wczytuje dane pomiarowe z pliku bezpośrednio do serii kolumnowej.
+ *
+ * Pomija tworzenie pośrednich obiektów Measurement.
+ *
+ * @param stationId ID stacji.
+ * @param sensorId ID sensora.
+ * @param series Referencja do serii, do której zostaną załadowane dane.
+ * @return true jeśli dane zostały odnalezione i wczytane, false w przeciwnym razie.
+ */
+bool DatabaseManager::loadSeries(int stationId, int sensorId, MeasurementSeries& series) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::string key = generateKey(stationId, sensorId);
+    if (!dbRoot_["data"].isMember(key)) {
+        return false;
+    }
+
+    const Json::Value& data = dbRoot_["data"][key];
+    std::vector<std::pair<int64_t, double>> points;
+    points.reserve(data.size());
+    for (const auto& m : data) {
+        int64_t timestamp;
+        if (MeasurementSeries::parseTimestamp(m["date"].asString(), timestamp)) {
+            points.emplace_back(timestamp, m["value"].asDouble());
+        }
+    }
+
+    // Dane zapisane z API są posortowane od najnowszych
+    std::stable_sort(points.begin(), points.end(),
+        [](const std::pair<int64_t, double>& a, const std::pair<int64_t, double>& b) { return a.first < b.first; });
+
+    series = MeasurementSeries();
+    series.reserve(points.size());
+    for (const auto& p : points) {
+        series.append(p.first, p.second);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Tworzy i zapisuje w pamięci szkice kwantyli dla każdego dnia z pomiarów.
+ *
+ * Szkic dnia jest budowany od nowa ze wszystkich znanych pomiarów tego dnia (zapisanych wcześniej
+ * i bieżących, bez powtórzeń dat), a nie scalany z zapisanym szkicem, który już je zawiera.
+ * Zapisany szkic jest zastępowany tylko wtedy, gdy nowy obejmuje co najmniej tyle pomiarów -
+ * dzień brzegowy, z którego API zwraca tylko część godzin, nie nadpisuje pełnego szkicu.
+ * Szkice pozostałych dni zostają zachowane, dzięki czemu historia dłuższa niż zakres zwracany
+ * przez API nadal jest dostępna.
+ *
+ * @param key Klucz danych sensora (stationId_sensorId).
+ * @param measurements Pomiary do podziału na dni.
+ * @param previous Pomiary sensora zapisane w bazie przed bieżącym zapisem.
+ */
+void DatabaseManager::saveDailySketches(const std::string& key, const std::vector<Measurement>& measurements,
+    const std::vector<Measurement>& previous) {
+    std::map<std::string, Measurement> byDate;
+    for (const auto& m : previous) {
+        byDate.emplace(m.getDate(), m);
+    }
+    std::set<std::string> days;
+    for (const auto& m : measurements) {
+        if (m.getDate().size() < 10) continue;
+        days.insert(m.getDate().substr(0, 10));
+        auto stored = byDate.find(m.getDate());
+        const uint8_t flags = static_cast<uint8_t>(m.getFlags() | (stored != byDate.end() ? stored->second.getFlags() : 0));
+        byDate.erase(m.getDate());
+        byDate.emplace(m.getDate(), Measurement(m.getDate(), m.getValue(), flags));
+    }
+
+    std::map<std::string, QuantileSketch> daily;
+    for (const auto& pair : byDate) {
+        const Measurement& m = pair.second;
+        if (!m.isValid() || m.isSuspect() || m.getDate().size() < 10) continue;
+        const std::string day = m.getDate().substr(0, 10);
+        if (days.count(day)) daily[day].add(m.getValue());
+    }
+
+    if (!dbRoot_["sketches"].isMember(key)) {
+        dbRoot_["sketches"][key] = Json::Value(Json::objectValue);
+    }
+
+    for (const auto& pair : daily) {
+        const QuantileSketch& sketch = pair.second;
+        if (dbRoot_["sketches"][key].isMember(pair.first)) {
+            double storedCount = 0.0;
+            for (const auto& centroid : dbRoot_["sketches"][key][pair.first]["centroids"]) {
+                storedCount += centroid[1].asDouble();
+            }
+            if (storedCount > sketch.getCount()) continue;
+        }
+
+        Json::Value sketchJson;
+        sketchJson["compression"] = sketch.getCompression();
+        sketchJson["min"] = sketch.getMin();
+        sketchJson["max"] = sketch.getMax();
+        sketchJson["centroids"] = Json::Value(Json::arrayValue);
+        for (const auto& c : sketch.getCentroids()) {
+            Json::Value centroid(Json::arrayValue);
+            centroid.append(c.mean);
+            centroid.append(c.weight);
+            sketchJson["centroids"].append(centroid);
+        }
+        dbRoot_["sketches"][key][pair.first] = sketchJson;
+    }
+}
+
+/**
+ * @brief Wczytuje i scala dzienne szkice kwantyli z zadanego zakresu dni.
+ *
+ * @param stationId ID stacji.
+ * @param sensorId ID sensora.
+ * @param fromDay Pierwszy dzień zakresu ("YYYY-MM-DD", włącznie).
+ * @param toDay Ostatni dzień zakresu ("YYYY-MM-DD", włącznie).
+ * @param sketch Referencja do szkicu, do którego zostaną dołączone szkice dzienne.
+ * @return true jeśli znaleziono co najmniej jeden szkic, false w przeciwnym razie.
+ */
+bool DatabaseManager::loadQuantileSketch(int stationId, int sensorId, const std::string& fromDay,
+    const std::string& toDay, QuantileSketch& sketch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::string key = generateKey(stationId, sensorId);
+    if (!dbRoot_["sketches"].isMember(key)) {
+        return false;
+    }
+
+    bool found = false;
+    const Json::Value& days = dbRoot_["sketches"][key];
+    for (auto it = days.begin(); it != days.end(); ++it) {
+        std::string day = it.name();
+        if (day < fromDay || day > toDay) continue;
+
+        std::vector<QuantileSketch::Centroid> centroids;
+        for (const auto& c : (*it)["centroids"]) {
+            centroids.push_back({ c[0].asDouble(), c[1].asDouble() });
+        }
+        sketch.merge(QuantileSketch::fromCentroids((*it)["compression"].asDouble(), centroids,
+            (*it)["min"].asDouble(), (*it)["max"].asDouble()));
+        found = true;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Pobiera zapisane stacje z bazy danych.
+ *
+ * @return Wektor par: ID stacji i nazwa stacji.
+ */
+std::vector<Station> DatabaseManager::getSavedStations() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::vector<Station> stations;
+    const Json::Value& stationsJson = dbRoot_["stations"];
+
+    for (auto it = stationsJson.begin(); it != stationsJson.end(); ++it) {
+        int id = std::stoi(it.name());
+        std::string name = (*it)["name"].asString();
+
+        // Położenie i dane administracyjne z katalogu (jeśli był zapisany)
+        const Json::Value& catalog = dbRoot_["catalog"];
+        if (catalog.isMember(it.name())) {
+            stations.push_back(stationFromJson(id, catalog[it.name()]));
+            continue;
+        }
+
+        // Tworzymy obiekt Station bezpośrednio
+        stations.emplace_back(id, name);
+    }
+
+    return stations;
+}
+
+/**
+ * @brief Zapisuje katalog stacji do lokalnej bazy.
+ *
+ * @param stations Lista stacji.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool DatabaseManager::saveStationCatalog(const std::vector<Station>& stations) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    Json::Value catalog(Json::objectValue);
+    for (const auto& station : stations) {
+        Json::Value entry;
+        entry["name"] = station.getName();
+        if (station.hasLocation()) {
+            entry["lat"] = station.getLatitude();
+            entry["lon"] = station.getLongitude();
+        }
+        entry["city"] = station.getCity();
+        entry["commune"] = station.getCommune();
+        entry["district"] = station.getDistrict();
+        entry["province"] = station.getProvince();
+        entry["address"] = station.getAddress();
+        catalog[std::to_string(station.getId())] = entry;
+    }
+
+    dbRoot_["catalog"] = catalog;
+    return saveDatabase();
+}
+
+/**
+ * @brief Zwraca katalog stacji zapisany w bazie.
+ *
+ * @return Wektor stacji z położeniem.
+ */
+std::vector<Station> DatabaseManager::getStationCatalog() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::vector<Station> stations;
+    const Json::Value& catalog = dbRoot_["catalog"];
+    for (auto it = catalog.begin(); it != catalog.end(); ++it) {
+        stations.push_back(stationFromJson(std::stoi(it.name()), *it));
+    }
+    return stations;
+}
+
+/**
+ * @brief Odtwarza stację z wpisu katalogu.
+ *
+ * @param id ID stacji.
+ * @param json Wpis katalogu.
+ * @return Obiekt Station.
+ */
+Station DatabaseManager::stationFromJson(int id, const Json::Value& json) {
+    double latitude = json.isMember("lat") ? json["lat"].asDouble() : NAN;
+    double longitude = json.isMember("lon") ? json["lon"].asDouble() : NAN;
+    return Station(id, json["name"].asString(), latitude, longitude, json["city"].asString(),
+        json["commune"].asString(), json["district"].asString(), json["province"].asString(),
+        json["address"].asString());
+}
+
+/**
+ * @brief Pobiera zapisane sensory przypisane do danej stacji.
+ *
+ * @param stationId ID stacji.
+ * @return Wektor par: ID sensora i nazwa sensora.
+ */
+std::vector<Sensor> DatabaseManager::getSavedSensors(int stationId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::vector<Sensor> sensors;
+    std::string stationIdStr = std::to_string(stationId);
+
+    if (dbRoot_["stations"].isMember(stationIdStr)) {
+        const Json::Value& stationJson = dbRoot_["stations"][stationIdStr];
+        const Json::Value& sensorsJson = stationJson["sensors"];
+        const Json::Value& formulasJson = stationJson["formulas"];
+
+        for (auto it = sensorsJson.begin(); it != sensorsJson.end(); ++it) {
+            int id = std::stoi(it.name());
+            std::string name = (*it).asString();
+            // Wzór chemiczny jest zapisywany od niedawna - dla starszych wpisów pozostaje pusty
+            std::string formula = formulasJson.isMember(it.name()) ? formulasJson[it.name()].asString() : "";
+            sensors.emplace_back(id, name, formula);
+        }
+    }
+
+    return sensors;
+}
+
+
+
+
+/**
+ * @brief Wczytuje indeks jakości powietrza dla stacji.
+ *
+ * @param stationId ID stacji.
+ * @param indexValues Referencja do mapy, do której zostaną załadowane indeksy.
+ * @return true jeśli dane zostały odnalezione i wczytane, false w przeciwnym razie.
+ */
+bool DatabaseManager::loadAirQualityIndex(int stationId, std::map<std::string, std::string>& indexValues) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ensureLoaded();
+
+    std::string key = "index_" + std::to_string(stationId);
+
+    if (!dbRoot_["indexes"].isObject() || !dbRoot_["indexes"].isMember(key)) {
+        return false;
+    }
+
+    const Json::Value& indexJson = dbRoot_["indexes"][key];
+    for (auto it = indexJson.begin(); it != indexJson.end(); ++it) {
+        indexValues[it.name()] = (*it).asString();
+    }
+
+    return !indexValues.empty();
 }
\ No newline at end of file
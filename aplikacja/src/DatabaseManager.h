@@ -1,106 +1,181 @@
-#pragma once
-
-#include <string>
-#include <vector>
-#include "Measurement.h"
-#include "Sensor.h"
-#include "Station.h"
-#include <json/json.h>
-#include <fstream>
-
-/**
- * @file DatabaseManager.h
- * @brief Klasa odpowiedzialna za zarzdzanie lokaln baz danych w formacie JSON.
- *
- * Umoliwia zapisywanie i wczytywanie danych pomiarowych, stacji oraz sensorw.
- */
-class DatabaseManager {
-public:
-    /**
-     * @brief Konstruktor klasy DatabaseManager.
-     *
-     * @param dbFilePath cieka do pliku bazy danych JSON (domylnie "air_qualitydata.json").
-     */
-    DatabaseManager(const std::string& dbFilePath = "air_qualitydata.json");
-
-    /**
- * @brief Zapisuje pomiary i opcjonalnie indeksy jakoci powietrza do lokalnej bazy (JSON).
- *
- * @param stationId    ID stacji.
- * @param stationName  Nazwa stacji.
- * @param sensorId     ID sensora.
- * @param sensorName   Nazwa sensora.
- * @param measurements Wektor pomiarw do zapisania.
- * @param indexValues  (opcjonalnie) Mapa indeksw jakoci powietrza, gdzie kluczem jest
- *                     nazwa indeksu (np. "Oglny"), a wartoci opis (np. "Dobry").
- * @return true jeli zapis danych i indeksw zakoczy si sukcesem, false w przeciwnym razie.
- */
-    bool saveData(int stationId, const std::string& stationName,
-        int sensorId, const std::string& sensorName,
-        const std::vector<Measurement>& measurements,
-        const std::map<std::string, std::string>& indexValues = std::map<std::string, std::string>());
-
-    /**
-     * @brief Wczytuje dane pomiarowe z lokalnej bazy danych.
-     *
-     * @param stationId ID stacji.
-     * @param sensorId ID sensora.
-     * @param measurements Referencja do wektora, do ktrego zostan zaadowane dane.
-     * @return true jeli dane zostay poprawnie wczytane, false w przeciwnym razie.
-     */
-    bool loadData(int stationId, int sensorId, std::vector<Measurement>& measurements);
-
-    /**
-     * @brief Zwraca list zapisanych stacji w bazie danych.
-     *
-     * @return Wektor par <ID stacji, nazwa stacji>.
-     */
-    std::vector<Station>  getSavedStations();
-
-    /**
-     * @brief Zwraca list zapisanych sensorw dla danej stacji.
-     *
-     * @param stationId ID stacji.
-     * @return Wektor par <ID sensora, nazwa sensora>.
-     */
-    std::vector<Sensor> getSavedSensors(int stationId);
-    
-   
-
-        /**
-         * @brief Wczytuje indeks jakoci powietrza dla stacji.
-         *
-         * @param stationId ID stacji.
-         * @param indexValues Referencja do mapy, do ktrej zostan zaadowane indeksy.
-         * @return true jeli dane zostay odnalezione i wczytane, false w przeciwnym razie.
-         */
-        bool loadAirQualityIndex(int stationId, std::map<std::string, std::string>& indexValues);
-private:
-    std::string dbFilePath_;   ///< cieka do pliku bazy danych JSON.
-    Json::Value dbRoot_;       ///< Struktura przechowujca dane bazy w pamici.
-
-    /**
-     * @brief aduje baz danych z pliku.
-     *
-     * @return true jeli plik zosta poprawnie zaadowany, false w przeciwnym razie.
-     */
-    bool loadDatabase();
-
-    /**
-     * @brief Zapisuje aktualn zawarto bazy danych do pliku.
-     *
-     * @return true jeli zapis si powid, false w przeciwnym razie.
-     */
-    bool saveDatabase();
-
-    /**
-     * @brief Generuje unikalny klucz identyfikujcy dane sensora w danej stacji.
-     *
-     * @param stationId ID stacji.
-     * @param sensorId ID sensora.
-     * @return Klucz jako string.
-     */
-    std::string generateKey(int stationId, int sensorId);
-
-   
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Measurement.h"
+#include "MeasurementSeries.h"
+#include "QuantileSketch.h"
+#include "Sensor.h"
+#include "Station.h"
+#include <json/json.h>
+#include <fstream>
+
+/**
+ * @file DatabaseManager.h
+ * @brief Klasa odpowiedzialna za zarządzanie lokalną bazą danych w formacie JSON.
+ *
+ * Umożliwia zapisywanie i wczytywanie danych pomiarowych, stacji oraz sensorów.
+ * Metody publiczne są bezpieczne wątkowo (wspólna blokada), więc z bazy mogą korzystać
+ * wątki robocze; plik jest wczytywany przy pierwszym użyciu.
+ */
+class DatabaseManager {
+public:
+    /**
+     * @brief Konstruktor klasy DatabaseManager.
+     *
+     * @param dbFilePath Ścieżka do pliku bazy danych JSON (domyślnie "air_qualitydata.json").
+     */
+    DatabaseManager(const std::string& dbFilePath = "air_qualitydata.json");
+
+    /**
+ * @brief Zapisuje pomiary i opcjonalnie indeksy jakości powietrza do lokalnej bazy (JSON).
+ *
+ * @param stationId    ID stacji.
+ * @param stationName  Nazwa stacji.
+ * @param sensorId     ID sensora.
+ * @param sensorName   Nazwa sensora.
+ * @param measurements Wektor pomiarów do zapisania.
+ * @param indexValues  (opcjonalnie) Mapa indeksów jakości powietrza, gdzie kluczem jest
+ *                     nazwa indeksu (np. "Ogólny"), a wartością opis (np. "Dobry").
+ * @param sensorFormula (opcjonalnie) Wzór wskaźnika (np. "PM10"), potrzebny do doboru norm w trybie offline.
+ * @return true jeśli zapis danych i indeksów zakończył się sukcesem, false w przeciwnym razie.
+ */
+    bool saveData(int stationId, const std::string& stationName,
+        int sensorId, const std::string& sensorName,
+        const std::vector<Measurement>& measurements,
+        const std::map<std::string, std::string>& indexValues = std::map<std::string, std::string>(),
+        const std::string& sensorFormula = "");
+
+    /**
+     * @brief Wczytuje dane pomiarowe z lokalnej bazy danych.
+     *
+     * @param stationId ID stacji.
+     * @param sensorId ID sensora.
+     * @param measurements Referencja do wektora, do którego zostaną załadowane dane.
+     * @return true jeśli dane zostały poprawnie wczytane, false w przeciwnym razie.
+     */
+    bool loadData(int stationId, int sensorId, std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Wczytuje dane pomiarowe bezpośrednio do serii kolumnowej.
+     *
+     * @param stationId ID stacji.
+     * @param sensorId ID sensora.
+     * @param series Referencja do serii, do której zostaną załadowane dane (rosnąco po czasie).
+     * @return true jeśli dane zostały poprawnie wczytane, false w przeciwnym razie.
+     */
+    bool loadSeries(int stationId, int sensorId, MeasurementSeries& series);
+
+    /**
+     * @brief Zwraca listę zapisanych stacji w bazie danych.
+     *
+     * @return Wektor par <ID stacji, nazwa stacji>.
+     */
+    std::vector<Station>  getSavedStations();
+
+    /**
+     * @brief Zwraca listę zapisanych sensorów dla danej stacji.
+     *
+     * @param stationId ID stacji.
+     * @return Wektor par <ID sensora, nazwa sensora>.
+     */
+    std::vector<Sensor> getSavedSensors(int stationId);
+
+    /**
+     * @brief Zapisuje katalog stacji (położenie i dane administracyjne) do lokalnej bazy.
+     *
+     * Katalog pozwala korzystać z wyszukiwania przestrzennego również w trybie offline.
+     *
+     * @param stations Lista stacji (np. z ApiClient::getStations).
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    bool saveStationCatalog(const std::vector<Station>& stations);
+
+    /**
+     * @brief Zwraca katalog stacji zapisany w bazie.
+     *
+     * @return Wektor stacji z położeniem (pusty, jeśli katalog nie był zapisany).
+     */
+    std::vector<Station> getStationCatalog();
+    
+   
+
+        /**
+         * @brief Wczytuje indeks jakości powietrza dla stacji.
+         *
+         * @param stationId ID stacji.
+         * @param indexValues Referencja do mapy, do której zostaną załadowane indeksy.
+         * @return true jeśli dane zostały odnalezione i wczytane, false w przeciwnym razie.
+         */
+        bool loadAirQualityIndex(int stationId, std::map<std::string, std::string>& indexValues);
+    /**
+     * @brief Wczytuje i scala dzienne szkice kwantyli sensora z zadanego zakresu dni.
+     *
+     * Szkice są tworzone automatycznie przy każdym zapisie danych (saveData), po jednym na dzień,
+     * więc np. roczne percentyle można wyznaczyć bez wczytywania i sortowania całej historii.
+     *
+     * @param stationId ID stacji.
+     * @param sensorId ID sensora.
+     * @param fromDay Pierwszy dzień zakresu ("YYYY-MM-DD", włącznie).
+     * @param toDay Ostatni dzień zakresu ("YYYY-MM-DD", włącznie).
+     * @param sketch Referencja do szkicu, do którego zostaną dołączone szkice dzienne.
+     * @return true jeśli znaleziono co najmniej jeden szkic, false w przeciwnym razie.
+     */
+    bool loadQuantileSketch(int stationId, int sensorId, const std::string& fromDay,
+        const std::string& toDay, QuantileSketch& sketch);
+private:
+    std::string dbFilePath_;   ///< Ścieżka do pliku bazy danych JSON.
+    Json::Value dbRoot_;       ///< Struktura przechowująca dane bazy w pamięci.
+    bool loaded_;              ///< Czy plik bazy został już wczytany.
+    std::mutex mutex_;         ///< Blokada chroniąca dbRoot_ i plik bazy.
+
+    /**
+     * @brief Wczytuje bazę przy pierwszym użyciu (wywoływane pod blokadą mutex_).
+     */
+    void ensureLoaded();
+
+    /**
+     * @brief Ładuje bazę danych z pliku.
+     *
+     * @return true jeśli plik został poprawnie załadowany, false w przeciwnym razie.
+     */
+    bool loadDatabase();
+
+    /**
+     * @brief Zapisuje aktualną zawartość bazy danych do pliku.
+     *
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    bool saveDatabase();
+
+    /**
+     * @brief Generuje unikalny klucz identyfikujący dane sensora w danej stacji.
+     *
+     * @param stationId ID stacji.
+     * @param sensorId ID sensora.
+     * @return Klucz jako string.
+     */
+    std::string generateKey(int stationId, int sensorId);
+
+    /**
+     * @brief Odtwarza stację z wpisu katalogu.
+     *
+     * @param id ID stacji.
+     * @param json Wpis katalogu.
+     * @return Obiekt Station.
+     */
+    static Station stationFromJson(int id, const Json::Value& json);
+
+    /**
+     * @brief Tworzy szkice kwantyli dla każdego dnia z pomiarów i zapisuje je w strukturze bazy.
+     *
+     * @param key Klucz danych sensora.
+     * @param measurements Pomiary do podziału na dni.
+     * @param previous Pomiary sensora zapisane przed bieżącym zapisem (uzupełniają dni brzegowe).
+     */
+    void saveDailySketches(const std::string& key, const std::vector<Measurement>& measurements,
+        const std::vector<Measurement>& previous);
+
+   
 };
\ No newline at end of file
@@ -0,0 +1,228 @@
+/**
+ * @file ExceedanceEngine.cpp
+ * @brief Implementacja zliczania przekroczeń norm dla wszystkich stacji i wskaźników.
+ */
+
+#include "ExceedanceEngine.h"
+#include "RollingWindow.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+
+namespace {
+
+/// Minimalna liczba godzin w dobie, przy której średnia dobowa jest ważna (75% z 24).
+const size_t MIN_HOURS_PER_DAY = 18;
+
+/**
+ * @brief Okres (godzina lub doba) z wartością uśrednioną.
+ */
+struct Period {
+    int64_t start; ///< Początek okresu.
+    double value;  ///< Wartość uśredniona.
+};
+
+/**
+ * @brief Wyznacza okresy z ważną wartością zgodnie ze sposobem uśredniania progu.
+ *
+ * @param series Pomiary (rosnąco po czasie).
+ * @param averaging Sposób uśredniania.
+ * @param periods Wektor, do którego zostaną zapisane okresy.
+ * @return Długość okresu w sekundach.
+ */
+int64_t buildPeriods(const MeasurementSeries& series, ExceedanceEngine::Averaging averaging, std::vector<Period>& periods) {
+    const auto& timestamps = series.getTimestamps();
+    const auto& values = series.getValues();
+
+    switch (averaging) {
+    case ExceedanceEngine::Averaging::HOURLY:
+        periods.reserve(series.size());
+        for (size_t i = 0; i < series.size(); i++) {
+            if (values[i] >= 0) periods.push_back({ timestamps[i], values[i] });
+        }
+        return 3600;
+
+    case ExceedanceEngine::Averaging::DAILY_MEAN: {
+        size_t i = 0;
+        while (i < series.size()) {
+            int64_t day = MeasurementSeries::startOfDay(timestamps[i]);
+            double sum = 0.0;
+            size_t count = 0;
+            for (; i < series.size() && MeasurementSeries::startOfDay(timestamps[i]) == day; i++) {
+                if (values[i] < 0) continue;
+                sum += values[i];
+                count++;
+            }
+            if (count >= MIN_HOURS_PER_DAY) periods.push_back({ day, sum / count });
+        }
+        return 86400;
+    }
+
+    case ExceedanceEngine::Averaging::DAILY_MAX_8H: {
+        RollingWindow window = RollingWindow::mean8h();
+        MeasurementSeries daily = window.dailyMaxima(window.compute(series));
+        for (size_t i = 0; i < daily.size(); i++) {
+            if (daily.getValues()[i] >= 0) periods.push_back({ daily.getTimestamps()[i], daily.getValues()[i] });
+        }
+        return 86400;
+    }
+    }
+    return 3600;
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor klasy ExceedanceEngine.
+ *
+ * @param dbManager Referencja do menedżera bazy danych.
+ * @param thresholds Tabela progów.
+ */
+ExceedanceEngine::ExceedanceEngine(DatabaseManager& dbManager, const ThresholdTable& thresholds)
+    : dbManager_(dbManager), thresholds_(thresholds) {
+}
+
+/**
+ * @brief Zwraca progi według dyrektywy 2008/50/WE.
+ *
+ * Dla każdego wskaźnika wybrano normę krótkoterminową; PM2.5 ma w dyrektywie tylko normę roczną.
+ *
+ * @return Tabela progów UE.
+ */
+ExceedanceEngine::ThresholdTable ExceedanceEngine::euThresholds() {
+    ThresholdTable table;
+    table["PM10"] = { 50.0, Averaging::DAILY_MEAN, 35 };
+    table["NO2"] = { 200.0, Averaging::HOURLY, 18 };
+    table["SO2"] = { 350.0, Averaging::HOURLY, 24 };
+    table["O3"] = { 120.0, Averaging::DAILY_MAX_8H, 25 };
+    table["CO"] = { 10000.0, Averaging::DAILY_MAX_8H, -1 };
+    return table;
+}
+
+/**
+ * @brief Zwraca progi krótkoterminowe według wytycznych WHO z 2021 roku.
+ *
+ * Wytyczne dopuszczają 3-4 dni z przekroczeniem w roku (99. percentyl).
+ *
+ * @return Tabela progów WHO.
+ */
+ExceedanceEngine::ThresholdTable ExceedanceEngine::whoThresholds() {
+    ThresholdTable table;
+    table["PM10"] = { 45.0, Averaging::DAILY_MEAN, 3 };
+    table["PM2.5"] = { 15.0, Averaging::DAILY_MEAN, 3 };
+    table["NO2"] = { 25.0, Averaging::DAILY_MEAN, 3 };
+    table["SO2"] = { 40.0, Averaging::DAILY_MEAN, 3 };
+    table["O3"] = { 100.0, Averaging::DAILY_MAX_8H, 3 };
+    table["CO"] = { 4000.0, Averaging::DAILY_MEAN, 3 };
+    return table;
+}
+
+/**
+ * @brief Ustawia tabelę progów.
+ *
+ * @param thresholds Nowa tabela progów.
+ */
+void ExceedanceEngine::setThresholds(const ThresholdTable& thresholds) {
+    thresholds_ = thresholds;
+}
+
+/**
+ * @brief Ocenia wszystkie serie zapisane w bazie, dla których istnieje próg.
+ *
+ * @param from Początek zakresu czasu (włącznie).
+ * @param to Koniec zakresu czasu (wyłącznie).
+ * @return Wyniki dla każdej pary stacja-sensor.
+ */
+std::vector<ExceedanceEngine::Result> ExceedanceEngine::evaluateAll(int64_t from, int64_t to) {
+    std::vector<Input> inputs;
+    for (const auto& station : dbManager_.getSavedStations()) {
+        for (const auto& sensor : dbManager_.getSavedSensors(station.getId())) {
+            if (!thresholds_.count(sensor.getParamFormula())) continue;
+
+            MeasurementSeries series;
+            if (!dbManager_.loadSeries(station.getId(), sensor.getId(), series)) continue;
+
+            inputs.push_back({ station.getId(), sensor.getId(), sensor.getParamFormula(), series.slice(from, to) });
+        }
+    }
+    return evaluate(inputs);
+}
+
+/**
+ * @brief Ocenia podane serie równolegle.
+ *
+ * Wątki pobierają kolejne serie ze wspólnego licznika, więc długie serie nie blokują pozostałych.
+ *
+ * @param inputs Serie do oceny.
+ * @return Wyniki dla serii, dla których istnieje próg.
+ */
+std::vector<ExceedanceEngine::Result> ExceedanceEngine::evaluate(const std::vector<Input>& inputs) const {
+    std::vector<const Input*> selected;
+    for (const auto& input : inputs) {
+        if (thresholds_.count(input.formula)) selected.push_back(&input);
+    }
+
+    std::vector<Result> results(selected.size());
+    if (selected.empty()) return results;
+
+    TaskScheduler::shared().parallelFor(selected.size(), [&](size_t i) {
+        const Input& input = *selected[i];
+        Result& result = results[i];
+        result.stationId = input.stationId;
+        result.sensorId = input.sensorId;
+        result.formula = input.formula;
+        evaluateSeries(input.series, thresholds_.at(input.formula), result);
+    });
+
+    return results;
+}
+
+/**
+ * @brief Ocenia jedną serię względem progu.
+ *
+ * Epizod to ciąg bezpośrednio po sobie następujących okresów z przekroczeniem;
+ * okres bez ważnej wartości przerywa epizod.
+ *
+ * @param series Pomiary (rosnąco po czasie).
+ * @param threshold Próg normy.
+ * @param result Referencja do wyniku.
+ */
+void ExceedanceEngine::evaluateSeries(const MeasurementSeries& series, const Threshold& threshold, Result& result) {
+    result.evaluatedPeriods = 0;
+    result.exceedances = 0;
+    result.firstExceedance = 0;
+    result.lastExceedance = 0;
+    result.longestEpisodeStart = 0;
+    result.longestEpisode = 0;
+    result.maxValue = -1.0;
+
+    std::vector<Period> periods;
+    const int64_t step = buildPeriods(series, threshold.averaging, periods);
+
+    int64_t episodeStart = 0;
+    size_t episodeLength = 0;
+    for (const auto& period : periods) {
+        result.evaluatedPeriods++;
+        result.maxValue = std::max(result.maxValue, period.value);
+
+        if (!(period.value > threshold.limit)) {
+            episodeLength = 0;
+            continue;
+        }
+
+        if (result.exceedances == 0) result.firstExceedance = period.start;
+        if (episodeLength > 0 && result.lastExceedance + step == period.start) {
+            episodeLength++;
+        }
+        else {
+            episodeStart = period.start;
+            episodeLength = 1;
+        }
+        if (episodeLength > result.longestEpisode) {
+            result.longestEpisode = episodeLength;
+            result.longestEpisodeStart = episodeStart;
+        }
+
+        result.exceedances++;
+        result.lastExceedance = period.start;
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "DatabaseManager.h"
+#include "MeasurementSeries.h"
+
+/**
+ * @file ExceedanceEngine.h
+ * @brief Zliczanie przekroczeń norm (UE/WHO) dla wszystkich zapisanych stacji i wskaźników.
+ *
+ * Progi są przechowywane w tabeli, której kluczem jest wzór wskaźnika (Sensor::getParamFormula).
+ * Każdy próg określa sposób uśredniania (wartości godzinowe, średnia dobowa lub dobowe maksimum
+ * średniej 8-godzinnej). Serie są oceniane równolegle na wszystkich rdzeniach procesora.
+ */
+class ExceedanceEngine {
+public:
+    /**
+     * @brief Sposób uśredniania pomiarów przed porównaniem z progiem.
+     */
+    enum class Averaging {
+        HOURLY,       ///< Każdy pomiar godzinowy osobno.
+        DAILY_MEAN,   ///< Średnia z doby kalendarzowej.
+        DAILY_MAX_8H  ///< Maksimum dobowe średnich kroczących 8-godzinnych.
+    };
+
+    /**
+     * @brief Próg normy dla wskaźnika.
+     */
+    struct Threshold {
+        double limit;         ///< Wartość progowa (przekroczenie, gdy wartość > limit).
+        Averaging averaging;  ///< Sposób uśredniania.
+        int allowedPerYear;   ///< Dopuszczalna liczba przekroczeń w roku (-1 gdy norma jej nie określa).
+    };
+
+    /**
+     * @brief Tabela progów - kluczem jest wzór wskaźnika (np. "PM10").
+     */
+    using ThresholdTable = std::map<std::string, Threshold>;
+
+    /**
+     * @brief Seria do oceny wraz z identyfikacją stacji i wskaźnika.
+     */
+    struct Input {
+        int stationId;            ///< ID stacji.
+        int sensorId;             ///< ID sensora.
+        std::string formula;      ///< Wzór wskaźnika.
+        MeasurementSeries series; ///< Pomiary (rosnąco po czasie).
+    };
+
+    /**
+     * @brief Wynik oceny jednej serii.
+     *
+     * Okresem jest godzina lub doba, zależnie od sposobu uśredniania progu.
+     */
+    struct Result {
+        int stationId;              ///< ID stacji.
+        int sensorId;               ///< ID sensora.
+        std::string formula;        ///< Wzór wskaźnika.
+        size_t evaluatedPeriods;    ///< Liczba okresów z ważną wartością.
+        size_t exceedances;         ///< Liczba okresów z przekroczeniem.
+        int64_t firstExceedance;    ///< Początek pierwszego okresu z przekroczeniem (0 gdy brak).
+        int64_t lastExceedance;     ///< Początek ostatniego okresu z przekroczeniem (0 gdy brak).
+        int64_t longestEpisodeStart;///< Początek najdłuższego epizodu (kolejnych okresów z przekroczeniem).
+        size_t longestEpisode;      ///< Długość najdłuższego epizodu w okresach.
+        double maxValue;            ///< Największa wartość uśredniona (-1.0 gdy brak danych).
+    };
+
+    /**
+     * @brief Konstruktor klasy ExceedanceEngine.
+     *
+     * @param dbManager Referencja do menedżera bazy danych (źródło zapisanych serii).
+     * @param thresholds Tabela progów (domyślnie normy UE).
+     */
+    explicit ExceedanceEngine(DatabaseManager& dbManager, const ThresholdTable& thresholds = euThresholds());
+
+    /**
+     * @brief Zwraca progi według dyrektywy 2008/50/WE (wartości w µg/m3).
+     *
+     * @return Tabela progów UE.
+     */
+    static ThresholdTable euThresholds();
+
+    /**
+     * @brief Zwraca progi krótkoterminowe według wytycznych WHO z 2021 roku (wartości w µg/m3).
+     *
+     * @return Tabela progów WHO.
+     */
+    static ThresholdTable whoThresholds();
+
+    /**
+     * @brief Ustawia tabelę progów.
+     *
+     * @param thresholds Nowa tabela progów.
+     */
+    void setThresholds(const ThresholdTable& thresholds);
+
+    /**
+     * @brief Zwraca bieżącą tabelę progów.
+     *
+     * @return Tabela progów.
+     */
+    const ThresholdTable& getThresholds() const { return thresholds_; }
+
+    /**
+     * @brief Ocenia wszystkie serie zapisane w bazie, dla których istnieje próg.
+     *
+     * Serie są wczytywane sekwencyjnie (baza nie jest bezpieczna wielowątkowo), a oceniane równolegle.
+     *
+     * @param from Początek zakresu czasu (włącznie).
+     * @param to Koniec zakresu czasu (wyłącznie).
+     * @return Wyniki dla każdej pary stacja-sensor.
+     */
+    std::vector<Result> evaluateAll(int64_t from = INT64_MIN, int64_t to = INT64_MAX);
+
+    /**
+     * @brief Ocenia podane serie równolegle.
+     *
+     * Serie bez progu dla swojego wzoru są pomijane.
+     *
+     * @param inputs Serie do oceny.
+     * @return Wyniki w kolejności serii wejściowych.
+     */
+    std::vector<Result> evaluate(const std::vector<Input>& inputs) const;
+
+    /**
+     * @brief Ocenia jedną serię względem progu.
+     *
+     * @param series Pomiary (rosnąco po czasie).
+     * @param threshold Próg normy.
+     * @param result Referencja do wyniku (pola statystyk zostaną wypełnione).
+     */
+    static void evaluateSeries(const MeasurementSeries& series, const Threshold& threshold, Result& result);
+
+private:
+    DatabaseManager& dbManager_; ///< Źródło zapisanych serii.
+    ThresholdTable thresholds_;  ///< Tabela progów.
+};
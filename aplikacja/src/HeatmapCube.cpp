@@ -0,0 +1,114 @@
+/**
+ * @file HeatmapCube.cpp
+ * @brief Implementacja kostki agregatów dzień × godzina.
+ */
+
+#include "HeatmapCube.h"
+#include <algorithm>
+
+/**
+ * @brief Tworzy pustą kostkę.
+ */
+HeatmapCube::HeatmapCube()
+    : firstDay_(0), dayCount_(0), valueCount_(0), minValue_(0.0), maxValue_(0.0) {
+}
+
+/**
+ * @brief Tworzy kostkę z serii.
+ *
+ * @param series Seria uporządkowana według czasu.
+ */
+HeatmapCube::HeatmapCube(const MeasurementSeries& series) : HeatmapCube() {
+    build(series);
+}
+
+/**
+ * @brief Buduje kostkę od nowa z serii.
+ *
+ * Jedno przejście po serii zlicza sumy i liczności komórek (w kolumnie dnia d + 1), a drugie
+ * przejście - po gęstej tablicy, nie po serii - zamienia je na sumy prefiksowe i wyznacza zakres
+ * średnich do skali kolorów.
+ *
+ * @param series Seria uporządkowana według czasu.
+ */
+void HeatmapCube::build(const MeasurementSeries& series) {
+    clear();
+    if (series.empty()) return;
+
+    const auto& timestamps = series.getTimestamps();
+    const auto& values = series.getValues();
+    firstDay_ = MeasurementSeries::startOfDay(timestamps.front()) / 86400;
+    const int64_t lastDay = MeasurementSeries::startOfDay(timestamps.back()) / 86400;
+    dayCount_ = static_cast<size_t>(lastDay - firstDay_ + 1);
+
+    sums_.assign(HOURS * (dayCount_ + 1), 0.0);
+    counts_.assign(HOURS * (dayCount_ + 1), 0);
+
+    for (size_t i = 0; i < timestamps.size(); i++) {
+        if (values[i] < 0) continue;
+        const int64_t dayStart = MeasurementSeries::startOfDay(timestamps[i]);
+        const size_t day = static_cast<size_t>(dayStart / 86400 - firstDay_);
+        const int hour = static_cast<int>((timestamps[i] - dayStart) / 3600);
+        sums_[index(day + 1, hour)] += values[i];
+        counts_[index(day + 1, hour)]++;
+        valueCount_++;
+    }
+
+    bool first = true;
+    for (int hour = 0; hour < HOURS; hour++) {
+        for (size_t day = 1; day <= dayCount_; day++) {
+            const size_t cell = index(day, hour);
+            if (counts_[cell] > 0) {
+                const double mean = sums_[cell] / counts_[cell];
+                minValue_ = first ? mean : std::min(minValue_, mean);
+                maxValue_ = first ? mean : std::max(maxValue_, mean);
+                first = false;
+            }
+            sums_[cell] += sums_[cell - 1];
+            counts_[cell] += counts_[cell - 1];
+        }
+    }
+}
+
+/**
+ * @brief Usuwa wszystkie dane.
+ */
+void HeatmapCube::clear() {
+    firstDay_ = 0;
+    dayCount_ = 0;
+    valueCount_ = 0;
+    sums_.clear();
+    counts_.clear();
+    minValue_ = 0.0;
+    maxValue_ = 0.0;
+}
+
+/**
+ * @brief Zwraca średnią godziny w zakresie dni (różnica dwóch sum prefiksowych).
+ *
+ * @param dayBegin Pierwszy dzień zakresu.
+ * @param dayEnd Dzień za ostatnim dniem zakresu.
+ * @param hour Godzina (0-23).
+ * @return Średnia lub -1.0, jeśli w zakresie nie ma pomiarów.
+ */
+double HeatmapCube::getRangeMean(size_t dayBegin, size_t dayEnd, int hour) const {
+    const size_t count = getRangeCount(dayBegin, dayEnd, hour);
+    if (count == 0) return -1.0;
+
+    dayEnd = std::min(dayEnd, dayCount_);
+    return (sums_[index(dayEnd, hour)] - sums_[index(dayBegin, hour)]) / count;
+}
+
+/**
+ * @brief Zwraca liczbę pomiarów godziny w zakresie dni.
+ *
+ * @param dayBegin Pierwszy dzień zakresu.
+ * @param dayEnd Dzień za ostatnim dniem zakresu.
+ * @param hour Godzina (0-23).
+ * @return Liczba pomiarów (0 dla pustego lub niepoprawnego zakresu).
+ */
+size_t HeatmapCube::getRangeCount(size_t dayBegin, size_t dayEnd, int hour) const {
+    dayEnd = std::min(dayEnd, dayCount_);
+    if (dayBegin >= dayEnd || hour < 0 || hour >= HOURS) return 0;
+    return counts_[index(dayEnd, hour)] - counts_[index(dayBegin, hour)];
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MeasurementSeries.h"
+
+/**
+ * @file HeatmapCube.h
+ * @brief Gęsta tablica agregatów dzień × godzina do kalendarzowej mapy ciepła.
+ *
+ * Kostka jest budowana jednym przejściem po serii: każdy punkt trafia do komórki (dzień, godzina),
+ * a następnie sumy i liczności w każdym wierszu godziny są zamieniane na sumy prefiksowe po dniach.
+ * Dzięki temu średnia pojedynczej komórki i średnia dowolnego zakresu dni (kolumna mapy obejmująca
+ * kilka dni przy wieloletnim zakresie) to dwa odczyty z tablicy - O(1) niezależnie od długości serii.
+ * Znaczniki czasu są traktowane jak czas lokalny stacji (tak jak w MeasurementSeries).
+ */
+class HeatmapCube {
+public:
+    /// Liczba godzin w dobie (wierszy mapy).
+    static constexpr int HOURS = 24;
+
+    /**
+     * @brief Tworzy pustą kostkę.
+     */
+    HeatmapCube();
+
+    /**
+     * @brief Tworzy kostkę z serii.
+     *
+     * @param series Seria uporządkowana według czasu (wartości ujemne oznaczają brak pomiaru).
+     */
+    explicit HeatmapCube(const MeasurementSeries& series);
+
+    /**
+     * @brief Buduje kostkę od nowa z serii.
+     *
+     * @param series Seria uporządkowana według czasu.
+     */
+    void build(const MeasurementSeries& series);
+
+    /**
+     * @brief Usuwa wszystkie dane.
+     */
+    void clear();
+
+    /**
+     * @brief Sprawdza, czy kostka nie zawiera żadnego pomiaru.
+     */
+    bool empty() const { return valueCount_ == 0; }
+
+    /**
+     * @brief Zwraca liczbę dni (kolumn) od pierwszego do ostatniego dnia serii.
+     */
+    size_t getDayCount() const { return dayCount_; }
+
+    /**
+     * @brief Zwraca znacznik czasu północy podanego dnia.
+     *
+     * @param day Numer dnia (0 - pierwszy dzień serii).
+     */
+    int64_t getDayTimestamp(size_t day) const { return (firstDay_ + static_cast<int64_t>(day)) * 86400; }
+
+    /**
+     * @brief Zwraca średnią komórki.
+     *
+     * @param day Numer dnia.
+     * @param hour Godzina (0-23).
+     * @return Średnia lub -1.0, jeśli w komórce nie ma pomiarów.
+     */
+    double getMean(size_t day, int hour) const { return getRangeMean(day, day + 1, hour); }
+
+    /**
+     * @brief Zwraca liczbę pomiarów w komórce.
+     *
+     * @param day Numer dnia.
+     * @param hour Godzina (0-23).
+     */
+    size_t getCount(size_t day, int hour) const { return getRangeCount(day, day + 1, hour); }
+
+    /**
+     * @brief Zwraca średnią godziny w zakresie dni [dayBegin, dayEnd).
+     *
+     * @param dayBegin Pierwszy dzień zakresu.
+     * @param dayEnd Dzień za ostatnim dniem zakresu.
+     * @param hour Godzina (0-23).
+     * @return Średnia lub -1.0, jeśli w zakresie nie ma pomiarów.
+     */
+    double getRangeMean(size_t dayBegin, size_t dayEnd, int hour) const;
+
+    /**
+     * @brief Zwraca liczbę pomiarów godziny w zakresie dni [dayBegin, dayEnd).
+     *
+     * @param dayBegin Pierwszy dzień zakresu.
+     * @param dayEnd Dzień za ostatnim dniem zakresu.
+     * @param hour Godzina (0-23).
+     */
+    size_t getRangeCount(size_t dayBegin, size_t dayEnd, int hour) const;
+
+    /**
+     * @brief Zwraca najmniejszą średnią komórki (dolny kraniec skali kolorów).
+     */
+    double getMinValue() const { return minValue_; }
+
+    /**
+     * @brief Zwraca największą średnią komórki (górny kraniec skali kolorów).
+     */
+    double getMaxValue() const { return maxValue_; }
+
+private:
+    /**
+     * @brief Zwraca indeks sumy prefiksowej (godzina, dzień) w tablicach.
+     */
+    size_t index(size_t day, int hour) const { return static_cast<size_t>(hour) * (dayCount_ + 1) + day; }
+
+    int64_t firstDay_;               ///< Numer pierwszego dnia (znacznik czasu / 86400).
+    size_t dayCount_;                ///< Liczba dni.
+    size_t valueCount_;              ///< Liczba pomiarów w kostce.
+    std::vector<double> sums_;       ///< Sumy prefiksowe wartości: HOURS wierszy po dayCount_ + 1 elementów.
+    std::vector<uint32_t> counts_;   ///< Sumy prefiksowe liczby pomiarów (układ jak sums_).
+    double minValue_;                ///< Najmniejsza średnia komórki.
+    double maxValue_;                ///< Największa średnia komórki.
+};
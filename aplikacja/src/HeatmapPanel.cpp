@@ -0,0 +1,318 @@
+/**
+ * @file HeatmapPanel.cpp
+ * @brief Implementacja kalendarzowej mapy ciepła pomiarów.
+ */
+
+#include "HeatmapPanel.h"
+#include "MeasurementSeries.h"
+#include <wx/dcbuffer.h>
+#include <algorithm>
+#include <cstdio>
+
+ /// Tablica zdarzeń wxWidgets
+wxBEGIN_EVENT_TABLE(HeatmapPanel, wxPanel)
+EVT_PAINT(HeatmapPanel::OnPaint)              ///< Obsługa zdarzenia rysowania panelu
+EVT_SIZE(HeatmapPanel::OnSize)                ///< Obsługa zdarzenia zmiany rozmiaru
+EVT_MOTION(HeatmapPanel::OnMotion)            ///< Podpowiedź z wartością komórki
+EVT_LEAVE_WINDOW(HeatmapPanel::OnLeaveWindow) ///< Usunięcie podpowiedzi
+wxEND_EVENT_TABLE()
+
+/**
+ * @brief Konstruktor klasy HeatmapPanel.
+ * @param parent Wskaźnik na okno nadrzędne.
+ */
+HeatmapPanel::HeatmapPanel(wxWindow* parent)
+    : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE),
+    cacheValid(false), hoverColumn(0), hoverHour(-1)
+{
+    SetBackgroundColour(*wxWHITE);
+    SetBackgroundStyle(wxBG_STYLE_PAINT);  // całe tło rysuje OnPaint (wymagane przez wxAutoBufferedPaintDC)
+}
+
+/**
+ * @brief Ustawia dane mapy (buduje kostkę agregatów jednym przejściem po serii).
+ *
+ * @param measurements Pomiary.
+ * @param title Tytuł mapy.
+ */
+void HeatmapPanel::SetData(const std::vector<Measurement>& measurements, const wxString& title)
+{
+    cube.build(MeasurementSeries(measurements));
+    this->title = title;
+    hoverHour = -1;
+    UnsetToolTip();
+    InvalidateCache();
+}
+
+/**
+ * @brief Czyści dane mapy.
+ */
+void HeatmapPanel::ClearData()
+{
+    cube.clear();
+    title.clear();
+    hoverHour = -1;
+    UnsetToolTip();
+    InvalidateCache();
+}
+
+/**
+ * @brief Obsługuje zmianę rozmiaru panelu.
+ * @param event Zdarzenie rozmiaru.
+ */
+void HeatmapPanel::OnSize(wxSizeEvent& event)
+{
+    InvalidateCache();
+    event.Skip();
+}
+
+/**
+ * @brief Unieważnia zapamiętany obraz mapy i zleca odświeżenie panelu.
+ */
+void HeatmapPanel::InvalidateCache()
+{
+    cacheValid = false;
+    Refresh(false);
+}
+
+/**
+ * @brief Zwraca obszar komórek mapy.
+ *
+ * @param size Rozmiar panelu.
+ * @return Prostokąt komórek (marginesy: 50 z lewej, 80 z prawej na skalę, 40 u góry i u dołu).
+ */
+wxRect HeatmapPanel::GetMapArea(const wxSize& size) const
+{
+    return wxRect(50, 40, std::max(0, size.x - 130), std::max(0, size.y - 80));
+}
+
+/**
+ * @brief Zwraca liczbę kolumn mapy - jedna na dzień, ale nie więcej niż pikseli szerokości.
+ *
+ * @param width Szerokość obszaru komórek.
+ * @return Liczba kolumn.
+ */
+size_t HeatmapPanel::GetColumnCount(int width) const
+{
+    return std::min(cube.getDayCount(), static_cast<size_t>(std::max(width, 0)));
+}
+
+/**
+ * @brief Zwraca zakres dni kolumny (przy zagęszczeniu kolumna obejmuje kilka kolejnych dni).
+ *
+ * @param column Numer kolumny.
+ * @param columnCount Liczba kolumn.
+ * @param dayBegin Zmienna na pierwszy dzień.
+ * @param dayEnd Zmienna na dzień za ostatnim.
+ */
+void HeatmapPanel::ColumnDays(size_t column, size_t columnCount, size_t& dayBegin, size_t& dayEnd) const
+{
+    dayBegin = column * cube.getDayCount() / columnCount;
+    dayEnd = (column + 1) * cube.getDayCount() / columnCount;
+}
+
+/**
+ * @brief Wyznacza komórkę mapy pod punktem.
+ *
+ * @param point Punkt we współrzędnych panelu.
+ * @param column Zmienna na numer kolumny.
+ * @param hour Zmienna na godzinę.
+ * @return false jeśli punkt leży poza obszarem komórek lub mapa jest pusta.
+ */
+bool HeatmapPanel::CellAt(const wxPoint& point, size_t& column, int& hour) const
+{
+    wxRect area = GetMapArea(GetClientSize());
+    size_t columnCount = GetColumnCount(area.width);
+    if (cube.empty() || columnCount == 0 || area.height <= 0 || !area.Contains(point)) return false;
+
+    column = static_cast<size_t>(point.x - area.x) * columnCount / area.width;
+    hour = (point.y - area.y) * HeatmapCube::HOURS / area.height;
+    return column < columnCount && hour >= 0 && hour < HeatmapCube::HOURS;
+}
+
+/**
+ * @brief Aktualizuje podpowiedź z wartością komórki pod kursorem.
+ *
+ * Podpowiedź jest zmieniana tylko po przejściu do innej komórki; wartość pochodzi z sum
+ * prefiksowych kostki (O(1)).
+ *
+ * @param event Zdarzenie myszy.
+ */
+void HeatmapPanel::OnMotion(wxMouseEvent& event)
+{
+    event.Skip();
+
+    size_t column;
+    int hour;
+    if (!CellAt(event.GetPosition(), column, hour)) {
+        if (hoverHour >= 0) {
+            hoverHour = -1;
+            UnsetToolTip();
+        }
+        return;
+    }
+    if (column == hoverColumn && hour == hoverHour) return;
+    hoverColumn = column;
+    hoverHour = hour;
+
+    size_t dayBegin, dayEnd;
+    ColumnDays(column, GetColumnCount(GetMapArea(GetClientSize()).width), dayBegin, dayEnd);
+
+    std::string text = MeasurementSeries::formatTimestamp(cube.getDayTimestamp(dayBegin)).substr(0, 10);
+    if (dayEnd - dayBegin > 1) {
+        text += " - " + MeasurementSeries::formatTimestamp(cube.getDayTimestamp(dayEnd - 1)).substr(0, 10);
+    }
+
+    char buffer[96];
+    const double mean = cube.getRangeMean(dayBegin, dayEnd, hour);
+    if (mean < 0) {
+        std::snprintf(buffer, sizeof(buffer), ", godz. %02d:00: brak pomiarów", hour);
+    }
+    else {
+        std::snprintf(buffer, sizeof(buffer), ", godz. %02d:00: %.1f (pomiarów: %zu)", hour, mean,
+            cube.getRangeCount(dayBegin, dayEnd, hour));
+    }
+    SetToolTip(wxString::FromUTF8(text + buffer));
+}
+
+/**
+ * @brief Usuwa podpowiedź po opuszczeniu panelu przez kursor.
+ *
+ * @param event Zdarzenie myszy.
+ */
+void HeatmapPanel::OnLeaveWindow(wxMouseEvent& event)
+{
+    hoverHour = -1;
+    UnsetToolTip();
+    event.Skip();
+}
+
+/**
+ * @brief Zwraca kolor skali (niebieski - żółty - czerwony).
+ *
+ * @param fraction Położenie w skali (0 - minimum, 1 - maksimum).
+ * @return Kolor interpolowany liniowo między punktami skali.
+ */
+wxColour HeatmapPanel::ScaleColour(double fraction)
+{
+    static const unsigned char stops[][3] = {
+        { 49, 54, 149 }, { 116, 173, 209 }, { 255, 255, 191 }, { 244, 109, 67 }, { 165, 0, 38 }
+    };
+    const int last = static_cast<int>(sizeof(stops) / sizeof(stops[0])) - 1;
+
+    const double position = std::min(std::max(fraction, 0.0), 1.0) * last;
+    const int index = std::min(static_cast<int>(position), last - 1);
+    const double t = position - index;
+    auto mix = [&](int channel) {
+        return static_cast<unsigned char>(stops[index][channel] + (stops[index + 1][channel] - stops[index][channel]) * t + 0.5);
+    };
+    return wxColour(mix(0), mix(1), mix(2));
+}
+
+/**
+ * @brief Rysuje mapę do bitmapy cache.
+ *
+ * Komórki trafiają do obrazu o wymiarach kolumny × 24 (jeden piksel na komórkę, wypełniany
+ * bezpośrednio w buforze RGB), który jest skalowany do obszaru mapy bez wygładzania. Koszt
+ * zależy więc od rozmiaru panelu, a nie od liczby dni ani pomiarów.
+ *
+ * @param size Rozmiar panelu.
+ */
+void HeatmapPanel::RenderCache(const wxSize& size)
+{
+    cache.Create(size.x, size.y);
+    wxMemoryDC dc(cache);
+    dc.SetBackground(wxBrush(GetBackgroundColour()));
+    dc.Clear();
+
+    wxRect area = GetMapArea(size);
+    size_t columnCount = GetColumnCount(area.width);
+    if (cube.empty() || columnCount == 0 || area.height < HeatmapCube::HOURS) {
+        dc.DrawText(wxString::FromUTF8("Brak danych do wyświetlenia"), 10, 10);
+        dc.SelectObject(wxNullBitmap);
+        return;
+    }
+
+    // Tytuł
+    dc.SetFont(wxFont(12, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_BOLD));
+    wxSize titleSize = dc.GetTextExtent(title);
+    dc.DrawText(title, (size.x - titleSize.x) / 2, 10);
+    dc.SetFont(wxFont(8, wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL));
+
+    // Komórki
+    const double minValue = cube.getMinValue();
+    const double range = cube.getMaxValue() > minValue ? cube.getMaxValue() - minValue : 1.0;
+    wxImage image(static_cast<int>(columnCount), HeatmapCube::HOURS);
+    unsigned char* pixels = image.GetData();
+    for (size_t column = 0; column < columnCount; column++) {
+        size_t dayBegin, dayEnd;
+        ColumnDays(column, columnCount, dayBegin, dayEnd);
+        for (int hour = 0; hour < HeatmapCube::HOURS; hour++) {
+            const double mean = cube.getRangeMean(dayBegin, dayEnd, hour);
+            wxColour colour = mean < 0 ? wxColour(235, 235, 235) : ScaleColour((mean - minValue) / range);
+            unsigned char* pixel = pixels + (static_cast<size_t>(hour) * columnCount + column) * 3;
+            pixel[0] = colour.Red();
+            pixel[1] = colour.Green();
+            pixel[2] = colour.Blue();
+        }
+    }
+    image.Rescale(area.width, area.height, wxIMAGE_QUALITY_NORMAL);
+    dc.DrawBitmap(wxBitmap(image), area.x, area.y);
+
+    // Oś godzin
+    dc.SetPen(*wxBLACK_PEN);
+    for (int hour = 0; hour <= HeatmapCube::HOURS; hour += 6) {
+        const int y = area.y + hour * area.height / HeatmapCube::HOURS;
+        dc.DrawLine(area.x - 4, y, area.x, y);
+        if (hour < HeatmapCube::HOURS) {
+            wxString label = wxString::Format("%02d:00", hour);
+            wxSize labelSize = dc.GetTextExtent(label);
+            dc.DrawText(label, area.x - labelSize.x - 6, y);
+        }
+    }
+
+    // Oś dni - etykiety co ok. 110 pikseli
+    const int labelCount = std::max(1, area.width / 110);
+    for (int i = 0; i < labelCount; i++) {
+        const int x = area.x + i * area.width / labelCount;
+        size_t dayBegin, dayEnd;
+        ColumnDays(static_cast<size_t>(x - area.x) * columnCount / area.width, columnCount, dayBegin, dayEnd);
+        dc.DrawLine(x, area.GetBottom() + 1, x, area.GetBottom() + 5);
+        dc.DrawText(MeasurementSeries::formatTimestamp(cube.getDayTimestamp(dayBegin)).substr(0, 10), x, area.GetBottom() + 7);
+    }
+
+    // Skala kolorów
+    const int scaleX = area.GetRight() + 15;
+    for (int y = 0; y < area.height; y++) {
+        dc.SetPen(wxPen(ScaleColour(1.0 - static_cast<double>(y) / (area.height - 1))));
+        dc.DrawLine(scaleX, area.y + y, scaleX + 14, area.y + y);
+    }
+    dc.SetPen(*wxBLACK_PEN);
+    dc.SetBrush(*wxTRANSPARENT_BRUSH);
+    dc.DrawRectangle(scaleX, area.y, 14, area.height);
+    dc.DrawText(wxString::Format("%.1f", cube.getMaxValue()), scaleX + 18, area.y);
+    dc.DrawText(wxString::Format("%.1f", minValue), scaleX + 18, area.GetBottom() - dc.GetCharHeight());
+
+    dc.SelectObject(wxNullBitmap);
+}
+
+/**
+ * @brief Obsługuje rysowanie panelu (kopiuje bitmapę cache, tworząc ją w razie potrzeby).
+ *
+ * @param event Zdarzenie rysowania.
+ */
+void HeatmapPanel::OnPaint(wxPaintEvent& event)
+{
+    wxAutoBufferedPaintDC dc(this);
+    wxSize size = GetClientSize();
+    if (size.x <= 0 || size.y <= 0) {
+        return;
+    }
+
+    if (!cacheValid || !cache.IsOk() || cache.GetWidth() != size.x || cache.GetHeight() != size.y) {
+        RenderCache(size);
+        cacheValid = true;
+    }
+
+    dc.DrawBitmap(cache, 0, 0);
+}
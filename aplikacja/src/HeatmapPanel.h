@@ -0,0 +1,132 @@
+#pragma once
+
+#include <wx/wx.h>
+#include <vector>
+#include "Measurement.h"
+#include "HeatmapCube.h"
+
+/**
+ * @file HeatmapPanel.h
+ * @brief Kalendarzowa mapa ciepła pomiarów (dni na osi X, godziny doby na osi Y).
+ *
+ * Panel pokazuje wzorce dobowe i tygodniowe, które na wykresie liniowym giną. Dane pochodzą
+ * z HeatmapCube (gęste sumy prefiksowe dzień × godzina), więc kolor każdej komórki i treść
+ * podpowiedzi pod kursorem to odczyty O(1). Gdy dni jest więcej niż pikseli szerokości, kolumna
+ * mapy obejmuje kilka dni (średnia z zakresu, również O(1)). Mapa jest rysowana do bitmapy tylko
+ * po zmianie danych lub rozmiaru, tak jak w ChartPanel.
+ */
+class HeatmapPanel : public wxPanel {
+public:
+    /**
+     * @brief Konstruktor klasy HeatmapPanel.
+     *
+     * @param parent Wskaźnik na okno nadrzędne.
+     */
+    HeatmapPanel(wxWindow* parent);
+
+    /**
+     * @brief Ustawia dane mapy.
+     *
+     * @param measurements Pomiary (w dowolnej kolejności; niepoprawne są pomijane).
+     * @param title Tytuł mapy.
+     */
+    void SetData(const std::vector<Measurement>& measurements, const wxString& title);
+
+    /**
+     * @brief Czyści dane mapy.
+     */
+    void ClearData();
+
+private:
+    /**
+     * @brief Obsługa zdarzenia rysowania panelu.
+     *
+     * @param event Obiekt zdarzenia rysowania.
+     */
+    void OnPaint(wxPaintEvent& event);
+
+    /**
+     * @brief Obsługa zmiany rozmiaru panelu.
+     *
+     * @param event Obiekt zdarzenia zmiany rozmiaru.
+     */
+    void OnSize(wxSizeEvent& event);
+
+    /**
+     * @brief Aktualizuje podpowiedź z wartością komórki pod kursorem.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnMotion(wxMouseEvent& event);
+
+    /**
+     * @brief Usuwa podpowiedź po opuszczeniu panelu przez kursor.
+     *
+     * @param event Obiekt zdarzenia myszy.
+     */
+    void OnLeaveWindow(wxMouseEvent& event);
+
+    /**
+     * @brief Unieważnia zapamiętany obraz mapy i zleca odświeżenie panelu.
+     */
+    void InvalidateCache();
+
+    /**
+     * @brief Rysuje mapę, osie i skalę kolorów do bitmapy cache.
+     *
+     * @param size Rozmiar panelu.
+     */
+    void RenderCache(const wxSize& size);
+
+    /**
+     * @brief Zwraca obszar komórek mapy (bez marginesów na tytuł, etykiety i skalę).
+     *
+     * @param size Rozmiar panelu.
+     */
+    wxRect GetMapArea(const wxSize& size) const;
+
+    /**
+     * @brief Zwraca liczbę kolumn mapy dla podanej szerokości obszaru.
+     *
+     * @param width Szerokość obszaru komórek w pikselach.
+     */
+    size_t GetColumnCount(int width) const;
+
+    /**
+     * @brief Wyznacza komórkę mapy pod punktem.
+     *
+     * @param point Punkt we współrzędnych panelu.
+     * @param column Zmienna na numer kolumny.
+     * @param hour Zmienna na godzinę.
+     * @return false jeśli punkt leży poza obszarem komórek.
+     */
+    bool CellAt(const wxPoint& point, size_t& column, int& hour) const;
+
+    /**
+     * @brief Zwraca zakres dni [dayBegin, dayEnd) kolumny mapy.
+     *
+     * @param column Numer kolumny.
+     * @param columnCount Liczba kolumn.
+     * @param dayBegin Zmienna na pierwszy dzień.
+     * @param dayEnd Zmienna na dzień za ostatnim.
+     */
+    void ColumnDays(size_t column, size_t columnCount, size_t& dayBegin, size_t& dayEnd) const;
+
+    /**
+     * @brief Zwraca kolor skali dla położenia w zakresie wartości.
+     *
+     * @param fraction Położenie w skali (0 - minimum, 1 - maksimum).
+     */
+    static wxColour ScaleColour(double fraction);
+
+    HeatmapCube cube;     ///< Agregaty dzień × godzina.
+    wxString title;       ///< Tytuł mapy.
+
+    wxBitmap cache;       ///< Zapamiętany obraz mapy (odświeżany po zmianie danych lub rozmiaru).
+    bool cacheValid;      ///< Czy obraz w cache odpowiada bieżącym danym i rozmiarowi.
+
+    size_t hoverColumn;   ///< Kolumna, dla której ustawiono podpowiedź.
+    int hoverHour;        ///< Godzina, dla której ustawiono podpowiedź (-1 - brak podpowiedzi).
+
+    wxDECLARE_EVENT_TABLE();  ///< Makro do deklaracji tablicy zdarzeń wxWidgets.
+};
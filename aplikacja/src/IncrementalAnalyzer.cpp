@@ -0,0 +1,288 @@
+/**
+ * @file IncrementalAnalyzer.cpp
+ * @brief Implementacja strumieniowej analizy pomiarów z aktualizacją w czasie stałym.
+ */
+
+#include "IncrementalAnalyzer.h"
+#include <cstdint>
+
+/**
+ * @brief Konstruktor klasy IncrementalAnalyzer.
+ *
+ * @param windowSeconds Długość okna przesuwnego w sekundach (0 - bez okna).
+ */
+IncrementalAnalyzer::IncrementalAnalyzer(int64_t windowSeconds)
+    : windowSeconds_(windowSeconds), origin_(0), lastTimestamp_(INT64_MIN), removalsSinceRecompute_(0),
+    meanX_(0.0), meanY_(0.0), m2x_(0.0), m2y_(0.0), cxy_(0.0) {
+}
+
+/**
+ * @brief Dodaje nowy pomiar i przesuwa okno.
+ *
+ * Koszt zamortyzowany O(1): każdy punkt jest dodawany i usuwany z każdej kolejki co najwyżej raz.
+ *
+ * @param timestamp Znacznik czasu pomiaru w sekundach.
+ * @param value Wartość pomiaru.
+ * @return true jeśli punkt został dodany.
+ */
+bool IncrementalAnalyzer::push(int64_t timestamp, double value) {
+    if (timestamp < lastTimestamp_) {
+        return false;
+    }
+    lastTimestamp_ = timestamp;
+
+    if (windowSeconds_ > 0) {
+        evictBefore(timestamp - windowSeconds_ + 1);
+    }
+
+    // Brak pomiaru przesuwa okno, ale nie trafia do statystyk
+    if (!(value >= 0)) {
+        return false;
+    }
+
+    if (points_.empty()) {
+        origin_ = timestamp;
+    }
+
+    Point point{ timestamp, value };
+    points_.push_back(point);
+
+    // Równe wartości zostają w kolejce, dzięki czemu z przodu jest najwcześniejsze wystąpienie
+    while (!minQueue_.empty() && minQueue_.back().value > value) minQueue_.pop_back();
+    minQueue_.push_back(point);
+    while (!maxQueue_.empty() && maxQueue_.back().value < value) maxQueue_.pop_back();
+    maxQueue_.push_back(point);
+
+    addMoments(toHours(timestamp), value);
+    return true;
+}
+
+/**
+ * @brief Usuwa z analizy punkty starsze niż podany czas.
+ *
+ * @param timestamp Najstarszy zachowywany znacznik czasu.
+ */
+void IncrementalAnalyzer::evictBefore(int64_t timestamp) {
+    bool removed = false;
+    while (!points_.empty() && points_.front().timestamp < timestamp) {
+        const Point& oldest = points_.front();
+        removeMoments(toHours(oldest.timestamp), oldest.value);
+        points_.pop_front();
+        removalsSinceRecompute_++;
+        removed = true;
+    }
+    if (!removed) return;
+
+    while (!minQueue_.empty() && minQueue_.front().timestamp < timestamp) minQueue_.pop_front();
+    while (!maxQueue_.empty() && maxQueue_.front().timestamp < timestamp) maxQueue_.pop_front();
+
+    if (points_.empty()) {
+        // Okno opróżnione przerwą w danych - lastTimestamp_ nadal chroni przed starszymi pomiarami
+        resetWindow();
+    }
+    else if (removalsSinceRecompute_ > points_.size()) {
+        // Pełne przeliczenie raz na tyle usunięć, ile punktów jest w oknie - koszt pozostaje O(1) zamortyzowany
+        recomputeMoments();
+    }
+}
+
+/**
+ * @brief Usuwa wszystkie punkty i zapomina czas ostatniego pomiaru.
+ */
+void IncrementalAnalyzer::clear() {
+    resetWindow();
+    lastTimestamp_ = INT64_MIN;
+}
+
+/**
+ * @brief Usuwa punkty, kolejki i momenty okna.
+ */
+void IncrementalAnalyzer::resetWindow() {
+    points_.clear();
+    minQueue_.clear();
+    maxQueue_.clear();
+    origin_ = 0;
+    removalsSinceRecompute_ = 0;
+    meanX_ = meanY_ = m2x_ = m2y_ = cxy_ = 0.0;
+}
+
+/**
+ * @brief Zwraca znacznik czasu ostatniego przyjętego pomiaru.
+ *
+ * @return Znacznik czasu lub INT64_MIN.
+ */
+int64_t IncrementalAnalyzer::getLastTimestamp() const {
+    return lastTimestamp_;
+}
+
+/**
+ * @brief Zwraca liczbę punktów w analizie.
+ *
+ * @return Liczba punktów.
+ */
+size_t IncrementalAnalyzer::getCount() const {
+    return points_.size();
+}
+
+/**
+ * @brief Sprawdza, czy są dostępne jakiekolwiek dane.
+ *
+ * @return true jeśli analiza zawiera co najmniej jeden punkt.
+ */
+bool IncrementalAnalyzer::hasData() const {
+    return !points_.empty();
+}
+
+/**
+ * @brief Zwraca wartość minimalną.
+ *
+ * @return Minimum lub -1.0 jeśli brak danych.
+ */
+double IncrementalAnalyzer::getMinValue() const {
+    return hasData() ? minQueue_.front().value : -1.0;
+}
+
+/**
+ * @brief Zwraca czas pierwszego wystąpienia minimum.
+ *
+ * @return Znacznik czasu lub 0 jeśli brak danych.
+ */
+int64_t IncrementalAnalyzer::getMinTimestamp() const {
+    return hasData() ? minQueue_.front().timestamp : 0;
+}
+
+/**
+ * @brief Zwraca wartość maksymalną.
+ *
+ * @return Maksimum lub -1.0 jeśli brak danych.
+ */
+double IncrementalAnalyzer::getMaxValue() const {
+    return hasData() ? maxQueue_.front().value : -1.0;
+}
+
+/**
+ * @brief Zwraca czas pierwszego wystąpienia maksimum.
+ *
+ * @return Znacznik czasu lub 0 jeśli brak danych.
+ */
+int64_t IncrementalAnalyzer::getMaxTimestamp() const {
+    return hasData() ? maxQueue_.front().timestamp : 0;
+}
+
+/**
+ * @brief Zwraca średnią wartość.
+ *
+ * @return Średnia lub -1.0 jeśli brak danych.
+ */
+double IncrementalAnalyzer::getAverage() const {
+    return hasData() ? meanY_ : -1.0;
+}
+
+/**
+ * @brief Zwraca wariancję (populacyjną).
+ *
+ * @return Wariancja lub -1.0 jeśli brak danych.
+ */
+double IncrementalAnalyzer::getVariance() const {
+    if (!hasData()) return -1.0;
+    double variance = m2y_ / points_.size();
+    return variance > 0.0 ? variance : 0.0;
+}
+
+/**
+ * @brief Zwraca nachylenie prostej regresji względem czasu.
+ *
+ * @return Zmiana wartości na godzinę.
+ */
+double IncrementalAnalyzer::getSlopePerHour() const {
+    if (points_.size() < 2 || m2x_ <= 0.0) return 0.0;
+    return cxy_ / m2x_;
+}
+
+/**
+ * @brief Zwraca trend na podstawie nachylenia regresji.
+ *
+ * @return Wartość enum Trend.
+ */
+MeasurementAnalyzer::Trend IncrementalAnalyzer::getTrend() const {
+    if (points_.size() < 2) return MeasurementAnalyzer::Trend::UNKNOWN;
+
+    const double THRESHOLD = 0.01;
+    double slope = getSlopePerHour();
+    if (slope > THRESHOLD) return MeasurementAnalyzer::Trend::RISING;
+    if (slope < -THRESHOLD) return MeasurementAnalyzer::Trend::FALLING;
+    return MeasurementAnalyzer::Trend::STABLE;
+}
+
+/**
+ * @brief Dołącza punkt do momentów statystycznych (krok Welforda).
+ *
+ * @param x Czas w godzinach.
+ * @param y Wartość.
+ */
+void IncrementalAnalyzer::addMoments(double x, double y) {
+    double n = static_cast<double>(points_.size());
+    double dx = x - meanX_;
+    double dy = y - meanY_;
+    meanX_ += dx / n;
+    meanY_ += dy / n;
+    m2x_ += dx * (x - meanX_);
+    m2y_ += dy * (y - meanY_);
+    cxy_ += dx * (y - meanY_);
+}
+
+/**
+ * @brief Usuwa punkt z momentów statystycznych (odwrócony krok Welforda).
+ *
+ * Wywoływana przed usunięciem punktu z kolejki, więc points_.size() obejmuje jeszcze usuwany punkt.
+ *
+ * @param x Czas w godzinach.
+ * @param y Wartość.
+ */
+void IncrementalAnalyzer::removeMoments(double x, double y) {
+    double n = static_cast<double>(points_.size());
+    if (n <= 1.0) {
+        meanX_ = meanY_ = m2x_ = m2y_ = cxy_ = 0.0;
+        return;
+    }
+
+    double meanXAfter = (n * meanX_ - x) / (n - 1.0);
+    double meanYAfter = (n * meanY_ - y) / (n - 1.0);
+    m2x_ -= (x - meanXAfter) * (x - meanX_);
+    m2y_ -= (y - meanYAfter) * (y - meanY_);
+    cxy_ -= (x - meanXAfter) * (y - meanY_);
+    meanX_ = meanXAfter;
+    meanY_ = meanYAfter;
+}
+
+/**
+ * @brief Przelicza momenty od nowa z punktów w oknie.
+ */
+void IncrementalAnalyzer::recomputeMoments() {
+    origin_ = points_.front().timestamp;
+    meanX_ = meanY_ = m2x_ = m2y_ = cxy_ = 0.0;
+
+    double n = 0.0;
+    for (const auto& p : points_) {
+        double x = toHours(p.timestamp);
+        n += 1.0;
+        double dx = x - meanX_;
+        double dy = p.value - meanY_;
+        meanX_ += dx / n;
+        meanY_ += dy / n;
+        m2x_ += dx * (x - meanX_);
+        m2y_ += dy * (p.value - meanY_);
+        cxy_ += dx * (p.value - meanY_);
+    }
+    removalsSinceRecompute_ = 0;
+}
+
+/**
+ * @brief Zamienia znacznik czasu na godziny względem początku analizy.
+ *
+ * @param timestamp Znacznik czasu w sekundach.
+ * @return Czas w godzinach.
+ */
+double IncrementalAnalyzer::toHours(int64_t timestamp) const {
+    return static_cast<double>(timestamp - origin_) / 3600.0;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include "MeasurementAnalyzer.h"
+
+/**
+ * @file IncrementalAnalyzer.h
+ * @brief Analiza strumieniowa pomiarów z aktualizacją w czasie stałym.
+ *
+ * W przeciwieństwie do MeasurementAnalyzer nie wymaga przeliczania całej serii po nadejściu
+ * nowego punktu. Minimum i maksimum są utrzymywane w kolejkach monotonicznych, średnia i wariancja
+ * metodą Welforda (z obsługą usuwania punktów), a nachylenie regresji z momentów mieszanych
+ * względem czasu. Opcjonalne okno przesuwne usuwa punkty starsze niż zadany czas.
+ */
+class IncrementalAnalyzer {
+public:
+    /**
+     * @brief Konstruktor klasy IncrementalAnalyzer.
+     *
+     * @param windowSeconds Długość okna przesuwnego w sekundach (0 - bez okna, analiza narastająca).
+     */
+    explicit IncrementalAnalyzer(int64_t windowSeconds = 0);
+
+    /**
+     * @brief Dodaje nowy pomiar.
+     *
+     * Punkty muszą napływać w kolejności niemalejącego czasu. Przy aktywnym oknie usuwane są
+     * punkty o czasie nie większym niż timestamp - windowSeconds.
+     *
+     * @param timestamp Znacznik czasu pomiaru w sekundach.
+     * @param value Wartość pomiaru.
+     * @return true jeśli punkt został dodany, false jeśli był nieprawidłowy lub starszy od poprzedniego.
+     */
+    bool push(int64_t timestamp, double value);
+
+    /**
+     * @brief Usuwa z analizy punkty starsze niż podany czas.
+     *
+     * @param timestamp Najstarszy zachowywany znacznik czasu.
+     */
+    void evictBefore(int64_t timestamp);
+
+    /**
+     * @brief Usuwa wszystkie punkty i zapomina czas ostatniego pomiaru.
+     */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę punktów w analizie.
+     *
+     * @return Liczba punktów.
+     */
+    size_t getCount() const;
+
+    /**
+     * @brief Zwraca znacznik czasu ostatniego przyjętego pomiaru (także pomiaru bez wartości).
+     *
+     * Pozwala dopisywać z kolejnych pobrań tylko nowe pomiary.
+     *
+     * @return Znacznik czasu lub INT64_MIN, jeśli nie dodano jeszcze żadnego pomiaru.
+     */
+    int64_t getLastTimestamp() const;
+
+    /**
+     * @brief Sprawdza, czy są dostępne jakiekolwiek dane.
+     *
+     * @return true jeśli analiza zawiera co najmniej jeden punkt.
+     */
+    bool hasData() const;
+
+    /**
+     * @brief Zwraca wartość minimalną.
+     *
+     * @return Minimum lub -1.0 jeśli brak danych.
+     */
+    double getMinValue() const;
+
+    /**
+     * @brief Zwraca czas pierwszego wystąpienia minimum.
+     *
+     * @return Znacznik czasu lub 0 jeśli brak danych.
+     */
+    int64_t getMinTimestamp() const;
+
+    /**
+     * @brief Zwraca wartość maksymalną.
+     *
+     * @return Maksimum lub -1.0 jeśli brak danych.
+     */
+    double getMaxValue() const;
+
+    /**
+     * @brief Zwraca czas pierwszego wystąpienia maksimum.
+     *
+     * @return Znacznik czasu lub 0 jeśli brak danych.
+     */
+    int64_t getMaxTimestamp() const;
+
+    /**
+     * @brief Zwraca średnią wartość.
+     *
+     * @return Średnia lub -1.0 jeśli brak danych.
+     */
+    double getAverage() const;
+
+    /**
+     * @brief Zwraca wariancję (populacyjną).
+     *
+     * @return Wariancja lub -1.0 jeśli brak danych.
+     */
+    double getVariance() const;
+
+    /**
+     * @brief Zwraca nachylenie prostej regresji względem czasu.
+     *
+     * @return Zmiana wartości na godzinę (0.0 jeśli mniej niż dwa punkty).
+     */
+    double getSlopePerHour() const;
+
+    /**
+     * @brief Zwraca trend na podstawie nachylenia regresji.
+     *
+     * Używa tego samego progu co MeasurementAnalyzer (dla danych godzinowych wyniki są zgodne).
+     *
+     * @return Wartość enum Trend.
+     */
+    MeasurementAnalyzer::Trend getTrend() const;
+
+private:
+    /**
+     * @brief Punkt przechowywany w oknie.
+     */
+    struct Point {
+        int64_t timestamp; ///< Znacznik czasu w sekundach.
+        double value;      ///< Wartość pomiaru.
+    };
+
+    /**
+     * @brief Usuwa punkty, kolejki i momenty okna (czas ostatniego pomiaru pozostaje).
+     */
+    void resetWindow();
+
+    /**
+     * @brief Dołącza punkt do momentów statystycznych.
+     */
+    void addMoments(double x, double y);
+
+    /**
+     * @brief Usuwa punkt z momentów statystycznych.
+     */
+    void removeMoments(double x, double y);
+
+    /**
+     * @brief Przelicza momenty od nowa z punktów w oknie (ogranicza kumulację błędów zaokrągleń).
+     */
+    void recomputeMoments();
+
+    /**
+     * @brief Zamienia znacznik czasu na godziny względem początku analizy.
+     */
+    double toHours(int64_t timestamp) const;
+
+    int64_t windowSeconds_;        ///< Długość okna (0 - bez okna).
+    int64_t origin_;               ///< Znacznik czasu pierwszego punktu (początek osi x).
+    int64_t lastTimestamp_;        ///< Znacznik czasu ostatniego przyjętego pomiaru.
+    std::deque<Point> points_;     ///< Punkty w oknie (potrzebne do ich późniejszego usunięcia).
+    std::deque<Point> minQueue_;   ///< Kolejka monotoniczna rosnąca (minimum z przodu).
+    std::deque<Point> maxQueue_;   ///< Kolejka monotoniczna malejąca (maksimum z przodu).
+    size_t removalsSinceRecompute_;///< Liczba usunięć od ostatniego pełnego przeliczenia.
+
+    double meanX_;                 ///< Średnia czasu (w godzinach).
+    double meanY_;                 ///< Średnia wartości.
+    double m2x_;                   ///< Suma kwadratów odchyleń czasu.
+    double m2y_;                   ///< Suma kwadratów odchyleń wartości.
+    double cxy_;                   ///< Suma iloczynów odchyleń czasu i wartości.
+};
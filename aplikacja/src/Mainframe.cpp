@@ -1,456 +1,1444 @@
-/**
- * @file MainFrame.cpp
- * @brief Implementacja klasy MainFrame – głównego okna aplikacji GUI dla monitorowania jakości powietrza.
- */
-
-
-#include "MainFrame.h"
-
- /**
-  * @brief Konstruktor klasy MainFrame.
-  *
-  * Tworzy i konfiguruje główne komponenty GUI: pola wyboru stacji i czujników, daty, przyciski oraz zakładki z danymi i wykresem.
-  * Inicjalizuje tryb online lub offline w zależności od dostępności danych z API.
-  *
-  * @param title Tytuł okna aplikacji.
-  */
-MainFrame::MainFrame(const wxString& title)
-    : wxFrame(nullptr, wxID_ANY, title, wxDefaultPosition, wxSize(1000, 800)),
-    dbManager("data/air_quality_data.json"),
-    isOfflineMode(false) {  // inicjalizacja trybu ofline
-
-    // Tworzenie głównego panelu i układu pionowego (sizer)
-    panel = new wxPanel(this);
-    wxBoxSizer* vbox = new wxBoxSizer(wxVERTICAL);
-
-    // Etykieta: "Wybierz stację"
-    wxStaticText* label1 = new wxStaticText(panel, wxID_ANY, wxString::FromUTF8("Wybierz stację:"));
-    vbox->Add(label1, 0, wxALL, 10);
-
-    // Lista rozwijana z dostępnymi stacjami
-    stationCombo = new wxComboBox(panel, wxID_ANY);
-    vbox->Add(stationCombo, 0, wxEXPAND | wxALL, 10);
-    // Obsługa zdarzenia wyboru stacji
-    stationCombo->Bind(wxEVT_COMBOBOX, &MainFrame::OnStationSelected, this);
-
-    // Etykieta: "Wybierz czujnik"
-    wxStaticText* label2 = new wxStaticText(panel, wxID_ANY, "Wybierz czujnik:");
-    vbox->Add(label2, 0, wxALL, 10);
-
-    // Lista rozwijana z czujnikami
-    sensorCombo = new wxComboBox(panel, wxID_ANY);
-    vbox->Add(sensorCombo, 0, wxEXPAND | wxALL, 10);
-
-    // Układ poziomy dla wyboru dat (od - do)
-    wxBoxSizer* dateSizer = new wxBoxSizer(wxHORIZONTAL);
-    dateFrom = new wxDatePickerCtrl(panel, wxID_ANY); // data początkowa
-    dateTo = new wxDatePickerCtrl(panel, wxID_ANY);   // data końcowa
-
-    // Dodanie etykiet i kontrolek wyboru dat do sizer'a
-    dateSizer->Add(new wxStaticText(panel, wxID_ANY, "Od:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
-    dateSizer->Add(dateFrom, 0, wxRIGHT, 10);
-    dateSizer->Add(new wxStaticText(panel, wxID_ANY, "Do:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
-    dateSizer->Add(dateTo, 0);
-    vbox->Add(dateSizer, 0, wxALL, 10);
-
-    // Układ poziomy dla przycisków
-    wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
-
-    // Przycisk do pobierania danych
-    fetchBtn = new wxButton(panel, wxID_ANY, "Pobierz dane");
-    buttonSizer->Add(fetchBtn, 1, wxEXPAND | wxRIGHT, 10);
-    fetchBtn->Bind(wxEVT_BUTTON, &MainFrame::OnFetch, this);
-
-    // Przycisk do zapisu danych do bazy – na początku nieaktywny
-    saveToDbBtn = new wxButton(panel, wxID_ANY, "Zapisz do bazy danych");
-    buttonSizer->Add(saveToDbBtn, 1, wxEXPAND | wxRIGHT, 10);
-    saveToDbBtn->Bind(wxEVT_BUTTON, &MainFrame::OnSaveToDb, this);
-    saveToDbBtn->Disable();  // Dezaktywacja do czasu pobrania danych
-
-    // Przycisk do wczytywania danych z bazy
-    loadFromDbBtn = new wxButton(panel, wxID_ANY, "Wczytaj z bazy danych");
-    buttonSizer->Add(loadFromDbBtn, 1, wxEXPAND);
-    loadFromDbBtn->Bind(wxEVT_BUTTON, &MainFrame::OnLoadFromDb, this);
-
-    // Dodanie paska przycisków do głównego sizer'a
-    vbox->Add(buttonSizer, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
-
-    // Etykieta informacyjna – ukryta do czasu potrzeby pokazania komunikatu
-    infoLabel = new wxStaticText(panel, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
-    infoLabel->Hide();
-    vbox->Add(infoLabel, 0, wxLEFT | wxBOTTOM, 10);
-
-    // Notebook – zakładki do przełączania między widokiem danych tekstowych a wykresem
-    notebook = new wxNotebook(panel, wxID_ANY);
-    vbox->Add(notebook, 1, wxEXPAND | wxALL, 10);
-
-    // Panel na dane tekstowe i analizę
-    wxPanel* dataPanel = new wxPanel(notebook);
-    wxBoxSizer* dataPanelSizer = new wxBoxSizer(wxHORIZONTAL);
-
-    // Pole tekstowe do wyświetlania danych pomiarowych
-    dataText = new wxTextCtrl(dataPanel, wxID_ANY, "", wxDefaultPosition, wxSize(480, 400),
-        wxTE_MULTILINE | wxTE_READONLY);
-
-    // Pole tekstowe do wyświetlania dodatkowych informacji lub analiz
-    extraText = new wxTextCtrl(dataPanel, wxID_ANY, "", wxDefaultPosition, wxSize(480, 400),
-        wxTE_MULTILINE | wxTE_READONLY);
-
-    // Dodanie obu pól tekstowych do sizer'a
-    dataPanelSizer->Add(dataText, 1, wxEXPAND | wxALL, 10);
-    dataPanelSizer->Add(extraText, 1, wxEXPAND | wxALL, 10);
-    dataPanel->SetSizer(dataPanelSizer);  // Ustawienie layoutu panelu danych
-
-    // Panel z wykresem
-    chartPanel = new ChartPanel(notebook);
-
-    // Dodanie zakładek do notesooka
-    notebook->AddPage(dataPanel, "Dane i analiza");
-    notebook->AddPage(chartPanel, "Wykres");
-
-    panel->SetSizer(vbox);
-
-    // Wczytanie stacji
-    try {
-        stations = api.getStations();
-        for (const auto& station : stations) {
-            stationCombo->Append(wxString::FromUTF8(station.getName()));
-        }
-    }
-    catch (const std::exception& e) {
-        wxMessageBox(wxString::FromUTF8("Brak internetu - przełączam na tryb offline"), "Informacja", wxOK | wxICON_INFORMATION);
-        SwitchToOfflineMode();
-    }
-}
-
-/**
- * @brief Przełącza aplikację w tryb offline, jeśli nie można pobrać danych z API.
- *
- * Wyłącza przyciski online, wczytuje zapisane stacje i czujniki z lokalnej bazy danych,
- * informuje użytkownika o trybie offline.
- */
-void MainFrame::SwitchToOfflineMode() {
-    isOfflineMode = true;
-
-	// wyczyść i wyłącz przyciski
-    fetchBtn->Disable();
-    saveToDbBtn->Disable();
-
-	// wyczyszczenie comboboxow
-    stationCombo->Clear();
-    sensorCombo->Clear();
-
-    auto dbStations = dbManager.getSavedStations();
-
-    if (dbStations.empty()) {
-        stationCombo->Disable();
-        sensorCombo->Disable();
-        loadFromDbBtn->Disable();
-        return;
-    }
-
-	// dodanie stacji do comboboxa
-    stations.clear();
-    for (const auto& station : dbStations) {
-        stationCombo->Append(wxString::FromUTF8(station.getName()));
-        stations.push_back(station); // Zamiast emplace_back tworzymy już gotową stację
-    }
-
-	// włączamy comboboxy
-    stationCombo->Enable();
-	sensorCombo->Disable(); // bedzie włączone po wyborze stacji
-    loadFromDbBtn->Enable();
-
-	// ustawienie etykiety informacyjnej
-    infoLabel->SetLabel("TRYB OFFLINE - dane z lokalnej bazy");
-    infoLabel->SetForegroundColour(*wxRED);
-    infoLabel->Show();
-    panel->Layout();
-}
-
-/**
- * @brief Obsługuje zdarzenie wyboru stacji z listy.
- *
- * W zależności od trybu (online/offline), ładuje czujniki z API lub z bazy danych dla wybranej stacji.
- *
- * @param event Zdarzenie wxEVT_COMBOBOX związane z wyborem stacji.
- */
-void MainFrame::OnStationSelected(wxCommandEvent& event) {
-    int sel = stationCombo->GetSelection();
-    if (sel == wxNOT_FOUND) return;
-
-    int stationId = stations[sel].getId();
-
-	// Wyczyszanie poprzednich czujników
-    sensorCombo->Clear();
-    currentSensors.clear();
-
-    if (isOfflineMode) {
-        // pobieiebranie czujnikow z bazy        
-        auto dbSensors = dbManager.getSavedSensors(stationId);
-
-        if (dbSensors.empty()) {
-            sensorCombo->Append("Brak zapisanych czujników dla tej stacji");
-            sensorCombo->Disable();
-            return;
-        }
-
-		// Dodaje dane  do comboboxa
-        for (const auto& sensor : dbSensors) {
-            sensorCombo->Append(wxString::FromUTF8(sensor.getParamName()));
-            currentSensors.push_back(sensor); // Tu bezpośrednio używamy obiektu Sensor
-        }
-
-        sensorCombo->Enable();
-    }
-    else {
-		// Pobieranie czujników z API
-        try {
-            currentSensors = api.getSensors(stationId);
-            for (const auto& sensor : currentSensors) {
-                sensorCombo->Append(wxString::FromUTF8(sensor.getParamName()));
-            }
-        }
-        catch (const std::exception& e) {
-            wxMessageBox("Błąd podczas pobierania czujników: " + std::string(e.what()),
-                "Błąd", wxOK | wxICON_ERROR);
-            SwitchToOfflineMode();
-        }
-    }
-}
-
-/**
- * @brief Pobiera dane pomiarowe z API i wykonuje analizę.
- *
- * Weryfikuje wybór stacji i czujnika, zakres dat, pobiera dane z API, analizuje je, wyświetla dane tekstowo i w formie wykresu.
- * Aktywuje przycisk zapisu danych do bazy.
- *
- * @param event Zdarzenie kliknięcia przycisku "Pobierz dane".
- */
-void MainFrame::OnFetch(wxCommandEvent& event) {
-    int selStation = stationCombo->GetSelection();
-    int selSensor = sensorCombo->GetSelection();
-
-    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND) {
-        wxMessageBox("Wybierz stację i czujnik!", "Błąd", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    int stationId = stations[selStation].getId();
-    const auto& sensor = currentSensors[selSensor];
-
-    std::ostringstream dataOut;
-    std::ostringstream analysisOut;
-
-    try {
-        wxDateTime fromDate = dateFrom->GetValue();
-        wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
-
-        if (fromDate > toDate) {
-           throw std::runtime_error("Data początkowa nie może być późniejsza od końcowej.");
-        }
-
-        // Indeks jakości powietrza
-        auto index = api.getAirQualityIndex(stationId);
-        if (index.count("Ogólny")) {
-            infoLabel->SetLabel(wxString::FromUTF8("Ogólny indeks jakości powietrza: " + index["Ogólny"]));
-        }
-        else {
-            infoLabel->SetLabel("Brak ogólnego indeksu jakości powietrza.");
-        }
-        infoLabel->Show();
-        panel->Layout(); // Odśwież układ
-
-        // Pomiar
-        auto measurements = api.getSensorData(sensor.getId());
-		currentMeasurements = measurements;  // zapisz dla bazy danych
-
-        std::vector<Measurement> filtered;
-        for (const auto& m : measurements) {
-            wxDateTime mDate;
-            mDate.ParseFormat(m.getDate(), "%Y-%m-%d %H:%M:%S");
-
-            if (!mDate.IsValid()) continue;
-            if (mDate >= fromDate && mDate <= toDate) {
-                dataOut << mDate.FormatISOCombined(' ') << " - "
-                    << (m.isValid() ? std::to_string(m.getValue()) : "brak pomiaru") << "\n";
-                filtered.push_back(m);
-            }
-        }
-
-        dataText->SetValue(dataOut.str());
-
-        // Analiza
-        MeasurementAnalyzer analyzer(filtered);
-        if (!analyzer.hasData()) {
-            throw std::runtime_error("Brak danych pomiarowych.");
-        }
-
-        analysisOut << "Analiza dla czujnika: " << sensor.getParamName() << "\n\n";
-        analysisOut << "Liczba pomiarów: " << filtered.size() << "\n";
-        analysisOut << "Min: " << analyzer.getMinValue() << " (" << analyzer.getMinDate() << ")\n";
-        analysisOut << "Max: " << analyzer.getMaxValue() << " (" << analyzer.getMaxDate() << ")\n";
-        analysisOut << "Średnia: " << analyzer.getAverage() << "\n";
-        analysisOut << "Trend: " << analyzer.getTrendDescription() << "\n";
-
-        extraText->SetValue(analysisOut.str());
-
-        // Utwórz tytuł wykresu
-        wxString chartTitle = wxString::Format("Wykres pomiarów %s",
-            wxString::FromUTF8(sensor.getParamName()));
-
-        // Ustaw dane na wykresie
-        chartPanel->SetData(filtered, chartTitle);
-
-        // Przełącz na zakładkę z wykresem
-        notebook->SetSelection(1);
-
-		// umozliwia zapisywanie danych do bazy
-        saveToDbBtn->Enable();
-    }
-    catch (const std::exception& e) {
-        wxMessageBox(wxString::Format("Błąd: %s", e.what()), "Błąd", wxOK | wxICON_ERROR);
-        
-        
-    }
-}
-/**
- * @brief Zapisuje dane pomiarowe do lokalnej bazy danych.
- *
- * Weryfikuje wybór stacji i czujnika, a następnie zapisuje dane do pliku JSON.
- * Informuje użytkownika o sukcesie lub błędzie operacji.
- *
- * @param event Zdarzenie kliknięcia przycisku "Zapisz do bazy danych".
- */
-// Implementation of the OnSaveToDb method
-void MainFrame::OnSaveToDb(wxCommandEvent& event) {
-    int selStation = stationCombo->GetSelection();
-    int selSensor = sensorCombo->GetSelection();
-
-    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND || currentMeasurements.empty()) {
-        wxMessageBox("Brak danych do zapisania!", "Błąd", wxOK | wxICON_ERROR);
-        return;
-    }
-
-    int stationId = stations[selStation].getId();
-    std::string stationName = stations[selStation].getName();
-
-    int sensorId = currentSensors[selSensor].getId();
-    std::string sensorName = currentSensors[selSensor].getParamName();
-
-    try {
-        // Indeks jakości powietrza do zapisania
-        std::map<std::string, std::string> indexValues;
-
-        // Jeśli jesteśmy w trybie online, pobierz indeks jakości powietrza
-        if (!isOfflineMode) {
-            try {
-                indexValues = api.getAirQualityIndex(stationId);
-            }
-            catch (const std::exception& e) {
-                // Jeśli nie uda się pobrać indeksu, ignorujemy błąd
-                // i kontynuujemy z zapisem danych pomiarowych
-            }
-        }
-
-        // Przekazujemy dane pomiarowe i indeksy jakości powietrza do zapisania
-        bool saved = dbManager.saveData(stationId, stationName, sensorId, sensorName, currentMeasurements, indexValues);
-
-        if (saved) {
-            wxMessageBox("Dane zostały zapisane do bazy danych!", "Sukces", wxOK | wxICON_INFORMATION);
-        }
-        else {
-            throw std::runtime_error("Nie udało się zapisać danych do bazy danych.");
-        }
-    }
-    catch (const std::exception& e) {
-        wxMessageBox(wxString::Format("Błąd: %s", e.what()), "Błąd", wxOK | wxICON_ERROR);
-    }
-}
-/**
- * @brief Wczytuje dane pomiarowe z lokalnej bazy danych i analizuje je.
- *
- * Filtruje dane po wybranym zakresie dat, prezentuje analizę oraz wykres.
- *
- * @param event Zdarzenie kliknięcia przycisku "Wczytaj z bazy danych".
- */
-void MainFrame::OnLoadFromDb(wxCommandEvent& event) {
-    int selStation = stationCombo->GetSelection();
-    int selSensor = sensorCombo->GetSelection();
-    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND) {
-        wxMessageBox("Wybierz stację i czujnik!", "Błąd", wxOK | wxICON_ERROR);
-        return;
-    }
-    int stationId = stations[selStation].getId();
-    int sensorId = currentSensors[selSensor].getId();
-    std::string sensorName = currentSensors[selSensor].getParamName();
-    std::vector<Measurement> measurements;
-    try {
-        if (!dbManager.loadData(stationId, sensorId, measurements)) {
-            wxMessageBox("Brak danych dla wybranej stacji i czujnika w bazie danych.",
-                "Informacja", wxOK | wxICON_INFORMATION);
-            return;
-        }
-        currentMeasurements = measurements;
-
-        // Próba wczytania indeksu jakości powietrza
-        std::map<std::string, std::string> airQualityIndex;
-        if (dbManager.loadAirQualityIndex(stationId, airQualityIndex) &&
-            airQualityIndex.count("Ogólny")) {
-            infoLabel->SetLabel(wxString::FromUTF8("Ogólny indeks jakości powietrza: " +
-                airQualityIndex["Ogólny"] + " (dane z bazy)"));
-        }
-        else {
-            infoLabel->SetLabel("Dane wczytane z lokalnej bazy");
-        }
-
-        // dane flitrowane poprzez date
-        wxDateTime fromDate = dateFrom->GetValue();
-        wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
-        std::vector<Measurement> filtered;
-        std::ostringstream dataOut;
-        for (const auto& m : measurements) {
-            wxDateTime mDate;
-            mDate.ParseFormat(m.getDate(), "%Y-%m-%d %H:%M:%S");
-            if (!mDate.IsValid()) continue;
-            if (mDate >= fromDate && mDate <= toDate) {
-                dataOut << mDate.FormatISOCombined(' ') << " - "
-                    << (m.isValid() ? std::to_string(m.getValue()) : "brak pomiaru") << "\n";
-                filtered.push_back(m);
-            }
-        }
-        // Pokazuje dane
-        dataText->SetValue(dataOut.str());
-        // Analizuje dane
-        MeasurementAnalyzer analyzer(filtered);
-        std::ostringstream analysisOut;
-        if (!analyzer.hasData()) {
-            analysisOut << "Brak danych pomiarowych w wybranym zakresie dat.\n";
-        }
-        else {
-            analysisOut << "Analiza dla czujnika: " << sensorName << " (dane z bazy)\n\n";
-            analysisOut << wxString::FromUTF8("Liczba pomiarów: ") << filtered.size() << "\n";
-            analysisOut << "Min: " << analyzer.getMinValue() << " (" << analyzer.getMinDate() << ")\n";
-            analysisOut << "Max: " << analyzer.getMaxValue() << " (" << analyzer.getMaxDate() << ")\n";
-            analysisOut << "Średnia: " << analyzer.getAverage() << "\n";
-            analysisOut << "Trend: " << analyzer.getTrendDescription() << "\n";
-			// ustawienie wykresu
-            wxString chartTitle = wxString::Format("Wykres pomiarów %s (dane z bazy)",
-                wxString::FromUTF8(sensorName));
-            chartPanel->SetData(filtered, chartTitle);
-			// Zamiast pokazywać wykres, pokazuje dane
-            notebook->SetSelection(1);
-        }
-        extraText->SetValue(analysisOut.str());
-
-        if (!isOfflineMode) {
-            infoLabel->SetForegroundColour(*wxBLUE);
-        }
-        infoLabel->Show();
-        panel->Layout();
-    }
-    catch (const std::exception& e) {
-        wxMessageBox(wxString::Format("Błąd podczas wczytywania danych: %s", e.what()),
-            "Błąd", wxOK | wxICON_ERROR);
-    }
-}
\ No newline at end of file
+/**
+ * @file MainFrame.cpp
+ * @brief Implementacja klasy MainFrame – głównego okna aplikacji GUI dla monitorowania jakości powietrza.
+ */
+
+
+#include "MainFrame.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+ /**
+  * @brief Konstruktor klasy MainFrame.
+  *
+  * Tworzy i konfiguruje główne komponenty GUI: pola wyboru stacji i czujników, daty, przyciski oraz zakładki z danymi i wykresem.
+  * Lista stacji jest pobierana w tle; tryb online lub offline jest wybierany po odpowiedzi API.
+  *
+  * @param title Tytuł okna aplikacji.
+  */
+MainFrame::MainFrame(const wxString& title)
+    : wxFrame(nullptr, wxID_ANY, title, wxDefaultPosition, wxSize(1000, 800)),
+    dbManager("data/air_quality_data.json"),
+    isOfflineMode(false),  // inicjalizacja trybu ofline
+    requestGeneration(0),
+    analysisGeneration(0),
+    displayedSensorId(-1),
+    displayedFrom(0),
+    displayedTo(0) {
+
+    // Tworzenie głównego panelu i układu pionowego (sizer)
+    panel = new wxPanel(this);
+    wxBoxSizer* vbox = new wxBoxSizer(wxVERTICAL);
+
+    // Etykieta: "Wybierz stację"
+    wxStaticText* label1 = new wxStaticText(panel, wxID_ANY, wxString::FromUTF8("Wybierz stację:"));
+    vbox->Add(label1, 0, wxALL, 10);
+
+    // Wyszukiwarka stacji – zawęża listę przy każdym naciśnięciu klawisza (Enter wybiera najlepszy wynik)
+    stationSearch = new wxSearchCtrl(panel, wxID_ANY, "", wxDefaultPosition, wxDefaultSize, wxTE_PROCESS_ENTER);
+    stationSearch->SetDescriptiveText(wxString::FromUTF8("Szukaj stacji (nazwa lub miejscowość)"));
+    stationSearch->ShowCancelButton(true);
+    vbox->Add(stationSearch, 0, wxEXPAND | wxLEFT | wxRIGHT, 10);
+    stationSearch->Bind(wxEVT_TEXT, &MainFrame::OnStationSearch, this);
+    stationSearch->Bind(wxEVT_TEXT_ENTER, &MainFrame::OnStationSearchEnter, this);
+    stationSearch->Bind(wxEVT_SEARCHCTRL_SEARCH_BTN, &MainFrame::OnStationSearchEnter, this);
+    stationSearch->Bind(wxEVT_SEARCHCTRL_CANCEL_BTN, [this](wxCommandEvent&) { stationSearch->SetValue(""); });
+
+    // Lista rozwijana z dostępnymi stacjami
+    stationCombo = new wxComboBox(panel, wxID_ANY);
+    vbox->Add(stationCombo, 0, wxEXPAND | wxALL, 10);
+    // Obsługa zdarzenia wyboru stacji
+    stationCombo->Bind(wxEVT_COMBOBOX, &MainFrame::OnStationSelected, this);
+
+    // Etykieta: "Wybierz czujnik"
+    wxStaticText* label2 = new wxStaticText(panel, wxID_ANY, "Wybierz czujnik:");
+    vbox->Add(label2, 0, wxALL, 10);
+
+    // Lista rozwijana z czujnikami
+    sensorCombo = new wxComboBox(panel, wxID_ANY);
+    vbox->Add(sensorCombo, 0, wxEXPAND | wxALL, 10);
+    sensorCombo->Bind(wxEVT_COMBOBOX, &MainFrame::OnSensorSelected, this);
+
+    // Układ poziomy dla wyboru dat (od - do)
+    wxBoxSizer* dateSizer = new wxBoxSizer(wxHORIZONTAL);
+    dateFrom = new wxDatePickerCtrl(panel, wxID_ANY); // data początkowa
+    dateTo = new wxDatePickerCtrl(panel, wxID_ANY);   // data końcowa
+    dateFrom->Bind(wxEVT_DATE_CHANGED, &MainFrame::OnDateRangeChanged, this);
+    dateTo->Bind(wxEVT_DATE_CHANGED, &MainFrame::OnDateRangeChanged, this);
+
+    // Dodanie etykiet i kontrolek wyboru dat do sizer'a
+    dateSizer->Add(new wxStaticText(panel, wxID_ANY, "Od:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    dateSizer->Add(dateFrom, 0, wxRIGHT, 10);
+    dateSizer->Add(new wxStaticText(panel, wxID_ANY, "Do:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    dateSizer->Add(dateTo, 0, wxRIGHT, 20);
+
+    // Nakładanie kolejnych serii na wykres (porównanie stacji lub wskaźników)
+    overlayCheck = new wxCheckBox(panel, wxID_ANY, wxString::FromUTF8("Nakładaj serie na wykres"));
+    dateSizer->Add(overlayCheck, 0, wxALIGN_CENTER_VERTICAL);
+    vbox->Add(dateSizer, 0, wxALL, 10);
+
+    // Układ poziomy dla przycisków
+    wxBoxSizer* buttonSizer = new wxBoxSizer(wxHORIZONTAL);
+
+    // Przycisk do pobierania danych
+    fetchBtn = new wxButton(panel, wxID_ANY, "Pobierz dane");
+    buttonSizer->Add(fetchBtn, 1, wxEXPAND | wxRIGHT, 10);
+    fetchBtn->Bind(wxEVT_BUTTON, &MainFrame::OnFetch, this);
+
+    // Przycisk do zapisu danych do bazy – na początku nieaktywny
+    saveToDbBtn = new wxButton(panel, wxID_ANY, "Zapisz do bazy danych");
+    buttonSizer->Add(saveToDbBtn, 1, wxEXPAND | wxRIGHT, 10);
+    saveToDbBtn->Bind(wxEVT_BUTTON, &MainFrame::OnSaveToDb, this);
+    saveToDbBtn->Disable();  // Dezaktywacja do czasu pobrania danych
+
+    // Przycisk do wczytywania danych z bazy
+    loadFromDbBtn = new wxButton(panel, wxID_ANY, "Wczytaj z bazy danych");
+    buttonSizer->Add(loadFromDbBtn, 1, wxEXPAND | wxRIGHT, 10);
+    loadFromDbBtn->Bind(wxEVT_BUTTON, &MainFrame::OnLoadFromDb, this);
+
+    // Przycisk do eksportu zapisanych danych do pliku Arrow (Feather)
+    exportBtn = new wxButton(panel, wxID_ANY, "Eksportuj (Arrow)");
+    buttonSizer->Add(exportBtn, 1, wxEXPAND | wxRIGHT, 10);
+    exportBtn->Bind(wxEVT_BUTTON, &MainFrame::OnExportArrow, this);
+
+    // Przycisk do zliczenia przekroczeń norm dla wszystkich zapisanych stacji
+    exceedanceBtn = new wxButton(panel, wxID_ANY, "Przekroczenia norm");
+    buttonSizer->Add(exceedanceBtn, 1, wxEXPAND | wxRIGHT, 10);
+    exceedanceBtn->Bind(wxEVT_BUTTON, &MainFrame::OnCheckExceedances, this);
+
+    // Przycisk do eksportu macierzy korelacji wskaźnika między stacjami
+    correlationBtn = new wxButton(panel, wxID_ANY, "Korelacje (CSV)");
+    buttonSizer->Add(correlationBtn, 1, wxEXPAND | wxRIGHT, 10);
+    correlationBtn->Bind(wxEVT_BUTTON, &MainFrame::OnExportCorrelations, this);
+
+    // Przycisk do eksportu mapy stężeń wskaźnika (interpolacja między stacjami)
+    mapBtn = new wxButton(panel, wxID_ANY, "Mapa (PNG)");
+    buttonSizer->Add(mapBtn, 1, wxEXPAND);
+    mapBtn->Bind(wxEVT_BUTTON, &MainFrame::OnExportMap, this);
+
+    // Dodanie paska przycisków do głównego sizer'a
+    vbox->Add(buttonSizer, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+
+    // Wskaźnik postępu operacji w tle z przyciskiem anulowania – widoczny tylko podczas operacji
+    progressSizer = new wxBoxSizer(wxHORIZONTAL);
+    progressGauge = new wxGauge(panel, wxID_ANY, 100, wxDefaultPosition, wxSize(200, -1));
+    progressLabel = new wxStaticText(panel, wxID_ANY, "");
+    cancelBtn = new wxButton(panel, wxID_ANY, "Anuluj");
+    cancelBtn->Bind(wxEVT_BUTTON, &MainFrame::OnCancel, this);
+    progressSizer->Add(progressGauge, 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 10);
+    progressSizer->Add(progressLabel, 1, wxALIGN_CENTER_VERTICAL | wxRIGHT, 10);
+    progressSizer->Add(cancelBtn, 0);
+    vbox->Add(progressSizer, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+    progressSizer->ShowItems(false);
+    progressTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &MainFrame::OnProgressTimer, this, progressTimer.GetId());
+
+    // Etykieta informacyjna – ukryta do czasu potrzeby pokazania komunikatu
+    infoLabel = new wxStaticText(panel, wxID_ANY, "", wxDefaultPosition, wxDefaultSize);
+    infoLabel->Hide();
+    vbox->Add(infoLabel, 0, wxLEFT | wxBOTTOM, 10);
+
+    // Notebook – zakładki do przełączania między widokiem danych a wykresem
+    notebook = new wxNotebook(panel, wxID_ANY);
+    vbox->Add(notebook, 1, wxEXPAND | wxALL, 10);
+
+    // Panel na dane tekstowe i analizę
+    wxPanel* dataPanel = new wxPanel(notebook);
+    wxBoxSizer* dataPanelSizer = new wxBoxSizer(wxHORIZONTAL);
+
+    // Tabela pomiarów (wirtualna – wiersze formatowane dopiero przy rysowaniu) z przejściem do daty
+    wxBoxSizer* dataListSizer = new wxBoxSizer(wxVERTICAL);
+    wxBoxSizer* jumpSizer = new wxBoxSizer(wxHORIZONTAL);
+    jumpDate = new wxDatePickerCtrl(dataPanel, wxID_ANY);
+    jumpDate->Bind(wxEVT_DATE_CHANGED, &MainFrame::OnJumpToDate, this);
+    jumpSizer->Add(new wxStaticText(dataPanel, wxID_ANY, wxString::FromUTF8("Przejdź do:")), 0,
+        wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    jumpSizer->Add(jumpDate, 0);
+    dataList = new MeasurementListCtrl(dataPanel);
+    dataListSizer->Add(jumpSizer, 0, wxBOTTOM, 5);
+    dataListSizer->Add(dataList, 1, wxEXPAND);
+
+    // Pole tekstowe do wyświetlania dodatkowych informacji lub analiz
+    extraText = new wxTextCtrl(dataPanel, wxID_ANY, "", wxDefaultPosition, wxSize(480, 400),
+        wxTE_MULTILINE | wxTE_READONLY);
+
+    // Dodanie tabeli i pola analizy do sizer'a
+    dataPanelSizer->Add(dataListSizer, 1, wxEXPAND | wxALL, 10);
+    dataPanelSizer->Add(extraText, 1, wxEXPAND | wxALL, 10);
+    dataPanel->SetSizer(dataPanelSizer);  // Ustawienie layoutu panelu danych
+
+    // Panel z wykresem
+    chartPanel = new ChartPanel(notebook);
+
+    // Panel z mapą ciepła (dzień × godzina)
+    heatmapPanel = new HeatmapPanel(notebook);
+
+    // Dodanie zakładek do notesooka
+    notebook->AddPage(dataPanel, "Dane i analiza");
+    notebook->AddPage(chartPanel, "Wykres");
+    notebook->AddPage(heatmapPanel, wxString::FromUTF8("Mapa ciepła"));
+
+    panel->SetSizer(vbox);
+
+    // Wczytanie stacji w tle – okno pokazuje się od razu
+    RunInBackground(wxString::FromUTF8("Pobieranie listy stacji..."), [this](const CancellationToken&) -> std::function<void()> {
+        try {
+            std::vector<Station> loaded = api.getStations();
+            // Katalog z położeniem stacji pozwala na zapytania przestrzenne także w trybie offline
+            dbManager.saveStationCatalog(loaded);
+            std::vector<uint32_t> masks = LoadParameterMasks(loaded);
+            return [this, loaded, masks]() {
+                SetStations(loaded, masks);
+            };
+        }
+        catch (const std::exception& e) {
+            std::vector<Station> dbStations = dbManager.getSavedStations();
+            std::vector<uint32_t> masks = LoadParameterMasks(dbStations);
+            return [this, dbStations, masks]() {
+                wxMessageBox(wxString::FromUTF8("Brak internetu - przełączam na tryb offline"), "Informacja", wxOK | wxICON_INFORMATION);
+                SwitchToOfflineMode(dbStations, masks);
+            };
+        }
+    });
+}
+
+/**
+ * @brief Destruktor klasy MainFrame.
+ *
+ * Przerywa trwające zapytania i czeka na zadania w tle, które korzystają z klienta API i bazy
+ * (składowych okna). Wyniki zgłoszone przez CallAfter są usuwane razem z oknem.
+ */
+MainFrame::~MainFrame() {
+    progressTimer.Stop();
+    backgroundToken.cancel();
+    analysisToken.cancel();
+    api.cancelPendingRequests();
+    for (const auto& task : backgroundTasks) {
+        try {
+            task.wait();
+        }
+        catch (const std::exception& e) {
+            // Wynik i tak zostałby odrzucony
+        }
+    }
+}
+
+/**
+ * @brief Uruchamia operację w tle (pula TaskScheduler, priorytet interaktywny), zastępując bieżącą.
+ *
+ * Praca zwraca funkcję z wynikami, która jest przekazywana do wątku GUI przez CallAfter i wykonywana
+ * tylko wtedy, gdy w międzyczasie nie rozpoczęto innej operacji, nie anulowano tej ani nie zmieniono
+ * wyboru stacji lub czujnika (numer operacji się nie zmienił).
+ *
+ * @param status Opis operacji.
+ * @param work Praca do wykonania w wątku roboczym.
+ */
+void MainFrame::RunInBackground(const wxString& status, BackgroundWork work) {
+    CancelBackground();
+    const unsigned generation = requestGeneration;
+    ShowProgress(status);
+
+    backgroundTasks.erase(std::remove_if(backgroundTasks.begin(), backgroundTasks.end(),
+        [](const TaskScheduler::TaskHandle& task) { return task.isDone(); }), backgroundTasks.end());
+
+    backgroundTasks.push_back(TaskScheduler::shared().submit(
+        [this, generation, work](const CancellationToken& token) {
+            std::function<void()> done;
+            try {
+                done = work(token);
+            }
+            catch (const std::exception& e) {
+                std::string message = e.what();
+                done = [message]() {
+                    wxMessageBox(wxString::Format("Błąd: %s", message.c_str()), "Błąd", wxOK | wxICON_ERROR);
+                };
+            }
+            CallAfter([this, generation, done]() {
+                if (generation != requestGeneration) return;  // wynik nieaktualny
+                HideProgress();
+                if (done) done();
+            });
+        }, TaskScheduler::Priority::INTERACTIVE, backgroundToken));
+}
+
+/**
+ * @brief Anuluje bieżącą operację w tle i odrzuca jej wynik.
+ */
+void MainFrame::CancelBackground() {
+    requestGeneration++;
+    backgroundToken.cancel();
+    backgroundToken = CancellationToken();
+    api.cancelPendingRequests();
+    HideProgress();
+}
+
+/**
+ * @brief Obsługuje przycisk anulowania operacji w tle.
+ *
+ * Jeśli anulowano wczytywanie listy stacji, aplikacja przechodzi w tryb offline.
+ *
+ * @param event Zdarzenie kliknięcia przycisku "Anuluj".
+ */
+void MainFrame::OnCancel(wxCommandEvent& event) {
+    CancelBackground();
+    if (stations.empty() && !isOfflineMode) {
+        StartOfflineMode();
+    }
+}
+
+/**
+ * @brief Pokazuje wskaźnik postępu (nieokreślonego - czas odpowiedzi API nie jest znany).
+ *
+ * @param status Opis operacji.
+ */
+void MainFrame::ShowProgress(const wxString& status) {
+    progressLabel->SetLabel(status);
+    progressGauge->Pulse();
+    progressSizer->ShowItems(true);
+    panel->Layout();
+    progressTimer.Start(100);
+}
+
+/**
+ * @brief Ukrywa wskaźnik postępu.
+ */
+void MainFrame::HideProgress() {
+    progressTimer.Stop();
+    progressSizer->ShowItems(false);
+    panel->Layout();
+}
+
+/**
+ * @brief Przesuwa wskaźnik postępu.
+ *
+ * @param event Zdarzenie timera.
+ */
+void MainFrame::OnProgressTimer(wxTimerEvent& event) {
+    progressGauge->Pulse();
+}
+
+/**
+ * @brief Wczytuje w tle stacje zapisane w bazie i przełącza aplikację w tryb offline.
+ */
+void MainFrame::StartOfflineMode() {
+    RunInBackground(wxString::FromUTF8("Wczytywanie stacji z lokalnej bazy..."),
+        [this](const CancellationToken&) -> std::function<void()> {
+            std::vector<Station> dbStations = dbManager.getSavedStations();
+            std::vector<uint32_t> masks = LoadParameterMasks(dbStations);
+            return [this, dbStations, masks]() { SwitchToOfflineMode(dbStations, masks); };
+        });
+}
+
+/**
+ * @brief Przełącza aplikację w tryb offline, jeśli nie można pobrać danych z API.
+ *
+ * Wyłącza przyciski online, pokazuje stacje i czujniki zapisane w lokalnej bazie danych,
+ * informuje użytkownika o trybie offline.
+ *
+ * @param dbStations Stacje zapisane w lokalnej bazie (wczytane w tle).
+ * @param parameterMasks Maski wskaźników stacji (wyznaczone w tle).
+ */
+void MainFrame::SwitchToOfflineMode(const std::vector<Station>& dbStations, const std::vector<uint32_t>& parameterMasks) {
+    isOfflineMode = true;
+
+	// wyczyść i wyłącz przyciski
+    fetchBtn->Disable();
+    saveToDbBtn->Disable();
+
+	// wyczyszczenie comboboxow i dodanie stacji z bazy
+    SetStations(dbStations, parameterMasks);
+    sensorCombo->Clear();
+
+    if (dbStations.empty()) {
+        stationSearch->Disable();
+        stationCombo->Disable();
+        sensorCombo->Disable();
+        loadFromDbBtn->Disable();
+        exportBtn->Disable();
+        exceedanceBtn->Disable();
+        correlationBtn->Disable();
+        mapBtn->Disable();
+        return;
+    }
+
+	// włączamy comboboxy
+    stationSearch->Enable();
+    stationCombo->Enable();
+	sensorCombo->Disable(); // bedzie włączone po wyborze stacji
+    loadFromDbBtn->Enable();
+    exportBtn->Enable();
+    exceedanceBtn->Enable();
+    correlationBtn->Enable();
+    mapBtn->Enable();
+
+	// ustawienie etykiety informacyjnej
+    infoLabel->SetLabel("TRYB OFFLINE - dane z lokalnej bazy");
+    infoLabel->SetForegroundColour(*wxRED);
+    infoLabel->Show();
+    panel->Layout();
+}
+
+/**
+ * @brief Ustawia listę stacji, buduje dla niej indeks wyszukiwania i indeks przestrzenny
+ * oraz wypełnia listę rozwijaną.
+ *
+ * @param list Stacje (z API lub z lokalnej bazy).
+ * @param parameterMasks Maski wskaźników stacji.
+ */
+void MainFrame::SetStations(const std::vector<Station>& list, const std::vector<uint32_t>& parameterMasks) {
+    stations = list;
+    stationSearchIndex = StationSearchIndex(stations);
+    stationParameters = parameterMasks;
+    stationParameters.resize(stations.size(), 0);
+    stationIndex = StationIndex(stations, stationParameters);
+    stationRows.clear();
+    ShowStations();
+}
+
+/**
+ * @brief Wyznacza maski wskaźników stacji z czujników zapisanych w lokalnej bazie.
+ *
+ * Stacje, których czujniki nie były jeszcze zapisane, dostają maskę 0 i nie pasują do żadnego
+ * filtra wskaźnika, dopóki ich czujniki nie zostaną wczytane (UpdateStationParameters).
+ *
+ * @param list Stacje.
+ * @return Maski równoległe do listy.
+ */
+std::vector<uint32_t> MainFrame::LoadParameterMasks(const std::vector<Station>& list) {
+    std::vector<uint32_t> masks;
+    masks.reserve(list.size());
+    for (const auto& station : list) {
+        masks.push_back(StationIndex::parameterMask(dbManager.getSavedSensors(station.getId())));
+    }
+    return masks;
+}
+
+/**
+ * @brief Uaktualnia maskę wskaźników stacji po wczytaniu jej czujników.
+ *
+ * Indeks ma kilkaset stacji, więc jest przebudowywany w całości (tylko gdy maska się zmieniła).
+ *
+ * @param stationId ID stacji.
+ * @param sensors Czujniki stacji.
+ */
+void MainFrame::UpdateStationParameters(int stationId, const std::vector<Sensor>& sensors) {
+    const uint32_t mask = StationIndex::parameterMask(sensors);
+    for (size_t i = 0; i < stations.size(); i++) {
+        if (stations[i].getId() != stationId) continue;
+        if (stationParameters[i] == mask) return;
+        stationParameters[i] = mask;
+        stationIndex = StationIndex(stations, stationParameters);
+        return;
+    }
+}
+
+/**
+ * @brief Tworzy opis najbliższych stacji mierzących ten sam wskaźnik co czujnik.
+ *
+ * @param station Stacja czujnika.
+ * @param sensor Czujnik.
+ * @return Opis lub pusty tekst.
+ */
+wxString MainFrame::DescribeNearestStations(const Station& station, const Sensor& sensor) const {
+    const size_t NEAREST_STATIONS = 3;
+    const uint32_t bit = StationIndex::parameterBit(sensor.getParamFormula());
+    if (bit == 0 || !station.hasLocation()) return wxString();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    size_t count = 0;
+    for (const auto& hit : stationIndex.nearest(station.getLatitude(), station.getLongitude(), NEAREST_STATIONS + 1, bit)) {
+        if (stations[hit.index].getId() == station.getId()) continue;
+        if (count == NEAREST_STATIONS) break;
+        out << (count == 0 ? "" : ", ") << stations[hit.index].getName() << " (" << hit.distanceKm << " km)";
+        count++;
+    }
+    if (count == 0) return wxString();
+    return wxString::FromUTF8("Najbliższe stacje mierzące " + sensor.getParamFormula() + ": " + out.str());
+}
+
+/**
+ * @brief Wypełnia listę rozwijaną stacjami pasującymi do tekstu wyszukiwarki.
+ *
+ * Pusty tekst pokazuje wszystkie stacje w kolejności z API; w przeciwnym razie stacje są
+ * ułożone od najlepiej pasującej. Wybrana stacja pozostaje zaznaczona, jeśli nadal jest na liście.
+ */
+void MainFrame::ShowStations() {
+    const int selected = GetSelectedStation();
+    const std::string query(stationSearch->GetValue().utf8_str());
+
+    stationRows.clear();
+    if (StationSearchIndex::normalize(query).empty()) {
+        for (size_t i = 0; i < stations.size(); i++) {
+            stationRows.push_back(i);
+        }
+    }
+    else {
+        for (const auto& hit : stationSearchIndex.search(query, stations.size())) {
+            stationRows.push_back(hit.index);
+        }
+    }
+
+    wxArrayString names;
+    for (size_t index : stationRows) {
+        names.Add(wxString::FromUTF8(stations[index].getName()));
+    }
+    stationCombo->Set(names);
+
+    for (size_t row = 0; row < stationRows.size(); row++) {
+        if (static_cast<int>(stationRows[row]) == selected) {
+            stationCombo->SetSelection(static_cast<int>(row));
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Zwraca indeks wybranej stacji w wektorze stations.
+ *
+ * @return Indeks stacji lub wxNOT_FOUND, jeśli żadna stacja nie jest wybrana.
+ */
+int MainFrame::GetSelectedStation() const {
+    const int row = stationCombo->GetSelection();
+    if (row == wxNOT_FOUND || row >= static_cast<int>(stationRows.size())) return wxNOT_FOUND;
+    return static_cast<int>(stationRows[row]);
+}
+
+/**
+ * @brief Zawęża listę stacji po każdej zmianie tekstu wyszukiwarki.
+ *
+ * @param event Zdarzenie zmiany tekstu.
+ */
+void MainFrame::OnStationSearch(wxCommandEvent& event) {
+    ShowStations();
+}
+
+/**
+ * @brief Wybiera najlepiej pasującą stację (Enter lub przycisk lupy w wyszukiwarce).
+ *
+ * @param event Zdarzenie zatwierdzenia wyszukiwania.
+ */
+void MainFrame::OnStationSearchEnter(wxCommandEvent& event) {
+    if (stationRows.empty()) return;
+    stationCombo->SetSelection(0);
+    wxCommandEvent selectEvent(wxEVT_COMBOBOX, stationCombo->GetId());
+    OnStationSelected(selectEvent);
+}
+
+/**
+ * @brief Obsługuje zdarzenie wyboru stacji z listy.
+ *
+ * W zależności od trybu (online/offline), ładuje w tle czujniki z API lub z bazy danych dla wybranej
+ * stacji. Wybór innej stacji w trakcie ładowania odrzuca wynik poprzedniego zapytania.
+ *
+ * @param event Zdarzenie wxEVT_COMBOBOX związane z wyborem stacji.
+ */
+void MainFrame::OnStationSelected(wxCommandEvent& event) {
+    int sel = GetSelectedStation();
+    if (sel == wxNOT_FOUND) return;
+
+    int stationId = stations[sel].getId();
+
+	// Wyczyszanie poprzednich czujników
+    sensorCombo->Clear();
+    currentSensors.clear();
+
+    const bool offline = isOfflineMode;
+    RunInBackground(wxString::FromUTF8("Pobieranie czujników stacji..."),
+        [this, stationId, offline](const CancellationToken&) -> std::function<void()> {
+            if (offline) {
+                // pobieranie czujnikow z bazy
+                std::vector<Sensor> dbSensors = dbManager.getSavedSensors(stationId);
+                return [this, stationId, dbSensors]() {
+                    UpdateStationParameters(stationId, dbSensors);
+                    if (dbSensors.empty()) {
+                        sensorCombo->Append("Brak zapisanych czujników dla tej stacji");
+                        sensorCombo->Disable();
+                        return;
+                    }
+
+                    // Dodaje dane  do comboboxa
+                    for (const auto& sensor : dbSensors) {
+                        sensorCombo->Append(wxString::FromUTF8(sensor.getParamName()));
+                    }
+                    currentSensors = dbSensors;
+                    sensorCombo->Enable();
+                };
+            }
+
+            // Pobieranie czujników z API
+            try {
+                std::vector<Sensor> sensors = api.getSensors(stationId);
+                return [this, stationId, sensors]() {
+                    UpdateStationParameters(stationId, sensors);
+                    currentSensors = sensors;
+                    for (const auto& sensor : currentSensors) {
+                        sensorCombo->Append(wxString::FromUTF8(sensor.getParamName()));
+                    }
+                };
+            }
+            catch (const std::exception& e) {
+                std::string message = e.what();
+                std::vector<Station> dbStations = dbManager.getSavedStations();
+                std::vector<uint32_t> masks = LoadParameterMasks(dbStations);
+                return [this, message, dbStations, masks]() {
+                    wxMessageBox("Błąd podczas pobierania czujników: " + message,
+                        "Błąd", wxOK | wxICON_ERROR);
+                    SwitchToOfflineMode(dbStations, masks);
+                };
+            }
+        });
+}
+
+/**
+ * @brief Unieważnia wynik operacji w tle po zmianie wybranego czujnika.
+ *
+ * Etykieta informacyjna pokazuje najbliższe stacje mierzące ten sam wskaźnik. Jeśli seria czujnika
+ * jest w pamięci sesji (pobrana lub wczytana wcześniej), jest od razu pokazywana dla wybranego
+ * zakresu dat - bez zapytania do API i odczytu bazy.
+ *
+ * @param event Zdarzenie wxEVT_COMBOBOX związane z wyborem czujnika.
+ */
+void MainFrame::OnSensorSelected(wxCommandEvent& event) {
+    CancelBackground();
+    event.Skip();
+
+    const int selSensor = sensorCombo->GetSelection();
+    if (selSensor == wxNOT_FOUND || selSensor >= static_cast<int>(currentSensors.size())) return;
+
+    const int sel = GetSelectedStation();
+    const wxString nearestText = sel == wxNOT_FOUND ? wxString() :
+        DescribeNearestStations(stations[sel], currentSensors[selSensor]);
+    if (!nearestText.empty()) {
+        infoLabel->SetLabel(isOfflineMode ? "TRYB OFFLINE - dane z lokalnej bazy\n" + nearestText : nearestText);
+        infoLabel->Show();
+        panel->Layout();
+    }
+
+    std::shared_ptr<const SeriesCache::Entry> entry = seriesCache.find(currentSensors[selSensor].getId());
+    if (entry) {
+        currentMeasurements = entry->measurements;
+        ShowCachedRange(entry);
+    }
+}
+
+/**
+ * @brief Wybiera na nowo pomiary pokazywanej serii po zmianie zakresu dat.
+ *
+ * Seria jest brana z pamięci sesji, więc tabela i wykres są aktualizowane od razu (a analiza
+ * w tle), bez ponownego pobierania danych. Jeśli żadna seria nie jest pokazywana, zmiana zakresu
+ * zostanie uwzględniona przy najbliższym pobraniu lub wczytaniu.
+ *
+ * @param event Zdarzenie zmiany daty.
+ */
+void MainFrame::OnDateRangeChanged(wxDateEvent& event) {
+    event.Skip();
+
+    std::shared_ptr<const SeriesCache::Entry> entry = seriesCache.find(displayedSensorId);
+    int64_t from, to;
+    if (!entry || !GetSelectedRange(from, to) || (from == displayedFrom && to == displayedTo)) return;
+    ShowCachedRange(entry);
+}
+
+/**
+ * @brief Odczytuje zakres dat z kontrolek "Od" i "Do".
+ *
+ * @param from Zmienna na początek zakresu (północ dnia "Od").
+ * @param to Zmienna na koniec zakresu (północ dnia następującego po dniu "Do").
+ * @return false jeśli data początkowa jest późniejsza od końcowej.
+ */
+bool MainFrame::GetSelectedRange(int64_t& from, int64_t& to) const {
+    wxDateTime fromDate = dateFrom->GetValue();
+    wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
+    if (fromDate > toDate) return false;
+    from = MeasurementSeries::makeTimestamp(fromDate.GetYear(), fromDate.GetMonth() + 1, fromDate.GetDay());
+    to = MeasurementSeries::makeTimestamp(toDate.GetYear(), toDate.GetMonth() + 1, toDate.GetDay());
+    return true;
+}
+
+/**
+ * @brief Pokazuje serię z pamięci sesji dla wybranego zakresu dat (tabela, analiza, wykres, mapa ciepła).
+ *
+ * Wycinek jest wyznaczany wyszukiwaniem binarnym w przeliczonych wcześniej znacznikach czasu
+ * i od razu trafia do tabeli, wykresu i mapy ciepła; opis analizy (kwantyle, trend, średnie
+ * kroczące) jest liczony w tle, więc długa seria nie blokuje okna. Przy nakładaniu serii wykres
+ * porównawczy nie jest zmieniany.
+ *
+ * @param entry Seria czujnika.
+ */
+void MainFrame::ShowCachedRange(std::shared_ptr<const SeriesCache::Entry> entry) {
+    int64_t from, to;
+    if (!GetSelectedRange(from, to)) return;
+
+    auto filtered = std::make_shared<std::vector<Measurement>>();
+    std::vector<int64_t> timestamps;
+    entry->slice(from, to, *filtered, timestamps);
+    displayedSensorId = entry->sensor.getId();
+    displayedFrom = from;
+    displayedTo = to;
+
+    dataList->SetData(*filtered, timestamps);
+
+    wxString chartTitle = wxString::Format(entry->fromDatabase ? "Wykres pomiarów %s (dane z bazy)" : "Wykres pomiarów %s",
+        wxString::FromUTF8(entry->sensor.getParamName()));
+    heatmapPanel->SetData(*filtered, chartTitle);
+    if (!overlayCheck->IsChecked()) {
+        chartPanel->SetData(*filtered, chartTitle);
+        chartFormula = entry->sensor.getParamFormula();
+    }
+
+    // Analiza w tle - wynik jest pokazywany tylko, jeśli w międzyczasie nie pokazano innego zakresu
+    analysisToken.cancel();
+    analysisToken = CancellationToken();
+    const unsigned generation = ++analysisGeneration;
+    extraText->SetValue(wxString::FromUTF8("Obliczanie analizy..."));
+
+    backgroundTasks.erase(std::remove_if(backgroundTasks.begin(), backgroundTasks.end(),
+        [](const TaskScheduler::TaskHandle& task) { return task.isDone(); }), backgroundTasks.end());
+
+    std::shared_ptr<const std::vector<Measurement>> slice = filtered;
+    backgroundTasks.push_back(TaskScheduler::shared().submit(
+        [this, generation, entry, slice](const CancellationToken& token) {
+            bool hasData;
+            std::string analysisText = DescribeAnalysis(*entry, *slice, hasData);
+            if (token.isCancelled()) return;
+            CallAfter([this, generation, analysisText]() {
+                if (generation != analysisGeneration) return;  // analiza nieaktualna
+                extraText->SetValue(analysisText);
+            });
+        }, TaskScheduler::Priority::INTERACTIVE, analysisToken));
+}
+
+/**
+ * @brief Oznacza serię przygotowaną w tle jako pokazywaną.
+ *
+ * Jeśli w trakcie pobierania lub wczytywania zmieniono zakres dat, wycinek i analiza przygotowane
+ * w tle są nieaktualne - seria jest wtedy od razu pokazywana dla nowego zakresu z pamięci sesji.
+ *
+ * @param entry Seria czujnika.
+ * @param from Początek zakresu, dla którego przygotowano wynik.
+ * @param to Koniec zakresu, dla którego przygotowano wynik.
+ * @return true jeśli seria została pokazana dla nowego zakresu.
+ */
+bool MainFrame::ShowIfRangeChanged(std::shared_ptr<const SeriesCache::Entry> entry, int64_t from, int64_t to) {
+    int64_t selectedFrom, selectedTo;
+    if (GetSelectedRange(selectedFrom, selectedTo) && (selectedFrom != from || selectedTo != to)) {
+        ShowCachedRange(entry);
+        return true;
+    }
+    displayedSensorId = entry->sensor.getId();
+    displayedFrom = from;
+    displayedTo = to;
+    analysisGeneration++;  // analiza przygotowana w tle zastępuje analizę liczoną po zmianie zakresu
+    return false;
+}
+
+/**
+ * @brief Tworzy opis analizy pomiarów (statystyki, kwantyle, trend, średnie kroczące).
+ *
+ * Nie korzysta z kontrolek okna, więc może działać w wątku roboczym.
+ *
+ * @param entry Seria czujnika (nazwa i wzór wskaźnika, źródło danych).
+ * @param measurements Pomiary z wybranego zakresu dat.
+ * @param hasData Zmienna na informację, czy w zakresie są pomiary z wartością.
+ * @return Tekst analizy.
+ */
+std::string MainFrame::DescribeAnalysis(const SeriesCache::Entry& entry, const std::vector<Measurement>& measurements,
+    bool& hasData) {
+    MeasurementAnalyzer analyzer(measurements);
+    hasData = analyzer.hasData();
+    if (!hasData) {
+        return "Brak danych pomiarowych w wybranym zakresie dat.\n";
+    }
+
+    std::ostringstream out;
+    out << "Analiza dla czujnika: " << entry.sensor.getParamName() << (entry.fromDatabase ? " (dane z bazy)" : "") << "\n\n";
+    out << "Liczba pomiarów: " << measurements.size() << "\n";
+    out << "Min: " << analyzer.getMinValue() << " (" << analyzer.getMinDate() << ")\n";
+    out << "Max: " << analyzer.getMaxValue() << " (" << analyzer.getMaxDate() << ")\n";
+    out << "Średnia: " << analyzer.getAverage() << "\n";
+    out << "Odchylenie standardowe: " << std::sqrt(analyzer.getVariance()) << "\n";
+    std::vector<double> quantiles = analyzer.getQuantiles({ 0.5, 0.9, 0.98 });
+    out << "Mediana: " << quantiles[0] << ", P90: " << quantiles[1] << ", P98: " << quantiles[2] << "\n";
+    out << "Trend: " << analyzer.getTrendDescription() << "\n";
+    out << "Trend względem czasu (Theil-Sen): "
+        << TrendAnalyzer::describe(TrendAnalyzer::analyze(MeasurementSeries(measurements))) << "\n";
+    out << DescribeRollingMetrics(entry.sensor.getParamFormula(), measurements);
+    return out.str();
+}
+
+/**
+ * @brief Przewija tabelę pomiarów do pierwszego pomiaru z wybranego dnia (lub najbliższego późniejszego).
+ *
+ * @param event Zdarzenie zmiany daty.
+ */
+void MainFrame::OnJumpToDate(wxDateEvent& event) {
+    const wxDateTime date = event.GetDate();
+    if (!date.IsValid()) return;
+    dataList->JumpToTimestamp(MeasurementSeries::makeTimestamp(date.GetYear(), date.GetMonth() + 1, date.GetDay()));
+}
+
+/**
+ * @brief Pobiera dane pomiarowe z API i wykonuje analizę.
+ *
+ * Weryfikuje wybór stacji i czujnika oraz zakres dat, a następnie w tle pobiera dane z API, analizuje je
+ * i przygotowuje opis tekstowy. Wyniki są wyświetlane (w tabeli, w analizie i na wykresie) w wątku GUI, o ile
+ * w międzyczasie nie zmieniono wyboru. Pobrana seria trafia do pamięci sesji, więc późniejsza zmiana
+ * zakresu dat nie wymaga ponownego pobierania. Aktywuje przycisk zapisu danych do bazy.
+ *
+ * @param event Zdarzenie kliknięcia przycisku "Pobierz dane".
+ */
+void MainFrame::OnFetch(wxCommandEvent& event) {
+    int selStation = GetSelectedStation();
+    int selSensor = sensorCombo->GetSelection();
+
+    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND) {
+        wxMessageBox("Wybierz stację i czujnik!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    int64_t from, to;
+    if (!GetSelectedRange(from, to)) {
+        wxMessageBox(wxString::Format("Błąd: %s", "Data początkowa nie może być późniejsza od końcowej."),
+            "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    const Station station = stations[selStation];
+    const Sensor sensor = currentSensors[selSensor];
+    const std::vector<Sensor> stationSensors = currentSensors;
+
+    RunInBackground(wxString::FromUTF8("Pobieranie pomiarów " + sensor.getParamName() + "..."),
+        [this, station, sensor, stationSensors, from, to](const CancellationToken& token) -> std::function<void()> {
+            int stationId = station.getId();
+
+            // Pomiar
+            auto measurements = api.getSensorData(sensor.getId());
+            if (token.isCancelled()) return {};
+
+            // Flagi jakości liczone na kopii stanu sensora - wspólny monitor zmienia się dopiero
+            // po pokazaniu wyniku, więc anulowane lub zastąpione pobranie go nie modyfikuje
+            AnomalyMonitor sensorMonitor;
+            {
+                std::lock_guard<std::mutex> lock(anomalyMutex);
+                sensorMonitor = anomalyMonitor.extract(sensor.getId());
+            }
+            sensorMonitor.process(sensor.getId(), measurements);
+
+            // Indeks jakości powietrza - liczony lokalnie, API gdy brak aktualnych pomiarów któregoś wskaźnika
+            auto index = ComputeLocalIndex(stationId, sensor.getParamFormula(), measurements, stationSensors);
+            std::string indexSource = " (obliczony lokalnie)";
+            if (!index.count("Ogólny")) {
+                indexSource.clear();
+                try {
+                    index = api.getAirQualityIndex(stationId);
+                }
+                catch (const std::exception& e) {
+                    // Brak indeksu nie przerywa wyświetlania pomiarów
+                }
+            }
+            wxString indexLabel = index.count("Ogólny")
+                ? wxString::FromUTF8("Ogólny indeks jakości powietrza: " + index["Ogólny"] + indexSource)
+                : wxString("Brak ogólnego indeksu jakości powietrza.");
+
+            // Seria do pamięci sesji (daty parsowane raz) i wycinek z wybranego zakresu
+            auto entry = std::make_shared<const SeriesCache::Entry>(station, sensor, measurements, false);
+            std::vector<Measurement> filtered;
+            std::vector<int64_t> timestamps;
+            entry->slice(from, to, filtered, timestamps);
+
+            // Analiza
+            bool hasData;
+            std::string analysisText = DescribeAnalysis(*entry, filtered, hasData);
+
+            return [this, station, sensor, entry, measurements, filtered, timestamps, from, to, indexLabel, analysisText, hasData,
+                sensorMonitor]() {
+                {
+                    std::lock_guard<std::mutex> lock(anomalyMutex);
+                    anomalyMonitor.commit(sensorMonitor);
+                }
+                currentMeasurements = measurements;  // zapisz dla bazy danych
+                seriesCache.store(entry);
+
+                wxString latestDayText = UpdateLatestDay(*entry);
+                infoLabel->SetLabel(latestDayText.empty() ? indexLabel : indexLabel + "\n" + latestDayText);
+                infoLabel->Show();
+                panel->Layout(); // Odśwież układ
+                saveToDbBtn->Enable();
+
+                if (ShowIfRangeChanged(entry, from, to)) return;
+
+                dataList->SetData(filtered, timestamps);
+                if (!hasData) {
+                    wxMessageBox(wxString::Format("Błąd: %s", "Brak danych pomiarowych."), "Błąd", wxOK | wxICON_ERROR);
+                    return;
+                }
+                extraText->SetValue(analysisText);
+
+                // Utwórz tytuł wykresu
+                wxString chartTitle = wxString::Format("Wykres pomiarów %s",
+                    wxString::FromUTF8(sensor.getParamName()));
+
+                // Ustaw dane na wykresie
+                ShowOnChart(filtered, station, sensor, chartTitle);
+
+                // Przełącz na zakładkę z wykresem
+                notebook->SetSelection(1);
+            };
+        });
+}
+/**
+ * @brief Zapisuje dane pomiarowe do lokalnej bazy danych.
+ *
+ * Weryfikuje wybór stacji i czujnika, a następnie w tle zapisuje dane do pliku JSON.
+ * Informuje użytkownika o sukcesie lub błędzie operacji. Anulowanie przerywa jedynie pobieranie
+ * indeksu - rozpoczęty zapis pliku jest zawsze kończony.
+ *
+ * @param event Zdarzenie kliknięcia przycisku "Zapisz do bazy danych".
+ */
+// Implementation of the OnSaveToDb method
+void MainFrame::OnSaveToDb(wxCommandEvent& event) {
+    int selStation = GetSelectedStation();
+    int selSensor = sensorCombo->GetSelection();
+
+    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND || currentMeasurements.empty()) {
+        wxMessageBox("Brak danych do zapisania!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    const Station station = stations[selStation];
+    const Sensor sensor = currentSensors[selSensor];
+    const std::vector<Measurement> measurements = currentMeasurements;
+    const std::vector<Sensor> stationSensors = currentSensors;
+    const bool offline = isOfflineMode;
+
+    RunInBackground("Zapisywanie do bazy danych...",
+        [this, station, sensor, measurements, stationSensors, offline](const CancellationToken&) -> std::function<void()> {
+            int stationId = station.getId();
+
+            // Indeks jakości powietrza do zapisania - liczony lokalnie z posiadanych pomiarów
+            // (indeks ogólny tylko przy aktualnych pomiarach wszystkich wskaźników stacji)
+            std::map<std::string, std::string> indexValues =
+                ComputeLocalIndex(stationId, sensor.getParamFormula(), measurements, stationSensors);
+
+            // Jeśli indeks lokalny jest niepełny, a jesteśmy w trybie online, pobierz indeks z API;
+            // w przeciwnym razie zapisywane są tylko indeksy wskaźników, bez częściowego indeksu ogólnego
+            if (!indexValues.count("Ogólny") && !offline) {
+                try {
+                    indexValues = api.getAirQualityIndex(stationId);
+                }
+                catch (const std::exception& e) {
+                    // Jeśli nie uda się pobrać indeksu, ignorujemy błąd
+                    // i kontynuujemy z zapisem danych pomiarowych
+                }
+            }
+
+            // Przekazujemy dane pomiarowe i indeksy jakości powietrza do zapisania
+            bool saved = dbManager.saveData(stationId, station.getName(), sensor.getId(), sensor.getParamName(),
+                measurements, indexValues, sensor.getParamFormula());
+
+            if (!saved) {
+                throw std::runtime_error("Nie udało się zapisać danych do bazy danych.");
+            }
+            return []() {
+                wxMessageBox("Dane zostały zapisane do bazy danych!", "Sukces", wxOK | wxICON_INFORMATION);
+            };
+        });
+}
+/**
+ * @brief Wczytuje dane pomiarowe z lokalnej bazy danych i analizuje je.
+ *
+ * Odczyt, filtrowanie po wybranym zakresie dat i analiza odbywają się w tle; analiza oraz wykres
+ * są pokazywane w wątku GUI. Wczytana seria trafia do pamięci sesji (jak seria pobrana z API).
+ *
+ * @param event Zdarzenie kliknięcia przycisku "Wczytaj z bazy danych".
+ */
+void MainFrame::OnLoadFromDb(wxCommandEvent& event) {
+    int selStation = GetSelectedStation();
+    int selSensor = sensorCombo->GetSelection();
+    if (selStation == wxNOT_FOUND || selSensor == wxNOT_FOUND) {
+        wxMessageBox("Wybierz stację i czujnik!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    // dane flitrowane poprzez date
+    int64_t from, to;
+    if (!GetSelectedRange(from, to)) {
+        wxMessageBox(wxString::Format("Błąd: %s", "Data początkowa nie może być późniejsza od końcowej."),
+            "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    const Station station = stations[selStation];
+    const Sensor sensor = currentSensors[selSensor];
+
+    RunInBackground("Wczytywanie z bazy danych...",
+        [this, station, sensor, from, to](const CancellationToken& token) -> std::function<void()> {
+            int stationId = station.getId();
+            std::vector<Measurement> measurements;
+            try {
+                if (!dbManager.loadData(stationId, sensor.getId(), measurements)) {
+                    return []() {
+                        wxMessageBox("Brak danych dla wybranej stacji i czujnika w bazie danych.",
+                            "Informacja", wxOK | wxICON_INFORMATION);
+                    };
+                }
+
+                // Próba wczytania indeksu jakości powietrza
+                std::map<std::string, std::string> airQualityIndex;
+                wxString indexLabel = "Dane wczytane z lokalnej bazy";
+                if (dbManager.loadAirQualityIndex(stationId, airQualityIndex) &&
+                    airQualityIndex.count("Ogólny")) {
+                    indexLabel = wxString::FromUTF8("Ogólny indeks jakości powietrza: " +
+                        airQualityIndex["Ogólny"] + " (dane z bazy)");
+                }
+                if (token.isCancelled()) return {};
+
+                // Seria do pamięci sesji i wycinek z wybranego zakresu
+                auto entry = std::make_shared<const SeriesCache::Entry>(station, sensor, measurements, true);
+                std::vector<Measurement> filtered;
+                std::vector<int64_t> timestamps;
+                entry->slice(from, to, filtered, timestamps);
+
+                // Analizuje dane
+                bool hasData;
+                std::string analysisText = DescribeAnalysis(*entry, filtered, hasData);
+
+                return [this, station, sensor, entry, measurements, filtered, timestamps, from, to, indexLabel, analysisText, hasData]() {
+                    currentMeasurements = measurements;
+                    seriesCache.store(entry);
+                    infoLabel->SetLabel(indexLabel);
+                    if (!isOfflineMode) {
+                        infoLabel->SetForegroundColour(*wxBLUE);
+                    }
+                    infoLabel->Show();
+                    panel->Layout();
+
+                    if (ShowIfRangeChanged(entry, from, to)) return;
+
+                    // Pokazuje dane
+                    dataList->SetData(filtered, timestamps);
+                    if (hasData) {
+                        // ustawienie wykresu
+                        wxString chartTitle = wxString::Format("Wykres pomiarów %s (dane z bazy)",
+                            wxString::FromUTF8(sensor.getParamName()));
+                        ShowOnChart(filtered, station, sensor, chartTitle);
+                        // Zamiast pokazywać wykres, pokazuje dane
+                        notebook->SetSelection(1);
+                    }
+                    extraText->SetValue(analysisText);
+                };
+            }
+            catch (const std::exception& e) {
+                std::string message = e.what();
+                return [message]() {
+                    wxMessageBox(wxString::Format("Błąd podczas wczytywania danych: %s", message.c_str()),
+                        "Błąd", wxOK | wxICON_ERROR);
+                };
+            }
+        });
+}
+/**
+ * @brief Eksportuje zapisane dane wybranej stacji i czujnika do pliku Apache Arrow (Feather v2).
+ *
+ * Eksportowany jest zakres dat wybrany w kontrolkach "Od" i "Do". Jeśli nie wybrano czujnika,
+ * eksportowane są wszystkie zapisane czujniki stacji. Plik jest wybierany przed rozpoczęciem
+ * operacji, a wczytanie danych z bazy i zapis pliku odbywają się w tle.
+ *
+ * @param event Zdarzenie kliknięcia przycisku "Eksportuj (Arrow)".
+ */
+void MainFrame::OnExportArrow(wxCommandEvent& event) {
+    int selStation = GetSelectedStation();
+    int selSensor = sensorCombo->GetSelection();
+
+    if (selStation == wxNOT_FOUND) {
+        wxMessageBox("Wybierz stację!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+
+    wxFileDialog saveDialog(this, "Eksportuj dane", "", "dane.arrow",
+        "Pliki Arrow/Feather (*.arrow;*.feather)|*.arrow;*.feather", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (saveDialog.ShowModal() == wxID_CANCEL) return;
+    const std::string path = saveDialog.GetPath().ToStdString();
+
+    wxDateTime fromDate = dateFrom->GetValue();
+    wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
+
+    ArrowExporter::Selection selection;
+    selection.stationId = stations[selStation].getId();
+    selection.sensorId = (selSensor == wxNOT_FOUND || currentSensors.empty()) ? -1 : currentSensors[selSensor].getId();
+    selection.from = MeasurementSeries::makeTimestamp(fromDate.GetYear(), fromDate.GetMonth() + 1, fromDate.GetDay());
+    selection.to = MeasurementSeries::makeTimestamp(toDate.GetYear(), toDate.GetMonth() + 1, toDate.GetDay());
+
+    RunInBackground(wxString::FromUTF8("Przygotowywanie eksportu..."),
+        [this, selection, path](const CancellationToken& token) -> std::function<void()> {
+            const std::vector<ArrowExporter::Batch> batches = ArrowExporter(dbManager).collectBatches({ selection });
+            if (token.isCancelled()) return {};
+
+            const bool saved = ArrowExporter::writeFile(batches, path);
+            return [saved]() {
+                if (saved) {
+                    wxMessageBox("Dane zostały wyeksportowane.", "Sukces", wxOK | wxICON_INFORMATION);
+                }
+                else {
+                    wxMessageBox("Nie udało się zapisać pliku.", "Błąd", wxOK | wxICON_ERROR);
+                }
+            };
+        });
+}
+
+/**
+ * @brief Zlicza przekroczenia norm UE dla wszystkich stacji i wskaźników zapisanych w bazie.
+ *
+ * Uwzględnia zakres dat wybrany w kontrolkach. Wynik (liczba przekroczeń, pierwsze i ostatnie
+ * przekroczenie, najdłuższy epizod) jest liczony w tle i wyświetlany w polu analizy.
+ *
+ * @param event Zdarzenie kliknięcia przycisku.
+ */
+void MainFrame::OnCheckExceedances(wxCommandEvent& event) {
+    wxDateTime fromDate = dateFrom->GetValue();
+    wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
+    int64_t from = MeasurementSeries::makeTimestamp(fromDate.GetYear(), fromDate.GetMonth() + 1, fromDate.GetDay());
+    int64_t to = MeasurementSeries::makeTimestamp(toDate.GetYear(), toDate.GetMonth() + 1, toDate.GetDay());
+    const std::string header = "Przekroczenia norm UE (" + std::string(fromDate.FormatISODate().ToStdString()) + " - " +
+        std::string(dateTo->GetValue().FormatISODate().ToStdString()) + ")\n\n";
+
+    RunInBackground(wxString::FromUTF8("Sprawdzanie przekroczeń norm..."),
+        [this, from, to, header](const CancellationToken& token) -> std::function<void()> {
+            ExceedanceEngine engine(dbManager);
+            std::vector<ExceedanceEngine::Result> results = engine.evaluateAll(from, to);
+            if (token.isCancelled()) return {};
+            if (results.empty()) {
+                return []() {
+                    wxMessageBox("Brak zapisanych danych ze wskaźnikami objętymi normami.", "Informacja",
+                        wxOK | wxICON_INFORMATION);
+                };
+            }
+
+            std::map<int, std::string> stationNames;
+            for (const auto& station : dbManager.getSavedStations()) {
+                stationNames[station.getId()] = station.getName();
+            }
+
+            std::ostringstream out;
+            out << header;
+            for (const auto& result : results) {
+                const ExceedanceEngine::Threshold& threshold = engine.getThresholds().at(result.formula);
+                const char* unit = threshold.averaging == ExceedanceEngine::Averaging::HOURLY ? "godz." : "dni";
+
+                out << stationNames[result.stationId] << " - " << result.formula << ": "
+                    << result.exceedances << " z " << result.evaluatedPeriods << " " << unit;
+                if (threshold.allowedPerYear >= 0) {
+                    out << " (dopuszczalne " << threshold.allowedPerYear << " w roku)";
+                }
+                out << "\n";
+                if (result.exceedances > 0) {
+                    out << "    pierwsze: " << MeasurementSeries::formatTimestamp(result.firstExceedance)
+                        << ", ostatnie: " << MeasurementSeries::formatTimestamp(result.lastExceedance) << "\n";
+                    out << "    najdłuższy epizod: " << result.longestEpisode << " " << unit << " od "
+                        << MeasurementSeries::formatTimestamp(result.longestEpisodeStart) << "\n";
+                }
+            }
+
+            const std::string text = out.str();
+            return [this, text]() {
+                analysisGeneration++;  // zestawienie zastępuje analizę liczoną w tle
+                extraText->SetValue(wxString::FromUTF8(text));
+                notebook->SetSelection(0);
+            };
+        });
+}
+
+/**
+ * @brief Eksportuje macierz korelacji wybranego wskaźnika między wszystkimi stacjami zapisanymi w bazie.
+ *
+ * Po wyborze pliku serie z wybranego zakresu dat są w tle wyrównywane do siatki godzinowej
+ * i korelowane, a następnie (także w tle) zapisywane są dwa pliki CSV: macierz korelacji
+ * Pearsona oraz 5 najbardziej skorelowanych sąsiadów każdej stacji.
+ *
+ * @param event Zdarzenie kliknięcia przycisku.
+ */
+void MainFrame::OnExportCorrelations(wxCommandEvent& event) {
+    int selSensor = sensorCombo->GetSelection();
+    if (selSensor == wxNOT_FOUND || currentSensors[selSensor].getParamFormula().empty()) {
+        wxMessageBox("Wybierz czujnik (wskaźnik) do porównania między stacjami!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+    const std::string formula = currentSensors[selSensor].getParamFormula();
+
+    wxFileDialog saveDialog(this, "Eksportuj macierz korelacji", "", "korelacje_" + formula + ".csv",
+        "Pliki CSV (*.csv)|*.csv", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (saveDialog.ShowModal() == wxID_CANCEL) return;
+    wxFileName neighborsFile(saveDialog.GetPath());
+    neighborsFile.SetName(neighborsFile.GetName() + "_sasiedzi");
+    const std::string matrixPath = saveDialog.GetPath().ToStdString();
+    const std::string neighborsPath = neighborsFile.GetFullPath().ToStdString();
+
+    wxDateTime fromDate = dateFrom->GetValue();
+    wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
+    int64_t from = MeasurementSeries::makeTimestamp(fromDate.GetYear(), fromDate.GetMonth() + 1, fromDate.GetDay());
+    int64_t to = MeasurementSeries::makeTimestamp(toDate.GetYear(), toDate.GetMonth() + 1, toDate.GetDay());
+
+    RunInBackground(wxString::FromUTF8("Obliczanie korelacji " + formula + "..."),
+        [this, formula, from, to, matrixPath, neighborsPath](const CancellationToken& token) -> std::function<void()> {
+            std::vector<MeasurementSeries> series;
+            std::vector<std::string> labels;
+            for (const auto& station : dbManager.getSavedStations()) {
+                if (token.isCancelled()) return {};
+                for (const auto& sensor : dbManager.getSavedSensors(station.getId())) {
+                    if (sensor.getParamFormula() != formula) continue;
+
+                    MeasurementSeries stored;
+                    if (!dbManager.loadSeries(station.getId(), sensor.getId(), stored)) continue;
+                    MeasurementSeries sliced = stored.slice(from, to);
+                    if (sliced.empty()) continue;
+
+                    series.push_back(std::move(sliced));
+                    labels.push_back(station.getName());
+                }
+            }
+
+            if (series.size() < 2) {
+                return []() {
+                    wxMessageBox("Za mało stacji z zapisanymi danymi tego wskaźnika w wybranym zakresie dat.",
+                        "Informacja", wxOK | wxICON_INFORMATION);
+                };
+            }
+
+            Resampler resampler(Resampler::HOUR);
+            CorrelationEngine engine(CorrelationEngine::Method::PEARSON);
+            const CorrelationEngine::Matrix matrix = engine.compute(resampler.resampleMany(series));
+            if (token.isCancelled()) return {};
+
+            const bool saved = CorrelationEngine::exportMatrixCsv(matrix, labels, matrixPath) &&
+                CorrelationEngine::exportNeighborsCsv(matrix, labels, 5, neighborsPath);
+            return [saved]() {
+                if (saved) {
+                    wxMessageBox("Macierz korelacji została zapisana.", "Sukces", wxOK | wxICON_INFORMATION);
+                }
+                else {
+                    wxMessageBox("Nie udało się zapisać pliku.", "Błąd", wxOK | wxICON_ERROR);
+                }
+            };
+        });
+}
+
+/**
+ * @brief Handler eksportu mapy stężeń wskaźnika.
+ *
+ * Dla wskaźnika wybranego czujnika pobiera z bazy ostatni prawidłowy pomiar z wybranego zakresu
+ * dat każdej zapisanej stacji o znanym położeniu i interpoluje je (IDW) w tle na siatkę 1 km
+ * obejmującą Polskę. Plik jest wybierany przed rozpoczęciem obliczeń; obraz PNG oraz surowy raster
+ * float32 (plik .flt z nagłówkiem .hdr) są zapisywane w tle (wxImage nie wymaga wątku GUI).
+ *
+ * @param event Zdarzenie kliknięcia przycisku.
+ */
+void MainFrame::OnExportMap(wxCommandEvent& event) {
+    int selSensor = sensorCombo->GetSelection();
+    if (selSensor == wxNOT_FOUND || currentSensors[selSensor].getParamFormula().empty()) {
+        wxMessageBox("Wybierz czujnik (wskaźnik), dla którego ma powstać mapa!", "Błąd", wxOK | wxICON_ERROR);
+        return;
+    }
+    const std::string formula = currentSensors[selSensor].getParamFormula();
+
+    wxFileDialog saveDialog(this, "Eksportuj mapę", "", "mapa_" + formula + ".png",
+        "Obrazy PNG (*.png)|*.png", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (saveDialog.ShowModal() == wxID_CANCEL) return;
+    const wxString imagePath = saveDialog.GetPath();
+    wxFileName rawFile(imagePath);
+    rawFile.SetExt("flt");
+    const std::string rawPath = rawFile.GetFullPath().ToStdString();
+
+    wxDateTime fromDate = dateFrom->GetValue();
+    wxDateTime toDate = dateTo->GetValue().Add(wxTimeSpan::Days(1));
+    int64_t from = MeasurementSeries::makeTimestamp(fromDate.GetYear(), fromDate.GetMonth() + 1, fromDate.GetDay());
+    int64_t to = MeasurementSeries::makeTimestamp(toDate.GetYear(), toDate.GetMonth() + 1, toDate.GetDay());
+
+    RunInBackground(wxString::FromUTF8("Interpolacja mapy " + formula + "..."),
+        [this, formula, from, to, imagePath, rawPath](const CancellationToken& token) -> std::function<void()> {
+            std::vector<SpatialInterpolator::Sample> samples;
+            double maxValue = 0.0;
+            for (const auto& station : dbManager.getSavedStations()) {
+                if (token.isCancelled()) return {};
+                if (!station.hasLocation()) continue;
+                for (const auto& sensor : dbManager.getSavedSensors(station.getId())) {
+                    if (sensor.getParamFormula() != formula) continue;
+
+                    MeasurementSeries stored;
+                    if (!dbManager.loadSeries(station.getId(), sensor.getId(), stored)) continue;
+                    MeasurementSeries sliced = stored.slice(from, to);
+                    for (size_t i = sliced.size(); i-- > 0;) {
+                        if (sliced.getValues()[i] >= 0) {
+                            samples.push_back({ station.getLatitude(), station.getLongitude(), sliced.getValues()[i] });
+                            maxValue = std::max(maxValue, sliced.getValues()[i]);
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if (samples.size() < 2) {
+                return []() {
+                    wxMessageBox("Za mało stacji o znanym położeniu z zapisanymi danymi tego wskaźnika w wybranym zakresie dat.",
+                        "Informacja", wxOK | wxICON_INFORMATION);
+                };
+            }
+
+            SpatialInterpolator interpolator;
+            const SpatialInterpolator::Raster raster = interpolator.interpolate(samples, SpatialInterpolator::Grid::poland(1.0));
+            const std::vector<uint8_t> rgb = SpatialInterpolator::toRgb(raster, 0.0, maxValue);
+            if (token.isCancelled()) return {};
+
+            wxImage image(static_cast<int>(raster.grid.cols), static_cast<int>(raster.grid.rows));
+            std::copy(rgb.begin(), rgb.end(), image.GetData());
+            const bool saved = image.SaveFile(imagePath, wxBITMAP_TYPE_PNG) &&
+                SpatialInterpolator::writeRawFloat(raster, rawPath);
+            return [saved]() {
+                if (saved) {
+                    wxMessageBox("Mapa została zapisana.", "Sukces", wxOK | wxICON_INFORMATION);
+                }
+                else {
+                    wxMessageBox("Nie udało się zapisać pliku.", "Błąd", wxOK | wxICON_ERROR);
+                }
+            };
+        });
+}
+
+/**
+ * @brief Wyznacza indeks jakości powietrza stacji lokalnie, bez zapytania do API.
+ *
+ * Pomiary przekazanego wskaźnika są uzupełniane pomiarami pozostałych wskaźników stacji
+ * zapisanymi w bazie; uwzględniane są tylko pomiary z ostatnich 3 godzin. Indeks ogólny jest
+ * wyznaczany tylko wtedy, gdy aktualny pomiar ma każdy indeksowany wskaźnik stacji.
+ *
+ * @param stationId ID stacji.
+ * @param formula Wzór wskaźnika, którego pomiary są przekazane.
+ * @param measurements Najnowsze pomiary wskaźnika.
+ * @param stationSensors Wszystkie czujniki stacji.
+ * @return Indeks w formacie ApiClient::getAirQualityIndex.
+ */
+std::map<std::string, std::string> MainFrame::ComputeLocalIndex(int stationId, const std::string& formula,
+    const std::vector<Measurement>& measurements, const std::vector<Sensor>& stationSensors) {
+    std::map<std::string, std::vector<Measurement>> byFormula;
+    for (const auto& sensor : dbManager.getSavedSensors(stationId)) {
+        if (sensor.getParamFormula().empty() || sensor.getParamFormula() == formula) continue;
+
+        std::vector<Measurement> stored;
+        if (dbManager.loadData(stationId, sensor.getId(), stored)) {
+            byFormula[sensor.getParamFormula()] = std::move(stored);
+        }
+    }
+    if (!formula.empty()) {
+        byFormula[formula] = measurements;
+    }
+
+    wxDateTime now = wxDateTime::Now();
+    int64_t nowTimestamp = MeasurementSeries::makeTimestamp(now.GetYear(), now.GetMonth() + 1, now.GetDay(),
+        now.GetHour(), now.GetMinute(), now.GetSecond());
+    std::vector<std::string> measuredFormulas;
+    for (const auto& sensor : stationSensors) {
+        measuredFormulas.push_back(sensor.getParamFormula());
+    }
+    return AirQualityIndexCalculator().compute(byFormula, nowTimestamp, measuredFormulas);
+}
+
+/**
+ * @brief Dopisuje nowe pomiary pobranej serii do statystyk ostatnich 24 godzin czujnika.
+ *
+ * Statystyki są utrzymywane przez IncrementalAnalyzer z oknem 24 h: przy kolejnym pobraniu tego
+ * samego czujnika dopisywane są tylko pomiary nowsze od ostatnio przyjętego, a najstarsze wypadają
+ * z okna, więc koszt jest proporcjonalny do liczby nowych pomiarów, a nie długości serii.
+ * Pomiary oznaczone jako podejrzane są traktowane jak brak pomiaru.
+ *
+ * @param entry Pobrana seria czujnika.
+ * @return Opis statystyk (pusty, jeśli w oknie nie ma pomiarów).
+ */
+wxString MainFrame::UpdateLatestDay(const SeriesCache::Entry& entry) {
+    IncrementalAnalyzer& analyzer = latestDay.emplace(entry.sensor.getId(), IncrementalAnalyzer(24 * 3600)).first->second;
+
+    auto next = std::upper_bound(entry.timestamps.begin(), entry.timestamps.end(), analyzer.getLastTimestamp());
+    for (size_t i = next - entry.timestamps.begin(); i < entry.timestamps.size(); i++) {
+        const Measurement& m = entry.measurements[i];
+        analyzer.push(entry.timestamps[i], m.isSuspect() ? -1.0 : m.getValue());
+    }
+
+    if (!analyzer.hasData()) return wxString();
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1) << "Ostatnie 24 h: średnia " << analyzer.getAverage()
+        << ", min " << analyzer.getMinValue() << ", max " << analyzer.getMaxValue()
+        << ", trend " << MeasurementAnalyzer::describeTrend(analyzer.getTrend());
+    return wxString(out.str());  // jak tekst analizy (DescribeAnalysis)
+}
+
+/**
+ * @brief Tworzy opis wskaźników regulacyjnych (średnie kroczące 24h/8h) dla wskaźnika.
+ *
+ * Dla pyłów wyznacza maksymalną 24-godzinną średnią kroczącą, a dla ozonu i tlenku węgla
+ * maksymalną 8-godzinną. Okna z pokryciem poniżej 75% są pomijane.
+ *
+ * @param formula Wzór wskaźnika (np. "PM10", "O3").
+ * @param measurements Pomiary z wybranego zakresu dat.
+ * @return Tekst do dołączenia do analizy (pusty, jeśli wskaźnik nie ma okna regulacyjnego).
+ */
+std::string MainFrame::DescribeRollingMetrics(const std::string& formula, const std::vector<Measurement>& measurements) {
+    RollingWindow window = RollingWindow::mean24h();
+    if (!RollingWindow::forParameter(formula, window)) {
+        return "";
+    }
+
+    RollingWindow::Result result = window.compute(MeasurementSeries(measurements));
+    size_t best = result.size();
+    for (size_t i = 0; i < result.size(); i++) {
+        if (result.means[i] >= 0 && (best == result.size() || result.means[i] > result.means[best])) {
+            best = i;
+        }
+    }
+
+    std::ostringstream out;
+    int hours = static_cast<int>(window.getWindowSeconds() / 3600);
+    if (best == result.size()) {
+        out << "Średnia krocząca " << hours << "h: za mało danych\n";
+    }
+    else {
+        out << "Maks. średnia krocząca " << hours << "h: " << result.means[best]
+            << " (" << MeasurementSeries::formatTimestamp(result.timestamps[best]) << ")\n";
+    }
+    return out.str();
+}
+
+/**
+ * @brief Pokazuje pomiary na wykresie - zastępując dotychczasowe serie lub nakładając nową.
+ *
+ * Nakładane serie są przekazywane do wykresu jako współdzielone MeasurementSeries (bez kopiowania
+ * przez panel) z etykietą "stacja - wskaźnik". Wskaźnik inny niż wskaźnik pierwszej serii trafia
+ * na prawą oś Y. Mapa ciepła zawsze pokazuje ostatnio wybraną serię.
+ *
+ * @param measurements Pomiary z wybranego zakresu dat.
+ * @param station Stacja pomiarowa.
+ * @param sensor Czujnik.
+ * @param title Tytuł wykresu.
+ */
+void MainFrame::ShowOnChart(const std::vector<Measurement>& measurements, const Station& station, const Sensor& sensor,
+    const wxString& title) {
+    heatmapPanel->SetData(measurements, title);
+
+    if (!overlayCheck->IsChecked()) {
+        chartPanel->SetData(measurements, title);
+        chartFormula = sensor.getParamFormula();
+        return;
+    }
+    if (chartPanel->GetSeriesCount() == 0) {
+        chartFormula = sensor.getParamFormula();
+    }
+
+    std::vector<Measurement> valid;
+    for (const auto& m : measurements) {
+        if (m.isValid()) valid.push_back(m);
+    }
+
+    ChartPanel::Axis axis = sensor.getParamFormula() == chartFormula ? ChartPanel::Axis::LEFT : ChartPanel::Axis::RIGHT;
+    chartPanel->AddSeries(std::make_shared<const MeasurementSeries>(valid),
+        wxString::FromUTF8(station.getName() + " - " + sensor.getParamFormula()), axis);
+    chartPanel->SetTitle(chartPanel->GetSeriesCount() > 1 ? wxString::FromUTF8("Porównanie serii") : title);
+}
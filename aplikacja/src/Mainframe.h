@@ -1,85 +1,399 @@
-#pragma once
-
-#include <wx/wx.h>
-#include <wx/datectrl.h>
-#include <wx/dateevt.h>
-#include <wx/notebook.h>
-#include "ApiClient.h"
-#include "MeasurementAnalyzer.h"
-#include "ChartPanel.h"
-#include "DatabaseManager.h"
-
-/**
- * @file MainFrame.h
- * @brief Gwne okno aplikacji GUI opartej na wxWidgets do analizy jakoci powietrza.
- *
- * Umoliwia pobieranie, zapisywanie i wizualizacj danych pomiarowych ze stacji monitoringu powietrza.
- */
-class MainFrame : public wxFrame {
-public:
-    /**
-     * @brief Konstruktor klasy MainFrame.
-     *
-     * @param title Tytu gwnego okna aplikacji.
-     */
-    MainFrame(const wxString& title);
-
-private:
-    /**
-     * @brief Handler wyboru stacji z listy.
-     *
-     * @param event Zdarzenie wyboru stacji.
-     */
-    void OnStationSelected(wxCommandEvent& event);
-
-    /**
-     * @brief Handler przycisku pobierania danych z API.
-     *
-     * @param event Zdarzenie kliknicia przycisku.
-     */
-    void OnFetch(wxCommandEvent& event);
-
-    /**
-     * @brief Handler zapisu danych do lokalnej bazy danych.
-     *
-     * @param event Zdarzenie kliknicia przycisku.
-     */
-    void OnSaveToDb(wxCommandEvent& event);
-
-    /**
-     * @brief Handler adowania danych z lokalnej bazy danych.
-     *
-     * @param event Zdarzenie kliknicia przycisku.
-     */
-    void OnLoadFromDb(wxCommandEvent& event);
-
-    /**
-     * @brief Przecza aplikacj w tryb offline (gdy np. brak poczenia z API).
-     */
-    void SwitchToOfflineMode();
-
-    bool isOfflineMode;  ///< Flaga okrelajca, czy aplikacja dziaa w trybie offline.
-
-    // Komponenty GUI
-    wxPanel* panel;                   ///< Gwny panel aplikacji.
-    wxComboBox* stationCombo;        ///< Lista rozwijana ze stacjami.
-    wxComboBox* sensorCombo;         ///< Lista rozwijana z sensorami.
-    wxDatePickerCtrl* dateFrom;      ///< Wybr daty pocztkowej.
-    wxDatePickerCtrl* dateTo;        ///< Wybr daty kocowej.
-    wxTextCtrl* dataText;            ///< Pole tekstowe do wywietlania danych.
-    wxTextCtrl* extraText;           ///< Dodatkowe pole tekstowe (np. informacje statystyczne).
-    wxStaticText* infoLabel;         ///< Etykieta informacyjna.
-    wxNotebook* notebook;            ///< Notebook (zakadki) do wywietlania danych i wykresw.
-    ChartPanel* chartPanel;          ///< Panel z wykresem.
-
-    wxButton* fetchBtn;              ///< Przycisk do pobierania danych z API.
-    wxButton* saveToDbBtn;           ///< Przycisk do zapisywania danych do bazy.
-    wxButton* loadFromDbBtn;         ///< Przycisk do adowania danych z bazy.
-
-    ApiClient api;                   ///< Klient API do pobierania danych online.
-    DatabaseManager dbManager;       ///< Manager lokalnej bazy danych.
-
-    std::vector<Station> stations;               ///< Lista dostpnych stacji.
-    std::vector<Sensor> currentSensors;          ///< Lista sensorw aktualnie wybranej stacji.
-    std::vector<Measurement> currentMeasurements;///< Aktualnie pobrane lub zaadowane pomiary.
+#pragma once
+
+#include <wx/wx.h>
+#include <wx/datectrl.h>
+#include <wx/dateevt.h>
+#include <wx/notebook.h>
+#include <wx/filedlg.h>
+#include <wx/filename.h>
+#include <wx/gauge.h>
+#include <wx/timer.h>
+#include <wx/srchctrl.h>
+#include <functional>
+#include <mutex>
+#include "ApiClient.h"
+#include "MeasurementAnalyzer.h"
+#include "ChartPanel.h"
+#include "HeatmapPanel.h"
+#include "MeasurementListCtrl.h"
+#include "SeriesCache.h"
+#include "StationSearchIndex.h"
+#include "StationIndex.h"
+#include "DatabaseManager.h"
+#include "ArrowExporter.h"
+#include "RollingWindow.h"
+#include "ExceedanceEngine.h"
+#include "TrendAnalyzer.h"
+#include "Resampler.h"
+#include "CorrelationEngine.h"
+#include "AnomalyDetector.h"
+#include "IncrementalAnalyzer.h"
+#include "SpatialInterpolator.h"
+#include "AirQualityIndexCalculator.h"
+#include "TaskScheduler.h"
+
+/**
+ * @file MainFrame.h
+ * @brief Główne okno aplikacji GUI opartej na wxWidgets do analizy jakości powietrza.
+ *
+ * Umożliwia pobieranie, zapisywanie i wizualizację danych pomiarowych ze stacji monitoringu powietrza.
+ * Zapytania do API i operacje na bazie są wykonywane w tle (TaskScheduler), a ich wyniki trafiają
+ * do wątku GUI przez CallAfter - okno nie blokuje się podczas pobierania ani zapisu.
+ */
+class MainFrame : public wxFrame {
+public:
+    /**
+     * @brief Konstruktor klasy MainFrame.
+     *
+     * @param title Tytuł głównego okna aplikacji.
+     */
+    MainFrame(const wxString& title);
+
+    /**
+     * @brief Destruktor - przerywa operacje w tle i czeka na ich zakończenie.
+     */
+    ~MainFrame();
+
+private:
+    /**
+     * @brief Praca wykonywana w tle.
+     *
+     * Otrzymuje znacznik anulowania i zwraca funkcję, która zostanie wykonana w wątku GUI
+     * z wynikami pracy (może być pusta).
+     */
+    using BackgroundWork = std::function<std::function<void()>(const CancellationToken&)>;
+
+    /**
+     * @brief Handler wyboru stacji z listy.
+     *
+     * @param event Zdarzenie wyboru stacji.
+     */
+    void OnStationSelected(wxCommandEvent& event);
+
+    /**
+     * @brief Handler wyboru czujnika - unieważnia wyniki operacji dotyczącej poprzedniego wyboru.
+     *
+     * @param event Zdarzenie wyboru czujnika.
+     */
+    void OnSensorSelected(wxCommandEvent& event);
+
+    /**
+     * @brief Handler przycisku pobierania danych z API.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnFetch(wxCommandEvent& event);
+
+    /**
+     * @brief Handler zapisu danych do lokalnej bazy danych.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnSaveToDb(wxCommandEvent& event);
+
+    /**
+     * @brief Handler ładowania danych z lokalnej bazy danych.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnLoadFromDb(wxCommandEvent& event);
+
+    /**
+     * @brief Handler eksportu zapisanych danych do pliku Apache Arrow (Feather).
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnExportArrow(wxCommandEvent& event);
+
+    /**
+     * @brief Handler zliczania przekroczeń norm dla wszystkich zapisanych stacji.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnCheckExceedances(wxCommandEvent& event);
+
+    /**
+     * @brief Handler eksportu macierzy korelacji wskaźnika między stacjami.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnExportCorrelations(wxCommandEvent& event);
+
+    /**
+     * @brief Handler eksportu mapy stężeń wskaźnika (interpolacja ostatnich pomiarów stacji).
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnExportMap(wxCommandEvent& event);
+
+    /**
+     * @brief Handler przycisku anulowania bieżącej operacji w tle.
+     *
+     * @param event Zdarzenie kliknięcia przycisku.
+     */
+    void OnCancel(wxCommandEvent& event);
+
+    /**
+     * @brief Przesuwa wskaźnik postępu operacji w tle.
+     *
+     * @param event Zdarzenie timera.
+     */
+    void OnProgressTimer(wxTimerEvent& event);
+
+    /**
+     * @brief Uruchamia operację w tle, zastępując bieżącą.
+     *
+     * Poprzednia operacja jest anulowana (także jej trwające zapytania HTTP), a jej wynik -
+     * jeśli jeszcze nadejdzie - odrzucany. Wyjątek zgłoszony przez pracę jest pokazywany
+     * jako komunikat błędu.
+     *
+     * @param status Opis operacji wyświetlany obok wskaźnika postępu.
+     * @param work Praca do wykonania w wątku roboczym.
+     */
+    void RunInBackground(const wxString& status, BackgroundWork work);
+
+    /**
+     * @brief Anuluje bieżącą operację w tle i odrzuca jej wynik.
+     */
+    void CancelBackground();
+
+    /**
+     * @brief Pokazuje wskaźnik postępu i przycisk anulowania.
+     *
+     * @param status Opis operacji.
+     */
+    void ShowProgress(const wxString& status);
+
+    /**
+     * @brief Ukrywa wskaźnik postępu.
+     */
+    void HideProgress();
+
+    /**
+     * @brief Wczytuje w tle stacje zapisane w bazie i przełącza aplikację w tryb offline.
+     */
+    void StartOfflineMode();
+
+    /**
+     * @brief Przełącza aplikację w tryb offline (gdy np. brak połączenia z API).
+     *
+     * @param dbStations Stacje zapisane w lokalnej bazie.
+     * @param parameterMasks Maski wskaźników stacji (LoadParameterMasks).
+     */
+    void SwitchToOfflineMode(const std::vector<Station>& dbStations, const std::vector<uint32_t>& parameterMasks);
+
+    /**
+     * @brief Przewija tabelę pomiarów do wybranej daty.
+     *
+     * @param event Zdarzenie zmiany daty.
+     */
+    void OnJumpToDate(wxDateEvent& event);
+
+    /**
+     * @brief Ustawia listę stacji i buduje dla niej indeks wyszukiwania oraz indeks przestrzenny.
+     *
+     * @param list Stacje.
+     * @param parameterMasks Maski wskaźników stacji (LoadParameterMasks).
+     */
+    void SetStations(const std::vector<Station>& list, const std::vector<uint32_t>& parameterMasks);
+
+    /**
+     * @brief Wyznacza maski wskaźników stacji z czujników zapisanych w lokalnej bazie.
+     *
+     * Może być wywoływana w wątku roboczym.
+     *
+     * @param list Stacje.
+     * @return Maski (StationIndex::parameterMask) równoległe do listy; 0 - czujniki stacji nieznane.
+     */
+    std::vector<uint32_t> LoadParameterMasks(const std::vector<Station>& list);
+
+    /**
+     * @brief Uaktualnia maskę wskaźników stacji po wczytaniu jej czujników i w razie zmiany
+     * przebudowuje indeks przestrzenny.
+     *
+     * @param stationId ID stacji.
+     * @param sensors Czujniki stacji (z API lub z bazy).
+     */
+    void UpdateStationParameters(int stationId, const std::vector<Sensor>& sensors);
+
+    /**
+     * @brief Tworzy opis najbliższych stacji mierzących ten sam wskaźnik co czujnik.
+     *
+     * @param station Stacja czujnika.
+     * @param sensor Czujnik.
+     * @return Opis (pusty, jeśli stacja nie ma położenia, wskaźnik nie jest znany lub brak innych stacji).
+     */
+    wxString DescribeNearestStations(const Station& station, const Sensor& sensor) const;
+
+    /**
+     * @brief Wypełnia listę rozwijaną stacjami pasującymi do tekstu wyszukiwarki.
+     */
+    void ShowStations();
+
+    /**
+     * @brief Zwraca indeks wybranej stacji w wektorze stations.
+     *
+     * @return Indeks stacji lub wxNOT_FOUND.
+     */
+    int GetSelectedStation() const;
+
+    /**
+     * @brief Handler zmiany tekstu wyszukiwarki stacji.
+     *
+     * @param event Zdarzenie zmiany tekstu.
+     */
+    void OnStationSearch(wxCommandEvent& event);
+
+    /**
+     * @brief Handler zatwierdzenia wyszukiwania (wybór najlepiej pasującej stacji).
+     *
+     * @param event Zdarzenie zatwierdzenia.
+     */
+    void OnStationSearchEnter(wxCommandEvent& event);
+
+    /**
+     * @brief Pokazuje pokazywaną serię dla nowego zakresu dat (z pamięci sesji, bez pobierania).
+     *
+     * @param event Zdarzenie zmiany daty "Od" lub "Do".
+     */
+    void OnDateRangeChanged(wxDateEvent& event);
+
+    /**
+     * @brief Odczytuje zakres dat z kontrolek "Od" i "Do".
+     *
+     * @param from Zmienna na początek zakresu (znacznik czasu, włącznie).
+     * @param to Zmienna na koniec zakresu (znacznik czasu, włącznie).
+     * @return false jeśli data początkowa jest późniejsza od końcowej.
+     */
+    bool GetSelectedRange(int64_t& from, int64_t& to) const;
+
+    /**
+     * @brief Pokazuje serię z pamięci sesji dla wybranego zakresu dat (analiza jest liczona w tle).
+     *
+     * @param entry Seria czujnika.
+     */
+    void ShowCachedRange(std::shared_ptr<const SeriesCache::Entry> entry);
+
+    /**
+     * @brief Oznacza serię przygotowaną w tle jako pokazywaną lub - jeśli zakres dat zmieniono
+     * w międzyczasie - pokazuje ją dla nowego zakresu.
+     *
+     * @param entry Seria czujnika.
+     * @param from Początek zakresu, dla którego przygotowano wynik.
+     * @param to Koniec zakresu, dla którego przygotowano wynik.
+     * @return true jeśli seria została pokazana dla nowego zakresu.
+     */
+    bool ShowIfRangeChanged(std::shared_ptr<const SeriesCache::Entry> entry, int64_t from, int64_t to);
+
+    /**
+     * @brief Tworzy opis analizy pomiarów z zakresu dat.
+     *
+     * @param entry Seria czujnika.
+     * @param measurements Pomiary z wybranego zakresu dat.
+     * @param hasData Zmienna na informację, czy w zakresie są pomiary z wartością.
+     * @return Tekst analizy.
+     */
+    std::string DescribeAnalysis(const SeriesCache::Entry& entry, const std::vector<Measurement>& measurements,
+        bool& hasData);
+
+    /**
+     * @brief Dopisuje nowe pomiary pobranej serii do statystyk ostatnich 24 godzin czujnika.
+     *
+     * @param entry Pobrana seria czujnika.
+     * @return Opis statystyk ostatnich 24 godzin (pusty, jeśli brak pomiarów).
+     */
+    wxString UpdateLatestDay(const SeriesCache::Entry& entry);
+
+    /**
+     * @brief Tworzy opis wskaźników regulacyjnych (średnie kroczące 24h/8h) dla wskaźnika.
+     *
+     * @param formula Wzór wskaźnika (np. "PM10", "O3").
+     * @param measurements Pomiary z wybranego zakresu dat.
+     * @return Tekst do dołączenia do analizy (pusty, jeśli wskaźnik nie ma okna regulacyjnego).
+     */
+    std::string DescribeRollingMetrics(const std::string& formula, const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Wyznacza indeks jakości powietrza stacji lokalnie, bez zapytania do API.
+     *
+     * @param stationId ID stacji.
+     * @param formula Wzór wskaźnika, którego pomiary są przekazane.
+     * @param measurements Najnowsze pomiary wskaźnika (pozostałe wskaźniki stacji pochodzą z bazy).
+     * @param stationSensors Wszystkie czujniki stacji (wskaźniki wymagane do indeksu ogólnego).
+     * @return Indeks w formacie ApiClient::getAirQualityIndex (pusty, jeśli brak aktualnych pomiarów;
+     *         bez klucza "Ogólny", jeśli któryś wskaźnik stacji nie ma aktualnego pomiaru).
+     */
+    std::map<std::string, std::string> ComputeLocalIndex(int stationId, const std::string& formula,
+        const std::vector<Measurement>& measurements, const std::vector<Sensor>& stationSensors);
+
+    /**
+     * @brief Pokazuje pomiary na wykresie - zastępując dotychczasowe serie lub nakładając nową.
+     *
+     * Przy zaznaczonym nakładaniu seria jest dodawana do wykresu; wskaźnik inny niż wskaźnik
+     * pierwszej serii trafia na prawą oś Y. Seria trafia też na mapę ciepła.
+     *
+     * @param measurements Pomiary z wybranego zakresu dat.
+     * @param station Stacja pomiarowa.
+     * @param sensor Czujnik.
+     * @param title Tytuł wykresu (używany, gdy seria zastępuje dotychczasowe).
+     */
+    void ShowOnChart(const std::vector<Measurement>& measurements, const Station& station, const Sensor& sensor,
+        const wxString& title);
+
+    bool isOfflineMode;  ///< Flaga określająca, czy aplikacja działa w trybie offline.
+
+    // Komponenty GUI
+    wxPanel* panel;                   ///< Główny panel aplikacji.
+    wxSearchCtrl* stationSearch;     ///< Wyszukiwarka stacji (nazwa lub miejscowość).
+    wxComboBox* stationCombo;        ///< Lista rozwijana ze stacjami.
+    wxComboBox* sensorCombo;         ///< Lista rozwijana z sensorami.
+    wxDatePickerCtrl* dateFrom;      ///< Wybór daty początkowej.
+    wxDatePickerCtrl* dateTo;        ///< Wybór daty końcowej.
+    MeasurementListCtrl* dataList;   ///< Wirtualna tabela pomiarów.
+    wxDatePickerCtrl* jumpDate;      ///< Wybór daty, do której przewijana jest tabela pomiarów.
+    wxTextCtrl* extraText;           ///< Dodatkowe pole tekstowe (np. informacje statystyczne).
+    wxStaticText* infoLabel;         ///< Etykieta informacyjna.
+    wxNotebook* notebook;            ///< Notebook (zakładki) do wyświetlania danych i wykresów.
+    ChartPanel* chartPanel;          ///< Panel z wykresem.
+    HeatmapPanel* heatmapPanel;      ///< Panel z kalendarzową mapą ciepła (dzień × godzina).
+    wxCheckBox* overlayCheck;        ///< Nakładanie kolejnych serii na wykres zamiast zastępowania.
+
+    wxButton* fetchBtn;              ///< Przycisk do pobierania danych z API.
+    wxButton* saveToDbBtn;           ///< Przycisk do zapisywania danych do bazy.
+    wxButton* loadFromDbBtn;         ///< Przycisk do ładowania danych z bazy.
+    wxButton* exportBtn;             ///< Przycisk do eksportu danych do pliku Arrow.
+    wxButton* exceedanceBtn;         ///< Przycisk do zliczania przekroczeń norm.
+    wxButton* correlationBtn;        ///< Przycisk do eksportu macierzy korelacji.
+    wxButton* mapBtn;                ///< Przycisk do eksportu mapy stężeń.
+
+    wxBoxSizer* progressSizer;       ///< Wiersz ze wskaźnikiem postępu (ukryty, gdy nic nie trwa).
+    wxGauge* progressGauge;          ///< Wskaźnik postępu operacji w tle.
+    wxStaticText* progressLabel;     ///< Opis operacji w tle.
+    wxButton* cancelBtn;             ///< Przycisk anulowania operacji w tle.
+    wxTimer progressTimer;           ///< Timer animacji wskaźnika postępu.
+
+    ApiClient api;                   ///< Klient API do pobierania danych online.
+    DatabaseManager dbManager;       ///< Manager lokalnej bazy danych.
+    AnomalyMonitor anomalyMonitor;   ///< Wykrywanie błędnych danych w pobieranych pomiarach.
+    std::mutex anomalyMutex;         ///< Blokada anomalyMonitor (używanego w wątkach roboczych).
+
+    CancellationToken backgroundToken;                      ///< Znacznik anulowania bieżącej operacji w tle.
+    unsigned requestGeneration;                             ///< Numer bieżącej operacji (starsze wyniki są odrzucane).
+    CancellationToken analysisToken;                        ///< Znacznik anulowania analizy liczonej po zmianie zakresu dat.
+    unsigned analysisGeneration;                            ///< Numer bieżącej analizy (starsze wyniki są odrzucane).
+    std::vector<TaskScheduler::TaskHandle> backgroundTasks; ///< Zadania w tle, na które czeka destruktor.
+
+    std::vector<Station> stations;               ///< Lista dostępnych stacji.
+    StationSearchIndex stationSearchIndex;       ///< Indeks wyszukiwania stacji po nazwie i miejscowości.
+    std::vector<uint32_t> stationParameters;     ///< Maski wskaźników stacji (równoległe do stations).
+    StationIndex stationIndex;                   ///< Indeks przestrzenny stacji z filtrem wskaźnika.
+    std::vector<size_t> stationRows;             ///< Wiersz listy rozwijanej -> indeks stacji w stations.
+    std::vector<Sensor> currentSensors;          ///< Lista sensorów aktualnie wybranej stacji.
+    std::vector<Measurement> currentMeasurements;///< Aktualnie pobrane lub załadowane pomiary.
+    SeriesCache seriesCache;                     ///< Ostatnio pobrane lub wczytane serie (po jednej na czujnik).
+    std::map<int, IncrementalAnalyzer> latestDay; ///< Statystyki ostatnich 24 godzin pobieranych czujników (według ID).
+    int displayedSensorId;                       ///< ID czujnika pokazywanej serii (-1 - brak).
+    int64_t displayedFrom;                       ///< Początek pokazywanego zakresu dat.
+    int64_t displayedTo;                         ///< Koniec pokazywanego zakresu dat.
+    std::string chartFormula;                    ///< Wskaźnik serii na lewej osi wykresu.
 };
\ No newline at end of file
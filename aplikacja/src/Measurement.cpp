@@ -1 +1 @@
-#include "Measurement.h"
+#include "Measurement.h"
@@ -1,47 +1,83 @@
-#pragma once
-
-#include <string>
-
-/**
- * @file Measurement.h
- * @brief Klasa reprezentujca pojedynczy pomiar z wartoci i dat.
- */
-class Measurement {
-public:
-    /**
-     * @brief Konstruktor klasy Measurement.
-     *
-     * @param date Data wykonania pomiaru (w formacie tekstowym).
-     * @param value Warto pomiaru.
-     */
-    Measurement(const std::string& date, double value)
-        : date_(date), value_(value) {
-    }
-
-    /**
-     * @brief Zwraca dat pomiaru.
-     *
-     * @return Data w formacie std::string.
-     */
-    std::string getDate() const { return date_; }
-
-    /**
-     * @brief Zwraca warto pomiaru.
-     *
-     * @return Warto jako liczba zmiennoprzecinkowa.
-     */
-    double getValue() const { return value_; }
-
-    /**
-     * @brief Sprawdza, czy pomiar jest prawidowy.
-     *
-     * Pomiar uznaje si za prawidowy, jeli jego warto jest wiksza lub rwna 0.
-     *
-     * @return true jeli warto jest poprawna, false w przeciwnym razie.
-     */
-    bool isValid() const { return value_ >= 0; }
-
-private:
-    std::string date_;  ///< Data pomiaru.
-    double value_;      ///< Warto pomiaru.
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @file Measurement.h
+ * @brief Klasa reprezentująca pojedynczy pomiar z wartością i datą.
+ */
+class Measurement {
+public:
+    /**
+     * @brief Flagi jakości pomiaru (można łączyć operatorem |).
+     */
+    enum Flag : uint8_t {
+        FLAG_NONE = 0,        ///< Brak zastrzeżeń.
+        FLAG_SPIKE = 1,       ///< Pojedynczy skok wartości (odstający pomiar).
+        FLAG_FLATLINE = 2,    ///< Wiele identycznych odczytów z rzędu (zablokowany czujnik).
+        FLAG_LEVEL_SHIFT = 4  ///< Nagła, trwała zmiana poziomu.
+    };
+
+    /**
+     * @brief Konstruktor klasy Measurement.
+     *
+     * @param date Data wykonania pomiaru (w formacie tekstowym).
+     * @param value Wartość pomiaru.
+     * @param flags Flagi jakości pomiaru.
+     */
+    Measurement(const std::string& date, double value, uint8_t flags = FLAG_NONE)
+        : date_(date), value_(value), flags_(flags) {
+    }
+
+    /**
+     * @brief Zwraca datę pomiaru.
+     *
+     * @return Data w formacie std::string.
+     */
+    std::string getDate() const { return date_; }
+
+    /**
+     * @brief Zwraca wartość pomiaru.
+     *
+     * @return Wartość jako liczba zmiennoprzecinkowa.
+     */
+    double getValue() const { return value_; }
+
+    /**
+     * @brief Sprawdza, czy pomiar jest prawidłowy.
+     *
+     * Pomiar uznaje się za prawidłowy, jeśli jego wartość jest większa lub równa 0.
+     *
+     * @return true jeśli wartość jest poprawna, false w przeciwnym razie.
+     */
+    bool isValid() const { return value_ >= 0; }
+
+    /**
+     * @brief Zwraca flagi jakości pomiaru.
+     *
+     * @return Suma bitowa wartości Flag.
+     */
+    uint8_t getFlags() const { return flags_; }
+
+    /**
+     * @brief Ustawia flagi jakości pomiaru.
+     *
+     * @param flags Suma bitowa wartości Flag.
+     */
+    void setFlags(uint8_t flags) { flags_ = flags; }
+
+    /**
+     * @brief Sprawdza, czy pomiar jest podejrzany (skok lub zablokowany czujnik).
+     *
+     * Zmiana poziomu nie czyni pomiaru podejrzanym - zwykle jest to rzeczywista zmiana stężenia.
+     *
+     * @return true jeśli pomiar należy pominąć w statystykach.
+     */
+    bool isSuspect() const { return (flags_ & (FLAG_SPIKE | FLAG_FLATLINE)) != 0; }
+
+private:
+    std::string date_;  ///< Data pomiaru.
+    double value_;      ///< Wartość pomiaru.
+    uint8_t flags_;     ///< Flagi jakości pomiaru.
 };
\ No newline at end of file
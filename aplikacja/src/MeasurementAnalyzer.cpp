@@ -1,138 +1,219 @@
-/**
- * @file MeasurementAnalyzer.h
- * @brief Klasa do analizy pomiarw, takich jak min, max, rednia i trend.
- */
-
-#include "MeasurementAnalyzer.h"
-#include <algorithm>
-#include <numeric>
-
- /**
-  * @brief Konstruktor klasy MeasurementAnalyzer.
-  *
-  * Filtruje tylko prawidowe pomiary i zapisuje je do wewntrznej listy.
-  *
-  * @param measurements Wektor obiektw Measurement.
-  */
-MeasurementAnalyzer::MeasurementAnalyzer(const std::vector<Measurement>& measurements) {
-    for (const auto& m : measurements) {
-        if (m.isValid()) {
-            validMeasurements.push_back(m);
-        }
-    }
-}
-
-/**
- * @brief Sprawdza, czy s dostpne jakiekolwiek dane pomiarowe.
- *
- * @return true jeli s dostpne dane, false w przeciwnym razie.
- */
-bool MeasurementAnalyzer::hasData() const {
-    return !validMeasurements.empty();
-}
-
-/**
- * @brief Zwraca minimaln warto spord dostpnych pomiarw.
- *
- * @return Minimalna warto lub -1.0, jeli brak danych.
- */
-double MeasurementAnalyzer::getMinValue() const {
-    if (!hasData()) return -1.0;
-    auto min = std::min_element(validMeasurements.begin(), validMeasurements.end(),
-        [](const Measurement& a, const Measurement& b) { return a.getValue() < b.getValue(); });
-    return min->getValue();
-}
-
-/**
- * @brief Zwraca dat, w ktrej wystpia minimalna warto.
- *
- * @return Data minimalnej wartoci lub "brak danych", jeli brak danych.
- */
-std::string MeasurementAnalyzer::getMinDate() const {
-    if (!hasData()) return "brak danych";
-    auto min = std::min_element(validMeasurements.begin(), validMeasurements.end(),
-        [](const Measurement& a, const Measurement& b) { return a.getValue() < b.getValue(); });
-    return min->getDate();
-}
-
-/**
- * @brief Zwraca maksymaln warto spord dostpnych pomiarw.
- *
- * @return Maksymalna warto lub -1.0, jeli brak danych.
- */
-double MeasurementAnalyzer::getMaxValue() const {
-    if (!hasData()) return -1.0;
-    auto max = std::max_element(validMeasurements.begin(), validMeasurements.end(),
-        [](const Measurement& a, const Measurement& b) { return a.getValue() < b.getValue(); });
-    return max->getValue();
-}
-
-/**
- * @brief Zwraca dat, w ktrej wystpia maksymalna warto.
- *
- * @return Data maksymalnej wartoci lub "brak danych", jeli brak danych.
- */
-std::string MeasurementAnalyzer::getMaxDate() const {
-    if (!hasData()) return "brak danych";
-    auto max = std::max_element(validMeasurements.begin(), validMeasurements.end(),
-        [](const Measurement& a, const Measurement& b) { return a.getValue() < b.getValue(); });
-    return max->getDate();
-}
-
-/**
- * @brief Oblicza i zwraca redni z wartoci pomiarw.
- *
- * @return rednia warto lub -1.0, jeli brak danych.
- */
-double MeasurementAnalyzer::getAverage() const {
-    if (!hasData()) return -1.0;
-    double sum = std::accumulate(validMeasurements.begin(), validMeasurements.end(), 0.0,
-        [](double total, const Measurement& m) { return total + m.getValue(); });
-    return sum / validMeasurements.size();
-}
-
-/**
- * @brief Okrela trend na podstawie regresji liniowej.
- *
- * Trend moe by wzrostowy, malejcy, stabilny lub nieznany.
- *
- * @return Warto enum Trend opisujca kierunek zmian.
- */
-MeasurementAnalyzer::Trend MeasurementAnalyzer::getTrend() const {
-    if (validMeasurements.size() < 2) return Trend::UNKNOWN;
-
-    double n = validMeasurements.size();
-    double sumX = 0.0, sumY = 0.0, sumXY = 0.0, sumX2 = 0.0;
-
-    for (size_t i = 0; i < validMeasurements.size(); i++) {
-        double x = i;
-        double y = validMeasurements[i].getValue();
-
-        sumX += x;
-        sumY += y;
-        sumXY += x * y;
-        sumX2 += x * x;
-    }
-
-    double slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-    const double THRESHOLD = 0.01;
-
-    if (slope > THRESHOLD) return Trend::RISING;
-    if (slope < -THRESHOLD) return Trend::FALLING;
-    return Trend::STABLE;
-}
-
-/**
- * @brief Zwraca opisowy tekstowy opis trendu.
- *
- * @return Opis trendu jako napis ("wzrostowy", "malejcy", "stabilny", "nieznany").
- */
-std::string MeasurementAnalyzer::getTrendDescription() const {
-    switch (getTrend()) {
-    case Trend::RISING: return "wzrostowy";
-    case Trend::FALLING: return "malejcy";
-    case Trend::STABLE: return "stabilny";
-    case Trend::UNKNOWN: return "nieznany (zbyt mao danych)";
-    }
-    return "nieznany";
-}
+/**
+ * @file MeasurementAnalyzer.h
+ * @brief Klasa do analizy pomiarów, takich jak min, max, średnia i trend.
+ */
+
+#include "MeasurementAnalyzer.h"
+#include <algorithm>
+
+ /**
+  * @brief Konstruktor klasy MeasurementAnalyzer.
+  *
+  * Filtruje tylko prawidłowe pomiary (z pominięciem oznaczonych jako podejrzane), zapisuje ich wartości do ciągłej tablicy
+  * i jednorazowo oblicza wszystkie statystyki. Z pomiarów kopiowane są tylko
+  * daty minimum i maksimum.
+  *
+  * @param measurements Wektor obiektów Measurement.
+  */
+MeasurementAnalyzer::MeasurementAnalyzer(const std::vector<Measurement>& measurements)
+    : trend(Trend::UNKNOWN) {
+    std::vector<size_t> sourceIndex;
+    validValues.reserve(measurements.size());
+    sourceIndex.reserve(measurements.size());
+
+    for (size_t i = 0; i < measurements.size(); i++) {
+        if (measurements[i].isValid() && !measurements[i].isSuspect()) {
+            validValues.push_back(measurements[i].getValue());
+            sourceIndex.push_back(i);
+        }
+    }
+
+    summary = computeSummary(validValues.data(), validValues.size());
+    if (summary.count == 0) return;
+
+    minDate = measurements[sourceIndex[summary.minIndex]].getDate();
+    maxDate = measurements[sourceIndex[summary.maxIndex]].getDate();
+
+    if (summary.count >= 2) {
+        const double THRESHOLD = 0.01;
+        if (summary.slope > THRESHOLD) trend = Trend::RISING;
+        else if (summary.slope < -THRESHOLD) trend = Trend::FALLING;
+        else trend = Trend::STABLE;
+    }
+}
+
+/**
+ * @brief Oblicza wszystkie statystyki w jednym przebiegu po ciągłej tablicy wartości.
+ *
+ * Regresja liniowa jest liczona względem indeksu wartości (x = 0, 1, 2, ...).
+ *
+ * @param values Wskaźnik na pierwszą wartość.
+ * @param count Liczba wartości.
+ * @return Struktura Summary.
+ */
+MeasurementAnalyzer::Summary MeasurementAnalyzer::computeSummary(const double* values, size_t count) {
+    return StatisticsKernels::summarize(values, count);
+}
+
+/**
+ * @brief Zwraca statystyki obliczone w konstruktorze.
+ *
+ * @return Referencja do struktury Summary.
+ */
+const MeasurementAnalyzer::Summary& MeasurementAnalyzer::getSummary() const {
+    return summary;
+}
+
+/**
+ * @brief Sprawdza, czy są dostępne jakiekolwiek dane pomiarowe.
+ *
+ * @return true jeśli są dostępne dane, false w przeciwnym razie.
+ */
+bool MeasurementAnalyzer::hasData() const {
+    return summary.count > 0;
+}
+
+/**
+ * @brief Zwraca minimalną wartość spośród dostępnych pomiarów.
+ *
+ * @return Minimalna wartość lub -1.0, jeśli brak danych.
+ */
+double MeasurementAnalyzer::getMinValue() const {
+    if (!hasData()) return -1.0;
+    return summary.min;
+}
+
+/**
+ * @brief Zwraca datę, w której wystąpiła minimalna wartość.
+ *
+ * @return Data minimalnej wartości lub "brak danych", jeśli brak danych.
+ */
+std::string MeasurementAnalyzer::getMinDate() const {
+    if (!hasData()) return "brak danych";
+    return minDate;
+}
+
+/**
+ * @brief Zwraca maksymalną wartość spośród dostępnych pomiarów.
+ *
+ * @return Maksymalna wartość lub -1.0, jeśli brak danych.
+ */
+double MeasurementAnalyzer::getMaxValue() const {
+    if (!hasData()) return -1.0;
+    return summary.max;
+}
+
+/**
+ * @brief Zwraca datę, w której wystąpiła maksymalna wartość.
+ *
+ * @return Data maksymalnej wartości lub "brak danych", jeśli brak danych.
+ */
+std::string MeasurementAnalyzer::getMaxDate() const {
+    if (!hasData()) return "brak danych";
+    return maxDate;
+}
+
+/**
+ * @brief Zwraca średnią z wartości pomiarów.
+ *
+ * @return Średnia wartość lub -1.0, jeśli brak danych.
+ */
+double MeasurementAnalyzer::getAverage() const {
+    if (!hasData()) return -1.0;
+    return summary.mean;
+}
+
+/**
+ * @brief Zwraca wariancję (populacyjną) wartości pomiarów.
+ *
+ * @return Wariancja lub -1.0, jeśli brak danych.
+ */
+double MeasurementAnalyzer::getVariance() const {
+    if (!hasData()) return -1.0;
+    return summary.variance;
+}
+
+/**
+ * @brief Wyznacza kwantyl (percentyl) wartości pomiarów.
+ *
+ * @param q Rząd kwantyla z przedziału [0, 1].
+ * @return Wartość kwantyla lub -1.0, jeśli brak danych.
+ */
+double MeasurementAnalyzer::getQuantile(double q) const {
+    std::vector<double> result = getQuantiles({ q });
+    return result.empty() ? -1.0 : result.front();
+}
+
+/**
+ * @brief Wyznacza kilka kwantyli naraz.
+ *
+ * Ścieżka dokładna sortuje kopię wartości (zbiór jest mały), ścieżka przybliżona
+ * korzysta ze szkicu t-digest budowanego tylko raz.
+ *
+ * @param qs Rzędy kwantyli z przedziału [0, 1].
+ * @return Wartości kwantyli w tej samej kolejności.
+ */
+std::vector<double> MeasurementAnalyzer::getQuantiles(const std::vector<double>& qs) const {
+    std::vector<double> result;
+    if (!hasData()) return result;
+
+    if (validValues.size() <= EXACT_QUANTILE_LIMIT) {
+        std::vector<double> sorted(validValues);
+        std::sort(sorted.begin(), sorted.end());
+        for (double q : qs) {
+            q = std::min(1.0, std::max(0.0, q));
+            double position = q * (sorted.size() - 1);
+            size_t lower = static_cast<size_t>(position);
+            size_t upper = std::min(lower + 1, sorted.size() - 1);
+            result.push_back(sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]));
+        }
+        return result;
+    }
+
+    if (!sketch) {
+        sketch.reset(new QuantileSketch());
+        for (double v : validValues) {
+            sketch->add(v);
+        }
+    }
+    for (double q : qs) {
+        result.push_back(sketch->quantile(q));
+    }
+    return result;
+}
+
+/**
+ * @brief Zwraca trend wyznaczony na podstawie regresji liniowej.
+ *
+ * Trend może być wzrostowy, malejący, stabilny lub nieznany.
+ *
+ * @return Wartość enum Trend opisująca kierunek zmian.
+ */
+MeasurementAnalyzer::Trend MeasurementAnalyzer::getTrend() const {
+    return trend;
+}
+
+/**
+ * @brief Zwraca opisowy tekstowy opis trendu.
+ *
+ * @return Opis trendu jako napis ("wzrostowy", "malejący", "stabilny", "nieznany").
+ */
+std::string MeasurementAnalyzer::getTrendDescription() const {
+    return describeTrend(trend);
+}
+
+/**
+ * @brief Zwraca opis słowny podanego trendu.
+ *
+ * @param trend Trend.
+ * @return Opis trendu jako napis ("wzrostowy", "malejący", "stabilny", "nieznany").
+ */
+std::string MeasurementAnalyzer::describeTrend(Trend trend) {
+    switch (trend) {
+    case Trend::RISING: return "wzrostowy";
+    case Trend::FALLING: return "malejący";
+    case Trend::STABLE: return "stabilny";
+    case Trend::UNKNOWN: return "nieznany (zbyt mało danych)";
+    }
+    return "nieznany";
+}
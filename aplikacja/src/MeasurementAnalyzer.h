@@ -1,92 +1,165 @@
-#pragma once
-
-#include <vector>
-#include <string>
-#include "Measurement.h"
-
-/**
- * @file MeasurementAnalyzer.h
- * @brief Klasa suca do analizy zbioru pomiarw.
- *
- * Umoliwia obliczanie wartoci minimalnej, maksymalnej, redniej oraz okrelenie trendu danych.
- */
-class MeasurementAnalyzer {
-public:
-    /**
-     * @brief Konstruktor klasy MeasurementAnalyzer.
-     *
-     * Filtruje tylko prawidowe pomiary.
-     *
-     * @param measurements Wektor pomiarw do analizy.
-     */
-    MeasurementAnalyzer(const std::vector<Measurement>& measurements);
-
-    /**
-     * @brief Sprawdza, czy s dostpne jakiekolwiek dane do analizy.
-     *
-     * @return true jeli dostpne s dane, false w przeciwnym razie.
-     */
-    bool hasData() const;
-
-    /**
-     * @brief Zwraca minimaln warto spord pomiarw.
-     *
-     * @return Najnisza warto lub -1.0 jeli brak danych.
-     */
-    double getMinValue() const;
-
-    /**
-     * @brief Zwraca dat pomiaru o minimalnej wartoci.
-     *
-     * @return Data minimalnej wartoci lub "brak danych" jeli dane nie s dostpne.
-     */
-    std::string getMinDate() const;
-
-    /**
-     * @brief Zwraca maksymaln warto spord pomiarw.
-     *
-     * @return Najwysza warto lub -1.0 jeli brak danych.
-     */
-    double getMaxValue() const;
-
-    /**
-     * @brief Zwraca dat pomiaru o maksymalnej wartoci.
-     *
-     * @return Data maksymalnej wartoci lub "brak danych" jeli dane nie s dostpne.
-     */
-    std::string getMaxDate() const;
-
-    /**
-     * @brief Oblicza redni warto spord pomiarw.
-     *
-     * @return rednia warto lub -1.0 jeli brak danych.
-     */
-    double getAverage() const;
-
-    /**
-     * @brief Typ wyliczeniowy reprezentujcy trend danych.
-     */
-    enum class Trend {
-        RISING,     ///< Trend wzrostowy
-        FALLING,    ///< Trend malejcy
-        STABLE,     ///< Trend stabilny
-        UNKNOWN     ///< Trend nieznany (np. zbyt mao danych)
-    };
-
-    /**
-     * @brief Oblicza trend danych na podstawie regresji liniowej.
-     *
-     * @return Warto wyliczenia Trend reprezentujca kierunek zmian.
-     */
-    Trend getTrend() const;
-
-    /**
-     * @brief Zwraca opis sowny trendu.
-     *
-     * @return Tekstowy opis trendu: "wzrostowy", "malejcy", "stabilny" lub "nieznany".
-     */
-    std::string getTrendDescription() const;
-
-private:
-    std::vector<Measurement> validMeasurements; ///< Wektor prawidowych (nieujemnych) pomiarw.
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "Measurement.h"
+#include "StatisticsKernels.h"
+#include "QuantileSketch.h"
+
+/**
+ * @file MeasurementAnalyzer.h
+ * @brief Klasa służąca do analizy zbioru pomiarów.
+ *
+ * Umożliwia obliczanie wartości minimalnej, maksymalnej, średniej oraz określenie trendu danych.
+ */
+class MeasurementAnalyzer {
+public:
+    /**
+     * @brief Konstruktor klasy MeasurementAnalyzer.
+     *
+     * Filtruje tylko prawidłowe pomiary.
+     *
+     * @param measurements Wektor pomiarów do analizy.
+     */
+    MeasurementAnalyzer(const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Zbiorcze statystyki serii obliczane w jednym przebiegu (patrz StatisticsKernels).
+     */
+    using Summary = StatisticsKernels::Summary;
+
+    /**
+     * @brief Oblicza wszystkie statystyki w jednym przebiegu po ciągłej tablicy wartości.
+     *
+     * Obliczenia wykonuje wektorowe jądro StatisticsKernels wybrane dla bieżącego procesora.
+     * Wartości nieprawidłowe (ujemne) są pomijane, a indeksy odnoszą się do pozycji w tablicy.
+     *
+     * @param values Wskaźnik na pierwszą wartość.
+     * @param count Liczba wartości.
+     * @return Struktura Summary (count == 0 dla pustej tablicy).
+     */
+    static Summary computeSummary(const double* values, size_t count);
+
+    /**
+     * @brief Zwraca statystyki obliczone w konstruktorze.
+     *
+     * @return Referencja do struktury Summary.
+     */
+    const Summary& getSummary() const;
+
+    /**
+     * @brief Sprawdza, czy są dostępne jakiekolwiek dane do analizy.
+     *
+     * @return true jeśli dostępne są dane, false w przeciwnym razie.
+     */
+    bool hasData() const;
+
+    /**
+     * @brief Zwraca minimalną wartość spośród pomiarów.
+     *
+     * @return Najniższa wartość lub -1.0 jeśli brak danych.
+     */
+    double getMinValue() const;
+
+    /**
+     * @brief Zwraca datę pomiaru o minimalnej wartości.
+     *
+     * @return Data minimalnej wartości lub "brak danych" jeśli dane nie są dostępne.
+     */
+    std::string getMinDate() const;
+
+    /**
+     * @brief Zwraca maksymalną wartość spośród pomiarów.
+     *
+     * @return Najwyższa wartość lub -1.0 jeśli brak danych.
+     */
+    double getMaxValue() const;
+
+    /**
+     * @brief Zwraca datę pomiaru o maksymalnej wartości.
+     *
+     * @return Data maksymalnej wartości lub "brak danych" jeśli dane nie są dostępne.
+     */
+    std::string getMaxDate() const;
+
+    /**
+     * @brief Oblicza średnią wartość spośród pomiarów.
+     *
+     * @return Średnia wartość lub -1.0 jeśli brak danych.
+     */
+    double getAverage() const;
+
+    /**
+     * @brief Zwraca wariancję (populacyjną) wartości pomiarów.
+     *
+     * @return Wariancja lub -1.0 jeśli brak danych.
+     */
+    double getVariance() const;
+
+    /**
+     * @brief Maksymalna liczba pomiarów, dla której kwantyle są liczone dokładnie.
+     *
+     * Dla większych zbiorów używany jest szkic t-digest (QuantileSketch).
+     */
+    static const size_t EXACT_QUANTILE_LIMIT = 100000;
+
+    /**
+     * @brief Wyznacza kwantyl (percentyl) wartości pomiarów.
+     *
+     * Dla małych zbiorów wynik jest dokładny (interpolacja liniowa między statystykami pozycyjnymi),
+     * dla dużych - przybliżony ze szkicu t-digest budowanego jednokrotnie przy pierwszym wywołaniu.
+     *
+     * @param q Rząd kwantyla z przedziału [0, 1] (np. 0.5 - mediana, 0.98 - P98).
+     * @return Wartość kwantyla lub -1.0 jeśli brak danych.
+     */
+    double getQuantile(double q) const;
+
+    /**
+     * @brief Wyznacza kilka kwantyli naraz (dla małych zbiorów z jednym sortowaniem).
+     *
+     * @param qs Rzędy kwantyli z przedziału [0, 1].
+     * @return Wartości kwantyli w tej samej kolejności (puste, jeśli brak danych).
+     */
+    std::vector<double> getQuantiles(const std::vector<double>& qs) const;
+
+    /**
+     * @brief Typ wyliczeniowy reprezentujący trend danych.
+     */
+    enum class Trend {
+        RISING,     ///< Trend wzrostowy
+        FALLING,    ///< Trend malejący
+        STABLE,     ///< Trend stabilny
+        UNKNOWN     ///< Trend nieznany (np. zbyt mało danych)
+    };
+
+    /**
+     * @brief Oblicza trend danych na podstawie regresji liniowej.
+     *
+     * @return Wartość wyliczenia Trend reprezentująca kierunek zmian.
+     */
+    Trend getTrend() const;
+
+    /**
+     * @brief Zwraca opis słowny trendu.
+     *
+     * @return Tekstowy opis trendu: "wzrostowy", "malejący", "stabilny" lub "nieznany".
+     */
+    std::string getTrendDescription() const;
+
+    /**
+     * @brief Zwraca opis słowny podanego trendu (np. wyznaczonego przez IncrementalAnalyzer).
+     *
+     * @param trend Trend.
+     * @return Tekstowy opis trendu: "wzrostowy", "malejący", "stabilny" lub "nieznany".
+     */
+    static std::string describeTrend(Trend trend);
+
+private:
+    std::vector<double> validValues; ///< Ciągła tablica wartości prawidłowych (nieujemnych) pomiarów.
+    Summary summary;                 ///< Statystyki obliczone jednorazowo w konstruktorze.
+    std::string minDate;             ///< Data pomiaru o minimalnej wartości.
+    std::string maxDate;             ///< Data pomiaru o maksymalnej wartości.
+    Trend trend;                     ///< Trend wyznaczony z nachylenia regresji.
+    mutable std::unique_ptr<QuantileSketch> sketch; ///< Szkic kwantyli (tworzony przy pierwszym użyciu dla dużych zbiorów).
 };
\ No newline at end of file
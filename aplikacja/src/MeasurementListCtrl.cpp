@@ -0,0 +1,238 @@
+/**
+ * @file MeasurementListCtrl.cpp
+ * @brief Implementacja wirtualnej tabeli pomiarów.
+ */
+
+#include "MeasurementListCtrl.h"
+#include "AnomalyDetector.h"
+#include "MeasurementSeries.h"
+#include <algorithm>
+#include <numeric>
+
+ /// Tablica zdarzeń wxWidgets
+wxBEGIN_EVENT_TABLE(MeasurementListCtrl, wxListCtrl)
+EVT_LIST_COL_CLICK(wxID_ANY, MeasurementListCtrl::OnColumnClick) ///< Sortowanie po kliknięciu nagłówka
+wxEND_EVENT_TABLE()
+
+/**
+ * @brief Konstruktor klasy MeasurementListCtrl.
+ * @param parent Wskaźnik na okno nadrzędne.
+ */
+MeasurementListCtrl::MeasurementListCtrl(wxWindow* parent)
+    : wxListCtrl(parent, wxID_ANY, wxDefaultPosition, wxSize(480, 400), wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL),
+    sortColumn(COLUMN_DATE), sortAscending(true)
+{
+    AppendColumn("Data", wxLIST_FORMAT_LEFT, 150);
+    AppendColumn(wxString::FromUTF8("Wartość"), wxLIST_FORMAT_RIGHT, 110);
+    AppendColumn("Flagi", wxLIST_FORMAT_LEFT, 200);
+    UpdateColumnHeaders();
+}
+
+/**
+ * @brief Ustawia pomiary do wyświetlenia.
+ *
+ * Daty są parsowane raz, a pomiary porządkowane według czasu (dane z API są zwykle od najnowszych,
+ * więc najczęściej wystarcza odwrócenie kolejności). Tekst wierszy nie jest tworzony.
+ *
+ * @param measurements Pomiary.
+ */
+void MeasurementListCtrl::SetData(const std::vector<Measurement>& measurements)
+{
+    std::vector<int64_t> parsed;
+    std::vector<uint32_t> source;
+    parsed.reserve(measurements.size());
+    source.reserve(measurements.size());
+    for (size_t i = 0; i < measurements.size(); i++) {
+        int64_t timestamp;
+        if (MeasurementSeries::parseTimestamp(measurements[i].getDate(), timestamp)) {
+            parsed.push_back(timestamp);
+            source.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    std::vector<uint32_t> byTime(parsed.size());
+    std::iota(byTime.begin(), byTime.end(), 0);
+    if (std::is_sorted(parsed.rbegin(), parsed.rend()) && !std::is_sorted(parsed.begin(), parsed.end())) {
+        std::reverse(byTime.begin(), byTime.end());
+    }
+    else if (!std::is_sorted(parsed.begin(), parsed.end())) {
+        std::stable_sort(byTime.begin(), byTime.end(), [&parsed](uint32_t a, uint32_t b) { return parsed[a] < parsed[b]; });
+    }
+
+    timestamps.resize(byTime.size());
+    values.resize(byTime.size());
+    flags.resize(byTime.size());
+    for (size_t i = 0; i < byTime.size(); i++) {
+        const Measurement& m = measurements[source[byTime[i]]];
+        timestamps[i] = parsed[byTime[i]];
+        values[i] = m.getValue();
+        flags[i] = m.getFlags();
+    }
+
+    SetItemCount(static_cast<long>(timestamps.size()));
+    SortBy(sortColumn, sortAscending);
+}
+
+/**
+ * @brief Ustawia pomiary już uporządkowane według czasu.
+ *
+ * Używane dla wycinków serii z SeriesCache, których daty zostały przeliczone wcześniej.
+ *
+ * @param measurements Pomiary rosnąco według czasu.
+ * @param measurementTimestamps Znaczniki czasu pomiarów.
+ */
+void MeasurementListCtrl::SetData(const std::vector<Measurement>& measurements, const std::vector<int64_t>& measurementTimestamps)
+{
+    const size_t count = std::min(measurements.size(), measurementTimestamps.size());
+    timestamps.assign(measurementTimestamps.begin(), measurementTimestamps.begin() + count);
+    values.resize(count);
+    flags.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        values[i] = measurements[i].getValue();
+        flags[i] = measurements[i].getFlags();
+    }
+
+    SetItemCount(static_cast<long>(count));
+    SortBy(sortColumn, sortAscending);
+}
+
+/**
+ * @brief Usuwa wszystkie wiersze.
+ */
+void MeasurementListCtrl::ClearData()
+{
+    timestamps.clear();
+    values.clear();
+    flags.clear();
+    order.clear();
+    position.clear();
+    SetItemCount(0);
+    Refresh();
+}
+
+/**
+ * @brief Sortuje wiersze według kolumny.
+ *
+ * Sortowanie według daty tylko odwraca kolejność (dane są uporządkowane według czasu); przy
+ * sortowaniu według wartości pomiary bez wartości są zawsze na końcu. Sortowanie jest stabilne,
+ * więc równe wartości pozostają w kolejności czasu.
+ *
+ * @param column Kolumna.
+ * @param ascending Kierunek sortowania.
+ */
+void MeasurementListCtrl::SortBy(int column, bool ascending)
+{
+    sortColumn = column;
+    sortAscending = ascending;
+
+    order.resize(timestamps.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    if (column == COLUMN_VALUE) {
+        std::stable_sort(order.begin(), order.end(), [this, ascending](uint32_t a, uint32_t b) {
+            const bool validA = values[a] >= 0, validB = values[b] >= 0;
+            if (validA != validB) return validA;
+            return ascending ? values[a] < values[b] : values[a] > values[b];
+        });
+    }
+    else if (column == COLUMN_FLAGS) {
+        std::stable_sort(order.begin(), order.end(), [this, ascending](uint32_t a, uint32_t b) {
+            return ascending ? flags[a] < flags[b] : flags[a] > flags[b];
+        });
+    }
+    else if (!ascending) {
+        std::reverse(order.begin(), order.end());
+    }
+
+    UpdatePositions();
+    UpdateColumnHeaders();
+}
+
+/**
+ * @brief Odbudowuje odwrotną permutację i odświeża widok.
+ */
+void MeasurementListCtrl::UpdatePositions()
+{
+    position.resize(order.size());
+    for (size_t row = 0; row < order.size(); row++) {
+        position[order[row]] = static_cast<uint32_t>(row);
+    }
+    Refresh();
+}
+
+/**
+ * @brief Zaznacza i przewija do pierwszego pomiaru nie wcześniejszego niż podany czas.
+ *
+ * Pomiar jest wyszukiwany binarnie w danych uporządkowanych według czasu, a jego wiersz w bieżącym
+ * sortowaniu odczytywany z permutacji odwrotnej - O(log n) niezależnie od sortowania.
+ *
+ * @param timestamp Znacznik czasu.
+ * @return false jeśli tabela jest pusta.
+ */
+bool MeasurementListCtrl::JumpToTimestamp(int64_t timestamp)
+{
+    if (timestamps.empty()) return false;
+
+    size_t index = std::lower_bound(timestamps.begin(), timestamps.end(), timestamp) - timestamps.begin();
+    index = std::min(index, timestamps.size() - 1);
+    const long row = static_cast<long>(position[index]);
+
+    SetItemState(row, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    EnsureVisible(row);
+    return true;
+}
+
+/**
+ * @brief Zwraca tekst komórki widocznego wiersza.
+ *
+ * @param item Numer wiersza.
+ * @param column Numer kolumny.
+ * @return Tekst komórki.
+ */
+wxString MeasurementListCtrl::OnGetItemText(long item, long column) const
+{
+    if (item < 0 || static_cast<size_t>(item) >= order.size()) return wxString();
+    const uint32_t index = order[item];
+
+    switch (column) {
+    case COLUMN_DATE:
+        return MeasurementSeries::formatTimestamp(timestamps[index]);
+    case COLUMN_VALUE:
+        return values[index] >= 0 ? wxString::Format("%.2f", values[index]) : wxString("brak pomiaru");
+    case COLUMN_FLAGS:
+        return flags[index] != Measurement::FLAG_NONE
+            ? wxString::FromUTF8(AnomalyDetector::describeFlags(flags[index])) : wxString();
+    default:
+        return wxString();
+    }
+}
+
+/**
+ * @brief Sortuje według klikniętej kolumny.
+ *
+ * @param event Zdarzenie kliknięcia nagłówka.
+ */
+void MeasurementListCtrl::OnColumnClick(wxListEvent& event)
+{
+    const int column = event.GetColumn();
+    if (column < 0) return;
+    SortBy(column, column == sortColumn ? !sortAscending : true);
+}
+
+/**
+ * @brief Odświeża nagłówki kolumn (strzałka przy kolumnie sortowania).
+ */
+void MeasurementListCtrl::UpdateColumnHeaders()
+{
+    static const char* const labels[] = { "Data", "Wartość", "Flagi" };
+    for (int column = 0; column < 3; column++) {
+        std::string text = labels[column];
+        if (column == sortColumn) {
+            text += sortAscending ? " ▲" : " ▼";
+        }
+        wxListItem header;
+        header.SetMask(wxLIST_MASK_TEXT);
+        header.SetText(wxString::FromUTF8(text));
+        SetColumn(column, header);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+#include <cstdint>
+#include <vector>
+#include "Measurement.h"
+
+/**
+ * @file MeasurementListCtrl.h
+ * @brief Wirtualna tabela pomiarów (data, wartość, flagi jakości) z sortowaniem i skokiem do daty.
+ *
+ * Kontrolka nie przechowuje tekstu wierszy: w trybie wxLC_VIRTUAL wxListCtrl pyta tylko o widoczne
+ * komórki (OnGetItemText), które są formatowane na bieżąco z kolumn danych. Pokazanie 100 tys.
+ * pomiarów kosztuje więc tyle samo co pokazanie 100. Sortowanie zmienia jedynie permutację wierszy,
+ * a skok do daty to wyszukiwanie binarne w danych uporządkowanych według czasu.
+ */
+class MeasurementListCtrl : public wxListCtrl {
+public:
+    /**
+     * @brief Kolumny tabeli.
+     */
+    enum Column {
+        COLUMN_DATE = 0,  ///< Data i godzina pomiaru.
+        COLUMN_VALUE = 1, ///< Wartość pomiaru.
+        COLUMN_FLAGS = 2  ///< Flagi jakości (AnomalyDetector).
+    };
+
+    /**
+     * @brief Konstruktor klasy MeasurementListCtrl.
+     *
+     * @param parent Wskaźnik na okno nadrzędne.
+     */
+    MeasurementListCtrl(wxWindow* parent);
+
+    /**
+     * @brief Ustawia pomiary do wyświetlenia (zachowując wybrane sortowanie).
+     *
+     * @param measurements Pomiary w dowolnej kolejności (pomiary z niepoprawną datą są pomijane).
+     */
+    void SetData(const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Ustawia pomiary już uporządkowane według czasu (bez parsowania dat).
+     *
+     * @param measurements Pomiary rosnąco według czasu.
+     * @param measurementTimestamps Znaczniki czasu pomiarów (ta sama długość co measurements).
+     */
+    void SetData(const std::vector<Measurement>& measurements, const std::vector<int64_t>& measurementTimestamps);
+
+    /**
+     * @brief Usuwa wszystkie wiersze.
+     */
+    void ClearData();
+
+    /**
+     * @brief Sortuje wiersze według kolumny.
+     *
+     * @param column Kolumna (Column).
+     * @param ascending Kierunek sortowania.
+     */
+    void SortBy(int column, bool ascending);
+
+    /**
+     * @brief Zaznacza i przewija do pierwszego pomiaru nie wcześniejszego niż podany czas.
+     *
+     * @param timestamp Znacznik czasu w sekundach.
+     * @return false jeśli tabela jest pusta.
+     */
+    bool JumpToTimestamp(int64_t timestamp);
+
+private:
+    /**
+     * @brief Zwraca tekst komórki wiersza (wywoływane przez wxListCtrl tylko dla widocznych wierszy).
+     *
+     * @param item Numer wiersza.
+     * @param column Numer kolumny.
+     * @return Tekst komórki.
+     */
+    wxString OnGetItemText(long item, long column) const override;
+
+    /**
+     * @brief Sortuje według klikniętej kolumny (ponowne kliknięcie odwraca kierunek).
+     *
+     * @param event Zdarzenie kliknięcia nagłówka.
+     */
+    void OnColumnClick(wxListEvent& event);
+
+    /**
+     * @brief Odświeża nagłówki kolumn (strzałka przy kolumnie sortowania).
+     */
+    void UpdateColumnHeaders();
+
+    /**
+     * @brief Odbudowuje odwrotną permutację (indeks pomiaru -> numer wiersza) i odświeża widok.
+     */
+    void UpdatePositions();
+
+    std::vector<int64_t> timestamps;  ///< Znaczniki czasu pomiarów (rosnąco).
+    std::vector<double> values;       ///< Wartości pomiarów (ujemne - brak pomiaru).
+    std::vector<uint8_t> flags;       ///< Flagi jakości pomiarów.
+    std::vector<uint32_t> order;      ///< Numer wiersza -> indeks pomiaru.
+    std::vector<uint32_t> position;   ///< Indeks pomiaru -> numer wiersza.
+
+    int sortColumn;                   ///< Kolumna sortowania.
+    bool sortAscending;               ///< Kierunek sortowania.
+
+    wxDECLARE_EVENT_TABLE();          ///< Makro do deklaracji tablicy zdarzeń wxWidgets.
+};
@@ -0,0 +1,199 @@
+/**
+ * @file MeasurementSeries.cpp
+ * @brief Implementacja kolumnowej serii pomiarowej.
+ */
+
+#include "MeasurementSeries.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+/**
+ * @brief Tworzy serię z wektora pomiarów.
+ *
+ * @param measurements Wektor pomiarów.
+ */
+MeasurementSeries::MeasurementSeries(const std::vector<Measurement>& measurements) {
+    reserve(measurements.size());
+    for (const auto& m : measurements) {
+        int64_t timestamp;
+        if (parseTimestamp(m.getDate(), timestamp)) {
+            append(timestamp, m.getValue());
+        }
+    }
+
+    // API zwraca dane od najnowszych - najczęściej wystarczy odwrócić kolejność
+    if (std::is_sorted(timestamps_.begin(), timestamps_.end())) {
+        return;
+    }
+    if (std::is_sorted(timestamps_.rbegin(), timestamps_.rend())) {
+        std::reverse(timestamps_.begin(), timestamps_.end());
+        std::reverse(values_.begin(), values_.end());
+        return;
+    }
+
+    std::vector<size_t> order(timestamps_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [this](size_t a, size_t b) { return timestamps_[a] < timestamps_[b]; });
+
+    std::vector<int64_t> sortedTimestamps(order.size());
+    std::vector<double> sortedValues(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        sortedTimestamps[i] = timestamps_[order[i]];
+        sortedValues[i] = values_[order[i]];
+    }
+    timestamps_.swap(sortedTimestamps);
+    values_.swap(sortedValues);
+}
+
+/**
+ * @brief Rezerwuje miejsce na podaną liczbę punktów.
+ *
+ * @param count Liczba punktów.
+ */
+void MeasurementSeries::reserve(size_t count) {
+    timestamps_.reserve(count);
+    values_.reserve(count);
+}
+
+/**
+ * @brief Dodaje punkt na końcu serii.
+ *
+ * @param timestamp Znacznik czasu w sekundach.
+ * @param value Wartość pomiaru.
+ */
+void MeasurementSeries::append(int64_t timestamp, double value) {
+    timestamps_.push_back(timestamp);
+    values_.push_back(value);
+}
+
+/**
+ * @brief Zwraca fragment serii z przedziału czasu [from, to).
+ *
+ * @param from Początek przedziału (włącznie).
+ * @param to Koniec przedziału (wyłącznie).
+ * @return Nowa seria zawierająca punkty z przedziału.
+ */
+MeasurementSeries MeasurementSeries::slice(int64_t from, int64_t to) const {
+    MeasurementSeries result;
+    auto first = std::lower_bound(timestamps_.begin(), timestamps_.end(), from);
+    auto last = std::lower_bound(first, timestamps_.end(), to);
+
+    size_t begin = first - timestamps_.begin();
+    size_t end = last - timestamps_.begin();
+
+    result.timestamps_.assign(first, last);
+    result.values_.assign(values_.begin() + begin, values_.begin() + end);
+    return result;
+}
+
+/**
+ * @brief Konwertuje serię z powrotem na wektor pomiarów.
+ *
+ * @return Wektor obiektów Measurement.
+ */
+std::vector<Measurement> MeasurementSeries::toMeasurements() const {
+    std::vector<Measurement> result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        result.emplace_back(formatTimestamp(timestamps_[i]), values_[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Parsuje datę w formacie "YYYY-MM-DD HH:MM:SS" (lub "YYYY-MM-DD").
+ *
+ * @param date Data w formacie tekstowym.
+ * @param timestamp Zmienna, do której zostanie zapisany wynik.
+ * @return true jeśli parsowanie się powiodło, false w przeciwnym razie.
+ */
+bool MeasurementSeries::parseTimestamp(const std::string& date, int64_t& timestamp) {
+    auto digits = [&date](size_t pos, size_t count, int& out) {
+        out = 0;
+        for (size_t i = pos; i < pos + count; i++) {
+            if (date[i] < '0' || date[i] > '9') return false;
+            out = out * 10 + (date[i] - '0');
+        }
+        return true;
+    };
+
+    if (date.size() < 10 || date[4] != '-' || date[7] != '-') return false;
+
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    if (!digits(0, 4, year) || !digits(5, 2, month) || !digits(8, 2, day)) return false;
+
+    if (date.size() >= 19) {
+        if (date[13] != ':' || date[16] != ':') return false;
+        if (!digits(11, 2, hour) || !digits(14, 2, minute) || !digits(17, 2, second)) return false;
+    }
+
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) {
+        return false;
+    }
+
+    timestamp = makeTimestamp(year, month, day, hour, minute, second);
+    return true;
+}
+
+/**
+ * @brief Formatuje znacznik czasu jako "YYYY-MM-DD HH:MM:SS".
+ *
+ * @param timestamp Znacznik czasu w sekundach.
+ * @return Data w formacie tekstowym.
+ */
+std::string MeasurementSeries::formatTimestamp(int64_t timestamp) {
+    int64_t days = timestamp / 86400;
+    int64_t secondsOfDay = timestamp % 86400;
+    if (secondsOfDay < 0) {
+        secondsOfDay += 86400;
+        days -= 1;
+    }
+
+    // Algorytm odwrotny do makeTimestamp (kalendarz gregoriański)
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t mp = (5 * dayOfYear + 2) / 153;
+    int day = static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1);
+    int month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    int year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d %02d:%02d:%02d", year, month, day,
+        static_cast<int>(secondsOfDay / 3600), static_cast<int>(secondsOfDay / 60 % 60),
+        static_cast<int>(secondsOfDay % 60));
+    return buffer;
+}
+
+/**
+ * @brief Tworzy znacznik czasu z elementów daty.
+ *
+ * @return Znacznik czasu w sekundach od 1970-01-01 00:00:00.
+ */
+int64_t MeasurementSeries::makeTimestamp(int year, int month, int day, int hour, int minute, int second) {
+    int64_t y = year - (month <= 2 ? 1 : 0);
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yearOfEra = y - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = era * 146097 + dayOfEra - 719468;
+    return days * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+/**
+ * @brief Zwraca początek doby, w której leży znacznik czasu.
+ *
+ * @param timestamp Znacznik czasu w sekundach.
+ * @return Znacznik czasu północy tej doby.
+ */
+int64_t MeasurementSeries::startOfDay(int64_t timestamp) {
+    int64_t secondsOfDay = timestamp % 86400;
+    if (secondsOfDay < 0) {
+        secondsOfDay += 86400;
+    }
+    return timestamp - secondsOfDay;
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Measurement.h"
+
+/**
+ * @file MeasurementSeries.h
+ * @brief Kolumnowa reprezentacja serii pomiarowej (znaczniki czasu i wartości w osobnych tablicach).
+ *
+ * Daty są przechowywane jako liczba sekund od 1970-01-01 00:00:00 w czasie lokalnym stacji
+ * (bez strefy czasowej), tak jak zwraca je API GIOS. Seria jest zawsze posortowana rosnąco po czasie.
+ */
+class MeasurementSeries {
+public:
+    /**
+     * @brief Tworzy pustą serię.
+     */
+    MeasurementSeries() = default;
+
+    /**
+     * @brief Tworzy serię z wektora pomiarów.
+     *
+     * Pomiary z niepoprawną datą są pomijane, pomiary bez wartości (-1.0) są zachowywane.
+     * Wynik jest sortowany rosnąco po czasie (API zwraca dane od najnowszych).
+     *
+     * @param measurements Wektor pomiarów.
+     */
+    explicit MeasurementSeries(const std::vector<Measurement>& measurements);
+
+    /**
+     * @brief Rezerwuje miejsce na podaną liczbę punktów.
+     *
+     * @param count Liczba punktów.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Dodaje punkt na końcu serii.
+     *
+     * Wywołujący odpowiada za zachowanie rosnącej kolejności znaczników czasu.
+     *
+     * @param timestamp Znacznik czasu w sekundach.
+     * @param value Wartość pomiaru (ujemna oznacza brak pomiaru).
+     */
+    void append(int64_t timestamp, double value);
+
+    /**
+     * @brief Zwraca liczbę punktów w serii.
+     *
+     * @return Liczba punktów.
+     */
+    size_t size() const { return timestamps_.size(); }
+
+    /**
+     * @brief Sprawdza, czy seria jest pusta.
+     *
+     * @return true jeśli seria nie zawiera punktów.
+     */
+    bool empty() const { return timestamps_.empty(); }
+
+    /**
+     * @brief Zwraca kolumnę znaczników czasu.
+     *
+     * @return Referencja do ciągłej tablicy znaczników czasu.
+     */
+    const std::vector<int64_t>& getTimestamps() const { return timestamps_; }
+
+    /**
+     * @brief Zwraca kolumnę wartości.
+     *
+     * @return Referencja do ciągłej tablicy wartości.
+     */
+    const std::vector<double>& getValues() const { return values_; }
+
+    /**
+     * @brief Zwraca fragment serii z przedziału czasu [from, to).
+     *
+     * Granice są wyszukiwane binarnie.
+     *
+     * @param from Początek przedziału (włącznie).
+     * @param to Koniec przedziału (wyłącznie).
+     * @return Nowa seria zawierająca punkty z przedziału.
+     */
+    MeasurementSeries slice(int64_t from, int64_t to) const;
+
+    /**
+     * @brief Konwertuje serię z powrotem na wektor pomiarów.
+     *
+     * @return Wektor obiektów Measurement (rosnąco po czasie).
+     */
+    std::vector<Measurement> toMeasurements() const;
+
+    /**
+     * @brief Parsuje datę w formacie "YYYY-MM-DD HH:MM:SS" (lub "YYYY-MM-DD").
+     *
+     * @param date Data w formacie tekstowym.
+     * @param timestamp Zmienna, do której zostanie zapisany wynik.
+     * @return true jeśli parsowanie się powiodło, false w przeciwnym razie.
+     */
+    static bool parseTimestamp(const std::string& date, int64_t& timestamp);
+
+    /**
+     * @brief Formatuje znacznik czasu jako "YYYY-MM-DD HH:MM:SS".
+     *
+     * @param timestamp Znacznik czasu w sekundach.
+     * @return Data w formacie tekstowym.
+     */
+    static std::string formatTimestamp(int64_t timestamp);
+
+    /**
+     * @brief Tworzy znacznik czasu z elementów daty.
+     *
+     * @param year Rok.
+     * @param month Miesiąc (1-12).
+     * @param day Dzień miesiąca (1-31).
+     * @param hour Godzina.
+     * @param minute Minuta.
+     * @param second Sekunda.
+     * @return Znacznik czasu w sekundach.
+     */
+    static int64_t makeTimestamp(int year, int month, int day, int hour = 0, int minute = 0, int second = 0);
+
+    /**
+     * @brief Zwraca początek doby, w której leży znacznik czasu.
+     *
+     * @param timestamp Znacznik czasu w sekundach.
+     * @return Znacznik czasu północy tej doby.
+     */
+    static int64_t startOfDay(int64_t timestamp);
+
+private:
+    std::vector<int64_t> timestamps_; ///< Znaczniki czasu w sekundach (rosnąco).
+    std::vector<double> values_;      ///< Wartości pomiarów (ujemne = brak pomiaru).
+};
@@ -0,0 +1,213 @@
+/**
+ * @file QuantileSketch.cpp
+ * @brief Implementacja szkicu kwantyli t-digest.
+ */
+
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+/// Funkcja skali k1: k(q) = d / (2 pi) * asin(2q - 1)
+double scaleK(double q, double compression) {
+    return compression / (2.0 * PI) * std::asin(2.0 * q - 1.0);
+}
+
+/// Funkcja odwrotna do scaleK.
+double scaleQ(double k, double compression) {
+    if (k >= compression / 4.0) return 1.0;
+    return (std::sin(k * 2.0 * PI / compression) + 1.0) / 2.0;
+}
+
+} // namespace
+
+/**
+ * @brief Konstruktor klasy QuantileSketch.
+ *
+ * @param compression Parametr kompresji.
+ */
+QuantileSketch::QuantileSketch(double compression)
+    : compression_(compression),
+    min_(std::numeric_limits<double>::infinity()),
+    max_(-std::numeric_limits<double>::infinity()) {
+}
+
+/**
+ * @brief Tworzy szkic z zapisanych centroidów.
+ *
+ * @param compression Parametr kompresji.
+ * @param centroids Lista centroidów.
+ * @param min Najmniejsza wartość w szkicu.
+ * @param max Największa wartość w szkicu.
+ * @return Odtworzony szkic.
+ */
+QuantileSketch QuantileSketch::fromCentroids(double compression, const std::vector<Centroid>& centroids, double min, double max) {
+    QuantileSketch sketch(compression);
+    sketch.buffer_ = centroids;
+    if (!centroids.empty()) {
+        sketch.min_ = min;
+        sketch.max_ = max;
+    }
+    sketch.compress();
+    return sketch;
+}
+
+/**
+ * @brief Dodaje wartość do szkicu.
+ *
+ * Wartości trafiają do bufora, który jest scalany po przekroczeniu kilkukrotności kompresji.
+ *
+ * @param value Wartość.
+ * @param weight Waga wartości.
+ */
+void QuantileSketch::add(double value, double weight) {
+    if (!(weight > 0.0) || std::isnan(value)) return;
+
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    buffer_.push_back({ value, weight });
+
+    if (buffer_.size() >= static_cast<size_t>(compression_ * 5.0)) {
+        compress();
+    }
+}
+
+/**
+ * @brief Dołącza inny szkic do bieżącego.
+ *
+ * @param other Szkic do dołączenia.
+ */
+void QuantileSketch::merge(const QuantileSketch& other) {
+    const auto& otherCentroids = other.getCentroids();
+    if (otherCentroids.empty()) return;
+
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    buffer_.insert(buffer_.end(), otherCentroids.begin(), otherCentroids.end());
+    compress();
+}
+
+/**
+ * @brief Wyznacza przybliżony kwantyl.
+ *
+ * Między środkami sąsiednich centroidów stosowana jest interpolacja liniowa,
+ * a na krańcach - interpolacja do zapamiętanego minimum i maksimum.
+ *
+ * @param q Rząd kwantyla z przedziału [0, 1].
+ * @return Wartość kwantyla lub -1.0 jeśli szkic jest pusty.
+ */
+double QuantileSketch::quantile(double q) const {
+    const auto& centroids = getCentroids();
+    if (centroids.empty()) return -1.0;
+
+    q = std::min(1.0, std::max(0.0, q));
+    if (centroids.size() == 1) {
+        return min_ + (max_ - min_) * q;
+    }
+
+    double total = getCount();
+    double index = q * total;
+
+    // Lewy kraniec: od minimum do środka pierwszego centroidu
+    const Centroid& first = centroids.front();
+    if (index < first.weight / 2.0) {
+        if (first.weight <= 1.0) return min_;
+        return min_ + (first.mean - min_) * index / (first.weight / 2.0);
+    }
+
+    // Prawy kraniec: od środka ostatniego centroidu do maksimum
+    const Centroid& last = centroids.back();
+    if (index >= total - last.weight / 2.0) {
+        if (last.weight <= 1.0) return max_;
+        return last.mean + (max_ - last.mean) * (index - (total - last.weight / 2.0)) / (last.weight / 2.0);
+    }
+
+    double weightSoFar = first.weight / 2.0;
+    for (size_t i = 0; i + 1 < centroids.size(); i++) {
+        double step = (centroids[i].weight + centroids[i + 1].weight) / 2.0;
+        if (weightSoFar + step > index) {
+            // Centroidy o wadze 1 to dokładne wartości - bez interpolacji w ich obrębie
+            double left = centroids[i].weight == 1.0 ? 0.5 : 0.0;
+            double right = centroids[i + 1].weight == 1.0 ? 0.5 : 0.0;
+            double position = index - weightSoFar;
+            if (position < left) return centroids[i].mean;
+            if (position > step - right) return centroids[i + 1].mean;
+            double fraction = (position - left) / (step - left - right);
+            return centroids[i].mean + fraction * (centroids[i + 1].mean - centroids[i].mean);
+        }
+        weightSoFar += step;
+    }
+    return last.mean;
+}
+
+/**
+ * @brief Zwraca łączną wagę (liczbę wartości) w szkicu.
+ *
+ * @return Łączna waga.
+ */
+double QuantileSketch::getCount() const {
+    double total = 0.0;
+    for (const auto& c : centroids_) total += c.weight;
+    for (const auto& c : buffer_) total += c.weight;
+    return total;
+}
+
+/**
+ * @brief Zwraca listę centroidów po scaleniu bufora.
+ *
+ * @return Referencja do posortowanej listy centroidów.
+ */
+const std::vector<QuantileSketch::Centroid>& QuantileSketch::getCentroids() const {
+    if (!buffer_.empty()) {
+        compress();
+    }
+    return centroids_;
+}
+
+/**
+ * @brief Scala bufor z centroidami.
+ *
+ * Sąsiednie centroidy są łączone, dopóki łączna waga mieści się w przyroście funkcji skali o 1.
+ */
+void QuantileSketch::compress() const {
+    if (buffer_.empty()) return;
+
+    std::vector<Centroid> all;
+    all.reserve(centroids_.size() + buffer_.size());
+    all.insert(all.end(), centroids_.begin(), centroids_.end());
+    all.insert(all.end(), buffer_.begin(), buffer_.end());
+    buffer_.clear();
+
+    std::sort(all.begin(), all.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+
+    double total = 0.0;
+    for (const auto& c : all) total += c.weight;
+
+    std::vector<Centroid> merged;
+    merged.reserve(static_cast<size_t>(compression_) * 2);
+
+    Centroid current = all.front();
+    double weightSoFar = 0.0;
+    double limit = total * scaleQ(scaleK(0.0, compression_) + 1.0, compression_);
+
+    for (size_t i = 1; i < all.size(); i++) {
+        const Centroid& next = all[i];
+        if (weightSoFar + current.weight + next.weight <= limit) {
+            double weight = current.weight + next.weight;
+            current.mean += (next.mean - current.mean) * next.weight / weight;
+            current.weight = weight;
+        }
+        else {
+            weightSoFar += current.weight;
+            merged.push_back(current);
+            limit = total * scaleQ(scaleK(weightSoFar / total, compression_) + 1.0, compression_);
+            current = next;
+        }
+    }
+    merged.push_back(current);
+    centroids_.swap(merged);
+}
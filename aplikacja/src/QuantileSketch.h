@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * @file QuantileSketch.h
+ * @brief Szkic kwantyli typu t-digest (wersja scalająca), pozwalający wyznaczać percentyle bez sortowania danych.
+ *
+ * Szkic zajmuje stałą pamięć (rzędu kompresji), można go łączyć z innymi szkicami
+ * (np. dziennymi w roczny) i zapisywać jako listę centroidów. Dokładność jest najwyższa
+ * na krańcach rozkładu, co odpowiada percentylom używanym w normach (P90.4, P98, P99.8).
+ */
+class QuantileSketch {
+public:
+    /**
+     * @brief Centroid - średnia grupy sąsiednich wartości wraz z ich liczbą (wagą).
+     */
+    struct Centroid {
+        double mean;   ///< Średnia wartości w centroidzie.
+        double weight; ///< Liczba wartości w centroidzie.
+    };
+
+    /**
+     * @brief Konstruktor klasy QuantileSketch.
+     *
+     * @param compression Parametr kompresji (większy = dokładniej, więcej centroidów).
+     */
+    explicit QuantileSketch(double compression = 200.0);
+
+    /**
+     * @brief Tworzy szkic z zapisanych centroidów (np. odczytanych z bazy danych).
+     *
+     * @param compression Parametr kompresji.
+     * @param centroids Lista centroidów.
+     * @param min Najmniejsza wartość w szkicu.
+     * @param max Największa wartość w szkicu.
+     * @return Odtworzony szkic.
+     */
+    static QuantileSketch fromCentroids(double compression, const std::vector<Centroid>& centroids, double min, double max);
+
+    /**
+     * @brief Dodaje wartość do szkicu.
+     *
+     * @param value Wartość.
+     * @param weight Waga (liczba powtórzeń) wartości.
+     */
+    void add(double value, double weight = 1.0);
+
+    /**
+     * @brief Dołącza inny szkic do bieżącego.
+     *
+     * @param other Szkic do dołączenia.
+     */
+    void merge(const QuantileSketch& other);
+
+    /**
+     * @brief Wyznacza przybliżony kwantyl.
+     *
+     * @param q Rząd kwantyla z przedziału [0, 1] (np. 0.98 dla P98).
+     * @return Wartość kwantyla lub -1.0 jeśli szkic jest pusty.
+     */
+    double quantile(double q) const;
+
+    /**
+     * @brief Zwraca łączną wagę (liczbę wartości) w szkicu.
+     *
+     * @return Łączna waga.
+     */
+    double getCount() const;
+
+    /**
+     * @brief Zwraca najmniejszą wartość dodaną do szkicu.
+     *
+     * @return Minimum.
+     */
+    double getMin() const { return min_; }
+
+    /**
+     * @brief Zwraca największą wartość dodaną do szkicu.
+     *
+     * @return Maksimum.
+     */
+    double getMax() const { return max_; }
+
+    /**
+     * @brief Zwraca parametr kompresji.
+     *
+     * @return Parametr kompresji.
+     */
+    double getCompression() const { return compression_; }
+
+    /**
+     * @brief Zwraca listę centroidów (po scaleniu bufora).
+     *
+     * @return Referencja do posortowanej listy centroidów.
+     */
+    const std::vector<Centroid>& getCentroids() const;
+
+private:
+    /**
+     * @brief Scala bufor nowych wartości z centroidami zgodnie z funkcją skali k1.
+     */
+    void compress() const;
+
+    double compression_;                    ///< Parametr kompresji.
+    double min_;                            ///< Najmniejsza wartość.
+    double max_;                            ///< Największa wartość.
+    mutable std::vector<Centroid> centroids_; ///< Centroidy posortowane po średniej.
+    mutable std::vector<Centroid> buffer_;    ///< Wartości oczekujące na scalenie.
+};
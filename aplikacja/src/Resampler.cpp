@@ -0,0 +1,193 @@
+/**
+ * @file Resampler.cpp
+ * @brief Implementacja rzutowania serii na regularną siatkę czasu.
+ */
+
+#include "Resampler.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <limits>
+
+const int64_t Resampler::HOUR;
+const int64_t Resampler::DAY;
+
+/**
+ * @brief Konstruktor klasy Resampler.
+ *
+ * @param stepSeconds Krok siatki w sekundach.
+ * @param aggregation Sposób agregacji.
+ * @param fillPolicy Sposób uzupełniania luk.
+ * @param fillLimit Limit uzupełniania w krokach siatki (0 - bez limitu).
+ */
+Resampler::Resampler(int64_t stepSeconds, Aggregation aggregation, FillPolicy fillPolicy, size_t fillLimit)
+    : stepSeconds_(std::max<int64_t>(stepSeconds, 1)), aggregation_(aggregation),
+    fillPolicy_(fillPolicy), fillLimit_(fillLimit), minCount_(1) {
+}
+
+/**
+ * @brief Ustawia minimalną liczbę pomiarów, przy której przedział ma wartość.
+ *
+ * @param minCount Minimalna liczba pomiarów w przedziale.
+ */
+void Resampler::setMinCount(size_t minCount) {
+    minCount_ = std::max<size_t>(minCount, 1);
+}
+
+/**
+ * @brief Rzutuje serię na siatkę obejmującą zakres jej pomiarów.
+ *
+ * @param series Seria pomiarów.
+ * @return Seria o stałym kroku.
+ */
+MeasurementSeries Resampler::resample(const MeasurementSeries& series) const {
+    if (series.empty()) return MeasurementSeries();
+    return resample(series, series.getTimestamps().front(), series.getTimestamps().back() + 1);
+}
+
+/**
+ * @brief Rzutuje serię na siatkę obejmującą zadany zakres czasu.
+ *
+ * Jedno przejście po pomiarach (agregacja) i jedno po siatce (uzupełnianie luk) - O(n + m).
+ *
+ * @param series Seria pomiarów.
+ * @param from Początek zakresu (włącznie).
+ * @param to Koniec zakresu (wyłącznie).
+ * @return Seria o stałym kroku.
+ */
+MeasurementSeries Resampler::resample(const MeasurementSeries& series, int64_t from, int64_t to) const {
+    MeasurementSeries result;
+    const int64_t first = alignDown(from);
+    if (to <= first) return result;
+
+    const size_t count = static_cast<size_t>((to - first + stepSeconds_ - 1) / stepSeconds_);
+    const int64_t end = first + static_cast<int64_t>(count) * stepSeconds_;
+
+    std::vector<double> accumulated(count, 0.0);
+    std::vector<size_t> counts(count, 0);
+
+    const auto& timestamps = series.getTimestamps();
+    const auto& values = series.getValues();
+    auto begin = std::lower_bound(timestamps.begin(), timestamps.end(), first);
+    for (size_t i = begin - timestamps.begin(); i < series.size() && timestamps[i] < end; i++) {
+        if (!(values[i] >= 0)) continue;
+
+        const size_t bucket = static_cast<size_t>((timestamps[i] - first) / stepSeconds_);
+        const double value = values[i];
+        double& acc = accumulated[bucket];
+
+        if (counts[bucket] == 0) {
+            acc = value;
+        }
+        else {
+            switch (aggregation_) {
+            case Aggregation::MEAN:
+            case Aggregation::SUM: acc += value; break;
+            case Aggregation::MIN: acc = std::min(acc, value); break;
+            case Aggregation::MAX: acc = std::max(acc, value); break;
+            case Aggregation::LAST: acc = value; break;
+            case Aggregation::FIRST:
+            case Aggregation::COUNT: break;
+            }
+        }
+        counts[bucket]++;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (aggregation_ == Aggregation::COUNT) {
+            accumulated[i] = static_cast<double>(counts[i]);
+        }
+        else if (counts[i] < minCount_) {
+            accumulated[i] = -1.0;
+        }
+        else if (aggregation_ == Aggregation::MEAN) {
+            accumulated[i] /= static_cast<double>(counts[i]);
+        }
+    }
+
+    if (aggregation_ != Aggregation::COUNT) {
+        fillGaps(accumulated);
+    }
+
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        result.append(first + static_cast<int64_t>(i) * stepSeconds_, accumulated[i]);
+    }
+    return result;
+}
+
+/**
+ * @brief Rzutuje wiele serii na wspólną siatkę.
+ *
+ * @param series Serie pomiarów.
+ * @return Serie o stałym kroku i wspólnych znacznikach czasu.
+ */
+std::vector<MeasurementSeries> Resampler::resampleMany(const std::vector<MeasurementSeries>& series) const {
+    std::vector<MeasurementSeries> results(series.size());
+
+    int64_t from = std::numeric_limits<int64_t>::max();
+    int64_t to = std::numeric_limits<int64_t>::min();
+    for (const auto& s : series) {
+        if (s.empty()) continue;
+        from = std::min(from, s.getTimestamps().front());
+        to = std::max(to, s.getTimestamps().back() + 1);
+    }
+    if (from >= to) return results;
+
+    TaskScheduler::shared().parallelFor(series.size(), [&](size_t i) {
+        results[i] = resample(series[i], from, to);
+    });
+
+    return results;
+}
+
+/**
+ * @brief Uzupełnia luki w wartościach zgodnie z polityką.
+ *
+ * @param values Wartości na siatce (-1.0 oznacza brak).
+ */
+void Resampler::fillGaps(std::vector<double>& values) const {
+    if (fillPolicy_ == FillPolicy::NONE) return;
+
+    const size_t n = values.size();
+    size_t last = n; // indeks ostatniej znanej wartości (n - brak)
+
+    for (size_t i = 0; i < n; i++) {
+        if (values[i] < 0) continue;
+
+        if (last != n && i - last > 1) {
+            const size_t gap = i - last - 1;
+            if (fillPolicy_ == FillPolicy::LINEAR) {
+                if (fillLimit_ == 0 || gap <= fillLimit_) {
+                    const double delta = (values[i] - values[last]) / static_cast<double>(i - last);
+                    for (size_t j = last + 1; j < i; j++) {
+                        values[j] = values[last] + delta * static_cast<double>(j - last);
+                    }
+                }
+            }
+            else {
+                const size_t filled = fillLimit_ == 0 ? gap : std::min(gap, fillLimit_);
+                std::fill(values.begin() + last + 1, values.begin() + last + 1 + filled, values[last]);
+            }
+        }
+        last = i;
+    }
+
+    // Powielenie ostatniej wartości także na końcu siatki (interpolacja wymaga wartości z obu stron)
+    if (fillPolicy_ == FillPolicy::FORWARD && last != n && last + 1 < n) {
+        const size_t gap = n - last - 1;
+        const size_t filled = fillLimit_ == 0 ? gap : std::min(gap, fillLimit_);
+        std::fill(values.begin() + last + 1, values.begin() + last + 1 + filled, values[last]);
+    }
+}
+
+/**
+ * @brief Wyrównuje znacznik czasu w dół do wielokrotności kroku.
+ *
+ * @param timestamp Znacznik czasu.
+ * @return Wyrównany znacznik czasu.
+ */
+int64_t Resampler::alignDown(int64_t timestamp) const {
+    int64_t remainder = timestamp % stepSeconds_;
+    if (remainder < 0) remainder += stepSeconds_;
+    return timestamp - remainder;
+}
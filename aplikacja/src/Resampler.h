@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "MeasurementSeries.h"
+
+/**
+ * @file Resampler.h
+ * @brief Rzutowanie serii na regularną siatkę czasu (godzinową, dobową lub dowolną) z uzupełnianiem luk.
+ *
+ * Wynikiem jest seria o stałym kroku, w której i-ty element odpowiada przedziałowi
+ * [początek + i*krok, początek + (i+1)*krok). Dzięki temu serie z różnych sensorów
+ * można porównywać element po elemencie, a tablice wartości przekazywać bezpośrednio
+ * do obliczeń wektorowych i wykresów. Brakujące wartości mają, jak w całej aplikacji, wartość -1.0.
+ */
+class Resampler {
+public:
+    static const int64_t HOUR = 3600;  ///< Krok siatki godzinowej.
+    static const int64_t DAY = 86400;  ///< Krok siatki dobowej.
+
+    /**
+     * @brief Sposób agregacji pomiarów wpadających do jednego przedziału siatki.
+     */
+    enum class Aggregation {
+        MEAN,  ///< Średnia.
+        MIN,   ///< Minimum.
+        MAX,   ///< Maksimum.
+        SUM,   ///< Suma.
+        FIRST, ///< Pierwszy pomiar w przedziale.
+        LAST,  ///< Ostatni pomiar w przedziale.
+        COUNT  ///< Liczba prawidłowych pomiarów (przedział bez pomiarów ma wartość 0).
+    };
+
+    /**
+     * @brief Sposób uzupełniania przedziałów bez wartości.
+     */
+    enum class FillPolicy {
+        NONE,    ///< Bez uzupełniania.
+        LINEAR,  ///< Interpolacja liniowa między sąsiednimi wartościami (tylko luki wewnętrzne).
+        FORWARD  ///< Powielenie ostatniej znanej wartości.
+    };
+
+    /**
+     * @brief Konstruktor klasy Resampler.
+     *
+     * @param stepSeconds Krok siatki w sekundach (np. Resampler::HOUR, Resampler::DAY).
+     * @param aggregation Sposób agregacji.
+     * @param fillPolicy Sposób uzupełniania luk.
+     * @param fillLimit Limit uzupełniania w krokach siatki (0 - bez limitu). Przy interpolacji
+     *                  dłuższe luki pozostają puste, przy powielaniu uzupełniane jest co najwyżej
+     *                  fillLimit przedziałów po ostatniej znanej wartości.
+     */
+    explicit Resampler(int64_t stepSeconds = HOUR, Aggregation aggregation = Aggregation::MEAN,
+        FillPolicy fillPolicy = FillPolicy::NONE, size_t fillLimit = 0);
+
+    /**
+     * @brief Ustawia minimalną liczbę pomiarów, przy której przedział ma wartość.
+     *
+     * Pozwala np. uznawać średnią dobową tylko przy co najmniej 18 godzinach pomiarów.
+     *
+     * @param minCount Minimalna liczba pomiarów w przedziale.
+     */
+    void setMinCount(size_t minCount);
+
+    /**
+     * @brief Rzutuje serię na siatkę obejmującą zakres jej pomiarów.
+     *
+     * @param series Seria pomiarów posortowana rosnąco po czasie.
+     * @return Seria o stałym kroku (pusta, jeśli seria wejściowa jest pusta).
+     */
+    MeasurementSeries resample(const MeasurementSeries& series) const;
+
+    /**
+     * @brief Rzutuje serię na siatkę obejmującą zadany zakres czasu.
+     *
+     * Początek siatki jest wyrównywany w dół do wielokrotności kroku (np. do pełnej godziny lub północy).
+     *
+     * @param series Seria pomiarów posortowana rosnąco po czasie.
+     * @param from Początek zakresu (włącznie).
+     * @param to Koniec zakresu (wyłącznie).
+     * @return Seria o stałym kroku.
+     */
+    MeasurementSeries resample(const MeasurementSeries& series, int64_t from, int64_t to) const;
+
+    /**
+     * @brief Rzutuje wiele serii na wspólną siatkę (obejmującą wszystkie serie).
+     *
+     * Serie są przetwarzane równolegle. Wyniki mają jednakową długość i wspólne znaczniki czasu,
+     * więc mogą być porównywane element po elemencie.
+     *
+     * @param series Serie pomiarów.
+     * @return Serie o stałym kroku w tej samej kolejności co serie wejściowe.
+     */
+    std::vector<MeasurementSeries> resampleMany(const std::vector<MeasurementSeries>& series) const;
+
+    /**
+     * @brief Zwraca krok siatki.
+     *
+     * @return Krok w sekundach.
+     */
+    int64_t getStepSeconds() const { return stepSeconds_; }
+
+private:
+    /**
+     * @brief Uzupełnia luki w wartościach zgodnie z polityką.
+     *
+     * @param values Wartości na siatce (-1.0 oznacza brak).
+     */
+    void fillGaps(std::vector<double>& values) const;
+
+    /**
+     * @brief Wyrównuje znacznik czasu w dół do wielokrotności kroku.
+     */
+    int64_t alignDown(int64_t timestamp) const;
+
+    int64_t stepSeconds_;     ///< Krok siatki.
+    Aggregation aggregation_; ///< Sposób agregacji.
+    FillPolicy fillPolicy_;   ///< Sposób uzupełniania luk.
+    size_t fillLimit_;        ///< Limit uzupełniania (0 - bez limitu).
+    size_t minCount_;         ///< Minimalna liczba pomiarów w przedziale.
+};
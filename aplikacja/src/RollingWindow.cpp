@@ -0,0 +1,192 @@
+/**
+ * @file RollingWindow.cpp
+ * @brief Implementacja agregatów w oknie przesuwnym opartym na czasie.
+ */
+
+#include "RollingWindow.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+namespace {
+
+const int64_t SECONDS_PER_DAY = 86400;
+
+} // namespace
+
+/**
+ * @brief Zwraca średnie kroczące jako serię pomiarową.
+ *
+ * @return Seria średnich kroczących.
+ */
+MeasurementSeries RollingWindow::Result::toSeries() const {
+    MeasurementSeries series;
+    series.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        series.append(timestamps[i], means[i]);
+    }
+    return series;
+}
+
+/**
+ * @brief Konstruktor klasy RollingWindow.
+ *
+ * @param windowSeconds Długość okna w sekundach.
+ * @param stepSeconds Oczekiwany odstęp między pomiarami.
+ * @param minCoverage Minimalny odsetek oczekiwanych pomiarów w oknie.
+ */
+RollingWindow::RollingWindow(int64_t windowSeconds, int64_t stepSeconds, double minCoverage)
+    : windowSeconds_(std::max<int64_t>(windowSeconds, 1)),
+    stepSeconds_(std::max<int64_t>(stepSeconds, 1)),
+    minCoverage_(std::min(1.0, std::max(0.0, minCoverage))) {
+    double expected = static_cast<double>(windowSeconds_) / stepSeconds_;
+    // Odjęcie epsilona chroni przed zaokrągleniem np. 0.75 * 24 = 18.000000000000004 do 19
+    minCount_ = static_cast<uint32_t>(std::max(1.0, std::ceil(expected * minCoverage_ - 1e-9)));
+}
+
+/**
+ * @brief Okno 24-godzinne dla pyłów PM10 i PM2.5.
+ *
+ * @return Skonfigurowane okno.
+ */
+RollingWindow RollingWindow::mean24h() {
+    return RollingWindow(24 * 3600, 3600, 0.75);
+}
+
+/**
+ * @brief Okno 8-godzinne dla ozonu i tlenku węgla.
+ *
+ * @return Skonfigurowane okno.
+ */
+RollingWindow RollingWindow::mean8h() {
+    return RollingWindow(8 * 3600, 3600, 0.75);
+}
+
+/**
+ * @brief Dobiera okno regulacyjne do wskaźnika.
+ *
+ * @param formula Wzór wskaźnika.
+ * @param window Referencja do okna, które zostanie ustawione.
+ * @return true jeśli dla wskaźnika zdefiniowano okno regulacyjne.
+ */
+bool RollingWindow::forParameter(const std::string& formula, RollingWindow& window) {
+    if (formula == "PM10" || formula == "PM2.5") {
+        window = mean24h();
+        return true;
+    }
+    if (formula == "O3" || formula == "CO") {
+        window = mean8h();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Wyznacza agregaty kroczące dla jednej serii.
+ *
+ * Każdy punkt jest dodawany i usuwany z sumy oraz kolejek co najwyżej raz, więc koszt
+ * wynosi O(n) niezależnie od długości okna.
+ *
+ * @param series Seria pomiarów posortowana rosnąco po czasie.
+ * @return Wyniki dla każdego znacznika czasu serii.
+ */
+RollingWindow::Result RollingWindow::compute(const MeasurementSeries& series) const {
+    const auto& timestamps = series.getTimestamps();
+    const auto& values = series.getValues();
+    const size_t n = series.size();
+
+    Result result;
+    result.timestamps = timestamps;
+    result.means.assign(n, -1.0);
+    result.mins.assign(n, -1.0);
+    result.maxs.assign(n, -1.0);
+    result.counts.assign(n, 0);
+
+    std::deque<size_t> window;   // indeksy prawidłowych pomiarów w oknie
+    std::deque<size_t> minQueue; // wartości rosnąco - minimum z przodu
+    std::deque<size_t> maxQueue; // wartości malejąco - maksimum z przodu
+    double sum = 0.0;
+
+    for (size_t i = 0; i < n; i++) {
+        const int64_t start = timestamps[i] - windowSeconds_;
+
+        while (!window.empty() && timestamps[window.front()] <= start) {
+            sum -= values[window.front()];
+            window.pop_front();
+        }
+        while (!minQueue.empty() && timestamps[minQueue.front()] <= start) minQueue.pop_front();
+        while (!maxQueue.empty() && timestamps[maxQueue.front()] <= start) maxQueue.pop_front();
+
+        if (values[i] >= 0) {
+            window.push_back(i);
+            sum += values[i];
+            while (!minQueue.empty() && values[minQueue.back()] >= values[i]) minQueue.pop_back();
+            minQueue.push_back(i);
+            while (!maxQueue.empty() && values[maxQueue.back()] <= values[i]) maxQueue.pop_back();
+            maxQueue.push_back(i);
+        }
+
+        if (window.empty()) {
+            // Pusty przedział zeruje sumę, żeby nie przenosić błędów zaokrągleń przez luki
+            sum = 0.0;
+            continue;
+        }
+
+        const uint32_t count = static_cast<uint32_t>(window.size());
+        result.counts[i] = count;
+        if (count >= minCount_) {
+            result.means[i] = std::max(0.0, sum / count);
+            result.mins[i] = values[minQueue.front()];
+            result.maxs[i] = values[maxQueue.front()];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Wyznacza agregaty kroczące dla wielu serii w jednym wywołaniu.
+ *
+ * @param series Serie pomiarów.
+ * @return Wyniki w tej samej kolejności co serie.
+ */
+std::vector<RollingWindow::Result> RollingWindow::computeMany(const std::vector<MeasurementSeries>& series) const {
+    std::vector<Result> results(series.size());
+    if (series.empty()) return results;
+
+    TaskScheduler::shared().parallelFor(series.size(), [&](size_t i) {
+        results[i] = compute(series[i]);
+    });
+
+    return results;
+}
+
+/**
+ * @brief Wyznacza dobowe maksima średnich kroczących.
+ *
+ * @param result Wyniki z compute().
+ * @return Seria maksimów dobowych (-1.0 dla doby o niewystarczającym pokryciu).
+ */
+MeasurementSeries RollingWindow::dailyMaxima(const Result& result) const {
+    MeasurementSeries daily;
+    if (result.size() == 0) return daily;
+
+    const double expectedPerDay = static_cast<double>(SECONDS_PER_DAY) / stepSeconds_;
+    const size_t minValidWindows = static_cast<size_t>(std::max(1.0, std::ceil(expectedPerDay * minCoverage_ - 1e-9)));
+
+    size_t i = 0;
+    while (i < result.size()) {
+        const int64_t day = MeasurementSeries::startOfDay(result.timestamps[i]);
+        double maximum = -1.0;
+        size_t validWindows = 0;
+        for (; i < result.size() && MeasurementSeries::startOfDay(result.timestamps[i]) == day; i++) {
+            if (result.means[i] < 0) continue;
+            validWindows++;
+            maximum = std::max(maximum, result.means[i]);
+        }
+        daily.append(day, validWindows >= minValidWindows ? maximum : -1.0);
+    }
+
+    return daily;
+}
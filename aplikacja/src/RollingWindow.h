@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MeasurementSeries.h"
+
+/**
+ * @file RollingWindow.h
+ * @brief Agregaty w oknie przesuwnym opartym na czasie (średnie 24h, średnie 8h, maksima dobowe).
+ *
+ * Okno jest wyznaczane na podstawie znaczników czasu, a nie indeksów w tablicy, więc luki
+ * w danych nie przesuwają okna. Średnia, minimum, maksimum i liczba punktów są liczone w czasie
+ * O(n) niezależnie od długości okna (suma bieżąca i kolejki monotoniczne).
+ */
+class RollingWindow {
+public:
+    /**
+     * @brief Wyniki dla kolejnych położeń okna (jedno położenie na każdy znacznik czasu serii).
+     *
+     * Okno kończące się w chwili t obejmuje punkty z przedziału (t - długość okna, t].
+     * Dla okien o niewystarczającym pokryciu średnia, minimum i maksimum mają wartość -1.0.
+     */
+    struct Result {
+        std::vector<int64_t> timestamps; ///< Koniec okna (znacznik czasu w sekundach).
+        std::vector<double> means;       ///< Średnia w oknie.
+        std::vector<double> mins;        ///< Minimum w oknie.
+        std::vector<double> maxs;        ///< Maksimum w oknie.
+        std::vector<uint32_t> counts;    ///< Liczba prawidłowych pomiarów w oknie.
+
+        /**
+         * @brief Zwraca liczbę położeń okna.
+         *
+         * @return Liczba wyników.
+         */
+        size_t size() const { return timestamps.size(); }
+
+        /**
+         * @brief Zwraca średnie kroczące jako serię pomiarową (okna bez pokrycia jako brak pomiaru).
+         *
+         * @return Seria średnich kroczących.
+         */
+        MeasurementSeries toSeries() const;
+    };
+
+    /**
+     * @brief Konstruktor klasy RollingWindow.
+     *
+     * @param windowSeconds Długość okna w sekundach.
+     * @param stepSeconds Oczekiwany odstęp między pomiarami (do wyznaczenia pokrycia okna).
+     * @param minCoverage Minimalny odsetek oczekiwanych pomiarów, przy którym wynik okna jest ważny.
+     */
+    RollingWindow(int64_t windowSeconds, int64_t stepSeconds = 3600, double minCoverage = 0.75);
+
+    /**
+     * @brief Okno 24-godzinne dla pyłów PM10 i PM2.5 (ważne przy co najmniej 18 z 24 godzin).
+     *
+     * @return Skonfigurowane okno.
+     */
+    static RollingWindow mean24h();
+
+    /**
+     * @brief Okno 8-godzinne dla ozonu i tlenku węgla (ważne przy co najmniej 6 z 8 godzin).
+     *
+     * @return Skonfigurowane okno.
+     */
+    static RollingWindow mean8h();
+
+    /**
+     * @brief Dobiera okno regulacyjne do wskaźnika.
+     *
+     * @param formula Wzór wskaźnika (np. "PM10", "O3").
+     * @param window Referencja do okna, które zostanie ustawione.
+     * @return true jeśli dla wskaźnika zdefiniowano okno regulacyjne, false w przeciwnym razie.
+     */
+    static bool forParameter(const std::string& formula, RollingWindow& window);
+
+    /**
+     * @brief Wyznacza agregaty kroczące dla jednej serii.
+     *
+     * @param series Seria pomiarów posortowana rosnąco po czasie.
+     * @return Wyniki dla każdego znacznika czasu serii.
+     */
+    Result compute(const MeasurementSeries& series) const;
+
+    /**
+     * @brief Wyznacza agregaty kroczące dla wielu serii (np. wszystkich sensorów) w jednym wywołaniu.
+     *
+     * Serie są przetwarzane równolegle w kilku wątkach.
+     *
+     * @param series Serie pomiarów.
+     * @return Wyniki w tej samej kolejności co serie.
+     */
+    std::vector<Result> computeMany(const std::vector<MeasurementSeries>& series) const;
+
+    /**
+     * @brief Wyznacza dobowe maksima średnich kroczących (np. maksymalna dobowa średnia 8h dla ozonu).
+     *
+     * Każde okno jest przypisane do doby, w której się kończy. Doba jest ważna, jeśli ma
+     * co najmniej minCoverage oczekiwanej liczby ważnych okien.
+     *
+     * @param result Wyniki z compute().
+     * @return Seria z początkiem doby jako znacznikiem czasu i maksimum średnich (-1.0 dla doby nieważnej).
+     */
+    MeasurementSeries dailyMaxima(const Result& result) const;
+
+    /**
+     * @brief Zwraca długość okna.
+     *
+     * @return Długość okna w sekundach.
+     */
+    int64_t getWindowSeconds() const { return windowSeconds_; }
+
+    /**
+     * @brief Zwraca minimalną liczbę pomiarów, przy której wynik okna jest ważny.
+     *
+     * @return Minimalna liczba pomiarów w oknie.
+     */
+    uint32_t getMinCount() const { return minCount_; }
+
+private:
+    int64_t windowSeconds_; ///< Długość okna w sekundach.
+    int64_t stepSeconds_;   ///< Oczekiwany odstęp między pomiarami.
+    double minCoverage_;    ///< Minimalne pokrycie okna (0-1).
+    uint32_t minCount_;     ///< Minimalna liczba pomiarów w oknie wynikająca z pokrycia.
+};
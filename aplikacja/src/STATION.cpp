@@ -1 +1 @@
-#include "STATION.h"
+#include "STATION.h"
@@ -1,36 +1,120 @@
-#pragma once
-
-#include <string>
-
-/**
- * @file Station.h
- * @brief Klasa reprezentujca stacj pomiarow jakoci powietrza.
- */
-class Station {
-public:
-    /**
-     * @brief Konstruktor klasy Station.
-     *
-     * @param id Unikalny identyfikator stacji.
-     * @param name Nazwa stacji (np. lokalizacja).
-     */
-    Station(int id, const std::string& name) : id_(id), name_(name) {}
-
-    /**
-     * @brief Zwraca identyfikator stacji.
-     *
-     * @return Id stacji jako liczba cakowita.
-     */
-    int getId() const { return id_; }
-
-    /**
-     * @brief Zwraca nazw stacji.
-     *
-     * @return Nazwa stacji jako std::string.
-     */
-    std::string getName() const { return name_; }
-
-private:
-    int id_;           ///< Identyfikator stacji pomiarowej.
-    std::string name_; ///< Nazwa/lokalizacja stacji.
+#pragma once
+
+#include <cmath>
+#include <string>
+
+/**
+ * @file Station.h
+ * @brief Klasa reprezentująca stację pomiarową jakości powietrza.
+ */
+class Station {
+public:
+    /**
+     * @brief Konstruktor klasy Station.
+     *
+     * @param id Unikalny identyfikator stacji.
+     * @param name Nazwa stacji (np. lokalizacja).
+     */
+    Station(int id, const std::string& name)
+        : id_(id), name_(name), latitude_(NAN), longitude_(NAN) {}
+
+    /**
+     * @brief Konstruktor klasy Station z położeniem i danymi administracyjnymi.
+     *
+     * @param id Unikalny identyfikator stacji.
+     * @param name Nazwa stacji.
+     * @param latitude Szerokość geograficzna w stopniach (WGS84).
+     * @param longitude Długość geograficzna w stopniach (WGS84).
+     * @param city Miejscowość.
+     * @param commune Gmina.
+     * @param district Powiat.
+     * @param province Województwo.
+     * @param address Ulica (adres stacji).
+     */
+    Station(int id, const std::string& name, double latitude, double longitude,
+        const std::string& city, const std::string& commune, const std::string& district,
+        const std::string& province, const std::string& address)
+        : id_(id), name_(name), latitude_(latitude), longitude_(longitude), city_(city),
+        commune_(commune), district_(district), province_(province), address_(address) {}
+
+    /**
+     * @brief Zwraca identyfikator stacji.
+     *
+     * @return Id stacji jako liczba całkowita.
+     */
+    int getId() const { return id_; }
+
+    /**
+     * @brief Zwraca nazwę stacji.
+     *
+     * @return Nazwa stacji jako std::string.
+     */
+    std::string getName() const { return name_; }
+
+    /**
+     * @brief Sprawdza, czy znane jest położenie stacji.
+     *
+     * @return true jeśli szerokość i długość geograficzna są określone.
+     */
+    bool hasLocation() const { return !std::isnan(latitude_) && !std::isnan(longitude_); }
+
+    /**
+     * @brief Zwraca szerokość geograficzną stacji.
+     *
+     * @return Szerokość w stopniach lub NaN, jeśli nieznana.
+     */
+    double getLatitude() const { return latitude_; }
+
+    /**
+     * @brief Zwraca długość geograficzną stacji.
+     *
+     * @return Długość w stopniach lub NaN, jeśli nieznana.
+     */
+    double getLongitude() const { return longitude_; }
+
+    /**
+     * @brief Zwraca miejscowość stacji.
+     *
+     * @return Nazwa miejscowości (pusta, jeśli nieznana).
+     */
+    std::string getCity() const { return city_; }
+
+    /**
+     * @brief Zwraca gminę stacji.
+     *
+     * @return Nazwa gminy (pusta, jeśli nieznana).
+     */
+    std::string getCommune() const { return commune_; }
+
+    /**
+     * @brief Zwraca powiat stacji.
+     *
+     * @return Nazwa powiatu (pusta, jeśli nieznana).
+     */
+    std::string getDistrict() const { return district_; }
+
+    /**
+     * @brief Zwraca województwo stacji.
+     *
+     * @return Nazwa województwa (pusta, jeśli nieznana).
+     */
+    std::string getProvince() const { return province_; }
+
+    /**
+     * @brief Zwraca adres (ulicę) stacji.
+     *
+     * @return Adres (pusty, jeśli nieznany).
+     */
+    std::string getAddress() const { return address_; }
+
+private:
+    int id_;               ///< Identyfikator stacji pomiarowej.
+    std::string name_;     ///< Nazwa/lokalizacja stacji.
+    double latitude_;      ///< Szerokość geograficzna (NaN - nieznana).
+    double longitude_;     ///< Długość geograficzna (NaN - nieznana).
+    std::string city_;     ///< Miejscowość.
+    std::string commune_;  ///< Gmina.
+    std::string district_; ///< Powiat.
+    std::string province_; ///< Województwo.
+    std::string address_;  ///< Ulica.
 };
\ No newline at end of file
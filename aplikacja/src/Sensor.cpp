@@ -1 +1 @@
-#include "Sensor.h"
+#include "Sensor.h"
@@ -0,0 +1,120 @@
+/**
+ * @file SeriesCache.cpp
+ * @brief Implementacja sesyjnej pamięci podręcznej serii pomiarów.
+ */
+
+#include "SeriesCache.h"
+#include "MeasurementSeries.h"
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Tworzy wpis: parsuje daty i porządkuje pomiary według czasu.
+ *
+ * Dane z API przychodzą od najnowszych, więc najczęściej wystarcza odwrócenie kolejności.
+ *
+ * @param station Stacja pomiarowa.
+ * @param sensor Czujnik.
+ * @param measurements Pomiary.
+ * @param fromDatabase Czy dane pochodzą z lokalnej bazy.
+ */
+SeriesCache::Entry::Entry(const Station& station, const Sensor& sensor, const std::vector<Measurement>& measurements,
+    bool fromDatabase)
+    : station(station), sensor(sensor), fromDatabase(fromDatabase) {
+    std::vector<int64_t> parsed;
+    std::vector<size_t> source;
+    parsed.reserve(measurements.size());
+    source.reserve(measurements.size());
+    for (size_t i = 0; i < measurements.size(); i++) {
+        int64_t timestamp;
+        if (MeasurementSeries::parseTimestamp(measurements[i].getDate(), timestamp)) {
+            parsed.push_back(timestamp);
+            source.push_back(i);
+        }
+    }
+
+    std::vector<size_t> order(parsed.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(parsed.begin(), parsed.end())) {
+        if (std::is_sorted(parsed.rbegin(), parsed.rend())) {
+            std::reverse(order.begin(), order.end());
+        }
+        else {
+            std::stable_sort(order.begin(), order.end(), [&parsed](size_t a, size_t b) { return parsed[a] < parsed[b]; });
+        }
+    }
+
+    this->measurements.reserve(order.size());
+    timestamps.reserve(order.size());
+    for (size_t i : order) {
+        this->measurements.push_back(measurements[source[i]]);
+        timestamps.push_back(parsed[i]);
+    }
+}
+
+/**
+ * @brief Wybiera pomiary z zakresu dat.
+ *
+ * @param from Początek zakresu (włącznie).
+ * @param to Koniec zakresu (włącznie).
+ * @param slice Zmienna na pomiary z zakresu.
+ * @param sliceTimestamps Zmienna na znaczniki czasu pomiarów z zakresu.
+ */
+void SeriesCache::Entry::slice(int64_t from, int64_t to, std::vector<Measurement>& slice,
+    std::vector<int64_t>& sliceTimestamps) const {
+    const auto begin = std::lower_bound(timestamps.begin(), timestamps.end(), from);
+    const auto end = std::upper_bound(begin, timestamps.end(), to);
+    const size_t first = begin - timestamps.begin();
+    const size_t last = end - timestamps.begin();
+
+    slice.assign(measurements.begin() + first, measurements.begin() + last);
+    sliceTimestamps.assign(begin, end);
+}
+
+/**
+ * @brief Konstruktor klasy SeriesCache.
+ *
+ * @param capacity Maksymalna liczba zapamiętanych czujników (co najmniej 1).
+ */
+SeriesCache::SeriesCache(size_t capacity)
+    : capacity_(std::max<size_t>(capacity, 1)) {
+}
+
+/**
+ * @brief Zapamiętuje serię jako ostatnio używaną, usuwając poprzednią serię czujnika i w razie potrzeby
+ * najdawniej używaną serię.
+ *
+ * @param entry Seria czujnika.
+ */
+void SeriesCache::store(std::shared_ptr<const Entry> entry) {
+    if (!entry) return;
+    const int sensorId = entry->sensor.getId();
+    entries_.remove_if([sensorId](const std::shared_ptr<const Entry>& e) { return e->sensor.getId() == sensorId; });
+    entries_.push_front(std::move(entry));
+    if (entries_.size() > capacity_) {
+        entries_.pop_back();
+    }
+}
+
+/**
+ * @brief Wyszukuje serię czujnika i przenosi ją na początek listy.
+ *
+ * @param sensorId ID czujnika.
+ * @return Seria lub nullptr.
+ */
+std::shared_ptr<const SeriesCache::Entry> SeriesCache::find(int sensorId) {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if ((*it)->sensor.getId() == sensorId) {
+            entries_.splice(entries_.begin(), entries_, it);
+            return entries_.front();
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Usuwa wszystkie serie.
+ */
+void SeriesCache::clear() {
+    entries_.clear();
+}
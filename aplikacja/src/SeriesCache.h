@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+#include "Station.h"
+#include "Sensor.h"
+#include "Measurement.h"
+
+/**
+ * @file SeriesCache.h
+ * @brief Sesyjna pamięć podręczna ostatnio pobranych lub wczytanych serii pomiarów (po jednej na czujnik).
+ *
+ * Seria jest zapamiętywana raz, w postaci uporządkowanej według czasu i z przeliczonymi znacznikami
+ * czasu, więc wybór innego zakresu dat to dwa wyszukiwania binarne zamiast ponownego zapytania do API
+ * lub odczytu bazy i parsowania wszystkich dat. Pamięć mieści kilka ostatnio używanych czujników;
+ * najdawniej używany jest usuwany jako pierwszy.
+ */
+class SeriesCache {
+public:
+    /**
+     * @brief Zapamiętana seria czujnika.
+     */
+    struct Entry {
+        /**
+         * @brief Tworzy wpis: parsuje daty i porządkuje pomiary według czasu.
+         *
+         * @param station Stacja pomiarowa.
+         * @param sensor Czujnik.
+         * @param measurements Pomiary w dowolnej kolejności (pomiary z niepoprawną datą są pomijane).
+         * @param fromDatabase Czy dane pochodzą z lokalnej bazy (a nie z API).
+         */
+        Entry(const Station& station, const Sensor& sensor, const std::vector<Measurement>& measurements,
+            bool fromDatabase);
+
+        /**
+         * @brief Wybiera pomiary z zakresu dat (wyszukiwanie binarne, bez parsowania dat).
+         *
+         * @param from Początek zakresu (znacznik czasu, włącznie).
+         * @param to Koniec zakresu (znacznik czasu, włącznie).
+         * @param slice Zmienna na pomiary z zakresu (rosnąco według czasu).
+         * @param sliceTimestamps Zmienna na znaczniki czasu pomiarów z zakresu.
+         */
+        void slice(int64_t from, int64_t to, std::vector<Measurement>& slice, std::vector<int64_t>& sliceTimestamps) const;
+
+        Station station;                      ///< Stacja pomiarowa.
+        Sensor sensor;                        ///< Czujnik.
+        std::vector<Measurement> measurements; ///< Pomiary uporządkowane rosnąco według czasu.
+        std::vector<int64_t> timestamps;      ///< Znaczniki czasu pomiarów.
+        bool fromDatabase;                    ///< Czy dane pochodzą z lokalnej bazy.
+    };
+
+    /**
+     * @brief Konstruktor klasy SeriesCache.
+     *
+     * @param capacity Maksymalna liczba zapamiętanych czujników.
+     */
+    explicit SeriesCache(size_t capacity = 8);
+
+    /**
+     * @brief Zapamiętuje serię (zastępując poprzednią serię tego samego czujnika).
+     *
+     * @param entry Seria czujnika.
+     */
+    void store(std::shared_ptr<const Entry> entry);
+
+    /**
+     * @brief Wyszukuje serię czujnika i oznacza ją jako ostatnio używaną.
+     *
+     * @param sensorId ID czujnika.
+     * @return Seria lub nullptr, jeśli czujnika nie ma w pamięci.
+     */
+    std::shared_ptr<const Entry> find(int sensorId);
+
+    /**
+     * @brief Usuwa wszystkie serie.
+     */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę zapamiętanych serii.
+     */
+    size_t size() const { return entries_.size(); }
+
+private:
+    size_t capacity_;                               ///< Maksymalna liczba serii.
+    std::list<std::shared_ptr<const Entry>> entries_; ///< Serie, od ostatnio używanej.
+};
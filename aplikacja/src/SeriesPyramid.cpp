@@ -0,0 +1,133 @@
+/**
+ * @file SeriesPyramid.cpp
+ * @brief Implementacja piramidy agregatów serii.
+ */
+
+#include "SeriesPyramid.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Tworzy pustą piramidę.
+ */
+SeriesPyramid::SeriesPyramid() {
+}
+
+/**
+ * @brief Buduje piramidę dla wartości serii.
+ *
+ * Poziomy są budowane od dołu, każdy w jednym przejściu po poprzednim (łącznie O(n)).
+ *
+ * @param values Wartości w kolejności czasu.
+ */
+SeriesPyramid::SeriesPyramid(const std::vector<double>& values) {
+    if (values.empty()) return;
+
+    levels_.emplace_back();
+    levels_[0].reserve(values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        const bool valid = values[i] >= 0;
+        levels_[0].push_back({ i, 1, valid ? size_t(1) : size_t(0),
+            valid ? values[i] : std::numeric_limits<double>::infinity(),
+            valid ? values[i] : -std::numeric_limits<double>::infinity(),
+            valid ? values[i] : 0.0 });
+    }
+
+    while (levels_.back().size() > 1) {
+        const std::vector<Bucket>& lower = levels_.back();
+        std::vector<Bucket> upper;
+        upper.reserve((lower.size() + 1) / 2);
+        for (size_t i = 0; i < lower.size(); i += 2) {
+            upper.push_back(i + 1 < lower.size() ? merge(lower[i], lower[i + 1]) : lower[i]);
+        }
+        levels_.push_back(std::move(upper));
+    }
+}
+
+/**
+ * @brief Dopisuje punkt na końcu serii.
+ *
+ * Na każdym poziomie zmienia się tylko ostatni kubełek (albo dochodzi nowy), a gdy poziom
+ * najwyższy ma więcej niż jeden kubełek, dobudowywany jest kolejny poziom.
+ *
+ * @param value Wartość (ujemna = brak pomiaru).
+ */
+void SeriesPyramid::append(double value) {
+    if (levels_.empty()) levels_.emplace_back();
+
+    const size_t index = levels_[0].size();
+    const bool valid = value >= 0;
+    levels_[0].push_back({ index, 1, valid ? size_t(1) : size_t(0),
+        valid ? value : std::numeric_limits<double>::infinity(),
+        valid ? value : -std::numeric_limits<double>::infinity(),
+        valid ? value : 0.0 });
+
+    for (size_t level = 1; level < levels_.size() || levels_[level - 1].size() > 1; level++) {
+        if (level == levels_.size()) levels_.emplace_back();
+
+        const std::vector<Bucket>& lower = levels_[level - 1];
+        const size_t bucket = (lower.size() - 1) / 2;
+        const Bucket combined = bucket * 2 + 1 < lower.size()
+            ? merge(lower[bucket * 2], lower[bucket * 2 + 1]) : lower[bucket * 2];
+
+        std::vector<Bucket>& current = levels_[level];
+        if (bucket < current.size()) current[bucket] = combined;
+        else current.push_back(combined);
+    }
+}
+
+/**
+ * @brief Usuwa wszystkie punkty.
+ */
+void SeriesPyramid::clear() {
+    levels_.clear();
+}
+
+/**
+ * @brief Wybiera najdokładniejszy poziom, na którym zakres mieści się w maxBuckets kubełkach.
+ *
+ * @param begin Początek zakresu.
+ * @param end Koniec zakresu (wyłącznie).
+ * @param maxBuckets Maksymalna liczba kubełków.
+ * @return Numer poziomu.
+ */
+size_t SeriesPyramid::levelFor(size_t begin, size_t end, size_t maxBuckets) const {
+    if (levels_.empty() || end <= begin) return 0;
+    maxBuckets = std::max<size_t>(maxBuckets, 1);
+
+    size_t level = 0;
+    // Liczba kubełków poziomu L pokrywających [begin, end) to (end - 1) / 2^L - begin / 2^L + 1
+    while (level + 1 < levels_.size() && ((end - 1) >> level) - (begin >> level) + 1 > maxBuckets) {
+        level++;
+    }
+    return level;
+}
+
+/**
+ * @brief Zwraca kubełki pokrywające zakres punktów na poziomie dobranym do maxBuckets.
+ *
+ * @param begin Początek zakresu.
+ * @param end Koniec zakresu (wyłącznie).
+ * @param maxBuckets Maksymalna liczba kubełków.
+ * @return Kubełki w kolejności czasu.
+ */
+std::vector<SeriesPyramid::Bucket> SeriesPyramid::query(size_t begin, size_t end, size_t maxBuckets) const {
+    std::vector<Bucket> result;
+    end = std::min(end, size());
+    if (begin >= end) return result;
+
+    const size_t level = levelFor(begin, end, maxBuckets);
+    const std::vector<Bucket>& buckets = levels_[level];
+    const size_t first = begin >> level;
+    const size_t last = std::min((end - 1) >> level, buckets.size() - 1);
+    result.assign(buckets.begin() + first, buckets.begin() + last + 1);
+    return result;
+}
+
+/**
+ * @brief Łączy dwa kubełki.
+ */
+SeriesPyramid::Bucket SeriesPyramid::merge(const Bucket& a, const Bucket& b) {
+    return { a.first, a.count + b.count, a.valid + b.valid,
+        std::min(a.min, b.min), std::max(a.max, b.max), a.sum + b.sum };
+}
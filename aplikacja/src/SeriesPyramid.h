@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @file SeriesPyramid.h
+ * @brief Wielopoziomowa piramida agregatów (min/max/średnia) serii do płynnego przybliżania i przesuwania wykresu.
+ *
+ * Poziom 0 zawiera pojedyncze punkty, a każdy kolejny poziom łączy pary kubełków poprzedniego,
+ * więc kubełek poziomu L obejmuje 2^L kolejnych punktów. Zapytanie o zakres wybiera poziom, na
+ * którym zakres mieści się w zadanej liczbie kubełków (np. 2 na kolumnę pikseli), dlatego koszt
+ * rysowania zależy od szerokości wykresu, a nie od liczby punktów w widocznym zakresie.
+ * Dopisanie punktu aktualizuje tylko ostatni kubełek każdego poziomu (O(log n)).
+ */
+class SeriesPyramid {
+public:
+    /**
+     * @brief Agregat kubełka.
+     */
+    struct Bucket {
+        size_t first;  ///< Indeks pierwszego punktu kubełka.
+        size_t count;  ///< Liczba punktów kubełka (także bez wartości).
+        size_t valid;  ///< Liczba punktów z wartością.
+        double min;    ///< Minimum wartości.
+        double max;    ///< Maksimum wartości.
+        double sum;    ///< Suma wartości.
+
+        /**
+         * @brief Zwraca średnią kubełka.
+         *
+         * @return Średnia lub -1.0, jeśli kubełek nie ma wartości.
+         */
+        double mean() const { return valid > 0 ? sum / valid : -1.0; }
+    };
+
+    /**
+     * @brief Tworzy pustą piramidę.
+     */
+    SeriesPyramid();
+
+    /**
+     * @brief Buduje piramidę dla wartości serii.
+     *
+     * @param values Wartości w kolejności czasu (ujemne = brak pomiaru).
+     */
+    explicit SeriesPyramid(const std::vector<double>& values);
+
+    /**
+     * @brief Dopisuje punkt na końcu serii.
+     *
+     * @param value Wartość (ujemna = brak pomiaru).
+     */
+    void append(double value);
+
+    /**
+     * @brief Usuwa wszystkie punkty.
+     */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę punktów.
+     */
+    size_t size() const { return levels_.empty() ? 0 : levels_[0].size(); }
+
+    /**
+     * @brief Zwraca liczbę poziomów.
+     */
+    size_t getLevelCount() const { return levels_.size(); }
+
+    /**
+     * @brief Wybiera najdokładniejszy poziom, na którym zakres mieści się w maxBuckets kubełkach.
+     *
+     * @param begin Początek zakresu (indeks punktu).
+     * @param end Koniec zakresu (wyłącznie).
+     * @param maxBuckets Maksymalna liczba kubełków.
+     * @return Numer poziomu.
+     */
+    size_t levelFor(size_t begin, size_t end, size_t maxBuckets) const;
+
+    /**
+     * @brief Zwraca kubełki pokrywające zakres punktów na poziomie dobranym do maxBuckets.
+     *
+     * Kubełki brzegowe mogą obejmować punkty spoza zakresu (wyrównanie do 2^L).
+     *
+     * @param begin Początek zakresu (indeks punktu).
+     * @param end Koniec zakresu (wyłącznie).
+     * @param maxBuckets Maksymalna liczba kubełków (np. dwukrotność szerokości wykresu w pikselach).
+     * @return Kubełki w kolejności czasu.
+     */
+    std::vector<Bucket> query(size_t begin, size_t end, size_t maxBuckets) const;
+
+private:
+    /**
+     * @brief Łączy dwa kubełki.
+     */
+    static Bucket merge(const Bucket& a, const Bucket& b);
+
+    std::vector<std::vector<Bucket>> levels_; ///< Poziomy od pojedynczych punktów do całej serii.
+};
@@ -0,0 +1,376 @@
+/**
+ * @file SpatialInterpolator.cpp
+ * @brief Implementacja równoległej interpolacji IDW / krigingu na siatkę geograficzną.
+ */
+
+#include "SpatialInterpolator.h"
+#include "StationIndex.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+const double EARTH_RADIUS_KM = 6371.0; ///< Średni promień Ziemi.
+const double KM_PER_DEGREE = 111.2;    ///< Długość stopnia szerokości geograficznej.
+const double PI = 3.14159265358979323846;
+const size_t TILE = 64;                ///< Bok kafelka siatki w komórkach.
+const size_t MAX_NEIGHBORS = 32;       ///< Górne ograniczenie liczby sąsiadów komórki.
+const float NODATA = -9999.0f;         ///< Wartość braku danych w zapisanym rastrze.
+const size_t MAX_CACHED_SAMPLES = 1024; ///< Maksymalna liczba próbek, dla której wariogram par jest liczony z góry.
+
+/**
+ * @brief Zamienia współrzędne geograficzne na punkt na sferze jednostkowej.
+ */
+void toUnitVector(double latitude, double longitude, double* point) {
+    const double lat = latitude * PI / 180.0;
+    const double lon = longitude * PI / 180.0;
+    point[0] = std::cos(lat) * std::cos(lon);
+    point[1] = std::cos(lat) * std::sin(lon);
+    point[2] = std::sin(lat);
+}
+
+/**
+ * @brief Odległość po kole wielkim (km) między punktami na sferze jednostkowej.
+ */
+double distanceKm(const double* a, const double* b) {
+    const double dx = a[0] - b[0];
+    const double dy = a[1] - b[1];
+    const double dz = a[2] - b[2];
+    const double half = std::min(1.0, std::sqrt(dx * dx + dy * dy + dz * dz) / 2.0);
+    return 2.0 * EARTH_RADIUS_KM * std::asin(half);
+}
+
+/**
+ * @brief Rozwiązuje układ równań metodą eliminacji Gaussa z częściowym wyborem elementu głównego.
+ *
+ * @param a Macierz n x n wierszami (niszczona).
+ * @param b Prawa strona (po wywołaniu rozwiązanie).
+ * @param n Rozmiar układu.
+ * @return false, jeśli macierz jest osobliwa.
+ */
+bool solve(double* a, double* b, size_t n) {
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        for (size_t r = col + 1; r < n; r++) {
+            if (std::fabs(a[r * n + col]) > std::fabs(a[pivot * n + col])) pivot = r;
+        }
+        if (std::fabs(a[pivot * n + col]) < 1e-12) return false;
+        if (pivot != col) {
+            for (size_t c = 0; c < n; c++) std::swap(a[col * n + c], a[pivot * n + c]);
+            std::swap(b[col], b[pivot]);
+        }
+        for (size_t r = col + 1; r < n; r++) {
+            const double factor = a[r * n + col] / a[col * n + col];
+            if (factor == 0.0) continue;
+            for (size_t c = col; c < n; c++) a[r * n + c] -= factor * a[col * n + c];
+            b[r] -= factor * b[col];
+        }
+    }
+    for (size_t col = n; col-- > 0;) {
+        double sum = b[col];
+        for (size_t c = col + 1; c < n; c++) sum -= a[col * n + c] * b[c];
+        b[col] = sum / a[col * n + col];
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief Tworzy siatkę obejmującą Polskę o zadanym rozmiarze komórki.
+ *
+ * @param cellKm Przybliżony rozmiar komórki w kilometrach.
+ * @return Siatka.
+ */
+SpatialInterpolator::Grid SpatialInterpolator::Grid::poland(double cellKm) {
+    Grid grid;
+    grid.north = 54.9;
+    grid.south = 49.0;
+    grid.west = 14.1;
+    grid.east = 24.2;
+    cellKm = cellKm > 0 ? cellKm : 1.0;
+
+    const double midLatitude = (grid.north + grid.south) / 2.0 * PI / 180.0;
+    grid.rows = static_cast<size_t>(std::ceil((grid.north - grid.south) * KM_PER_DEGREE / cellKm));
+    grid.cols = static_cast<size_t>(std::ceil((grid.east - grid.west) * KM_PER_DEGREE * std::cos(midLatitude) / cellKm));
+    return grid;
+}
+
+/**
+ * @brief Konstruktor klasy SpatialInterpolator.
+ *
+ * @param settings Parametry interpolacji.
+ */
+SpatialInterpolator::SpatialInterpolator(const Settings& settings)
+    : settings_(settings) {
+    settings_.neighbors = std::max<size_t>(1, std::min(settings_.neighbors, MAX_NEIGHBORS));
+}
+
+/**
+ * @brief Interpoluje pomiary na siatkę.
+ *
+ * Kafelki TILE x TILE komórek są rozdzielane między wątki. Dla każdego kafelka indeks stacji
+ * wyznacza jednym zapytaniem o promień zbiór kandydatów, który na pewno zawiera k najbliższych
+ * próbek każdej komórki kafelka; komórki wybierają sąsiadów tylko spośród kandydatów. Z sąsiadów
+ * liczone są wagi IDW lub wagi krigingu zwyczajnego (układ k+1 równań). Gdy układ krigingu
+ * jest osobliwy, komórka jest liczona metodą IDW.
+ *
+ * @param samples Pomiary stacji.
+ * @param grid Siatka docelowa.
+ * @return Raster wartości.
+ */
+SpatialInterpolator::Raster SpatialInterpolator::interpolate(const std::vector<Sample>& samples, const Grid& grid) const {
+    Raster raster;
+    raster.grid = grid;
+    raster.values.assign(grid.rows * grid.cols, std::numeric_limits<float>::quiet_NaN());
+
+    // Próbki prawidłowe jako "stacje" indeksu przestrzennego
+    std::vector<Sample> valid;
+    std::vector<Station> points;
+    for (const auto& sample : samples) {
+        if (!(sample.value >= 0) || std::isnan(sample.latitude) || std::isnan(sample.longitude)) continue;
+        points.emplace_back(static_cast<int>(valid.size()), "", sample.latitude, sample.longitude, "", "", "", "", "");
+        valid.push_back(sample);
+    }
+    if (valid.empty() || grid.rows == 0 || grid.cols == 0) return raster;
+
+    const StationIndex index(points);
+    std::vector<double> unit(valid.size() * 3);
+    for (size_t i = 0; i < valid.size(); i++) {
+        toUnitVector(valid[i].latitude, valid[i].longitude, &unit[i * 3]);
+    }
+
+    // Parametry wariogramu wykładniczego: gamma(h) = nugget + (sill - nugget) * (1 - exp(-3h / range))
+    double sill = settings_.sill;
+    if (!(sill > 0)) {
+        double sum = 0.0, sumSquares = 0.0;
+        for (const auto& sample : valid) {
+            sum += sample.value;
+            sumSquares += sample.value * sample.value;
+        }
+        const double mean = sum / valid.size();
+        sill = std::max(sumSquares / valid.size() - mean * mean, 1e-6);
+    }
+    const double nugget = std::min(std::max(settings_.nugget, 0.0), sill);
+    const double range = settings_.rangeKm > 0 ? settings_.rangeKm : 100.0;
+    auto variogram = [&](double h) {
+        return h <= 0.0 ? 0.0 : nugget + (sill - nugget) * (1.0 - std::exp(-3.0 * h / range));
+    };
+
+    // Dla typowej liczby stacji wariogram wszystkich par próbek mieści się w pamięci i jest liczony raz
+    const size_t n = valid.size();
+    std::vector<double> pairVariogram;
+    if (settings_.method == Method::KRIGING && n <= MAX_CACHED_SAMPLES) {
+        pairVariogram.assign(n * n, 0.0);
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = i + 1; j < n; j++) {
+                pairVariogram[i * n + j] = pairVariogram[j * n + i] = variogram(distanceKm(&unit[i * 3], &unit[j * 3]));
+            }
+        }
+    }
+
+    const size_t k = std::min(settings_.neighbors, valid.size());
+    const size_t tileRows = (grid.rows + TILE - 1) / TILE;
+    const size_t tileCols = (grid.cols + TILE - 1) / TILE;
+    const size_t tileCount = tileRows * tileCols;
+
+    // Funkcje trygonometryczne środków wierszy i kolumn liczone raz dla całej siatki
+    std::vector<double> rowCos(grid.rows), rowSin(grid.rows), colCos(grid.cols), colSin(grid.cols);
+    for (size_t row = 0; row < grid.rows; row++) {
+        rowCos[row] = std::cos(grid.rowLatitude(row) * PI / 180.0);
+        rowSin[row] = std::sin(grid.rowLatitude(row) * PI / 180.0);
+    }
+    for (size_t col = 0; col < grid.cols; col++) {
+        colCos[col] = std::cos(grid.colLongitude(col) * PI / 180.0);
+        colSin[col] = std::sin(grid.colLongitude(col) * PI / 180.0);
+    }
+
+    TaskScheduler::shared().parallelFor(tileCount, [&](size_t t) {
+        StationIndex::Hit hits[MAX_NEIGHBORS];
+        double weights[MAX_NEIGHBORS + 1];
+        double system[(MAX_NEIGHBORS + 1) * (MAX_NEIGHBORS + 1)];
+        double cell[3];
+
+        const size_t rowBegin = (t / tileCols) * TILE;
+        const size_t colBegin = (t % tileCols) * TILE;
+        const size_t rowEnd = std::min(rowBegin + TILE, grid.rows);
+        const size_t colEnd = std::min(colBegin + TILE, grid.cols);
+
+        // Kandydaci kafelka: k najbliższych dowolnej komórki leży w odległości od środka kafelka
+        // nie większej niż odległość k-tego sąsiada środka plus dwie połowy przekątnej kafelka
+        const double centerLatitude = (grid.rowLatitude(rowBegin) + grid.rowLatitude(rowEnd - 1)) / 2.0;
+        const double centerLongitude = (grid.colLongitude(colBegin) + grid.colLongitude(colEnd - 1)) / 2.0;
+        const size_t centerFound = index.nearest(centerLatitude, centerLongitude, k, StationIndex::ALL_PARAMETERS, hits);
+        double halfDiagonal = 0.0;
+        for (size_t row : { rowBegin, rowEnd - 1 }) {
+            for (size_t col : { colBegin, colEnd - 1 }) {
+                halfDiagonal = std::max(halfDiagonal, StationIndex::distanceKm(centerLatitude, centerLongitude,
+                    grid.rowLatitude(row), grid.colLongitude(col)));
+            }
+        }
+        const double candidateRadius = hits[centerFound - 1].distanceKm + 2.0 * halfDiagonal + 1e-6;
+        const std::vector<StationIndex::Hit> candidates =
+            index.withinRadius(centerLatitude, centerLongitude, candidateRadius);
+
+        for (size_t row = rowBegin; row < rowEnd; row++) {
+            for (size_t col = colBegin; col < colEnd; col++) {
+                cell[0] = rowCos[row] * colCos[col];
+                cell[1] = rowCos[row] * colSin[col];
+                cell[2] = rowSin[row];
+
+                // k najbliższych kandydatów (sortowanie przez wstawianie według kwadratu cięciwy)
+                size_t found = 0;
+                for (const auto& candidate : candidates) {
+                    const double* p = &unit[candidate.index * 3];
+                    const double dx = cell[0] - p[0], dy = cell[1] - p[1], dz = cell[2] - p[2];
+                    const double d2 = dx * dx + dy * dy + dz * dz;
+                    if (found == k && d2 >= hits[k - 1].distanceKm) continue;
+
+                    size_t pos = found < k ? found++ : k - 1;
+                    while (pos > 0 && hits[pos - 1].distanceKm > d2) {
+                        hits[pos] = hits[pos - 1];
+                        pos--;
+                    }
+                    hits[pos] = { candidate.index, d2 };
+                }
+                if (found == 0) continue;
+                for (size_t i = 0; i < found; i++) {
+                    hits[i].distanceKm = 2.0 * EARTH_RADIUS_KM * std::asin(std::min(1.0, std::sqrt(hits[i].distanceKm) / 2.0));
+                }
+                if (settings_.maxDistanceKm > 0 && hits[0].distanceKm > settings_.maxDistanceKm) continue;
+
+                double value;
+                if (hits[0].distanceKm < 1e-6) {
+                    value = valid[hits[0].index].value;
+                }
+                else {
+                    bool solved = false;
+                    value = 0.0;
+                    if (settings_.method == Method::KRIGING && found > 1) {
+                        const size_t m = found + 1;
+                        for (size_t i = 0; i < found; i++) {
+                            const size_t a = hits[i].index;
+                            system[i * m + i] = 0.0;
+                            for (size_t j = i + 1; j < found; j++) {
+                                const size_t b = hits[j].index;
+                                const double g = pairVariogram.empty()
+                                    ? variogram(distanceKm(&unit[a * 3], &unit[b * 3])) : pairVariogram[a * n + b];
+                                system[i * m + j] = system[j * m + i] = g;
+                            }
+                            system[i * m + found] = system[found * m + i] = 1.0;
+                            weights[i] = variogram(hits[i].distanceKm);
+                        }
+                        system[found * m + found] = 0.0;
+                        weights[found] = 1.0;
+
+                        solved = solve(system, weights, m);
+                        if (solved) {
+                            for (size_t i = 0; i < found; i++) value += weights[i] * valid[hits[i].index].value;
+                            // Kriging nie gwarantuje nieujemności - stężenie nie może być ujemne
+                            value = std::max(0.0, value);
+                        }
+                    }
+                    if (!solved) {
+                        double weightSum = 0.0;
+                        value = 0.0;
+                        for (size_t i = 0; i < found; i++) {
+                            const double w = settings_.power == 2.0
+                                ? 1.0 / (hits[i].distanceKm * hits[i].distanceKm)
+                                : 1.0 / std::pow(hits[i].distanceKm, settings_.power);
+                            weightSum += w;
+                            value += w * valid[hits[i].index].value;
+                        }
+                        value /= weightSum;
+                    }
+                }
+                raster.values[row * grid.cols + col] = static_cast<float>(value);
+            }
+        }
+    });
+
+    return raster;
+}
+
+/**
+ * @brief Zapisuje raster jako surowe wartości float32 z nagłówkiem ESRI BIL.
+ *
+ * @param raster Raster.
+ * @param filePath Ścieżka do pliku danych.
+ * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+ */
+bool SpatialInterpolator::writeRawFloat(const Raster& raster, const std::string& filePath) {
+    std::ofstream data(filePath, std::ios::binary);
+    if (!data.is_open()) {
+        return false;
+    }
+    std::vector<float> values(raster.values);
+    for (auto& v : values) {
+        if (std::isnan(v)) v = NODATA;
+    }
+    data.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(float)));
+    if (!data.good()) {
+        return false;
+    }
+
+    size_t dot = filePath.find_last_of('.');
+    size_t slash = filePath.find_last_of("/\\");
+    std::string headerPath = (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+        ? filePath.substr(0, dot) + ".hdr" : filePath + ".hdr";
+    std::ofstream header(headerPath);
+    if (!header.is_open()) {
+        return false;
+    }
+
+    const Grid& grid = raster.grid;
+    const double xdim = (grid.east - grid.west) / grid.cols;
+    const double ydim = (grid.north - grid.south) / grid.rows;
+    header.precision(10);
+    header << "BYTEORDER I\nLAYOUT BIL\n"
+        << "NROWS " << grid.rows << "\nNCOLS " << grid.cols << "\n"
+        << "NBANDS 1\nNBITS 32\nPIXELTYPE FLOAT\n"
+        << "ULXMAP " << grid.west + xdim / 2.0 << "\nULYMAP " << grid.north - ydim / 2.0 << "\n"
+        << "XDIM " << xdim << "\nYDIM " << ydim << "\n"
+        << "NODATA " << NODATA << "\n";
+    return header.good();
+}
+
+/**
+ * @brief Przekształca raster w obraz RGB.
+ *
+ * @param raster Raster.
+ * @param minValue Wartość odpowiadająca początkowi skali.
+ * @param maxValue Wartość odpowiadająca końcowi skali.
+ * @return Piksele RGB wierszami.
+ */
+std::vector<uint8_t> SpatialInterpolator::toRgb(const Raster& raster, double minValue, double maxValue) {
+    std::vector<uint8_t> rgb(raster.values.size() * 3);
+    const double span = maxValue > minValue ? maxValue - minValue : 1.0;
+
+    for (size_t i = 0; i < raster.values.size(); i++) {
+        uint8_t* pixel = &rgb[i * 3];
+        const float v = raster.values[i];
+        if (std::isnan(v)) {
+            pixel[0] = pixel[1] = pixel[2] = 200;
+            continue;
+        }
+
+        // Zieleń (0, 170, 0) -> żółty (255, 220, 0) -> czerwień (200, 0, 0)
+        const double t = std::min(1.0, std::max(0.0, (v - minValue) / span));
+        double r, g;
+        if (t < 0.5) {
+            r = 255.0 * (t * 2.0);
+            g = 170.0 + 50.0 * (t * 2.0);
+        }
+        else {
+            r = 255.0 - 55.0 * (t * 2.0 - 1.0);
+            g = 220.0 * (2.0 - t * 2.0);
+        }
+        pixel[0] = static_cast<uint8_t>(r + 0.5);
+        pixel[1] = static_cast<uint8_t>(g + 0.5);
+        pixel[2] = 0;
+    }
+    return rgb;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file SpatialInterpolator.h
+ * @brief Interpolacja przestrzenna pomiarów stacji na regularną siatkę geograficzną (mapy zanieczyszczeń).
+ *
+ * Wartość każdej komórki wyznaczana jest z k najbliższych stacji (StationIndex) metodą odwrotnych
+ * odległości (IDW) albo krigingu zwyczajnego z wykładniczym wariogramem. Siatka dzielona jest na
+ * kafelki przetwarzane równolegle. Wynik można zapisać jako surowy raster float32 (z nagłówkiem .hdr)
+ * albo przekształcić w obraz RGB (np. do zapisu PNG przez wxImage).
+ */
+class SpatialInterpolator {
+public:
+    /**
+     * @brief Metoda interpolacji.
+     */
+    enum class Method {
+        IDW,    ///< Odwrotne odległości podniesione do potęgi.
+        KRIGING ///< Kriging zwyczajny z wykładniczym wariogramem.
+    };
+
+    /**
+     * @brief Pomiar stacji użyty do interpolacji.
+     */
+    struct Sample {
+        double latitude;  ///< Szerokość geograficzna w stopniach.
+        double longitude; ///< Długość geograficzna w stopniach.
+        double value;     ///< Wartość pomiaru.
+    };
+
+    /**
+     * @brief Regularna siatka w stopniach geograficznych (wiersz 0 = północ).
+     */
+    struct Grid {
+        double north;  ///< Szerokość północnej krawędzi.
+        double south;  ///< Szerokość południowej krawędzi.
+        double west;   ///< Długość zachodniej krawędzi.
+        double east;   ///< Długość wschodniej krawędzi.
+        size_t rows;   ///< Liczba wierszy.
+        size_t cols;   ///< Liczba kolumn.
+
+        /**
+         * @brief Tworzy siatkę obejmującą Polskę o zadanym rozmiarze komórki.
+         *
+         * @param cellKm Przybliżony rozmiar komórki w kilometrach.
+         * @return Siatka.
+         */
+        static Grid poland(double cellKm = 1.0);
+
+        /**
+         * @brief Zwraca szerokość geograficzną środka wiersza.
+         */
+        double rowLatitude(size_t row) const { return north - (static_cast<double>(row) + 0.5) * (north - south) / rows; }
+
+        /**
+         * @brief Zwraca długość geograficzną środka kolumny.
+         */
+        double colLongitude(size_t col) const { return west + (static_cast<double>(col) + 0.5) * (east - west) / cols; }
+    };
+
+    /**
+     * @brief Wynik interpolacji - raster wartości wierszami (NaN = brak danych).
+     */
+    struct Raster {
+        Grid grid;                 ///< Siatka rastra.
+        std::vector<float> values; ///< Wartości (rows * cols).
+
+        /**
+         * @brief Zwraca wartość komórki.
+         */
+        float at(size_t row, size_t col) const { return values[row * grid.cols + col]; }
+    };
+
+    /**
+     * @brief Parametry interpolacji.
+     */
+    struct Settings {
+        Method method;        ///< Metoda interpolacji.
+        size_t neighbors;     ///< Liczba najbliższych stacji używanych dla komórki.
+        double power;         ///< Wykładnik IDW.
+        double maxDistanceKm; ///< Komórki dalej od najbliższej stacji pozostają puste (0 = bez limitu).
+        double nugget;        ///< Efekt samorodka wariogramu.
+        double sill;          ///< Próg wariogramu (0 = wariancja próbek).
+        double rangeKm;       ///< Zasięg wariogramu w kilometrach.
+
+        /**
+         * @brief Tworzy parametry domyślne (IDW, 8 sąsiadów, potęga 2).
+         */
+        Settings()
+            : method(Method::IDW), neighbors(8), power(2.0), maxDistanceKm(0.0),
+            nugget(0.0), sill(0.0), rangeKm(100.0) {
+        }
+    };
+
+    /**
+     * @brief Konstruktor klasy SpatialInterpolator.
+     *
+     * @param settings Parametry interpolacji.
+     */
+    explicit SpatialInterpolator(const Settings& settings = Settings());
+
+    /**
+     * @brief Interpoluje pomiary na siatkę.
+     *
+     * @param samples Pomiary stacji (próbki z ujemną wartością lub bez położenia są pomijane).
+     * @param grid Siatka docelowa.
+     * @return Raster wartości.
+     */
+    Raster interpolate(const std::vector<Sample>& samples, const Grid& grid) const;
+
+    /**
+     * @brief Zapisuje raster jako surowe wartości float32 (little endian, wierszami od północy).
+     *
+     * Obok pliku zapisywany jest nagłówek w formacie ESRI BIL (ścieżka z rozszerzeniem .hdr),
+     * który pozwala otworzyć raster w programach GIS.
+     *
+     * @param raster Raster.
+     * @param filePath Ścieżka do pliku danych.
+     * @return true jeśli zapis się powiódł, false w przeciwnym razie.
+     */
+    static bool writeRawFloat(const Raster& raster, const std::string& filePath);
+
+    /**
+     * @brief Przekształca raster w obraz RGB (skala od zieleni przez żółty do czerwieni).
+     *
+     * @param raster Raster.
+     * @param minValue Wartość odpowiadająca początkowi skali.
+     * @param maxValue Wartość odpowiadająca końcowi skali.
+     * @return Piksele RGB wierszami (3 bajty na piksel; brak danych - kolor szary).
+     */
+    static std::vector<uint8_t> toRgb(const Raster& raster, double minValue, double maxValue);
+
+private:
+    Settings settings_; ///< Parametry interpolacji.
+};
@@ -0,0 +1,285 @@
+/**
+ * @file StationIndex.cpp
+ * @brief Implementacja drzewa k-d stacji na sferze jednostkowej.
+ */
+
+#include "StationIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double EARTH_RADIUS_KM = 6371.0;      ///< Średni promień Ziemi.
+const double PI = 3.14159265358979323846;
+
+/**
+ * @brief Zamienia współrzędne geograficzne na punkt na sferze jednostkowej.
+ */
+void toUnitVector(double latitude, double longitude, double* point) {
+    const double lat = latitude * PI / 180.0;
+    const double lon = longitude * PI / 180.0;
+    point[0] = std::cos(lat) * std::cos(lon);
+    point[1] = std::cos(lat) * std::sin(lon);
+    point[2] = std::sin(lat);
+}
+
+/**
+ * @brief Kwadrat odległości euklidesowej (cięciwy) dwóch punktów.
+ */
+double chord2(const double* a, const double* b) {
+    const double dx = a[0] - b[0];
+    const double dy = a[1] - b[1];
+    const double dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Zamienia kwadrat cięciwy na odległość po kole wielkim w kilometrach.
+ */
+double chord2ToKm(double c2) {
+    const double half = std::min(1.0, std::sqrt(c2) / 2.0);
+    return 2.0 * EARTH_RADIUS_KM * std::asin(half);
+}
+
+/**
+ * @brief Porządek kopca wyników - na szczycie najdalszy.
+ */
+bool closer(const StationIndex::Hit& a, const StationIndex::Hit& b) {
+    return a.distanceKm < b.distanceKm;
+}
+
+} // namespace
+
+/**
+ * @brief Buduje indeks dla podanych stacji.
+ *
+ * @param stations Stacje.
+ * @param parameterMasks Maski wskaźników mierzonych przez stacje.
+ */
+StationIndex::StationIndex(const std::vector<Station>& stations, const std::vector<uint32_t>& parameterMasks) {
+    nodes_.reserve(stations.size());
+    for (size_t i = 0; i < stations.size(); i++) {
+        if (!stations[i].hasLocation()) continue;
+
+        Node node;
+        toUnitVector(stations[i].getLatitude(), stations[i].getLongitude(), node.point);
+        node.mask = i < parameterMasks.size() ? parameterMasks[i] : 0xFFFFFFFFu;
+        node.subtreeMask = node.mask;
+        node.index = static_cast<uint32_t>(i);
+        node.axis = 0;
+        nodes_.push_back(node);
+    }
+    build(0, nodes_.size());
+}
+
+/**
+ * @brief Zwraca bit wskaźnika używany w maskach.
+ *
+ * @param formula Wzór wskaźnika.
+ * @return Bit wskaźnika lub 0.
+ */
+uint32_t StationIndex::parameterBit(const std::string& formula) {
+    static const char* const formulas[] = { "PM10", "PM2.5", "O3", "NO2", "SO2", "CO", "C6H6" };
+    for (size_t i = 0; i < sizeof(formulas) / sizeof(formulas[0]); i++) {
+        if (formula == formulas[i]) return 1u << i;
+    }
+    return 0;
+}
+
+/**
+ * @brief Zwraca maskę wskaźników mierzonych przez czujniki stacji.
+ *
+ * @param sensors Czujniki stacji.
+ * @return Suma bitów wzorów czujników.
+ */
+uint32_t StationIndex::parameterMask(const std::vector<Sensor>& sensors) {
+    uint32_t mask = 0;
+    for (const auto& sensor : sensors) {
+        mask |= parameterBit(sensor.getParamFormula());
+    }
+    return mask;
+}
+
+/**
+ * @brief Buduje poddrzewo z węzłów [begin, end).
+ *
+ * Oś podziału to wymiar o największym rozrzucie w zakresie; mediana (nth_element) trafia na
+ * środek zakresu, więc drzewo jest zrównoważone i nie wymaga wskaźników na dzieci.
+ *
+ * @param begin Początek zakresu.
+ * @param end Koniec zakresu.
+ */
+void StationIndex::build(size_t begin, size_t end) {
+    if (end - begin <= 1) return;
+
+    double low[3] = { 2.0, 2.0, 2.0 };
+    double high[3] = { -2.0, -2.0, -2.0 };
+    for (size_t i = begin; i < end; i++) {
+        for (int d = 0; d < 3; d++) {
+            low[d] = std::min(low[d], nodes_[i].point[d]);
+            high[d] = std::max(high[d], nodes_[i].point[d]);
+        }
+    }
+    int axis = 0;
+    for (int d = 1; d < 3; d++) {
+        if (high[d] - low[d] > high[axis] - low[axis]) axis = d;
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    std::nth_element(nodes_.begin() + begin, nodes_.begin() + mid, nodes_.begin() + end,
+        [axis](const Node& a, const Node& b) { return a.point[axis] < b.point[axis]; });
+    nodes_[mid].axis = static_cast<uint8_t>(axis);
+
+    build(begin, mid);
+    build(mid + 1, end);
+
+    uint32_t subtreeMask = nodes_[mid].mask;
+    if (mid > begin) subtreeMask |= nodes_[begin + (mid - begin) / 2].subtreeMask;
+    if (end > mid + 1) subtreeMask |= nodes_[mid + 1 + (end - mid - 1) / 2].subtreeMask;
+    nodes_[mid].subtreeMask = subtreeMask;
+}
+
+/**
+ * @brief Wyszukuje k najbliższych stacji.
+ *
+ * @param latitude Szerokość geograficzna punktu.
+ * @param longitude Długość geograficzna punktu.
+ * @param k Liczba stacji.
+ * @param requiredMask Wymagane wskaźniki.
+ * @return Stacje posortowane rosnąco według odległości.
+ */
+std::vector<StationIndex::Hit> StationIndex::nearest(double latitude, double longitude, size_t k, uint32_t requiredMask) const {
+    std::vector<Hit> hits(std::min(k, nodes_.size()));
+    hits.resize(nearest(latitude, longitude, hits.size(), requiredMask, hits.data()));
+    return hits;
+}
+
+/**
+ * @brief Wyszukuje k najbliższych stacji bez alokacji pamięci.
+ *
+ * Tablica wyjściowa służy w trakcie wyszukiwania jako kopiec (na szczycie najdalszy kandydat,
+ * odległości jako kwadraty cięciw); na końcu jest sortowana i przeliczana na kilometry.
+ *
+ * @param latitude Szerokość geograficzna punktu.
+ * @param longitude Długość geograficzna punktu.
+ * @param k Liczba stacji.
+ * @param requiredMask Wymagane wskaźniki.
+ * @param out Tablica na co najmniej k wyników.
+ * @return Liczba znalezionych stacji.
+ */
+size_t StationIndex::nearest(double latitude, double longitude, size_t k, uint32_t requiredMask, Hit* out) const {
+    if (k == 0 || nodes_.empty()) return 0;
+
+    double query[3];
+    toUnitVector(latitude, longitude, query);
+
+    size_t count = 0;
+    searchNearest(0, nodes_.size(), query, requiredMask, k, out, count);
+
+    std::sort_heap(out, out + count, closer);
+    for (size_t i = 0; i < count; i++) {
+        out[i].distanceKm = chord2ToKm(out[i].distanceKm);
+    }
+    return count;
+}
+
+/**
+ * @brief Wyszukuje stacje w zadanym promieniu.
+ *
+ * @param latitude Szerokość geograficzna punktu.
+ * @param longitude Długość geograficzna punktu.
+ * @param radiusKm Promień w kilometrach.
+ * @param requiredMask Wymagane wskaźniki.
+ * @return Stacje posortowane rosnąco według odległości.
+ */
+std::vector<StationIndex::Hit> StationIndex::withinRadius(double latitude, double longitude, double radiusKm, uint32_t requiredMask) const {
+    std::vector<Hit> hits;
+    if (nodes_.empty() || !(radiusKm >= 0)) return hits;
+
+    double query[3];
+    toUnitVector(latitude, longitude, query);
+
+    // Promień po kole wielkim -> długość cięciwy (powyżej połowy obwodu - cała sfera)
+    const double angle = radiusKm / EARTH_RADIUS_KM;
+    const double chord = angle >= PI ? 2.0 : 2.0 * std::sin(angle / 2.0);
+    searchRadius(0, nodes_.size(), query, requiredMask, chord * chord, hits);
+
+    std::sort(hits.begin(), hits.end(), closer);
+    for (auto& hit : hits) {
+        hit.distanceKm = chord2ToKm(hit.distanceKm);
+    }
+    return hits;
+}
+
+/**
+ * @brief Oblicza odległość po kole wielkim między dwoma punktami.
+ *
+ * @return Odległość w kilometrach.
+ */
+double StationIndex::distanceKm(double latitude1, double longitude1, double latitude2, double longitude2) {
+    double a[3], b[3];
+    toUnitVector(latitude1, longitude1, a);
+    toUnitVector(latitude2, longitude2, b);
+    return chord2ToKm(chord2(a, b));
+}
+
+/**
+ * @brief Rekurencyjne wyszukiwanie k najbliższych w poddrzewie [begin, end).
+ *
+ * Najpierw przeszukiwana jest strona podziału zawierająca punkt zapytania; druga strona tylko
+ * wtedy, gdy płaszczyzna podziału jest bliżej niż najdalszy z dotychczasowych kandydatów.
+ */
+void StationIndex::searchNearest(size_t begin, size_t end, const double* query, uint32_t requiredMask,
+    size_t k, Hit* heap, size_t& count) const {
+    if (begin >= end) return;
+
+    const size_t mid = begin + (end - begin) / 2;
+    const Node& node = nodes_[mid];
+    if ((node.subtreeMask & requiredMask) != requiredMask) return;
+
+    if ((node.mask & requiredMask) == requiredMask) {
+        const double d2 = chord2(query, node.point);
+        if (count < k) {
+            heap[count++] = { node.index, d2 };
+            std::push_heap(heap, heap + count, closer);
+        }
+        else if (d2 < heap[0].distanceKm) {
+            std::pop_heap(heap, heap + count, closer);
+            heap[count - 1] = { node.index, d2 };
+            std::push_heap(heap, heap + count, closer);
+        }
+    }
+
+    if (end - begin == 1) return;
+
+    const double diff = query[node.axis] - node.point[node.axis];
+    const bool lowerFirst = diff < 0;
+    if (lowerFirst) searchNearest(begin, mid, query, requiredMask, k, heap, count);
+    else searchNearest(mid + 1, end, query, requiredMask, k, heap, count);
+
+    if (count < k || diff * diff < heap[0].distanceKm) {
+        if (lowerFirst) searchNearest(mid + 1, end, query, requiredMask, k, heap, count);
+        else searchNearest(begin, mid, query, requiredMask, k, heap, count);
+    }
+}
+
+/**
+ * @brief Rekurencyjne wyszukiwanie w promieniu w poddrzewie [begin, end).
+ */
+void StationIndex::searchRadius(size_t begin, size_t end, const double* query, uint32_t requiredMask,
+    double maxChord2, std::vector<Hit>& hits) const {
+    if (begin >= end) return;
+
+    const size_t mid = begin + (end - begin) / 2;
+    const Node& node = nodes_[mid];
+    if ((node.subtreeMask & requiredMask) != requiredMask) return;
+
+    if ((node.mask & requiredMask) == requiredMask) {
+        const double d2 = chord2(query, node.point);
+        if (d2 <= maxChord2) hits.push_back({ node.index, d2 });
+    }
+
+    const double diff = query[node.axis] - node.point[node.axis];
+    if (diff < 0 || diff * diff <= maxChord2) searchRadius(begin, mid, query, requiredMask, maxChord2, hits);
+    if (diff >= 0 || diff * diff <= maxChord2) searchRadius(mid + 1, end, query, requiredMask, maxChord2, hits);
+}
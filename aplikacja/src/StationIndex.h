@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Station.h"
+#include "Sensor.h"
+
+/**
+ * @file StationIndex.h
+ * @brief Indeks przestrzenny stacji (drzewo k-d) z zapytaniami o najbliższe stacje i stacje w promieniu.
+ *
+ * Stacje są odwzorowane na punkty na sferze jednostkowej (x, y, z). Odległość cięciwy rośnie
+ * monotonicznie z odległością po kole wielkim, więc drzewo k-d w trzech wymiarach daje dokładne
+ * wyniki geodezyjne (model kulisty Ziemi) bez problemów z południkiem 180 i biegunami. Każdy węzeł
+ * przechowuje sumę bitową wskaźników mierzonych w poddrzewie, dzięki czemu filtr wskaźnika
+ * (np. "tylko stacje mierzące PM2.5") odcina całe gałęzie drzewa. Maski wskaźników stacji powstają
+ * z list czujników (parameterMask) - pobranych z API albo zapisanych w lokalnej bazie.
+ */
+class StationIndex {
+public:
+    static const uint32_t ALL_PARAMETERS = 0; ///< Maska oznaczająca brak filtra wskaźnika.
+
+    /**
+     * @brief Wynik zapytania.
+     */
+    struct Hit {
+        size_t index;      ///< Indeks stacji w wektorze przekazanym do konstruktora.
+        double distanceKm; ///< Odległość po kole wielkim w kilometrach.
+    };
+
+    /**
+     * @brief Tworzy pusty indeks.
+     */
+    StationIndex() = default;
+
+    /**
+     * @brief Buduje indeks dla podanych stacji.
+     *
+     * Stacje bez położenia są pomijane.
+     *
+     * @param stations Stacje.
+     * @param parameterMasks Maski wskaźników mierzonych przez stacje (parameterBit); pusty wektor -
+     *                       wszystkie stacje spełniają każdy filtr.
+     */
+    StationIndex(const std::vector<Station>& stations, const std::vector<uint32_t>& parameterMasks = std::vector<uint32_t>());
+
+    /**
+     * @brief Zwraca bit wskaźnika używany w maskach.
+     *
+     * @param formula Wzór wskaźnika (np. "PM2.5").
+     * @return Bit wskaźnika lub 0, jeśli wskaźnik nie jest znany.
+     */
+    static uint32_t parameterBit(const std::string& formula);
+
+    /**
+     * @brief Zwraca maskę wskaźników mierzonych przez czujniki stacji.
+     *
+     * @param sensors Czujniki stacji (z API lub z lokalnej bazy).
+     * @return Suma bitów parameterBit wzorów czujników (0, jeśli żaden wzór nie jest znany).
+     */
+    static uint32_t parameterMask(const std::vector<Sensor>& sensors);
+
+    /**
+     * @brief Wyszukuje k najbliższych stacji.
+     *
+     * @param latitude Szerokość geograficzna punktu w stopniach.
+     * @param longitude Długość geograficzna punktu w stopniach.
+     * @param k Liczba stacji.
+     * @param requiredMask Wymagane wskaźniki (suma bitów parameterBit; ALL_PARAMETERS - bez filtra).
+     * @return Stacje posortowane rosnąco według odległości.
+     */
+    std::vector<Hit> nearest(double latitude, double longitude, size_t k, uint32_t requiredMask = ALL_PARAMETERS) const;
+
+    /**
+     * @brief Wyszukuje k najbliższych stacji bez alokacji pamięci (do zapytań o dużej częstotliwości).
+     *
+     * @param latitude Szerokość geograficzna punktu w stopniach.
+     * @param longitude Długość geograficzna punktu w stopniach.
+     * @param k Liczba stacji.
+     * @param requiredMask Wymagane wskaźniki.
+     * @param out Tablica na co najmniej k wyników (posortowanych rosnąco według odległości).
+     * @return Liczba znalezionych stacji.
+     */
+    size_t nearest(double latitude, double longitude, size_t k, uint32_t requiredMask, Hit* out) const;
+
+    /**
+     * @brief Wyszukuje stacje w zadanym promieniu.
+     *
+     * @param latitude Szerokość geograficzna punktu w stopniach.
+     * @param longitude Długość geograficzna punktu w stopniach.
+     * @param radiusKm Promień w kilometrach.
+     * @param requiredMask Wymagane wskaźniki.
+     * @return Stacje posortowane rosnąco według odległości.
+     */
+    std::vector<Hit> withinRadius(double latitude, double longitude, double radiusKm, uint32_t requiredMask = ALL_PARAMETERS) const;
+
+    /**
+     * @brief Zwraca liczbę stacji w indeksie.
+     *
+     * @return Liczba stacji z położeniem.
+     */
+    size_t size() const { return nodes_.size(); }
+
+    /**
+     * @brief Oblicza odległość po kole wielkim między dwoma punktami.
+     *
+     * @return Odległość w kilometrach.
+     */
+    static double distanceKm(double latitude1, double longitude1, double latitude2, double longitude2);
+
+private:
+    /**
+     * @brief Węzeł drzewa - stacja będąca medianą swojego zakresu.
+     */
+    struct Node {
+        double point[3];      ///< Położenie na sferze jednostkowej.
+        uint32_t mask;        ///< Wskaźniki mierzone przez stację.
+        uint32_t subtreeMask; ///< Suma wskaźników w poddrzewie.
+        uint32_t index;       ///< Indeks stacji w wektorze wejściowym.
+        uint8_t axis;         ///< Oś podziału.
+    };
+
+    /**
+     * @brief Buduje poddrzewo z węzłów [begin, end) - mediana trafia na środek zakresu.
+     */
+    void build(size_t begin, size_t end);
+
+    /**
+     * @brief Rekurencyjne wyszukiwanie k najbliższych w poddrzewie [begin, end).
+     */
+    void searchNearest(size_t begin, size_t end, const double* query, uint32_t requiredMask,
+        size_t k, Hit* heap, size_t& count) const;
+
+    /**
+     * @brief Rekurencyjne wyszukiwanie w promieniu w poddrzewie [begin, end).
+     */
+    void searchRadius(size_t begin, size_t end, const double* query, uint32_t requiredMask,
+        double maxChord2, std::vector<Hit>& hits) const;
+
+    std::vector<Node> nodes_; ///< Węzły drzewa w układzie niejawnym (korzeń zakresu = środek).
+};
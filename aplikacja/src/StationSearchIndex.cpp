@@ -0,0 +1,312 @@
+/**
+ * @file StationSearchIndex.cpp
+ * @brief Implementacja indeksu wyszukiwania stacji po nazwie i miejscowości.
+ */
+
+#include "StationSearchIndex.h"
+#include <algorithm>
+
+namespace {
+
+    /// Minimalny udział trigramów zapytania obecnych w stacji dla dopasowania przybliżonego.
+    constexpr double MIN_FUZZY_SIMILARITY = 0.3;
+
+    /// Minimalna długość zapytania (po normalizacji), od której stosowane jest dopasowanie przybliżone.
+    constexpr size_t MIN_FUZZY_QUERY_LENGTH = 3;
+
+    /**
+     * @brief Sprowadza znak Unicode do małej litery lub cyfry ASCII.
+     *
+     * @param codePoint Kod znaku.
+     * @return Znak znormalizowany lub 0 dla separatora (znaku niebędącego literą ani cyfrą).
+     */
+    char foldCharacter(uint32_t codePoint) {
+        if (codePoint >= 'a' && codePoint <= 'z') return static_cast<char>(codePoint);
+        if (codePoint >= 'A' && codePoint <= 'Z') return static_cast<char>(codePoint - 'A' + 'a');
+        if (codePoint >= '0' && codePoint <= '9') return static_cast<char>(codePoint);
+        switch (codePoint) {
+        case 0x0104: case 0x0105: return 'a'; // Ą ą
+        case 0x0106: case 0x0107: return 'c'; // Ć ć
+        case 0x0118: case 0x0119: return 'e'; // Ę ę
+        case 0x0141: case 0x0142: return 'l'; // Ł ł
+        case 0x0143: case 0x0144: return 'n'; // Ń ń
+        case 0x00D3: case 0x00F3: return 'o'; // Ó ó
+        case 0x015A: case 0x015B: return 's'; // Ś ś
+        case 0x0179: case 0x017A: return 'z'; // Ź ź
+        case 0x017B: case 0x017C: return 'z'; // Ż ż
+        default: return 0;
+        }
+    }
+}
+
+/**
+ * @brief Tworzy pusty indeks.
+ */
+StationSearchIndex::StationSearchIndex()
+    : nodes_(1) {
+}
+
+/**
+ * @brief Buduje indeks dla podanych stacji.
+ *
+ * Do drzewa trafiają słowa nazwy i miejscowości każdej stacji; koszt budowy jest liniowy
+ * względem łącznej długości tekstów.
+ *
+ * @param stations Stacje.
+ */
+StationSearchIndex::StationSearchIndex(const std::vector<Station>& stations)
+    : nodes_(1) {
+    names_.reserve(stations.size());
+    for (size_t i = 0; i < stations.size(); i++) {
+        const uint32_t station = static_cast<uint32_t>(i);
+        names_.push_back(normalize(stations[i].getName()));
+        for (const auto& word : splitWords(names_.back())) {
+            addWord(word, station, FIELD_NAME);
+        }
+        for (const auto& word : splitWords(normalize(stations[i].getCity()))) {
+            addWord(word, station, FIELD_CITY);
+        }
+    }
+}
+
+/**
+ * @brief Normalizuje tekst do wyszukiwania.
+ *
+ * Niepoprawne sekwencje UTF-8 są traktowane jak separatory.
+ *
+ * @param text Tekst w UTF-8.
+ * @return Tekst znormalizowany.
+ */
+std::string StationSearchIndex::normalize(const std::string& text) {
+    std::string normalized;
+    normalized.reserve(text.size());
+    bool separator = false;
+
+    size_t i = 0;
+    while (i < text.size()) {
+        const unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t length = 1;
+        uint32_t codePoint = lead;
+        if (lead >= 0x80) {
+            length = (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 1;
+            codePoint = length == 2 ? lead & 0x1F : length == 3 ? lead & 0x0F : lead & 0x07;
+            if (length == 1 || i + length > text.size()) {
+                length = 1;
+                codePoint = 0;
+            }
+            else {
+                for (size_t k = 1; k < length; k++) {
+                    codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+                }
+            }
+        }
+        i += length;
+
+        const char folded = foldCharacter(codePoint);
+        if (folded == 0) {
+            separator = true;
+            continue;
+        }
+        if (separator && !normalized.empty()) {
+            normalized += ' ';
+        }
+        separator = false;
+        normalized += folded;
+    }
+    return normalized;
+}
+
+/**
+ * @brief Wyszukuje stacje pasujące do zapytania.
+ *
+ * Słowa zapytania są dopasowywane jako prefiksy słów stacji (część wspólna list z węzłów drzewa).
+ * Jeśli wyników jest mniej niż limit, dołączane są stacje o udziale wspólnych trigramów
+ * co najmniej MIN_FUZZY_SIMILARITY.
+ *
+ * @param query Zapytanie w UTF-8.
+ * @param limit Maksymalna liczba wyników.
+ * @return Wyniki od najlepszego.
+ */
+std::vector<StationSearchIndex::Hit> StationSearchIndex::search(const std::string& query, size_t limit) const {
+    std::vector<Hit> hits;
+    const std::string normalized = normalize(query);
+    if (normalized.empty() || limit == 0) return hits;
+    const std::vector<std::string> words = splitWords(normalized);
+
+    // Dopasowanie prefiksowe: stacje, w których każde słowo zapytania jest prefiksem któregoś słowa
+    std::vector<Posting> matched;
+    for (size_t w = 0; w < words.size(); w++) {
+        const Node* node = findNode(words[w]);
+        if (!node) {
+            matched.clear();
+            break;
+        }
+        if (w == 0) {
+            matched = node->postings;
+            continue;
+        }
+        std::vector<Posting> common;
+        auto a = matched.begin();
+        auto b = node->postings.begin();
+        while (a != matched.end() && b != node->postings.end()) {
+            if (a->station < b->station) ++a;
+            else if (b->station < a->station) ++b;
+            else {
+                common.push_back({ a->station, static_cast<uint8_t>(a->fields & b->fields) });
+                ++a;
+                ++b;
+            }
+        }
+        matched.swap(common);
+        if (matched.empty()) break;
+    }
+
+    std::vector<bool> isMatched(names_.size(), false);
+    for (const auto& posting : matched) {
+        const std::string& name = names_[posting.station];
+        Match match = Match::CITY_WORDS;
+        if (name == normalized) match = Match::EXACT;
+        else if (name.compare(0, normalized.size(), normalized) == 0) match = Match::NAME_PREFIX;
+        else if (posting.fields & FIELD_NAME) match = Match::NAME_WORDS;
+        hits.push_back({ posting.station, match, 1.0 });
+        isMatched[posting.station] = true;
+    }
+
+    // Dopasowanie przybliżone: udział trigramów zapytania występujących w słowach stacji
+    if (hits.size() < limit && normalized.size() >= MIN_FUZZY_QUERY_LENGTH) {
+        std::vector<uint32_t> keys;
+        for (const auto& word : words) {
+            appendTrigrams(word, keys);
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        std::vector<uint32_t> counts(names_.size(), 0);
+        for (uint32_t key : keys) {
+            auto it = trigrams_.find(key);
+            if (it == trigrams_.end()) continue;
+            for (uint32_t station : it->second) {
+                counts[station]++;
+            }
+        }
+        for (size_t station = 0; station < counts.size(); station++) {
+            if (isMatched[station] || counts[station] == 0) continue;
+            const double similarity = static_cast<double>(counts[station]) / keys.size();
+            if (similarity >= MIN_FUZZY_SIMILARITY) {
+                hits.push_back({ station, Match::FUZZY, similarity });
+            }
+        }
+    }
+
+    auto better = [this](const Hit& a, const Hit& b) {
+        if (a.match != b.match) return a.match < b.match;
+        if (a.similarity != b.similarity) return a.similarity > b.similarity;
+        if (names_[a.index] != names_[b.index]) return names_[a.index] < names_[b.index];
+        return a.index < b.index;
+    };
+    if (hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), better);
+        hits.resize(limit);
+    }
+    else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+    return hits;
+}
+
+/**
+ * @brief Dodaje słowo stacji do drzewa i do list trigramów.
+ *
+ * Stacja trafia do listy każdego węzła na ścieżce słowa, więc węzeł prefiksu od razu zna
+ * wszystkie pasujące stacje.
+ *
+ * @param word Słowo znormalizowane.
+ * @param station Indeks stacji.
+ * @param field Pole, z którego pochodzi słowo.
+ */
+void StationSearchIndex::addWord(const std::string& word, uint32_t station, uint8_t field) {
+    uint32_t node = 0;
+    for (char c : word) {
+        auto& children = nodes_[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char, uint32_t>& edge, char value) { return edge.first < value; });
+        uint32_t next;
+        if (it != children.end() && it->first == c) {
+            next = it->second;
+        }
+        else {
+            next = static_cast<uint32_t>(nodes_.size());
+            children.insert(it, { c, next });
+            nodes_.emplace_back();
+        }
+        node = next;
+
+        auto& postings = nodes_[node].postings;
+        if (!postings.empty() && postings.back().station == station) {
+            postings.back().fields |= field;
+        }
+        else {
+            postings.push_back({ station, field });
+        }
+    }
+
+    std::vector<uint32_t> keys;
+    appendTrigrams(word, keys);
+    for (uint32_t key : keys) {
+        auto& stations = trigrams_[key];
+        if (stations.empty() || stations.back() != station) {
+            stations.push_back(station);
+        }
+    }
+}
+
+/**
+ * @brief Zwraca węzeł drzewa dla prefiksu.
+ *
+ * @param prefix Prefiks znormalizowany.
+ * @return Węzeł lub nullptr.
+ */
+const StationSearchIndex::Node* StationSearchIndex::findNode(const std::string& prefix) const {
+    uint32_t node = 0;
+    for (char c : prefix) {
+        const auto& children = nodes_[node].children;
+        auto it = std::lower_bound(children.begin(), children.end(), c,
+            [](const std::pair<char, uint32_t>& edge, char value) { return edge.first < value; });
+        if (it == children.end() || it->first != c) return nullptr;
+        node = it->second;
+    }
+    return &nodes_[node];
+}
+
+/**
+ * @brief Dzieli tekst znormalizowany na słowa.
+ *
+ * @param text Tekst znormalizowany (słowa rozdzielone pojedynczą spacją).
+ * @return Słowa.
+ */
+std::vector<std::string> StationSearchIndex::splitWords(const std::string& text) {
+    std::vector<std::string> words;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find(' ', begin);
+        if (end == std::string::npos) end = text.size();
+        if (end > begin) words.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+    }
+    return words;
+}
+
+/**
+ * @brief Dopisuje trigramy słowa z granicami oznaczonymi spacją (np. "lodz" -> " lo", "lod", "odz", "dz ").
+ *
+ * @param word Słowo znormalizowane.
+ * @param trigrams Wektor na klucze trigramów (trzy bajty w jednej liczbie).
+ */
+void StationSearchIndex::appendTrigrams(const std::string& word, std::vector<uint32_t>& trigrams) {
+    const std::string padded = " " + word + " ";
+    for (size_t i = 0; i + 3 <= padded.size(); i++) {
+        trigrams.push_back((static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+            (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+            static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Station.h"
+
+/**
+ * @file StationSearchIndex.h
+ * @brief Indeks wyszukiwania stacji po nazwie i miejscowości: drzewo prefiksowe (trie) i trigramy.
+ *
+ * Nazwy i miejscowości są normalizowane (małe litery, polskie znaki bez ogonków, słowa rozdzielone
+ * spacją), więc "lodz" znajduje "Łódź". Każdy węzeł drzewa prefiksowego przechowuje listę stacji,
+ * których któreś słowo zaczyna się od prefiksu węzła - dopasowanie słowa zapytania to przejście
+ * po jego literach. Gdy dopasowań prefiksowych jest za mało, brane są stacje o największym udziale
+ * wspólnych trigramów ze słowami zapytania (odporność na literówki). Indeks nie zależy od GUI
+ * i może obsługiwać także zapytania spoza okna aplikacji.
+ */
+class StationSearchIndex {
+public:
+    /**
+     * @brief Rodzaj dopasowania (od najlepszego).
+     */
+    enum class Match {
+        EXACT = 0,       ///< Nazwa stacji równa zapytaniu.
+        NAME_PREFIX = 1, ///< Nazwa stacji zaczyna się od zapytania.
+        NAME_WORDS = 2,  ///< Każde słowo zapytania jest prefiksem słowa nazwy.
+        CITY_WORDS = 3,  ///< Każde słowo zapytania jest prefiksem słowa nazwy lub miejscowości.
+        FUZZY = 4        ///< Podobieństwo trigramowe (np. literówka).
+    };
+
+    /**
+     * @brief Wynik wyszukiwania.
+     */
+    struct Hit {
+        size_t index;      ///< Indeks stacji w wektorze przekazanym do konstruktora.
+        Match match;       ///< Rodzaj dopasowania.
+        double similarity; ///< Udział trigramów zapytania obecnych w stacji (1.0 dla dopasowań prefiksowych).
+    };
+
+    /**
+     * @brief Tworzy pusty indeks.
+     */
+    StationSearchIndex();
+
+    /**
+     * @brief Buduje indeks dla podanych stacji.
+     *
+     * @param stations Stacje.
+     */
+    explicit StationSearchIndex(const std::vector<Station>& stations);
+
+    /**
+     * @brief Normalizuje tekst do wyszukiwania.
+     *
+     * Zamienia litery na małe, usuwa polskie znaki diakrytyczne, a pozostałe znaki niebędące literą
+     * ani cyfrą zastępuje pojedynczą spacją.
+     *
+     * @param text Tekst w UTF-8.
+     * @return Tekst znormalizowany (bez spacji na początku i końcu).
+     */
+    static std::string normalize(const std::string& text);
+
+    /**
+     * @brief Wyszukuje stacje pasujące do zapytania.
+     *
+     * @param query Zapytanie w UTF-8 (np. "krak bujak", "lodz", "wroclw").
+     * @param limit Maksymalna liczba wyników.
+     * @return Wyniki od najlepszego: według rodzaju dopasowania, podobieństwa i nazwy.
+     *         Puste zapytanie daje pusty wynik.
+     */
+    std::vector<Hit> search(const std::string& query, size_t limit = 20) const;
+
+    /**
+     * @brief Zwraca liczbę stacji w indeksie.
+     */
+    size_t size() const { return names_.size(); }
+
+private:
+    /**
+     * @brief Stacja w liście węzła drzewa lub trigramu.
+     */
+    struct Posting {
+        uint32_t station; ///< Indeks stacji.
+        uint8_t fields;   ///< Pola, w których wystąpiło słowo (FIELD_NAME, FIELD_CITY).
+    };
+
+    /**
+     * @brief Węzeł drzewa prefiksowego.
+     */
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children; ///< Krawędzie (znak, węzeł), rosnąco według znaku.
+        std::vector<Posting> postings;                   ///< Stacje ze słowem o tym prefiksie, rosnąco.
+    };
+
+    static const uint8_t FIELD_NAME = 1; ///< Słowo z nazwy stacji.
+    static const uint8_t FIELD_CITY = 2; ///< Słowo z miejscowości.
+
+    /**
+     * @brief Dodaje słowo stacji do drzewa i do list trigramów.
+     *
+     * @param word Słowo znormalizowane.
+     * @param station Indeks stacji (stacje są dodawane rosnąco).
+     * @param field Pole, z którego pochodzi słowo.
+     */
+    void addWord(const std::string& word, uint32_t station, uint8_t field);
+
+    /**
+     * @brief Zwraca węzeł drzewa dla prefiksu.
+     *
+     * @param prefix Prefiks znormalizowany.
+     * @return Węzeł lub nullptr, jeśli żadne słowo nie ma takiego prefiksu.
+     */
+    const Node* findNode(const std::string& prefix) const;
+
+    /**
+     * @brief Dzieli tekst znormalizowany na słowa.
+     */
+    static std::vector<std::string> splitWords(const std::string& text);
+
+    /**
+     * @brief Dopisuje trigramy słowa (z granicami słowa oznaczonymi spacją).
+     *
+     * @param word Słowo znormalizowane.
+     * @param trigrams Wektor, do którego trafiają klucze trigramów.
+     */
+    static void appendTrigrams(const std::string& word, std::vector<uint32_t>& trigrams);
+
+    std::vector<Node> nodes_;                                       ///< Węzły drzewa (0 - korzeń).
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams_;  ///< Trigram -> stacje (rosnąco).
+    std::vector<std::string> names_;                                ///< Znormalizowane nazwy stacji.
+};
@@ -0,0 +1,465 @@
+/**
+ * @file StatisticsKernels.cpp
+ * @brief Implementacja wektorowych jąder statystyk (AVX-512, AVX2, SSE2, skalarne).
+ *
+ * Wszystkie warianty liczą te same sumy cząstkowe: liczbę punktów, sumy x, x^2, y, y^2, x*y
+ * oraz minimum i maksimum z pozycją. Wartości y są przesunięte o pierwszą prawidłową wartość,
+ * a x jest liczone względem środka tablicy, co ogranicza utratę precyzji przy odejmowaniu sum.
+ * Warianty różnią się wyłącznie kolejnością sumowania, więc wyniki min/max/indeksów są identyczne,
+ * a średnia, wariancja i nachylenie różnią się co najwyżej o kilka ULP.
+ */
+
+#include "StatisticsKernels.h"
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define STATS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STATS_TARGET_SSE2
+#define STATS_TARGET_AVX2
+#define STATS_TARGET_AVX512
+#else
+#include <cpuid.h>
+#define STATS_TARGET_SSE2 __attribute__((target("sse2")))
+#define STATS_TARGET_AVX2 __attribute__((target("avx2")))
+#define STATS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+#endif
+
+namespace {
+
+const double POSITIVE_INFINITY = std::numeric_limits<double>::infinity();
+const double NEGATIVE_INFINITY = -std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Sumy cząstkowe wspólne dla wszystkich wariantów jąder.
+ */
+struct Accumulator {
+    double count = 0.0;
+    double sumX = 0.0, sumX2 = 0.0;
+    double sumY = 0.0, sumY2 = 0.0, sumXY = 0.0;
+    double min = POSITIVE_INFINITY, minX = 0.0;
+    double max = NEGATIVE_INFINITY, maxX = 0.0;
+
+    /// Dołącza wyniki jednego toru wektora; przy równych wartościach wygrywa wcześniejsza pozycja.
+    void mergeLane(double laneCount, double sx, double sx2, double sy, double sy2, double sxy,
+        double laneMin, double laneMinX, double laneMax, double laneMaxX) {
+        count += laneCount;
+        sumX += sx;
+        sumX2 += sx2;
+        sumY += sy;
+        sumY2 += sy2;
+        sumXY += sxy;
+        if (laneMin < min || (laneMin == min && laneMinX < minX)) {
+            min = laneMin;
+            minX = laneMinX;
+        }
+        if (laneMax > max || (laneMax == max && laneMaxX < maxX)) {
+            max = laneMax;
+            maxX = laneMaxX;
+        }
+    }
+};
+
+/**
+ * @brief Wariant skalarny; używany też do obsługi końcówki tablicy w wariantach wektorowych.
+ */
+template <typename T>
+void accumulateScalar(const T* values, size_t begin, size_t end, double center, double shift, Accumulator& acc) {
+    for (size_t i = begin; i < end; i++) {
+        double v = static_cast<double>(values[i]);
+        if (!(v >= 0.0)) continue;
+
+        double x = static_cast<double>(i) - center;
+        double y = v - shift;
+        acc.count += 1.0;
+        acc.sumX += x;
+        acc.sumX2 += x * x;
+        acc.sumY += y;
+        acc.sumY2 += y * y;
+        acc.sumXY += x * y;
+        if (v < acc.min) { acc.min = v; acc.minX = x; }
+        if (v > acc.max) { acc.max = v; acc.maxX = x; }
+    }
+}
+
+#ifdef STATS_X86
+
+STATS_TARGET_SSE2 inline __m128d load2(const double* p) {
+    return _mm_loadu_pd(p);
+}
+
+STATS_TARGET_SSE2 inline __m128d load2(const float* p) {
+    return _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p))));
+}
+
+STATS_TARGET_SSE2 inline __m128d select2(__m128d mask, __m128d a, __m128d b) {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+template <typename T>
+STATS_TARGET_SSE2 size_t accumulateSse2(const T* values, size_t count, double center, double shift, Accumulator& acc) {
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d step = _mm_set1_pd(2.0);
+    const __m128d shiftV = _mm_set1_pd(shift);
+    const __m128d posInf = _mm_set1_pd(POSITIVE_INFINITY);
+    const __m128d negInf = _mm_set1_pd(NEGATIVE_INFINITY);
+
+    __m128d x = _mm_setr_pd(-center, 1.0 - center);
+    __m128d n = zero, sx = zero, sx2 = zero, sy = zero, sy2 = zero, sxy = zero;
+    __m128d vmin = posInf, vmax = negInf, vminX = zero, vmaxX = zero;
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d v = load2(values + i);
+        __m128d valid = _mm_cmpge_pd(v, zero);
+        __m128d y = _mm_and_pd(valid, _mm_sub_pd(v, shiftV));
+        __m128d xv = _mm_and_pd(valid, x);
+
+        n = _mm_add_pd(n, _mm_and_pd(valid, one));
+        sx = _mm_add_pd(sx, xv);
+        sx2 = _mm_add_pd(sx2, _mm_mul_pd(xv, xv));
+        sy = _mm_add_pd(sy, y);
+        sy2 = _mm_add_pd(sy2, _mm_mul_pd(y, y));
+        sxy = _mm_add_pd(sxy, _mm_mul_pd(xv, y));
+
+        __m128d less = _mm_cmplt_pd(select2(valid, v, posInf), vmin);
+        vmin = select2(less, v, vmin);
+        vminX = select2(less, x, vminX);
+        __m128d greater = _mm_cmpgt_pd(select2(valid, v, negInf), vmax);
+        vmax = select2(greater, v, vmax);
+        vmaxX = select2(greater, x, vmaxX);
+
+        x = _mm_add_pd(x, step);
+    }
+
+    alignas(16) double lanes[10][2];
+    _mm_store_pd(lanes[0], n);
+    _mm_store_pd(lanes[1], sx);
+    _mm_store_pd(lanes[2], sx2);
+    _mm_store_pd(lanes[3], sy);
+    _mm_store_pd(lanes[4], sy2);
+    _mm_store_pd(lanes[5], sxy);
+    _mm_store_pd(lanes[6], vmin);
+    _mm_store_pd(lanes[7], vminX);
+    _mm_store_pd(lanes[8], vmax);
+    _mm_store_pd(lanes[9], vmaxX);
+    for (int l = 0; l < 2; l++) {
+        acc.mergeLane(lanes[0][l], lanes[1][l], lanes[2][l], lanes[3][l], lanes[4][l], lanes[5][l],
+            lanes[6][l], lanes[7][l], lanes[8][l], lanes[9][l]);
+    }
+    return i;
+}
+
+STATS_TARGET_AVX2 inline __m256d load4(const double* p) {
+    return _mm256_loadu_pd(p);
+}
+
+STATS_TARGET_AVX2 inline __m256d load4(const float* p) {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+template <typename T>
+STATS_TARGET_AVX2 size_t accumulateAvx2(const T* values, size_t count, double center, double shift, Accumulator& acc) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+    const __m256d shiftV = _mm256_set1_pd(shift);
+    const __m256d posInf = _mm256_set1_pd(POSITIVE_INFINITY);
+    const __m256d negInf = _mm256_set1_pd(NEGATIVE_INFINITY);
+
+    __m256d x = _mm256_setr_pd(-center, 1.0 - center, 2.0 - center, 3.0 - center);
+    __m256d n = zero, sx = zero, sx2 = zero, sy = zero, sy2 = zero, sxy = zero;
+    __m256d vmin = posInf, vmax = negInf, vminX = zero, vmaxX = zero;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d v = load4(values + i);
+        __m256d valid = _mm256_cmp_pd(v, zero, _CMP_GE_OQ);
+        __m256d y = _mm256_and_pd(valid, _mm256_sub_pd(v, shiftV));
+        __m256d xv = _mm256_and_pd(valid, x);
+
+        n = _mm256_add_pd(n, _mm256_and_pd(valid, one));
+        sx = _mm256_add_pd(sx, xv);
+        sx2 = _mm256_add_pd(sx2, _mm256_mul_pd(xv, xv));
+        sy = _mm256_add_pd(sy, y);
+        sy2 = _mm256_add_pd(sy2, _mm256_mul_pd(y, y));
+        sxy = _mm256_add_pd(sxy, _mm256_mul_pd(xv, y));
+
+        __m256d less = _mm256_cmp_pd(_mm256_blendv_pd(posInf, v, valid), vmin, _CMP_LT_OQ);
+        vmin = _mm256_blendv_pd(vmin, v, less);
+        vminX = _mm256_blendv_pd(vminX, x, less);
+        __m256d greater = _mm256_cmp_pd(_mm256_blendv_pd(negInf, v, valid), vmax, _CMP_GT_OQ);
+        vmax = _mm256_blendv_pd(vmax, v, greater);
+        vmaxX = _mm256_blendv_pd(vmaxX, x, greater);
+
+        x = _mm256_add_pd(x, step);
+    }
+
+    alignas(32) double lanes[10][4];
+    _mm256_store_pd(lanes[0], n);
+    _mm256_store_pd(lanes[1], sx);
+    _mm256_store_pd(lanes[2], sx2);
+    _mm256_store_pd(lanes[3], sy);
+    _mm256_store_pd(lanes[4], sy2);
+    _mm256_store_pd(lanes[5], sxy);
+    _mm256_store_pd(lanes[6], vmin);
+    _mm256_store_pd(lanes[7], vminX);
+    _mm256_store_pd(lanes[8], vmax);
+    _mm256_store_pd(lanes[9], vmaxX);
+    for (int l = 0; l < 4; l++) {
+        acc.mergeLane(lanes[0][l], lanes[1][l], lanes[2][l], lanes[3][l], lanes[4][l], lanes[5][l],
+            lanes[6][l], lanes[7][l], lanes[8][l], lanes[9][l]);
+    }
+    return i;
+}
+
+STATS_TARGET_AVX512 inline __m512d load8(const double* p) {
+    return _mm512_loadu_pd(p);
+}
+
+STATS_TARGET_AVX512 inline __m512d load8(const float* p) {
+    // Wariant z maską zerującą - _mm512_cvtps_pd przekazuje do wbudowanej funkcji niezainicjowany
+    // rejestr źródłowy (_mm512_undefined_pd), co GCC zgłasza jako -Wmaybe-uninitialized
+    return _mm512_maskz_cvtps_pd(static_cast<__mmask8>(0xFF), _mm256_loadu_ps(p));
+}
+
+template <typename T>
+STATS_TARGET_AVX512 size_t accumulateAvx512(const T* values, size_t count, double center, double shift, Accumulator& acc) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d step = _mm512_set1_pd(8.0);
+    const __m512d shiftV = _mm512_set1_pd(shift);
+
+    __m512d x = _mm512_setr_pd(-center, 1.0 - center, 2.0 - center, 3.0 - center,
+        4.0 - center, 5.0 - center, 6.0 - center, 7.0 - center);
+    __m512d n = zero, sx = zero, sx2 = zero, sy = zero, sy2 = zero, sxy = zero;
+    __m512d vmin = _mm512_set1_pd(POSITIVE_INFINITY), vmax = _mm512_set1_pd(NEGATIVE_INFINITY);
+    __m512d vminX = zero, vmaxX = zero;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d v = load8(values + i);
+        __mmask8 valid = _mm512_cmp_pd_mask(v, zero, _CMP_GE_OQ);
+        __m512d y = _mm512_maskz_sub_pd(valid, v, shiftV);
+        __m512d xv = _mm512_maskz_mov_pd(valid, x);
+
+        n = _mm512_mask_add_pd(n, valid, n, one);
+        sx = _mm512_add_pd(sx, xv);
+        sx2 = _mm512_add_pd(sx2, _mm512_mul_pd(xv, xv));
+        sy = _mm512_add_pd(sy, y);
+        sy2 = _mm512_add_pd(sy2, _mm512_mul_pd(y, y));
+        sxy = _mm512_add_pd(sxy, _mm512_mul_pd(xv, y));
+
+        __mmask8 less = _mm512_mask_cmp_pd_mask(valid, v, vmin, _CMP_LT_OQ);
+        vmin = _mm512_mask_mov_pd(vmin, less, v);
+        vminX = _mm512_mask_mov_pd(vminX, less, x);
+        __mmask8 greater = _mm512_mask_cmp_pd_mask(valid, v, vmax, _CMP_GT_OQ);
+        vmax = _mm512_mask_mov_pd(vmax, greater, v);
+        vmaxX = _mm512_mask_mov_pd(vmaxX, greater, x);
+
+        x = _mm512_add_pd(x, step);
+    }
+
+    alignas(64) double lanes[10][8];
+    _mm512_store_pd(lanes[0], n);
+    _mm512_store_pd(lanes[1], sx);
+    _mm512_store_pd(lanes[2], sx2);
+    _mm512_store_pd(lanes[3], sy);
+    _mm512_store_pd(lanes[4], sy2);
+    _mm512_store_pd(lanes[5], sxy);
+    _mm512_store_pd(lanes[6], vmin);
+    _mm512_store_pd(lanes[7], vminX);
+    _mm512_store_pd(lanes[8], vmax);
+    _mm512_store_pd(lanes[9], vmaxX);
+    for (int l = 0; l < 8; l++) {
+        acc.mergeLane(lanes[0][l], lanes[1][l], lanes[2][l], lanes[3][l], lanes[4][l], lanes[5][l],
+            lanes[6][l], lanes[7][l], lanes[8][l], lanes[9][l]);
+    }
+    return i;
+}
+
+/**
+ * @brief Wykrywa zestaw instrukcji na podstawie CPUID i rejestru XCR0.
+ */
+StatisticsKernels::InstructionSet detectInstructionSet() {
+    unsigned int leaf1[4] = {}, leaf7[4] = {};
+    unsigned int maxLeaf = 0;
+    unsigned long long xcr0 = 0;
+
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    maxLeaf = static_cast<unsigned int>(regs[0]);
+    __cpuid(regs, 1);
+    for (int i = 0; i < 4; i++) leaf1[i] = static_cast<unsigned int>(regs[i]);
+    if (maxLeaf >= 7) {
+        __cpuidex(regs, 7, 0);
+        for (int i = 0; i < 4; i++) leaf7[i] = static_cast<unsigned int>(regs[i]);
+    }
+    if (leaf1[2] & (1u << 27)) {
+        xcr0 = _xgetbv(0);
+    }
+#else
+    maxLeaf = __get_cpuid_max(0, nullptr);
+    __get_cpuid(1, &leaf1[0], &leaf1[1], &leaf1[2], &leaf1[3]);
+    if (maxLeaf >= 7) {
+        __get_cpuid_count(7, 0, &leaf7[0], &leaf7[1], &leaf7[2], &leaf7[3]);
+    }
+    if (leaf1[2] & (1u << 27)) {
+        unsigned int eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+    }
+#endif
+
+    bool osAvx = (xcr0 & 0x6) == 0x6;          // rejestry XMM i YMM
+    bool osAvx512 = (xcr0 & 0xE6) == 0xE6;     // dodatkowo opmask i ZMM
+    bool avx2 = osAvx && (leaf1[2] & (1u << 28)) && (leaf7[1] & (1u << 5));
+    bool avx512 = avx2 && osAvx512 && (leaf7[1] & (1u << 16));
+
+    if (avx512) return StatisticsKernels::InstructionSet::AVX512;
+    if (avx2) return StatisticsKernels::InstructionSet::AVX2;
+    if (leaf1[3] & (1u << 26)) return StatisticsKernels::InstructionSet::SSE2;
+    return StatisticsKernels::InstructionSet::SCALAR;
+}
+
+#endif // STATS_X86
+
+/**
+ * @brief Wspólna część wszystkich wariantów: wybór jądra i wyznaczenie wyniku z sum cząstkowych.
+ */
+template <typename T>
+StatisticsKernels::Summary summarizeWith(const T* values, size_t count, StatisticsKernels::InstructionSet instructionSet) {
+    StatisticsKernels::Summary result;
+
+    // Przesunięcie o pierwszą prawidłową wartość poprawia dokładność wariancji
+    size_t first = 0;
+    while (first < count && !(static_cast<double>(values[first]) >= 0.0)) first++;
+    if (first == count) return result;
+
+    double shift = static_cast<double>(values[first]);
+    double center = static_cast<double>(count / 2);
+
+    if (instructionSet > StatisticsKernels::getInstructionSet()) {
+        instructionSet = StatisticsKernels::getInstructionSet();
+    }
+
+    Accumulator acc;
+    size_t processed = 0;
+#ifdef STATS_X86
+    switch (instructionSet) {
+    case StatisticsKernels::InstructionSet::AVX512:
+        processed = accumulateAvx512(values, count, center, shift, acc);
+        break;
+    case StatisticsKernels::InstructionSet::AVX2:
+        processed = accumulateAvx2(values, count, center, shift, acc);
+        break;
+    case StatisticsKernels::InstructionSet::SSE2:
+        processed = accumulateSse2(values, count, center, shift, acc);
+        break;
+    default:
+        break;
+    }
+#endif
+    accumulateScalar(values, processed, count, center, shift, acc);
+
+    double n = acc.count;
+    double meanX = acc.sumX / n;
+    double meanY = acc.sumY / n;
+    double varianceX = acc.sumX2 / n - meanX * meanX;
+    double varianceY = acc.sumY2 / n - meanY * meanY;
+    double covariance = acc.sumXY / n - meanX * meanY;
+
+    result.count = static_cast<size_t>(n);
+    result.min = acc.min;
+    result.minIndex = static_cast<size_t>(acc.minX + center);
+    result.max = acc.max;
+    result.maxIndex = static_cast<size_t>(acc.maxX + center);
+    result.mean = shift + meanY;
+    result.variance = varianceY > 0.0 ? varianceY : 0.0;
+    result.slope = (result.count >= 2 && varianceX > 0.0) ? covariance / varianceX : 0.0;
+    return result;
+}
+
+} // namespace
+
+/**
+ * @brief Oblicza statystyki kolumny wartości double najszybszym dostępnym wariantem.
+ *
+ * @param values Wskaźnik na pierwszą wartość.
+ * @param count Liczba wartości.
+ * @return Struktura Summary.
+ */
+StatisticsKernels::Summary StatisticsKernels::summarize(const double* values, size_t count) {
+    return summarizeWith(values, count, getInstructionSet());
+}
+
+/**
+ * @brief Oblicza statystyki kolumny wartości float najszybszym dostępnym wariantem.
+ *
+ * @param values Wskaźnik na pierwszą wartość.
+ * @param count Liczba wartości.
+ * @return Struktura Summary.
+ */
+StatisticsKernels::Summary StatisticsKernels::summarize(const float* values, size_t count) {
+    return summarizeWith(values, count, getInstructionSet());
+}
+
+/**
+ * @brief Oblicza statystyki kolumny double wskazanym wariantem.
+ *
+ * @param values Wskaźnik na pierwszą wartość.
+ * @param count Liczba wartości.
+ * @param instructionSet Żądany zestaw instrukcji.
+ * @return Struktura Summary.
+ */
+StatisticsKernels::Summary StatisticsKernels::summarize(const double* values, size_t count, InstructionSet instructionSet) {
+    return summarizeWith(values, count, instructionSet);
+}
+
+/**
+ * @brief Oblicza statystyki kolumny float wskazanym wariantem.
+ *
+ * @param values Wskaźnik na pierwszą wartość.
+ * @param count Liczba wartości.
+ * @param instructionSet Żądany zestaw instrukcji.
+ * @return Struktura Summary.
+ */
+StatisticsKernels::Summary StatisticsKernels::summarize(const float* values, size_t count, InstructionSet instructionSet) {
+    return summarizeWith(values, count, instructionSet);
+}
+
+/**
+ * @brief Zwraca najlepszy zestaw instrukcji obsługiwany przez procesor i system.
+ *
+ * @return Wykryty zestaw instrukcji.
+ */
+StatisticsKernels::InstructionSet StatisticsKernels::getInstructionSet() {
+#ifdef STATS_X86
+    static const InstructionSet detected = detectInstructionSet();
+    return detected;
+#else
+    return InstructionSet::SCALAR;
+#endif
+}
+
+/**
+ * @brief Zwraca nazwę zestawu instrukcji.
+ *
+ * @param instructionSet Zestaw instrukcji.
+ * @return Nazwa zestawu instrukcji.
+ */
+const char* StatisticsKernels::getInstructionSetName(InstructionSet instructionSet) {
+    switch (instructionSet) {
+    case InstructionSet::AVX512: return "AVX-512";
+    case InstructionSet::AVX2: return "AVX2";
+    case InstructionSet::SSE2: return "SSE2";
+    case InstructionSet::SCALAR: return "skalarny";
+    }
+    return "skalarny";
+}
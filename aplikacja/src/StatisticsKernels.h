@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file StatisticsKernels.h
+ * @brief Wektorowe (SIMD) jądra obliczeniowe statystyk serii z wyborem zestawu instrukcji w czasie działania.
+ *
+ * Dostępne warianty: AVX-512, AVX2, SSE2 oraz wersja skalarna. Wariant jest wybierany raz,
+ * na podstawie instrukcji CPUID i wsparcia systemu operacyjnego (XGETBV).
+ * Nieprawidłowe punkty (wartość < 0 lub NaN, zgodnie z Measurement::isValid) są pomijane
+ * za pomocą masek, bez rozgałęzień w pętli głównej.
+ */
+class StatisticsKernels {
+public:
+    /**
+     * @brief Zbiorcze statystyki serii obliczane w jednym przebiegu.
+     *
+     * Indeksy i regresja odnoszą się do pozycji w tablicy wejściowej (łącznie z punktami nieprawidłowymi).
+     */
+    struct Summary {
+        size_t count = 0;       ///< Liczba prawidłowych wartości.
+        double min = 0.0;       ///< Wartość minimalna.
+        size_t minIndex = 0;    ///< Indeks pierwszego wystąpienia minimum.
+        double max = 0.0;       ///< Wartość maksymalna.
+        size_t maxIndex = 0;    ///< Indeks pierwszego wystąpienia maksimum.
+        double mean = 0.0;      ///< Średnia arytmetyczna.
+        double variance = 0.0;  ///< Wariancja (populacyjna).
+        double slope = 0.0;     ///< Nachylenie prostej regresji względem indeksu pomiaru.
+    };
+
+    /**
+     * @brief Zestaw instrukcji używany przez jądra.
+     */
+    enum class InstructionSet {
+        SCALAR, ///< Wersja skalarna (zawsze dostępna).
+        SSE2,   ///< 2 wartości double na instrukcję.
+        AVX2,   ///< 4 wartości double na instrukcję.
+        AVX512  ///< 8 wartości double na instrukcję (AVX-512F).
+    };
+
+    /**
+     * @brief Oblicza statystyki kolumny wartości double najszybszym dostępnym wariantem.
+     *
+     * @param values Wskaźnik na pierwszą wartość.
+     * @param count Liczba wartości.
+     * @return Struktura Summary (count == 0, jeśli brak prawidłowych wartości).
+     */
+    static Summary summarize(const double* values, size_t count);
+
+    /**
+     * @brief Oblicza statystyki kolumny wartości float (akumulacja w double).
+     *
+     * @param values Wskaźnik na pierwszą wartość.
+     * @param count Liczba wartości.
+     * @return Struktura Summary.
+     */
+    static Summary summarize(const float* values, size_t count);
+
+    /**
+     * @brief Oblicza statystyki wskazanym wariantem (np. do porównań i pomiarów wydajności).
+     *
+     * Jeśli procesor nie obsługuje wskazanego zestawu instrukcji, używany jest najlepszy dostępny słabszy.
+     *
+     * @param values Wskaźnik na pierwszą wartość.
+     * @param count Liczba wartości.
+     * @param instructionSet Żądany zestaw instrukcji.
+     * @return Struktura Summary.
+     */
+    static Summary summarize(const double* values, size_t count, InstructionSet instructionSet);
+
+    /**
+     * @brief Wersja dla kolumny float z wyborem zestawu instrukcji.
+     *
+     * @param values Wskaźnik na pierwszą wartość.
+     * @param count Liczba wartości.
+     * @param instructionSet Żądany zestaw instrukcji.
+     * @return Struktura Summary.
+     */
+    static Summary summarize(const float* values, size_t count, InstructionSet instructionSet);
+
+    /**
+     * @brief Zwraca najlepszy zestaw instrukcji obsługiwany przez procesor i system.
+     *
+     * Wynik jest wyznaczany raz i zapamiętywany.
+     *
+     * @return Wykryty zestaw instrukcji.
+     */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * @brief Zwraca nazwę zestawu instrukcji.
+     *
+     * @param instructionSet Zestaw instrukcji.
+     * @return Nazwa, np. "AVX2".
+     */
+    static const char* getInstructionSetName(InstructionSet instructionSet);
+};
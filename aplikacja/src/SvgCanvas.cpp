@@ -0,0 +1,210 @@
+/**
+ * @file SvgCanvas.cpp
+ * @brief Implementacja zapisu wykresu do dokumentu SVG.
+ */
+
+#include "SvgCanvas.h"
+#include <cstdio>
+#include <fstream>
+#include <locale>
+
+/**
+ * @brief Tworzy pusty dokument o podanym rozmiarze z białym tłem.
+ *
+ * @param width Szerokość w pikselach.
+ * @param height Wysokość w pikselach.
+ */
+SvgCanvas::SvgCanvas(int width, int height)
+    : width_(width), height_(height), penColour_{ 0, 0, 0 }, penWidth_(1.0), penDotted_(false), penVisible_(true),
+    brushColour_{ 255, 255, 255 }, fontPixels_(12.0), fontBold_(false), clipCount_(0), clipOpen_(false) {
+    body_.imbue(std::locale::classic());
+    body_ << "<rect x=\"0\" y=\"0\" width=\"" << width_ << "\" height=\"" << height_ << "\" fill=\"#ffffff\"/>\n";
+}
+
+/**
+ * @brief Ustawia pióro dla linii i obrysów.
+ */
+void SvgCanvas::setPen(const ChartColour& colour, double width, bool dotted) {
+    penColour_ = colour;
+    penWidth_ = width;
+    penDotted_ = dotted;
+    penVisible_ = true;
+}
+
+/**
+ * @brief Wyłącza obrys.
+ */
+void SvgCanvas::setNoPen() {
+    penVisible_ = false;
+}
+
+/**
+ * @brief Ustawia kolor wypełnienia.
+ */
+void SvgCanvas::setBrush(const ChartColour& colour) {
+    brushColour_ = colour;
+}
+
+/**
+ * @brief Ustawia czcionkę (punkty są przeliczane na piksele przy 96 DPI).
+ */
+void SvgCanvas::setFont(double pointSize, bool bold) {
+    fontPixels_ = pointSize * 96.0 / 72.0;
+    fontBold_ = bold;
+}
+
+/**
+ * @brief Zapisuje odcinek.
+ */
+void SvgCanvas::drawLine(double x1, double y1, double x2, double y2) {
+    body_ << "<line x1=\"" << x1 << "\" y1=\"" << y1 << "\" x2=\"" << x2 << "\" y2=\"" << y2 << "\""
+        << strokeAttributes() << "/>\n";
+}
+
+/**
+ * @brief Zapisuje łamaną.
+ */
+void SvgCanvas::drawLines(const std::vector<Point>& points) {
+    body_ << "<polyline fill=\"none\" stroke-linejoin=\"round\" points=\"";
+    for (const auto& point : points) {
+        body_ << point.x << ',' << point.y << ' ';
+    }
+    body_ << "\"" << strokeAttributes() << "/>\n";
+}
+
+/**
+ * @brief Zapisuje wypełniony wielokąt.
+ */
+void SvgCanvas::drawPolygon(const std::vector<Point>& points) {
+    body_ << "<polygon fill=\"" << colourString(brushColour_) << "\" points=\"";
+    for (const auto& point : points) {
+        body_ << point.x << ',' << point.y << ' ';
+    }
+    body_ << "\"" << strokeAttributes() << "/>\n";
+}
+
+/**
+ * @brief Zapisuje wypełnione koło.
+ */
+void SvgCanvas::drawCircle(double x, double y, double radius) {
+    body_ << "<circle cx=\"" << x << "\" cy=\"" << y << "\" r=\"" << radius << "\" fill=\""
+        << colourString(brushColour_) << "\"" << strokeAttributes() << "/>\n";
+}
+
+/**
+ * @brief Zapisuje wypełniony prostokąt.
+ */
+void SvgCanvas::drawRectangle(double x, double y, double width, double height) {
+    body_ << "<rect x=\"" << x << "\" y=\"" << y << "\" width=\"" << width << "\" height=\"" << height
+        << "\" fill=\"" << colourString(brushColour_) << "\"" << strokeAttributes() << "/>\n";
+}
+
+/**
+ * @brief Rysuje tekst; SVG pozycjonuje tekst względem linii bazowej, więc y jest przesuwane o ascent.
+ */
+void SvgCanvas::drawText(const std::string& text, double x, double y) {
+    body_ << "<text x=\"" << x << "\" y=\"" << y + fontPixels_ * 0.9 << "\" font-family=\"sans-serif\" font-size=\""
+        << fontPixels_ << "\"" << (fontBold_ ? " font-weight=\"bold\"" : "") << " fill=\"#000000\">"
+        << escape(text) << "</text>\n";
+}
+
+/**
+ * @brief Szacuje rozmiar tekstu (0.55 wysokości czcionki na znak, 0.6 dla pogrubionej).
+ */
+void SvgCanvas::getTextExtent(const std::string& text, double& width, double& height) {
+    size_t characters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) characters++;  // pomijamy bajty kontynuacji UTF-8
+    }
+    width = characters * fontPixels_ * (fontBold_ ? 0.6 : 0.55);
+    height = fontPixels_ * 1.2;
+}
+
+/**
+ * @brief Otwiera grupę przyciętą do prostokąta (zamykając poprzednią).
+ */
+void SvgCanvas::setClip(double x, double y, double width, double height) {
+    resetClip();
+    clipCount_++;
+    body_ << "<clipPath id=\"clip" << clipCount_ << "\"><rect x=\"" << x << "\" y=\"" << y << "\" width=\""
+        << width << "\" height=\"" << height << "\"/></clipPath>\n";
+    body_ << "<g clip-path=\"url(#clip" << clipCount_ << ")\">\n";
+    clipOpen_ = true;
+}
+
+/**
+ * @brief Zamyka grupę z przycinaniem.
+ */
+void SvgCanvas::resetClip() {
+    if (clipOpen_) {
+        body_ << "</g>\n";
+        clipOpen_ = false;
+    }
+}
+
+/**
+ * @brief Zwraca kompletny dokument SVG.
+ *
+ * @return Tekst dokumentu.
+ */
+std::string SvgCanvas::toString() const {
+    std::ostringstream out;
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width_ << "\" height=\"" << height_
+        << "\" viewBox=\"0 0 " << width_ << ' ' << height_ << "\">\n"
+        << body_.str() << (clipOpen_ ? "</g>\n" : "") << "</svg>\n";
+    return out.str();
+}
+
+/**
+ * @brief Zapisuje dokument SVG do pliku.
+ *
+ * @param path Ścieżka pliku.
+ * @return true jeśli zapis się powiódł.
+ */
+bool SvgCanvas::saveFile(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file << toString();
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Zwraca atrybuty obrysu bieżącego pióra.
+ */
+std::string SvgCanvas::strokeAttributes() const {
+    if (!penVisible_) return " stroke=\"none\"";
+
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out << " stroke=\"" << colourString(penColour_) << "\" stroke-width=\"" << penWidth_ << "\"";
+    if (penDotted_) out << " stroke-dasharray=\"1,2\"";
+    return out.str();
+}
+
+/**
+ * @brief Zwraca kolor w zapisie #rrggbb.
+ */
+std::string SvgCanvas::colourString(const ChartColour& colour) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", colour.red, colour.green, colour.blue);
+    return buffer;
+}
+
+/**
+ * @brief Zastępuje znaki specjalne XML encjami.
+ */
+std::string SvgCanvas::escape(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+        case '&': result += "&amp;"; break;
+        case '<': result += "&lt;"; break;
+        case '>': result += "&gt;"; break;
+        case '"': result += "&quot;"; break;
+        default: result += c;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ChartCanvas.h"
+
+/**
+ * @file SvgCanvas.h
+ * @brief Powierzchnia rysowania zapisująca wykres jako dokument SVG (bez okna i bez wxWidgets).
+ *
+ * Szerokość tekstu jest szacowana (średnia szerokość znaku czcionki bezszeryfowej), bo SVG nie
+ * daje dostępu do metryk czcionki; wystarcza to do wyśrodkowania etykiet i rozmiaru legendy.
+ * Liczby są zapisywane zawsze z kropką dziesiętną, niezależnie od lokalizacji programu.
+ */
+class SvgCanvas : public ChartCanvas {
+public:
+    /**
+     * @brief Tworzy pusty dokument o podanym rozmiarze z białym tłem.
+     *
+     * @param width Szerokość w pikselach.
+     * @param height Wysokość w pikselach.
+     */
+    SvgCanvas(int width, int height);
+
+    void setPen(const ChartColour& colour, double width, bool dotted = false) override;
+    void setNoPen() override;
+    void setBrush(const ChartColour& colour) override;
+    void setFont(double pointSize, bool bold) override;
+    void drawLine(double x1, double y1, double x2, double y2) override;
+    void drawLines(const std::vector<Point>& points) override;
+    void drawPolygon(const std::vector<Point>& points) override;
+    void drawCircle(double x, double y, double radius) override;
+    void drawRectangle(double x, double y, double width, double height) override;
+    void drawText(const std::string& text, double x, double y) override;
+    void getTextExtent(const std::string& text, double& width, double& height) override;
+    void setClip(double x, double y, double width, double height) override;
+    void resetClip() override;
+
+    /**
+     * @brief Zwraca kompletny dokument SVG.
+     *
+     * @return Tekst dokumentu (UTF-8).
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Zapisuje dokument SVG do pliku.
+     *
+     * @param path Ścieżka pliku.
+     * @return true jeśli zapis się powiódł.
+     */
+    bool saveFile(const std::string& path) const;
+
+private:
+    /**
+     * @brief Zwraca atrybuty obrysu bieżącego pióra.
+     */
+    std::string strokeAttributes() const;
+
+    /**
+     * @brief Zwraca kolor w zapisie #rrggbb.
+     */
+    static std::string colourString(const ChartColour& colour);
+
+    /**
+     * @brief Zastępuje znaki specjalne XML encjami.
+     */
+    static std::string escape(const std::string& text);
+
+    int width_;                 ///< Szerokość dokumentu.
+    int height_;                ///< Wysokość dokumentu.
+    std::ostringstream body_;   ///< Elementy dokumentu.
+    ChartColour penColour_;     ///< Kolor pióra.
+    double penWidth_;           ///< Grubość pióra.
+    bool penDotted_;            ///< Pióro kropkowane.
+    bool penVisible_;           ///< Czy obrys jest rysowany.
+    ChartColour brushColour_;   ///< Kolor wypełnienia.
+    double fontPixels_;         ///< Rozmiar czcionki w pikselach.
+    bool fontBold_;             ///< Czcionka pogrubiona.
+    int clipCount_;             ///< Liczba utworzonych obszarów przycinania.
+    bool clipOpen_;             ///< Czy otwarta jest grupa z przycinaniem.
+};
@@ -0,0 +1,403 @@
+/**
+ * @file TaskScheduler.cpp
+ * @brief Implementacja puli wątków z podkradaniem zadań.
+ */
+
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+thread_local const TaskScheduler* currentScheduler = nullptr; ///< Pula, do której należy bieżący wątek.
+thread_local int currentWorker = -1;                          ///< Indeks bieżącego wątku w puli.
+
+/**
+ * @brief Zamienia odcinek czasu na nanosekundy.
+ */
+int64_t toNanoseconds(Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+} // namespace
+
+/**
+ * @brief Stan zadania współdzielony przez uchwyt i pulę.
+ */
+struct TaskScheduler::TaskHandle::State {
+    TaskScheduler* owner;           ///< Pula wykonująca zadanie.
+    CancellationToken token;        ///< Znacznik anulowania.
+    Priority priority;              ///< Priorytet.
+    Clock::time_point submitted;    ///< Chwila zgłoszenia.
+    TaskTiming timing;              ///< Czasy (ważne po zakończeniu).
+    std::exception_ptr error;       ///< Wyjątek zgłoszony przez zadanie.
+    std::atomic<bool> done;         ///< Zadanie się zakończyło.
+    std::mutex mutex;               ///< Chroni oczekiwanie na zakończenie.
+    std::condition_variable finished; ///< Sygnalizuje zakończenie.
+
+    State(TaskScheduler* owner, const CancellationToken& token, Priority priority)
+        : owner(owner), token(token), priority(priority), submitted(Clock::now()),
+        timing{ 0.0, 0.0, false, false }, done(false) {
+    }
+};
+
+/**
+ * @brief Czeka na zakończenie zadania.
+ *
+ * Zamiast blokować wątek, w czasie oczekiwania wykonuje inne zadania z kolejek - dzięki temu
+ * oczekiwanie wewnątrz zadania puli nie prowadzi do zakleszczenia.
+ */
+void TaskScheduler::TaskHandle::wait() const {
+    if (!state_) return;
+
+    while (!state_->done) {
+        if (state_->owner->tryRunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->finished.wait_for(lock, std::chrono::milliseconds(1), [this]() { return state_->done.load(); });
+    }
+    if (state_->error) {
+        std::rethrow_exception(state_->error);
+    }
+}
+
+/**
+ * @brief Sprawdza, czy zadanie się zakończyło.
+ *
+ * @return true jeśli zadanie zostało wykonane, pominięte lub zakończone wyjątkiem.
+ */
+bool TaskScheduler::TaskHandle::isDone() const {
+    return !state_ || state_->done;
+}
+
+/**
+ * @brief Anuluje zadanie.
+ */
+void TaskScheduler::TaskHandle::cancel() const {
+    if (state_) state_->token.cancel();
+}
+
+/**
+ * @brief Zwraca czasy wykonania zadania.
+ *
+ * @return Czasy (zera, jeśli zadanie jeszcze się nie zakończyło).
+ */
+TaskScheduler::TaskTiming TaskScheduler::TaskHandle::getTiming() const {
+    if (!state_ || !state_->done) return TaskTiming{ 0.0, 0.0, false, false };
+    return state_->timing;
+}
+
+/**
+ * @brief Konstruktor klasy TaskScheduler.
+ *
+ * @param threadCount Liczba wątków (0 - liczba rdzeni).
+ */
+TaskScheduler::TaskScheduler(unsigned threadCount)
+    : pending_(0), nextQueue_(0), stopping_(false), submitted_(0), completed_(0), cancelled_(0),
+    failed_(0), stolen_(0) {
+    for (int p = 0; p < 2; p++) {
+        runNanoseconds_[p] = 0;
+        waitNanoseconds_[p] = 0;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers_[i]->thread = std::thread(&TaskScheduler::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+/**
+ * @brief Destruktor - kończy wątki; zadania niewykonane są oznaczane jako anulowane.
+ */
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCondition_.notify_all();
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+
+    for (auto& worker : workers_) {
+        for (auto& queue : worker->queues) {
+            for (auto& task : queue) {
+                task.state->timing.cancelled = true;
+                std::lock_guard<std::mutex> lock(task.state->mutex);
+                task.state->done = true;
+                task.state->finished.notify_all();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Zwraca wspólną pulę aplikacji.
+ *
+ * @return Pula z liczbą wątków równą liczbie rdzeni.
+ */
+TaskScheduler& TaskScheduler::shared() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+
+/**
+ * @brief Zgłasza zadanie do wykonania.
+ *
+ * @param task Zadanie.
+ * @param priority Priorytet.
+ * @param token Znacznik anulowania.
+ * @return Uchwyt zadania.
+ */
+TaskScheduler::TaskHandle TaskScheduler::submit(std::function<void(const CancellationToken&)> task, Priority priority,
+    const CancellationToken& token) {
+    TaskHandle handle;
+    handle.state_ = std::make_shared<TaskHandle::State>(this, token, priority);
+    push(Task{ handle.state_, std::move(task) }, priority);
+    return handle;
+}
+
+/**
+ * @brief Wykonuje body(i) dla i = 0..count-1 na wszystkich wątkach puli i wątku wywołującym.
+ *
+ * Elementy są pobierane pojedynczo z licznika atomowego, więc nierówny koszt elementów
+ * (np. serie różnej długości) rozkłada się samoczynnie. Stan pętli jest współdzielony przez
+ * zadania pomocnicze; zadanie, które rozpocznie się po zakończeniu pętli, nie znajdzie już
+ * elementów i kończy się od razu. Po wyczerpaniu elementów wątek wywołujący pomaga w innych
+ * zadaniach z kolejek, a potem czeka na zmiennej warunkowej (bez aktywnego oczekiwania).
+ *
+ * @param count Liczba elementów.
+ * @param body Praca dla elementu.
+ * @param priority Priorytet zadań pomocniczych.
+ * @param token Znacznik anulowania.
+ * @return true jeśli wszystkie elementy zostały przetworzone, false po anulowaniu.
+ */
+bool TaskScheduler::parallelFor(size_t count, const std::function<void(size_t)>& body, Priority priority,
+    const CancellationToken& token) {
+    struct Loop {
+        std::atomic<size_t> next;     ///< Następny element do pobrania.
+        std::atomic<size_t> finished; ///< Liczba elementów zakończonych (także pominiętych).
+        std::atomic<bool> failed;     ///< Element zgłosił wyjątek.
+        std::mutex mutex;             ///< Chroni error i usypianie wątku wywołującego.
+        std::condition_variable done; ///< Budzi wątek wywołujący po zakończeniu ostatniego elementu.
+        std::exception_ptr error;     ///< Pierwszy zgłoszony wyjątek.
+        size_t count;                 ///< Liczba elementów.
+        const std::function<void(size_t)>* body; ///< Praca dla elementu.
+        CancellationToken token;      ///< Znacznik anulowania.
+    };
+
+    auto loop = std::make_shared<Loop>();
+    loop->next = 0;
+    loop->finished = 0;
+    loop->failed = false;
+    loop->count = count;
+    loop->body = &body;
+    loop->token = token;
+
+    auto runItems = [](Loop& state) {
+        for (size_t i = state.next++; i < state.count; i = state.next++) {
+            if (!state.failed && !state.token.isCancelled()) {
+                try {
+                    (*state.body)(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    if (!state.error) state.error = std::current_exception();
+                    state.failed = true;
+                }
+            }
+            if (++state.finished == state.count) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.done.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = count > 1 ? std::min(count - 1, workers_.size()) : 0;
+    for (size_t h = 0; h < helpers; h++) {
+        auto state = std::make_shared<TaskHandle::State>(this, token, priority);
+        push(Task{ state, [loop, runItems](const CancellationToken&) { runItems(*loop); } }, priority);
+    }
+
+    runItems(*loop);
+    // Pozostałe elementy są już wykonywane przez inne wątki - w oczekiwaniu wątek wywołujący
+    // wykonuje zadania z kolejek, a gdy ich brak, śpi do zakończenia ostatniego elementu
+    while (loop->finished < count) {
+        if (tryRunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        loop->done.wait(lock, [&loop, count]() { return loop->finished >= count; });
+    }
+
+    if (loop->error) {
+        std::rethrow_exception(loop->error);
+    }
+    return !token.isCancelled();
+}
+
+/**
+ * @brief Zwraca zbiorcze statystyki puli.
+ *
+ * @return Statystyki od utworzenia puli.
+ */
+TaskScheduler::Stats TaskScheduler::getStats() const {
+    Stats stats;
+    stats.submitted = submitted_;
+    stats.completed = completed_;
+    stats.cancelled = cancelled_;
+    stats.failed = failed_;
+    stats.stolen = stolen_;
+    for (int p = 0; p < 2; p++) {
+        stats.runSeconds[p] = runNanoseconds_[p] / 1e9;
+        stats.waitSeconds[p] = waitNanoseconds_[p] / 1e9;
+    }
+    return stats;
+}
+
+/**
+ * @brief Umieszcza zadanie w kolejce i budzi wątek.
+ *
+ * Zadanie zgłoszone z wątku puli trafia do jego własnej kolejki (dobra lokalność danych),
+ * pozostałe są rozdzielane po kolei między wątki.
+ */
+void TaskScheduler::push(Task task, Priority priority) {
+    size_t target = currentScheduler == this && currentWorker >= 0
+        ? static_cast<size_t>(currentWorker) : nextQueue_++ % workers_.size();
+    {
+        std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+        workers_[target]->queues[static_cast<int>(priority)].push_back(std::move(task));
+    }
+    submitted_++;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        pending_++;
+    }
+    sleepCondition_.notify_one();
+}
+
+/**
+ * @brief Pobiera zadanie: najpierw interaktywne (własne, potem podkradzione), następnie tła.
+ *
+ * Własna kolejka jest obsługiwana od końca (ostatnio dodane zadania mają dane w pamięci
+ * podręcznej), a podkradanie odbywa się od początku cudzych kolejek.
+ *
+ * @param workerIndex Indeks wątku puli (-1 dla wątku spoza puli).
+ * @param task Pobrane zadanie.
+ * @return true jeśli pobrano zadanie.
+ */
+bool TaskScheduler::tryPop(int workerIndex, Task& task) {
+    if (pending_ == 0) return false;
+
+    const size_t count = workers_.size();
+    for (int priority = 0; priority < 2; priority++) {
+        if (workerIndex >= 0) {
+            Worker& own = *workers_[workerIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& queue = own.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.back());
+                queue.pop_back();
+                pending_--;
+                return true;
+            }
+        }
+
+        const size_t start = workerIndex >= 0 ? static_cast<size_t>(workerIndex) + 1 : 0;
+        for (size_t k = 0; k < count; k++) {
+            const size_t victim = (start + k) % count;
+            if (static_cast<int>(victim) == workerIndex) continue;
+
+            Worker& other = *workers_[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            auto& queue = other.queues[priority];
+            if (!queue.empty()) {
+                task = std::move(queue.front());
+                queue.pop_front();
+                pending_--;
+                stolen_++;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Wykonuje jedno zadanie z kolejek, jeśli jakieś czeka.
+ *
+ * @return true jeśli wykonano zadanie.
+ */
+bool TaskScheduler::tryRunOne() {
+    Task task;
+    const int workerIndex = currentScheduler == this ? currentWorker : -1;
+    if (!tryPop(workerIndex, task)) return false;
+    run(task);
+    return true;
+}
+
+/**
+ * @brief Wykonuje zadanie i zapisuje jego czasy.
+ */
+void TaskScheduler::run(Task& task) {
+    TaskHandle::State& state = *task.state;
+    const int priority = static_cast<int>(state.priority);
+    const Clock::time_point started = Clock::now();
+
+    if (state.token.isCancelled()) {
+        state.timing.cancelled = true;
+        cancelled_++;
+    }
+    else {
+        try {
+            task.work(state.token);
+        }
+        catch (...) {
+            state.error = std::current_exception();
+            state.timing.failed = true;
+            failed_++;
+        }
+    }
+
+    const Clock::time_point finished = Clock::now();
+    state.timing.waitSeconds = std::chrono::duration<double>(started - state.submitted).count();
+    state.timing.runSeconds = std::chrono::duration<double>(finished - started).count();
+    waitNanoseconds_[priority] += toNanoseconds(started - state.submitted);
+    runNanoseconds_[priority] += toNanoseconds(finished - started);
+    completed_++;
+
+    // Zwolnienie pracy przed sygnałem - uchwyt może przeżyć zadanie
+    task.work = nullptr;
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.done = true;
+    state.finished.notify_all();
+}
+
+/**
+ * @brief Pętla wątku roboczego.
+ *
+ * @param workerIndex Indeks wątku w puli.
+ */
+void TaskScheduler::workerLoop(int workerIndex) {
+    currentScheduler = this;
+    currentWorker = workerIndex;
+
+    for (;;) {
+        Task task;
+        if (tryPop(workerIndex, task)) {
+            run(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCondition_.wait(lock, [this]() { return stopping_ || pending_ > 0; });
+        if (stopping_) return;
+    }
+}
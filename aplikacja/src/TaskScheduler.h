@@ -0,0 +1,273 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @file TaskScheduler.h
+ * @brief Wspólna pula wątków z podkradaniem zadań (work stealing) dla analiz, zapisu i eksportu.
+ *
+ * Każdy wątek ma własne kolejki zadań (osobno dla priorytetu interaktywnego i tła): wykonuje
+ * zadania od końca własnej kolejki, a gdy jest pusta - podkrada je z początku kolejek innych
+ * wątków. Zadania interaktywne są zawsze pobierane przed zadaniami tła. Anulowanie jest
+ * kooperacyjne (CancellationToken), a każde zadanie ma mierzony czas oczekiwania i wykonania.
+ */
+
+/**
+ * @brief Znacznik anulowania współdzielony przez kopie (anulowanie jednej kopii anuluje wszystkie).
+ */
+class CancellationToken {
+public:
+    /**
+     * @brief Tworzy nowy, nieanulowany znacznik.
+     */
+    CancellationToken() : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /**
+     * @brief Zgłasza anulowanie.
+     */
+    void cancel() const { *cancelled_ = true; }
+
+    /**
+     * @brief Sprawdza, czy zgłoszono anulowanie.
+     *
+     * @return true jeśli praca powinna zostać przerwana.
+     */
+    bool isCancelled() const { return *cancelled_; }
+
+private:
+    std::shared_ptr<std::atomic<bool>> cancelled_; ///< Wspólny stan anulowania.
+};
+
+/**
+ * @brief Pula wątków z podkradaniem zadań, priorytetami i statystykami.
+ */
+class TaskScheduler {
+public:
+    /**
+     * @brief Priorytet zadania.
+     */
+    enum class Priority {
+        INTERACTIVE = 0, ///< Praca, na którą czeka użytkownik.
+        BACKGROUND = 1   ///< Praca w tle (zapis, eksport, przeliczenia wsadowe).
+    };
+
+    /**
+     * @brief Czasy wykonania pojedynczego zadania.
+     */
+    struct TaskTiming {
+        double waitSeconds; ///< Czas od zgłoszenia do rozpoczęcia.
+        double runSeconds;  ///< Czas wykonania.
+        bool cancelled;     ///< Zadanie pominięte z powodu anulowania.
+        bool failed;        ///< Zadanie zakończone wyjątkiem.
+    };
+
+    /**
+     * @brief Zbiorcze statystyki puli.
+     */
+    struct Stats {
+        uint64_t submitted;     ///< Liczba zgłoszonych zadań.
+        uint64_t completed;     ///< Liczba zakończonych zadań (także anulowanych i z wyjątkiem).
+        uint64_t cancelled;     ///< Liczba zadań pominiętych z powodu anulowania.
+        uint64_t failed;        ///< Liczba zadań zakończonych wyjątkiem.
+        uint64_t stolen;        ///< Liczba zadań podkradzionych z kolejek innych wątków.
+        double runSeconds[2];   ///< Łączny czas wykonania według priorytetu.
+        double waitSeconds[2];  ///< Łączny czas oczekiwania według priorytetu.
+    };
+
+    /**
+     * @brief Uchwyt zgłoszonego zadania.
+     */
+    class TaskHandle {
+    public:
+        /**
+         * @brief Czeka na zakończenie zadania (pomagając w tym czasie w wykonywaniu innych zadań).
+         *
+         * Wyjątek zgłoszony przez zadanie jest przekazywany dalej.
+         */
+        void wait() const;
+
+        /**
+         * @brief Sprawdza, czy zadanie się zakończyło.
+         *
+         * @return true jeśli zadanie zostało wykonane, pominięte lub zakończone wyjątkiem.
+         */
+        bool isDone() const;
+
+        /**
+         * @brief Anuluje zadanie (przez jego znacznik anulowania).
+         */
+        void cancel() const;
+
+        /**
+         * @brief Zwraca czasy wykonania zadania.
+         *
+         * @return Czasy (zera, jeśli zadanie jeszcze się nie zakończyło).
+         */
+        TaskTiming getTiming() const;
+
+        /**
+         * @brief Sprawdza, czy uchwyt dotyczy zadania.
+         */
+        bool isValid() const { return state_ != nullptr; }
+
+    private:
+        friend class TaskScheduler;
+        struct State;
+        std::shared_ptr<State> state_; ///< Stan zadania współdzielony z pulą.
+    };
+
+    /**
+     * @brief Konstruktor klasy TaskScheduler.
+     *
+     * @param threadCount Liczba wątków (0 - liczba rdzeni).
+     */
+    explicit TaskScheduler(unsigned threadCount = 0);
+
+    /**
+     * @brief Destruktor - kończy wątki; zadania niewykonane są oznaczane jako anulowane.
+     */
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    /**
+     * @brief Zwraca wspólną pulę aplikacji.
+     *
+     * @return Pula z liczbą wątków równą liczbie rdzeni.
+     */
+    static TaskScheduler& shared();
+
+    /**
+     * @brief Zgłasza zadanie do wykonania.
+     *
+     * @param task Zadanie; otrzymuje znacznik anulowania, który powinno okresowo sprawdzać.
+     * @param priority Priorytet.
+     * @param token Znacznik anulowania.
+     * @return Uchwyt zadania.
+     */
+    TaskHandle submit(std::function<void(const CancellationToken&)> task, Priority priority = Priority::BACKGROUND,
+        const CancellationToken& token = CancellationToken());
+
+    /**
+     * @brief Wykonuje body(i) dla i = 0..count-1 na wszystkich wątkach puli i wątku wywołującym.
+     *
+     * Wątek wywołujący bierze udział w pracy, więc funkcję można bezpiecznie wywoływać także
+     * z wnętrza zadania puli. Pierwszy wyjątek zgłoszony przez body przerywa pętlę i jest
+     * przekazywany dalej.
+     *
+     * @param count Liczba elementów.
+     * @param body Praca dla elementu.
+     * @param priority Priorytet zadań pomocniczych.
+     * @param token Znacznik anulowania (sprawdzany przed każdym elementem).
+     * @return true jeśli wszystkie elementy zostały przetworzone, false po anulowaniu.
+     */
+    bool parallelFor(size_t count, const std::function<void(size_t)>& body, Priority priority = Priority::INTERACTIVE,
+        const CancellationToken& token = CancellationToken());
+
+    /**
+     * @brief Wylicza map(i) równolegle i łączy wyniki funkcją reduce w kolejności indeksów.
+     *
+     * Kolejność łączenia nie zależy od podziału pracy, więc wynik jest powtarzalny.
+     * Po anulowaniu elementy nieprzetworzone wnoszą wartość domyślną T.
+     *
+     * @param count Liczba elementów.
+     * @param map Funkcja size_t -> T.
+     * @param reduce Funkcja (T, T) -> T.
+     * @param init Wartość początkowa.
+     * @param priority Priorytet zadań pomocniczych.
+     * @param token Znacznik anulowania.
+     * @return Połączony wynik.
+     */
+    template <typename T, typename Map, typename Reduce>
+    T mapReduce(size_t count, Map map, Reduce reduce, T init, Priority priority = Priority::INTERACTIVE,
+        const CancellationToken& token = CancellationToken()) {
+        std::vector<T> partial(count);
+        parallelFor(count, [&](size_t i) { partial[i] = map(i); }, priority, token);
+        for (auto& value : partial) {
+            init = reduce(std::move(init), std::move(value));
+        }
+        return init;
+    }
+
+    /**
+     * @brief Zwraca liczbę wątków puli.
+     */
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /**
+     * @brief Zwraca zbiorcze statystyki puli.
+     *
+     * @return Statystyki od utworzenia puli.
+     */
+    Stats getStats() const;
+
+private:
+    /**
+     * @brief Zadanie w kolejce.
+     */
+    struct Task {
+        std::shared_ptr<TaskHandle::State> state;           ///< Stan widoczny przez uchwyt.
+        std::function<void(const CancellationToken&)> work; ///< Praca do wykonania.
+    };
+
+    /**
+     * @brief Wątek roboczy z własnymi kolejkami (po jednej na priorytet).
+     */
+    struct Worker {
+        std::mutex mutex;         ///< Chroni kolejki.
+        std::deque<Task> queues[2]; ///< Kolejki według priorytetu.
+        std::thread thread;       ///< Wątek.
+    };
+
+    /**
+     * @brief Umieszcza zadanie w kolejce (własnej, jeśli wywołuje wątek puli) i budzi wątek.
+     */
+    void push(Task task, Priority priority);
+
+    /**
+     * @brief Pobiera zadanie: najpierw interaktywne (własne, potem podkradzione), następnie tła.
+     */
+    bool tryPop(int workerIndex, Task& task);
+
+    /**
+     * @brief Wykonuje jedno zadanie z kolejek, jeśli jakieś czeka.
+     *
+     * @return true jeśli wykonano zadanie.
+     */
+    bool tryRunOne();
+
+    /**
+     * @brief Wykonuje zadanie i zapisuje jego czasy.
+     */
+    void run(Task& task);
+
+    /**
+     * @brief Pętla wątku roboczego.
+     */
+    void workerLoop(int workerIndex);
+
+    std::vector<std::unique_ptr<Worker>> workers_; ///< Wątki robocze.
+    std::mutex sleepMutex_;                        ///< Chroni usypianie i budzenie wątków.
+    std::condition_variable sleepCondition_;       ///< Budzi wątki po zgłoszeniu zadania.
+    std::atomic<size_t> pending_;                  ///< Liczba zadań w kolejkach.
+    std::atomic<size_t> nextQueue_;                ///< Kolejka dla zadań z wątków spoza puli.
+    bool stopping_;                                ///< Pula jest zamykana (chronione przez sleepMutex_).
+
+    std::atomic<uint64_t> submitted_;              ///< Licznik zgłoszonych zadań.
+    std::atomic<uint64_t> completed_;              ///< Licznik zakończonych zadań.
+    std::atomic<uint64_t> cancelled_;              ///< Licznik anulowanych zadań.
+    std::atomic<uint64_t> failed_;                 ///< Licznik zadań z wyjątkiem.
+    std::atomic<uint64_t> stolen_;                 ///< Licznik podkradzionych zadań.
+    std::atomic<int64_t> runNanoseconds_[2];       ///< Łączny czas wykonania według priorytetu.
+    std::atomic<int64_t> waitNanoseconds_[2];      ///< Łączny czas oczekiwania według priorytetu.
+};
@@ -0,0 +1,326 @@
+/**
+ * @file TrendAnalyzer.cpp
+ * @brief Implementacja analizy trendu metodami Theila-Sena i Manna-Kendalla.
+ */
+
+#include "TrendAnalyzer.h"
+#include "TaskScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Punkt serii: czas w godzinach od pierwszego pomiaru i wartość.
+ */
+struct Point {
+    double x; ///< Czas w godzinach.
+    double y; ///< Wartość.
+};
+
+/**
+ * @brief Zlicza pary i < j, dla których keys[j] <= keys[i] (sortując klucze przez scalanie).
+ *
+ * @param keys Klucze (po wywołaniu posortowane rosnąco).
+ * @param buffer Bufor pomocniczy.
+ * @return Liczba par.
+ */
+uint64_t countNonIncreasingPairs(std::vector<double>& keys, std::vector<double>& buffer) {
+    const size_t n = keys.size();
+    buffer.resize(n);
+    uint64_t count = 0;
+
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = std::min(left + width, n);
+            size_t right = std::min(left + 2 * width, n);
+            size_t i = left, j = mid, k = left;
+            while (i < mid && j < right) {
+                if (keys[i] < keys[j]) {
+                    buffer[k++] = keys[i++];
+                }
+                else {
+                    // Wszystkie pozostałe elementy lewej części są >= keys[j]
+                    count += mid - i;
+                    buffer[k++] = keys[j++];
+                }
+            }
+            while (i < mid) buffer[k++] = keys[i++];
+            while (j < right) buffer[k++] = keys[j++];
+        }
+        keys.swap(buffer);
+    }
+    return count;
+}
+
+/**
+ * @brief Zlicza pary punktów o nachyleniu nie większym niż s.
+ *
+ * Nachylenie pary i < j jest <= s wtedy i tylko wtedy, gdy y_j - s*x_j <= y_i - s*x_i,
+ * więc wystarczy policzyć inwersje ciągu z = y - s*x.
+ */
+uint64_t countSlopesAtMost(const std::vector<Point>& points, double s, std::vector<double>& keys, std::vector<double>& buffer) {
+    keys.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        keys[i] = points[i].y - s * points[i].x;
+    }
+    return countNonIncreasingPairs(keys, buffer);
+}
+
+/**
+ * @brief Zbiera nachylenia par z przedziału (lo, hi].
+ *
+ * Punkty są ustawiane według z = y - lo*x; pary, które przy przejściu do z = y - hi*x zamieniają się
+ * kolejnością, to dokładnie pary o nachyleniu z przedziału. Wyszukiwane są jako inwersje
+ * sortowaniem przez scalanie w czasie O(n log n + liczba par).
+ *
+ * @param limit Maksymalna liczba zebranych nachyleń.
+ */
+void collectSlopesBetween(const std::vector<Point>& points, double lo, double hi, size_t limit, std::vector<double>& slopes) {
+    const size_t n = points.size();
+    std::vector<size_t> order(n);
+    for (size_t i = 0; i < n; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        double za = points[a].y - lo * points[a].x;
+        double zb = points[b].y - lo * points[b].x;
+        if (za != zb) return za < zb;
+        return points[a].x > points[b].x;
+    });
+
+    std::vector<std::pair<double, size_t>> items(n), buffer(n);
+    for (size_t i = 0; i < n; i++) {
+        items[i] = { points[order[i]].y - hi * points[order[i]].x, order[i] };
+    }
+
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = std::min(left + width, n);
+            size_t right = std::min(left + 2 * width, n);
+            size_t i = left, j = mid, k = left;
+            while (i < mid && j < right) {
+                if (items[i].first < items[j].first) {
+                    buffer[k++] = items[i++];
+                    continue;
+                }
+                const Point& b = points[items[j].second];
+                for (size_t t = i; t < mid; t++) {
+                    const Point& a = points[items[t].second];
+                    if (!(a.x < b.x)) continue;
+                    double slope = (b.y - a.y) / (b.x - a.x);
+                    if (slope > lo && slope <= hi) {
+                        slopes.push_back(slope);
+                        if (slopes.size() >= limit) return;
+                    }
+                }
+                buffer[k++] = items[j++];
+            }
+            while (i < mid) buffer[k++] = items[i++];
+            while (j < right) buffer[k++] = items[j++];
+        }
+        items.swap(buffer);
+    }
+}
+
+/**
+ * @brief Wyznacza k-te (od 1) najmniejsze nachylenie spośród wszystkich par punktów.
+ *
+ * Przedział zawierający szukane nachylenie jest zawężany bisekcją (każdy krok to zliczenie
+ * inwersji w O(n log n)), aż zostanie w nim nie więcej niż n par - te są zbierane jawnie.
+ */
+double kthSlope(const std::vector<Point>& points, uint64_t k, double bound) {
+    const size_t n = points.size();
+    std::vector<double> keys, buffer;
+
+    double lo = -bound, hi = bound;
+    uint64_t countLo = 0;
+    uint64_t countHi = static_cast<uint64_t>(n) * (n - 1) / 2;
+
+    for (int iteration = 0; iteration < 200 && countHi - countLo > n; iteration++) {
+        double mid = lo + (hi - lo) / 2.0;
+        if (hi - lo <= 1e-12 * std::max(1.0, std::max(std::fabs(lo), std::fabs(hi))) || mid <= lo || mid >= hi) {
+            break;
+        }
+        uint64_t count = countSlopesAtMost(points, mid, keys, buffer);
+        if (count >= k) {
+            hi = mid;
+            countHi = count;
+        }
+        else {
+            lo = mid;
+            countLo = count;
+        }
+    }
+
+    // Przy wielu jednakowych nachyleniach (np. powtarzające się wartości) przedział się nie zawęża -
+    // wtedy dowolne nachylenie z przedziału jest równe szukanemu z dokładnością maszynową
+    std::vector<double> slopes;
+    collectSlopesBetween(points, lo, hi, n + 1, slopes);
+    if (slopes.empty()) return hi;
+    if (slopes.size() > n) return slopes.front();
+
+    std::sort(slopes.begin(), slopes.end());
+    uint64_t index = k > countLo ? k - countLo - 1 : 0;
+    return slopes[std::min<uint64_t>(index, slopes.size() - 1)];
+}
+
+/**
+ * @brief Wartość krytyczna rozkładu normalnego dla dwustronnego poziomu istotności.
+ */
+double normalCriticalValue(double alpha) {
+    double lo = 0.0, hi = 10.0;
+    for (int i = 0; i < 100; i++) {
+        double mid = (lo + hi) / 2.0;
+        if (std::erfc(mid / std::sqrt(2.0)) > alpha) lo = mid;
+        else hi = mid;
+    }
+    return (lo + hi) / 2.0;
+}
+
+} // namespace
+
+/**
+ * @brief Analizuje trend serii pomiarów.
+ *
+ * @param series Seria pomiarów posortowana rosnąco po czasie.
+ * @param alpha Poziom istotności.
+ * @return Wynik analizy.
+ */
+TrendAnalyzer::Result TrendAnalyzer::analyze(const MeasurementSeries& series, double alpha) {
+    Result result{};
+    result.trend = MeasurementAnalyzer::Trend::UNKNOWN;
+    result.pValue = 1.0;
+
+    // Punkty prawidłowe, pomiary o tym samym czasie uśredniane (nachylenie pary byłoby nieokreślone)
+    const auto& timestamps = series.getTimestamps();
+    const auto& values = series.getValues();
+    std::vector<Point> points;
+    points.reserve(series.size());
+    int64_t origin = 0;
+    int64_t lastTimestamp = 0;
+    size_t sameCount = 0;
+    for (size_t i = 0; i < series.size(); i++) {
+        if (!(values[i] >= 0)) continue;
+        if (points.empty()) origin = timestamps[i];
+
+        if (!points.empty() && timestamps[i] == lastTimestamp) {
+            sameCount++;
+            points.back().y += (values[i] - points.back().y) / sameCount;
+            continue;
+        }
+        points.push_back({ static_cast<double>(timestamps[i] - origin) / 3600.0, values[i] });
+        lastTimestamp = timestamps[i];
+        sameCount = 1;
+    }
+
+    const size_t n = points.size();
+    result.count = n;
+    if (n < 3) return result;
+
+    const uint64_t pairs = static_cast<uint64_t>(n) * (n - 1) / 2;
+
+    // Mann-Kendall: S = C - D = pary - remisy - 2 * (pary nierosnące - remisy)
+    std::vector<double> keys(n), buffer;
+    for (size_t i = 0; i < n; i++) keys[i] = points[i].y;
+    uint64_t nonIncreasing = countNonIncreasingPairs(keys, buffer);
+
+    uint64_t tiedPairs = 0;
+    double tieCorrection = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && keys[j] == keys[i]) j++;
+        double t = static_cast<double>(j - i);
+        tiedPairs += static_cast<uint64_t>(j - i) * (j - i - 1) / 2;
+        tieCorrection += t * (t - 1.0) * (2.0 * t + 5.0);
+        i = j;
+    }
+
+    const double nd = static_cast<double>(n);
+    result.kendallS = static_cast<double>(pairs) + static_cast<double>(tiedPairs) - 2.0 * static_cast<double>(nonIncreasing);
+    result.varianceS = (nd * (nd - 1.0) * (2.0 * nd + 5.0) - tieCorrection) / 18.0;
+    result.tau = result.kendallS / static_cast<double>(pairs);
+
+    if (result.varianceS > 0.0) {
+        double sd = std::sqrt(result.varianceS);
+        if (result.kendallS > 0.0) result.z = (result.kendallS - 1.0) / sd;
+        else if (result.kendallS < 0.0) result.z = (result.kendallS + 1.0) / sd;
+        result.pValue = std::erfc(std::fabs(result.z) / std::sqrt(2.0));
+    }
+
+    // Theil-Sen: mediana nachyleń wszystkich par
+    double minY = keys.front(), maxY = keys.back();
+    double minDx = std::numeric_limits<double>::infinity();
+    for (size_t i = 1; i < n; i++) {
+        minDx = std::min(minDx, points[i].x - points[i - 1].x);
+    }
+    double bound = (maxY - minY) / minDx + 1.0;
+
+    if (pairs % 2 == 1) {
+        result.slopePerHour = kthSlope(points, pairs / 2 + 1, bound);
+    }
+    else {
+        result.slopePerHour = (kthSlope(points, pairs / 2, bound) + kthSlope(points, pairs / 2 + 1, bound)) / 2.0;
+    }
+
+    // Przedział ufności nachylenia (rzędy wyznaczone z wariancji S)
+    double c = normalCriticalValue(alpha) * std::sqrt(std::max(0.0, result.varianceS));
+    uint64_t lowerRank = static_cast<uint64_t>(std::max(1.0, std::round((static_cast<double>(pairs) - c) / 2.0)));
+    uint64_t upperRank = static_cast<uint64_t>(std::min(static_cast<double>(pairs), std::round((static_cast<double>(pairs) + c) / 2.0) + 1.0));
+    result.lowerSlope = kthSlope(points, lowerRank, bound);
+    result.upperSlope = kthSlope(points, upperRank, bound);
+
+    std::vector<double> residuals(n);
+    for (size_t i = 0; i < n; i++) {
+        residuals[i] = points[i].y - result.slopePerHour * points[i].x;
+    }
+    auto middle = residuals.begin() + n / 2;
+    std::nth_element(residuals.begin(), middle, residuals.end());
+    result.intercept = *middle;
+    if (n % 2 == 0) {
+        result.intercept = (result.intercept + *std::max_element(residuals.begin(), middle)) / 2.0;
+    }
+
+    if (result.pValue < alpha && result.kendallS > 0.0) result.trend = MeasurementAnalyzer::Trend::RISING;
+    else if (result.pValue < alpha && result.kendallS < 0.0) result.trend = MeasurementAnalyzer::Trend::FALLING;
+    else result.trend = MeasurementAnalyzer::Trend::STABLE;
+
+    return result;
+}
+
+/**
+ * @brief Analizuje trend wielu serii równolegle.
+ *
+ * @param series Serie pomiarów.
+ * @param alpha Poziom istotności.
+ * @return Wyniki w tej samej kolejności co serie.
+ */
+std::vector<TrendAnalyzer::Result> TrendAnalyzer::analyzeMany(const std::vector<MeasurementSeries>& series, double alpha) {
+    std::vector<Result> results(series.size());
+    if (series.empty()) return results;
+
+    TaskScheduler::shared().parallelFor(series.size(), [&](size_t i) {
+        results[i] = analyze(series[i], alpha);
+    });
+
+    return results;
+}
+
+/**
+ * @brief Zwraca opis trendu wraz z nachyleniem i istotnością.
+ *
+ * @param result Wynik analizy.
+ * @return Opis tekstowy (UTF-8).
+ */
+std::string TrendAnalyzer::describe(const Result& result) {
+    std::ostringstream out;
+    switch (result.trend) {
+    case MeasurementAnalyzer::Trend::RISING: out << "wzrostowy"; break;
+    case MeasurementAnalyzer::Trend::FALLING: out << "malejący"; break;
+    case MeasurementAnalyzer::Trend::STABLE: out << "brak istotnego trendu"; break;
+    case MeasurementAnalyzer::Trend::UNKNOWN: return "nieznany (zbyt mało danych)";
+    }
+    out << ", " << result.slopePerHour * 24.0 << " na dobę (p = " << result.pValue << ")";
+    return out.str();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MeasurementSeries.h"
+#include "MeasurementAnalyzer.h"
+
+/**
+ * @file TrendAnalyzer.h
+ * @brief Odporna analiza trendu względem czasu: nachylenie Theila-Sena i test Manna-Kendalla.
+ *
+ * W odróżnieniu od MeasurementAnalyzer oś x to rzeczywisty czas pomiaru (w godzinach), więc luki
+ * w danych nie zniekształcają nachylenia, a o istnieniu trendu decyduje istotność statystyczna
+ * zamiast stałego progu zależnego od jednostek. Oba estymatory są liczone w czasie O(n log n)
+ * (zliczanie inwersji sortowaniem przez scalanie) zamiast naiwnego przeglądu wszystkich par.
+ */
+class TrendAnalyzer {
+public:
+    /**
+     * @brief Wynik analizy trendu.
+     */
+    struct Result {
+        size_t count;        ///< Liczba prawidłowych pomiarów użytych w analizie.
+        double slopePerHour; ///< Nachylenie Theila-Sena (mediana nachyleń par) na godzinę.
+        double lowerSlope;   ///< Dolna granica przedziału ufności nachylenia.
+        double upperSlope;   ///< Górna granica przedziału ufności nachylenia.
+        double intercept;    ///< Wyraz wolny (wartość w chwili pierwszego pomiaru).
+        double kendallS;     ///< Statystyka S Manna-Kendalla.
+        double varianceS;    ///< Wariancja S z poprawką na wartości powtarzające się.
+        double tau;          ///< Współczynnik tau Kendalla.
+        double z;            ///< Statystyka Z (z poprawką na ciągłość).
+        double pValue;       ///< Dwustronna wartość p testu.
+        MeasurementAnalyzer::Trend trend; ///< Trend (STABLE, jeśli nieistotny statystycznie).
+    };
+
+    /**
+     * @brief Analizuje trend serii pomiarów.
+     *
+     * Pomiary nieprawidłowe są pomijane, a pomiary o tym samym znaczniku czasu uśredniane.
+     *
+     * @param series Seria pomiarów posortowana rosnąco po czasie.
+     * @param alpha Poziom istotności testu i przedziału ufności (np. 0.05).
+     * @return Wynik analizy (trend UNKNOWN, jeśli pomiarów jest mniej niż 3).
+     */
+    static Result analyze(const MeasurementSeries& series, double alpha = 0.05);
+
+    /**
+     * @brief Analizuje trend wielu serii równolegle (np. wszystkich sensorów).
+     *
+     * @param series Serie pomiarów.
+     * @param alpha Poziom istotności.
+     * @return Wyniki w tej samej kolejności co serie.
+     */
+    static std::vector<Result> analyzeMany(const std::vector<MeasurementSeries>& series, double alpha = 0.05);
+
+    /**
+     * @brief Zwraca opis trendu wraz z nachyleniem i istotnością.
+     *
+     * @param result Wynik analizy.
+     * @return Opis tekstowy (UTF-8).
+     */
+    static std::string describe(const Result& result);
+};
@@ -0,0 +1,130 @@
+/**
+ * @file WxChartCanvas.cpp
+ * @brief Implementacja powierzchni rysowania wykresu opartej na wxGraphicsContext.
+ */
+
+#include "WxChartCanvas.h"
+
+/**
+ * @brief Tworzy powierzchnię rysującą do podanego kontekstu.
+ *
+ * @param context Kontekst graficzny.
+ */
+WxChartCanvas::WxChartCanvas(wxGraphicsContext& context) : context_(context) {
+    context_.SetAntialiasMode(wxANTIALIAS_DEFAULT);
+}
+
+/**
+ * @brief Ustawia pióro dla linii i obrysów.
+ */
+void WxChartCanvas::setPen(const ChartColour& colour, double width, bool dotted) {
+    context_.SetPen(wxPen(wxColour(colour.red, colour.green, colour.blue), static_cast<int>(width + 0.5),
+        dotted ? wxPENSTYLE_DOT : wxPENSTYLE_SOLID));
+}
+
+/**
+ * @brief Wyłącza obrys.
+ */
+void WxChartCanvas::setNoPen() {
+    context_.SetPen(*wxTRANSPARENT_PEN);
+}
+
+/**
+ * @brief Ustawia kolor wypełnienia.
+ */
+void WxChartCanvas::setBrush(const ChartColour& colour) {
+    context_.SetBrush(wxBrush(wxColour(colour.red, colour.green, colour.blue)));
+}
+
+/**
+ * @brief Ustawia czcionkę; czcionka danego rozmiaru jest tworzona tylko przy pierwszym użyciu.
+ */
+void WxChartCanvas::setFont(double pointSize, bool bold) {
+    for (const auto& cached : fonts_) {
+        if (cached.pointSize == pointSize && cached.bold == bold) {
+            context_.SetFont(cached.font, *wxBLACK);
+            return;
+        }
+    }
+    wxFont font(static_cast<int>(pointSize + 0.5), wxFONTFAMILY_DEFAULT, wxFONTSTYLE_NORMAL,
+        bold ? wxFONTWEIGHT_BOLD : wxFONTWEIGHT_NORMAL);
+    fonts_.push_back({ pointSize, bold, font });
+    context_.SetFont(font, *wxBLACK);
+}
+
+/**
+ * @brief Rysuje odcinek.
+ */
+void WxChartCanvas::drawLine(double x1, double y1, double x2, double y2) {
+    context_.StrokeLine(x1, y1, x2, y2);
+}
+
+/**
+ * @brief Rysuje łamaną.
+ */
+void WxChartCanvas::drawLines(const std::vector<Point>& points) {
+    const std::vector<wxPoint2DDouble>& converted = convert(points);
+    context_.StrokeLines(converted.size(), converted.data());
+}
+
+/**
+ * @brief Rysuje wypełniony wielokąt.
+ */
+void WxChartCanvas::drawPolygon(const std::vector<Point>& points) {
+    const std::vector<wxPoint2DDouble>& converted = convert(points);
+    context_.DrawLines(converted.size(), converted.data());
+}
+
+/**
+ * @brief Rysuje wypełnione koło.
+ */
+void WxChartCanvas::drawCircle(double x, double y, double radius) {
+    context_.DrawEllipse(x - radius, y - radius, 2 * radius, 2 * radius);
+}
+
+/**
+ * @brief Rysuje wypełniony prostokąt.
+ */
+void WxChartCanvas::drawRectangle(double x, double y, double width, double height) {
+    context_.DrawRectangle(x, y, width, height);
+}
+
+/**
+ * @brief Rysuje tekst.
+ */
+void WxChartCanvas::drawText(const std::string& text, double x, double y) {
+    context_.DrawText(wxString::FromUTF8(text), x, y);
+}
+
+/**
+ * @brief Mierzy tekst bieżącą czcionką.
+ */
+void WxChartCanvas::getTextExtent(const std::string& text, double& width, double& height) {
+    context_.GetTextExtent(wxString::FromUTF8(text), &width, &height);
+}
+
+/**
+ * @brief Ogranicza rysowanie do prostokąta.
+ */
+void WxChartCanvas::setClip(double x, double y, double width, double height) {
+    context_.ResetClip();
+    context_.Clip(x, y, width, height);
+}
+
+/**
+ * @brief Usuwa ograniczenie rysowania.
+ */
+void WxChartCanvas::resetClip() {
+    context_.ResetClip();
+}
+
+/**
+ * @brief Przepisuje punkty do formatu wxGraphicsContext (do wspólnego bufora).
+ */
+const std::vector<wxPoint2DDouble>& WxChartCanvas::convert(const std::vector<Point>& points) {
+    points_.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        points_[i] = wxPoint2DDouble(points[i].x, points[i].y);
+    }
+    return points_;
+}
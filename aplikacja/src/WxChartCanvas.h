@@ -0,0 +1,56 @@
+#pragma once
+
+#include <wx/wx.h>
+#include <wx/graphics.h>
+#include <vector>
+#include "ChartCanvas.h"
+
+/**
+ * @file WxChartCanvas.h
+ * @brief Powierzchnia rysowania wykresu oparta na wxGraphicsContext (panel na ekranie lub obraz w pamięci).
+ *
+ * Kontekst może być utworzony dla wxMemoryDC (bitmapa panelu) albo dla wxImage - ten drugi
+ * wariant nie wymaga okna ani ekranu i jest używany przy wsadowym tworzeniu wykresów PNG.
+ */
+class WxChartCanvas : public ChartCanvas {
+public:
+    /**
+     * @brief Tworzy powierzchnię rysującą do podanego kontekstu.
+     *
+     * @param context Kontekst graficzny (musi istnieć dłużej niż ten obiekt).
+     */
+    explicit WxChartCanvas(wxGraphicsContext& context);
+
+    void setPen(const ChartColour& colour, double width, bool dotted = false) override;
+    void setNoPen() override;
+    void setBrush(const ChartColour& colour) override;
+    void setFont(double pointSize, bool bold) override;
+    void drawLine(double x1, double y1, double x2, double y2) override;
+    void drawLines(const std::vector<Point>& points) override;
+    void drawPolygon(const std::vector<Point>& points) override;
+    void drawCircle(double x, double y, double radius) override;
+    void drawRectangle(double x, double y, double width, double height) override;
+    void drawText(const std::string& text, double x, double y) override;
+    void getTextExtent(const std::string& text, double& width, double& height) override;
+    void setClip(double x, double y, double width, double height) override;
+    void resetClip() override;
+
+private:
+    /**
+     * @brief Przepisuje punkty do formatu wxGraphicsContext.
+     */
+    const std::vector<wxPoint2DDouble>& convert(const std::vector<Point>& points);
+
+    /**
+     * @brief Czcionka zapamiętana dla rozmiaru i grubości.
+     */
+    struct CachedFont {
+        double pointSize; ///< Rozmiar w punktach.
+        bool bold;        ///< Pogrubienie.
+        wxFont font;      ///< Czcionka.
+    };
+
+    wxGraphicsContext& context_;          ///< Kontekst graficzny.
+    std::vector<CachedFont> fonts_;       ///< Czcionki utworzone dotąd (tworzone raz na rozmiar).
+    std::vector<wxPoint2DDouble> points_; ///< Bufor punktów wielokrotnego użytku.
+};
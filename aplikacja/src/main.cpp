@@ -1,35 +1,87 @@
-/**
- * @file main.cpp
- * @brief Punkt wejścia do aplikacji wxWidgets - tworzy i pokazuje główne okno (MainFrame).
- */
-
-#include <wx/wx.h>
-#include "MainFrame.h"
-
- /**
-  * @class MyApp
-  * @brief Główna klasa aplikacji dziedzicząca po wxApp.
-  *
-  * Odpowiada za inicjalizację lokalizacji oraz uruchomienie głównego okna aplikacji.
-  */
-class MyApp : public wxApp {
-public:
-    /**
-     * @brief Funkcja inicjalizacyjna aplikacji wxWidgets.
-     *
-     * Ustawia lokalizację na język polski, tworzy i pokazuje główne okno.
-     *
-     * @return true jeśli inicjalizacja się powiodła.
-     */
-    bool OnInit() override {
-        wxLocale locale;
-        setlocale(LC_ALL, "");
-        locale.Init(wxLANGUAGE_POLISH);
-        MainFrame* frame = new MainFrame("Jakosc_Powietrza-Piotr Czajkowski");
-        frame->Show(true);
-        return true;
-    }
-};
-
-/// Makro wxWidgets, które definiuje główną funkcję main() i uruchamia aplikację.
+/**
+ * @file main.cpp
+ * @brief Punkt wejścia do aplikacji wxWidgets - tworzy i pokazuje główne okno (MainFrame).
+ *
+ * Uruchomienie z argumentami "--raport <katalog> [dni]" tworzy bez okna wykresy PNG i SVG
+ * wszystkich zapisanych w bazie serii (ostatnie dni, domyślnie 7) i kończy program.
+ */
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <cstdio>
+#include "MainFrame.h"
+#include "ChartBatch.h"
+
+ /**
+  * @class MyApp
+  * @brief Główna klasa aplikacji dziedzicząca po wxApp.
+  *
+  * Odpowiada za inicjalizację lokalizacji oraz uruchomienie głównego okna aplikacji.
+  */
+class MyApp : public wxApp {
+public:
+    /**
+     * @brief Funkcja inicjalizacyjna aplikacji wxWidgets.
+     *
+     * Ustawia lokalizację na język polski, rejestruje obsługę formatów obrazów,
+     * tworzy i pokazuje główne okno (w trybie raportu okno nie jest tworzone).
+     *
+     * @return true jeśli inicjalizacja się powiodła.
+     */
+    bool OnInit() override {
+        wxLocale locale;
+        setlocale(LC_ALL, "");
+        locale.Init(wxLANGUAGE_POLISH);
+        wxInitAllImageHandlers(); // zapis map do PNG
+
+        // Tryb wsadowy: --raport <katalog> [dni]
+        if (argc >= 3 && argv[1] == "--raport") {
+            reportDirectory = argv[2];
+            long days = 7;
+            if (argc >= 4 && argv[3].ToLong(&days) && days >= 0) {
+                reportDays = static_cast<int>(days);
+            }
+            return true;
+        }
+
+        MainFrame* frame = new MainFrame("Jakosc_Powietrza-Piotr Czajkowski");
+        frame->Show(true);
+        return true;
+    }
+
+    /**
+     * @brief Uruchamia pętlę zdarzeń albo - w trybie raportu - tworzy wykresy i kończy program.
+     *
+     * @return Kod wyjścia (w trybie raportu 1, jeśli któregoś pliku nie udało się zapisać).
+     */
+    int OnRun() override {
+        if (reportDirectory.empty()) {
+            return wxApp::OnRun();
+        }
+
+        if (!wxFileName::Mkdir(reportDirectory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+            std::fprintf(stderr, "Nie można utworzyć katalogu %s\n", static_cast<const char*>(reportDirectory.utf8_str()));
+            return 1;
+        }
+
+        DatabaseManager dbManager("data/air_quality_data.json");
+        ChartBatch batch(dbManager);
+        std::vector<ChartBatch::Job> jobs = batch.collectJobs(reportDays);
+        ChartBatch::Result result = ChartBatch::render(jobs, std::string(reportDirectory.utf8_str()),
+            ChartBatch::PNG | ChartBatch::SVG);
+
+        std::printf("Wykresy: %zu, zapisane pliki: %zu, błędy: %zu, czas: %.2f s\n",
+            result.charts, result.files, result.failed, result.seconds);
+        for (const auto& error : result.errors) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+        }
+        return result.failed == 0 ? 0 : 1;
+    }
+
+private:
+    wxString reportDirectory;  ///< Katalog raportu (pusty - zwykłe uruchomienie z oknem).
+    int reportDays = 7;        ///< Liczba dni na wykresach raportu.
+};
+
+/// Makro wxWidgets, które definiuje główną funkcję main() i uruchamia aplikację.
 wxIMPLEMENT_APP(MyApp);
\ No newline at end of file
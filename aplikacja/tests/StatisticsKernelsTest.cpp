@@ -0,0 +1,202 @@
+/**
+ * @file StatisticsKernelsTest.cpp
+ * @brief Porównanie wariantów SIMD jąder statystyk (StatisticsKernels) z wariantem skalarnym i pomiar czasu.
+ *
+ * Każdy wariant obsługiwany przez procesor (SSE2, AVX2, AVX-512) jest porównywany z wariantem skalarnym
+ * dla kolumn double i float o różnych długościach (także krótszych niż szerokość wektora i z niepełną
+ * końcówką), z brakami (-1.0), wartościami NaN, samymi wartościami nieprawidłowymi oraz dużym przesunięciem
+ * wartości (utrata precyzji przy odejmowaniu sum). Liczba punktów, minimum, maksimum i ich indeksy muszą być
+ * identyczne; średnia, wariancja i nachylenie mogą się różnić tylko kolejnością sumowania, więc są
+ * porównywane z dopuszczalną liczbą ULP względem skali danych (rosnącą jak pierwiastek z liczby
+ * sumowanych wartości, tak jak błąd zaokrągleń sumy). Uruchomienie:
+ *
+ *     StatisticsKernelsTest [liczba_wartości_w_pomiarze_czasu]
+ *
+ * Kod wyjścia 1 oznacza niezgodność któregoś wariantu.
+ */
+
+#include "StatisticsKernels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using InstructionSet = StatisticsKernels::InstructionSet;
+
+/// Dopuszczalny błąd średniej, wariancji i nachylenia w ULP skali danych (mnożony przez pierwiastek z długości).
+const double MAX_ULPS = 16.0;
+
+/// Warianty porównywane z wariantem skalarnym.
+const InstructionSet VECTOR_SETS[] = { InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512 };
+
+/**
+ * @brief Przypadek testowy - kolumna wartości i jej opis.
+ */
+struct Case {
+    std::string name;           ///< Opis przypadku.
+    std::vector<double> values; ///< Wartości (ujemne i NaN - brak pomiaru).
+};
+
+/**
+ * @brief Sprawdza, czy dwie wartości różnią się co najwyżej o MAX_ULPS * sqrt(count) jednostek
+ * ostatniego miejsca skali.
+ *
+ * @param a Wartość wariantu wektorowego.
+ * @param b Wartość wariantu skalarnego.
+ * @param scale Skala wielkości (np. największa wartość bezwzględna danych).
+ * @param count Liczba sumowanych wartości.
+ * @return true jeśli różnica mieści się w granicy.
+ */
+bool close(double a, double b, double scale, size_t count) {
+    const double unit = std::numeric_limits<double>::epsilon() * std::max({ std::abs(a), std::abs(b), scale });
+    return std::abs(a - b) <= MAX_ULPS * std::sqrt(static_cast<double>(std::max<size_t>(count, 1))) * unit;
+}
+
+/**
+ * @brief Porównuje wynik wariantu z wynikiem skalarnym.
+ *
+ * @param label Opis (wariant, typ, przypadek) do komunikatu o błędzie.
+ * @param got Wynik wariantu wektorowego.
+ * @param expected Wynik wariantu skalarnego.
+ * @param count Długość kolumny (skala osi x).
+ * @return true jeśli wyniki są zgodne.
+ */
+bool compare(const std::string& label, const StatisticsKernels::Summary& got, const StatisticsKernels::Summary& expected,
+    size_t count) {
+    bool ok = got.count == expected.count;
+    if (ok && expected.count > 0) {
+        const double range = expected.max - expected.min;
+        const double valueScale = std::max(std::abs(expected.max), std::abs(expected.min));
+        ok = got.min == expected.min && got.minIndex == expected.minIndex &&
+            got.max == expected.max && got.maxIndex == expected.maxIndex &&
+            close(got.mean, expected.mean, valueScale, count) &&
+            close(got.variance, expected.variance, range * range, count) &&
+            close(got.slope, expected.slope, range / static_cast<double>(count), count);
+    }
+    if (!ok) {
+        std::printf("NIEZGODNOŚĆ %s: count %zu/%zu, min %.17g[%zu]/%.17g[%zu], max %.17g[%zu]/%.17g[%zu], "
+            "średnia %.17g/%.17g, wariancja %.17g/%.17g, nachylenie %.17g/%.17g\n", label.c_str(),
+            got.count, expected.count, got.min, got.minIndex, expected.min, expected.minIndex,
+            got.max, got.maxIndex, expected.max, expected.maxIndex, got.mean, expected.mean,
+            got.variance, expected.variance, got.slope, expected.slope);
+    }
+    return ok;
+}
+
+/**
+ * @brief Tworzy przypadki testowe.
+ *
+ * @return Przypadki dla wszystkich długości i rodzajów danych.
+ */
+std::vector<Case> makeCases() {
+    const size_t lengths[] = { 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 1000, 100003 };
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+    std::mt19937 random(2024);
+    std::uniform_real_distribution<double> uniform(0.0, 200.0);
+
+    std::vector<Case> cases;
+    for (size_t length : lengths) {
+        const std::string suffix = " n=" + std::to_string(length);
+        Case gaps{ "braki co 7." + suffix, std::vector<double>(length) };
+        Case nan{ "NaN i ujemne" + suffix, std::vector<double>(length) };
+        Case invalid{ "same nieprawidłowe" + suffix, std::vector<double>(length) };
+        Case offset{ "przesunięcie 1e9" + suffix, std::vector<double>(length) };
+        Case ties{ "powtórzone min/max" + suffix, std::vector<double>(length) };
+        for (size_t i = 0; i < length; i++) {
+            const double v = uniform(random);
+            gaps.values[i] = i % 7 == 3 ? -1.0 : v;
+            nan.values[i] = i % 5 == 1 ? NaN : (i % 11 == 4 ? -v : v);
+            invalid.values[i] = i % 2 == 0 ? -1.0 : NaN;
+            offset.values[i] = 1e9 + v / 1000.0;
+            ties.values[i] = static_cast<double>((i * 7919) % 4);
+        }
+        for (Case* c : { &gaps, &nan, &invalid, &offset, &ties }) {
+            cases.push_back(std::move(*c));
+        }
+    }
+    return cases;
+}
+
+/**
+ * @brief Mierzy średni czas jednego wywołania summarize dla wariantu.
+ *
+ * @return Czas w milisekundach.
+ */
+template <typename T>
+double measure(const std::vector<T>& values, InstructionSet instructionSet) {
+    const int REPEATS = 20;
+    double sink = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        sink += StatisticsKernels::summarize(values.data(), values.size(), instructionSet).mean;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (sink == 42.0) std::printf(" ");  // wynik musi zostać użyty
+    return seconds * 1000.0 / REPEATS;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t benchmarkCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4000000;
+    const InstructionSet available = StatisticsKernels::getInstructionSet();
+    std::printf("Wykryty zestaw instrukcji: %s\n", StatisticsKernels::getInstructionSetName(available));
+
+    // Zgodność z wariantem skalarnym
+    const std::vector<Case> cases = makeCases();
+    size_t checks = 0, failures = 0;
+    for (InstructionSet instructionSet : VECTOR_SETS) {
+        const char* name = StatisticsKernels::getInstructionSetName(instructionSet);
+        if (instructionSet > available) {
+            std::printf("%-8s pominięty (brak wsparcia procesora lub systemu)\n", name);
+            continue;
+        }
+        size_t setFailures = 0;
+        for (const Case& c : cases) {
+            const std::vector<float> floats(c.values.begin(), c.values.end());
+            const StatisticsKernels::Summary expectedDouble =
+                StatisticsKernels::summarize(c.values.data(), c.values.size(), InstructionSet::SCALAR);
+            const StatisticsKernels::Summary expectedFloat =
+                StatisticsKernels::summarize(floats.data(), floats.size(), InstructionSet::SCALAR);
+
+            if (!compare(std::string(name) + " double, " + c.name,
+                StatisticsKernels::summarize(c.values.data(), c.values.size(), instructionSet), expectedDouble, c.values.size())) {
+                setFailures++;
+            }
+            if (!compare(std::string(name) + " float, " + c.name,
+                StatisticsKernels::summarize(floats.data(), floats.size(), instructionSet), expectedFloat, floats.size())) {
+                setFailures++;
+            }
+            checks += 2;
+        }
+        std::printf("%-8s %zu przypadków, niezgodnych: %zu\n", name, 2 * cases.size(), setFailures);
+        failures += setFailures;
+    }
+
+    // Pomiar czasu (co 7. wartość to brak pomiaru)
+    std::mt19937 random(7);
+    std::uniform_real_distribution<double> uniform(0.0, 200.0);
+    std::vector<double> doubles(benchmarkCount);
+    for (size_t i = 0; i < doubles.size(); i++) {
+        doubles[i] = i % 7 == 3 ? -1.0 : uniform(random);
+    }
+    const std::vector<float> floats(doubles.begin(), doubles.end());
+
+    std::printf("\nCzas jednego wywołania summarize dla %zu wartości [ms]:\n", benchmarkCount);
+    std::printf("%-8s %10s %10s\n", "wariant", "double", "float");
+    for (InstructionSet instructionSet : { InstructionSet::SCALAR, InstructionSet::SSE2, InstructionSet::AVX2, InstructionSet::AVX512 }) {
+        if (instructionSet > available) continue;
+        std::printf("%-8s %10.2f %10.2f\n", StatisticsKernels::getInstructionSetName(instructionSet),
+            measure(doubles, instructionSet), measure(floats, instructionSet));
+    }
+
+    std::printf("\nSprawdzenia: %zu, niezgodne: %zu\n", checks, failures);
+    return failures == 0 ? 0 : 1;
+}